@@ -0,0 +1,101 @@
+#pragma once
+
+#include "qse/core/Config.h"
+#include "qse/data/TickDataset.h"
+#include "qse/order/OrderManager.h"
+#include "qse/strategy/IStrategy.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qse {
+
+/// One tick CSV replayed by a job, under `symbol` (the reader's override)
+struct TickSource {
+    std::string data_file;
+    std::string symbol;
+};
+
+/**
+ * @brief One backtest of a batch: the data to replay, the strategy and the
+ * order manager configuration.
+ */
+struct BacktestJob {
+    // Builds the job's strategy around the job's own OrderManager. Called on
+    // a worker thread, once per run.
+    using StrategyFactory =
+        std::function<std::unique_ptr<IStrategy>(const std::shared_ptr<OrderManager>&)>;
+
+    std::string name;                // label in the results
+    std::string symbol;              // Backtester symbol
+    std::vector<TickSource> sources; // primary first (pairs jobs list both legs)
+    StrategyFactory make_strategy;
+
+    // Optional config (slippage, depth book, initial cash); without it the
+    // OrderManager is built from initial_cash alone
+    std::shared_ptr<const Config> config;
+    double initial_cash = 100000.0;
+
+    // Output files; empty discards that output
+    std::string equity_file;
+    std::string tradelog_file;
+
+    std::chrono::seconds bar_interval{60};
+};
+
+/// Outcome of one job. A job that throws is reported here, not rethrown.
+struct BacktestJobResult {
+    std::string name;
+    std::string symbol;
+    bool ok = false;
+    std::string error;
+    RunSummary summary;
+    double wall_seconds = 0.0;
+};
+
+/**
+ * @brief Runs a batch of backtests in parallel on a WorkStealingPool.
+ *
+ * Every distinct (data file, symbol) source is loaded once, as a TickDataset
+ * mapped straight from the binary tick cache, and all jobs replaying it share
+ * it through SharedTickDataReader; loads run in parallel too. Each job
+ * then gets its own OrderManager, strategy and Backtester, so jobs share
+ * nothing mutable and a 4-symbol x N-strategy sweep takes about as long as
+ * its slowest jobs rather than their sum.
+ *
+ * Jobs must not write to the same output files.
+ */
+class BacktestBatchRunner {
+public:
+    /// `threads` workers; 0 means one per hardware thread
+    explicit BacktestBatchRunner(unsigned threads = 0);
+
+    void add_job(BacktestJob job);
+    std::size_t job_count() const { return jobs_.size(); }
+
+    /// Loads the data, runs every job and returns the results in job order
+    std::vector<BacktestJobResult> run();
+
+    /// One line per job: return, max drawdown, trades, turnover, wall time
+    static void print_results(const std::vector<BacktestJobResult>& results, std::ostream& out);
+
+private:
+    using SourceKey = std::pair<std::string, std::string>; // (data_file, symbol)
+
+    BacktestJobResult run_job(const BacktestJob& job) const;
+
+    unsigned threads_;
+    std::vector<BacktestJob> jobs_;
+    // Loaded sources; a failed load maps to nullptr and fails its jobs
+    std::map<SourceKey, std::shared_ptr<const TickDataset>> datasets_;
+    std::map<SourceKey, std::string> load_errors_;
+};
+
+} // namespace qse
@@ -3,13 +3,14 @@
 #include <memory>
 #include <string> // <-- Add for std::string
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
+#include <map>
+#include <optional>
 
 #include "qse/data/IDataReader.h"
 #include "qse/strategy/IStrategy.h"
 #include "qse/order/IOrderManager.h"
-#include "qse/data/BarBuilder.h"
+#include "qse/data/InformationBarBuilder.h"
+#include "qse/data/MultiTimeframeBarBuilder.h"
 #include "qse/data/OrderBook.h"
 #include "qse/core/BarRouter.h"
 
@@ -29,27 +30,76 @@ public:
 
     void add_data_source(std::unique_ptr<IDataReader> data_reader);
 
+    // Build bars at several intervals from the one tick pass, e.g. {1s, 60s,
+    // 300s, 86400s}: finest first, each a multiple of the one before (see
+    // MultiTimeframeBarBuilder). Replaces bar_interval; call before the first
+    // tick. The strategy receives every interval and tells them apart by
+    // Bar::interval.
+    void set_bar_intervals(std::vector<std::chrono::seconds> intervals);
+
+    // Also build information-driven bars for every symbol: a bar per
+    // `threshold` ticks, shares or traded dollars (see InformationBarBuilder),
+    // in the same pass. Call before the first tick; may be called once per
+    // type/threshold wanted. The strategy receives them alongside the time
+    // bars and tells them apart by Bar::type.
+    void add_information_bars(BarType type, double threshold);
+
+    // Incremental driving for callers that own the tick stream (a parameter
+    // sweep feeds one stream to many Backtesters): step() processes one tick
+    // and returns false once the strategy has thrown; finish() flushes the
+    // last partial bar of every symbol. run() is this loop over the sources.
+    bool step(const Tick& tick) { return process_tick(tick); }
+    void finish();
+
+    // Record equity once per completed bar instead of on every tick: the
+    // order manager marks the portfolio only on ticks that complete a bar
+    // (any interval or bar type), plus once more in finish() if ticks
+    // arrived since. Off by default.
+    void set_equity_per_bar(bool enabled) { equity_per_bar_ = enabled; }
+
 private:
-    void process_tick(const Tick& tick);
+    // Routes and clears completed_bars_
+    void route_completed_bars();
+
+    // Drives one tick through strategy, bar builder and order manager.
+    // Returns false when the strategy threw and the run must stop.
+    bool process_tick(const Tick& tick);
+
+    // Per-symbol hot-path state, indexed by SymbolId so a tick never hashes
+    // its ticker string
+    struct SymbolState {
+        bool registered = false; // bar and tick routes set up in bar_router_
+        std::optional<MultiTimeframeBarBuilder> bar_builder;
+        std::vector<InformationBarBuilder> information_bar_builders;
+    };
+    SymbolState& symbol_state(SymbolId id);
+    // Feeds the tick to the symbol's bar builders; true if any bar completed
+    bool add_to_bars(SymbolState& state, const Tick& tick);
 
     std::string symbol_; // <-- Add member to store the symbol
     std::vector<std::unique_ptr<IDataReader>> data_readers_;
     std::unique_ptr<IStrategy> strategy_;
     std::shared_ptr<IOrderManager> order_manager_;
 
-    // BarRouter dispatches bars to strategies interested in each symbol.
+    // BarRouter dispatches ticks and bars to strategies interested in each symbol.
     BarRouter bar_router_;
 
-    // One BarBuilder per symbol to avoid mixing OHLC between symbols.
-    std::unordered_map<std::string, BarBuilder> bar_builders_;
-
     OrderBook order_book_;
 
-    // Cache symbols that have already been registered with the router to
-    // avoid duplicate registrations.
-    std::unordered_set<std::string> registered_symbols_;
+    // One entry per symbol seen: router registration flag and the symbol's
+    // own BarBuilder (so OHLC never mixes between symbols).
+    std::vector<SymbolState> symbol_states_;
 
     std::chrono::seconds bar_interval_;
+    std::vector<std::chrono::seconds> bar_intervals_; // {bar_interval_} unless set
+    std::vector<InformationBarBuilder> information_bars_; // prototypes, copied per symbol
+
+    // Bars completed by the current tick, reused so routing never allocates
+    std::vector<Bar> completed_bars_;
+
+    bool equity_per_bar_ = false;
+    // Per-bar mode: timestamp of the latest tick whose equity was not recorded
+    std::optional<long long> unrecorded_equity_ts_;
 };
 
 } // namespace qse
\ No newline at end of file
@@ -1,47 +1,132 @@
 #pragma once
 
 #include "qse/data/Data.h"
+#include "qse/data/SymbolTable.h"
 #include "qse/strategy/IStrategy.h"
-#include <unordered_map>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <chrono>
 
 namespace qse {
 
 /**
- * @brief Simple dispatcher that routes bars to strategies that have
- *        registered interest in a given symbol. The implementation is
- *        intentionally lightweight and header-only so we can avoid touching
- *        the build system / CMakeLists.txt.
+ * @brief Simple dispatcher that routes bars, and ticks, to strategies that
+ *        have registered interest in a given symbol, and optionally a given
+ *        bar type (Bar::type) or time-bar interval (Bar::interval).
+ *
+ * Routes are flat vectors indexed by interned SymbolId, so dispatching a bar
+ * or tick that carries its ID (everything the readers and bar builders
+ * produce) is an index, not a string hash. Registration by ticker interns it
+ * once. The implementation is intentionally lightweight and header-only so
+ * we can avoid touching the build system / CMakeLists.txt.
  */
 class BarRouter {
 public:
-    // Register the given strategy for a particular symbol. Duplicate
-    // registrations are ignored.
+    // Register the given strategy for every bar of a particular symbol,
+    // whatever its type and interval. Duplicate registrations are ignored.
     void register_strategy(const std::string& symbol, IStrategy* strategy) {
-        if (!strategy)
-            return;
-        auto& vec = routes_[symbol];
-        if (std::find(vec.begin(), vec.end(), strategy) == vec.end()) {
-            vec.push_back(strategy);
-        }
+        register_strategy(intern_symbol(symbol), strategy);
+    }
+    void register_strategy(SymbolId symbol, IStrategy* strategy) {
+        add_route(bar_routes_, symbol, Route{true, BarType::Time, kAnyInterval, strategy});
+    }
+
+    // Register the given strategy for one (symbol, interval) pair of time
+    // bars only. Duplicate registrations are ignored.
+    void register_strategy(const std::string& symbol, std::chrono::seconds interval,
+                           IStrategy* strategy) {
+        register_strategy(intern_symbol(symbol), interval, strategy);
+    }
+    void register_strategy(SymbolId symbol, std::chrono::seconds interval, IStrategy* strategy) {
+        add_route(bar_routes_, symbol, Route{false, BarType::Time, interval, strategy});
+    }
+
+    // Register the given strategy for every bar of one type (e.g. volume
+    // bars) of a symbol. Duplicate registrations are ignored.
+    void register_strategy(const std::string& symbol, BarType type, IStrategy* strategy) {
+        register_strategy(intern_symbol(symbol), type, strategy);
+    }
+    void register_strategy(SymbolId symbol, BarType type, IStrategy* strategy) {
+        add_route(bar_routes_, symbol, Route{false, type, kAnyInterval, strategy});
     }
 
-    // Dispatch a bar to all interested strategies.
+    // Subscribe the given strategy to every tick of a symbol. Duplicate
+    // subscriptions are ignored.
+    void subscribe_ticks(const std::string& symbol, IStrategy* strategy) {
+        subscribe_ticks(intern_symbol(symbol), strategy);
+    }
+    void subscribe_ticks(SymbolId symbol, IStrategy* strategy) {
+        add_route(tick_routes_, symbol, Route{true, BarType::Time, kAnyInterval, strategy});
+    }
+
+    // Dispatch a bar to all strategies interested in its symbol, type and
+    // interval.
     void route_bar(const Bar& bar) const {
-        auto it = routes_.find(bar.symbol);
-        if (it == routes_.end())
+        // Bars built by hand without an ID fall back to a lookup (never
+        // interning: an unknown ticker has no routes)
+        const SymbolId id = bar.symbol_id != kInvalidSymbolId
+                                ? bar.symbol_id
+                                : SymbolTable::instance().find(bar.symbol);
+        if (id >= bar_routes_.size())
             return;
-        for (auto* strat : it->second) {
-            if (strat) {
-                strat->on_bar(bar);
+        for (const Route& route : bar_routes_[id]) {
+            if (route.matches(bar)) {
+                route.strategy->on_bar(bar);
             }
         }
     }
 
+    // Dispatch a tick to every strategy subscribed to its symbol. Exceptions
+    // from a strategy propagate to the caller.
+    void route_tick(const Tick& tick) const {
+        route_tick(tick.symbol_id != kInvalidSymbolId ? tick.symbol_id
+                                                      : SymbolTable::instance().find(tick.symbol),
+                   tick);
+    }
+    // Same, for a caller that already resolved the tick's ID
+    void route_tick(SymbolId symbol, const Tick& tick) const {
+        if (symbol >= tick_routes_.size())
+            return;
+        for (const Route& route : tick_routes_[symbol]) {
+            route.strategy->on_tick(tick);
+        }
+    }
+
 private:
-    std::unordered_map<std::string, std::vector<IStrategy*>> routes_;
+    static constexpr std::chrono::seconds kAnyInterval{0};
+
+    struct Route {
+        bool any_type;                 // every bar of the symbol
+        BarType type;
+        std::chrono::seconds interval; // kAnyInterval matches every interval
+        IStrategy* strategy;
+
+        bool matches(const Bar& bar) const {
+            return any_type ||
+                   (bar.type == type && (interval == kAnyInterval || bar.interval == interval));
+        }
+        bool operator==(const Route& o) const {
+            return any_type == o.any_type && type == o.type && interval == o.interval &&
+                   strategy == o.strategy;
+        }
+    };
+    using RouteTable = std::vector<std::vector<Route>>; // indexed by SymbolId
+
+    static void add_route(RouteTable& table, SymbolId symbol, const Route& route) {
+        if (!route.strategy || symbol == kInvalidSymbolId)
+            return;
+        if (symbol >= table.size()) {
+            table.resize(static_cast<std::size_t>(symbol) + 1);
+        }
+        auto& vec = table[symbol];
+        if (std::find(vec.begin(), vec.end(), route) == vec.end()) {
+            vec.push_back(route);
+        }
+    }
+
+    RouteTable bar_routes_;
+    RouteTable tick_routes_;
 };
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "qse/data/PriceTicks.h"
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <optional>
@@ -10,7 +12,7 @@ namespace qse {
  * @brief Configuration class for loading and managing QSE settings
  *
  * Handles loading of YAML configuration files including:
- * - Symbol-specific slippage coefficients
+ * - Symbol-specific slippage coefficients and tick sizes
  * - Backtester settings
  * - Data paths
  */
@@ -30,6 +32,14 @@ public:
      */
     double get_slippage_coeff(const std::string& symbol) const;
 
+    /**
+     * @brief Price increment the order books and fill logic use for a symbol
+     * @param symbol The symbol to get the tick size for
+     * @return `symbols.<symbol>.tick_size`, else `backtester.tick_size`, else
+     *         kDefaultPriceResolution
+     */
+    double get_tick_size(const std::string& symbol) const;
+
     /**
      * @brief Get initial cash amount
      * @return Initial cash amount
@@ -61,6 +71,17 @@ public:
      */
     bool use_full_depth_book() const { return fill_model_ == "full_depth"; }
 
+    /**
+     * @brief Format of the equity curve and trade log ("csv", "binary" or
+     *        "parquet")
+     */
+    std::string get_result_format() const { return result_format_; }
+
+    /**
+     * @brief Equity curve downsampling: one point written every N recorded
+     */
+    std::size_t get_equity_sample_every() const { return equity_sample_every_; }
+
     /**
      * @brief Get data base path
      * @return Data base path
@@ -86,11 +107,17 @@ private:
     // Slippage coefficients per symbol
     std::unordered_map<std::string, double> linear_impact_;
 
+    // Tick sizes per symbol, and for symbols without one
+    std::unordered_map<std::string, double> tick_sizes_;
+    double default_tick_size_ = kDefaultPriceResolution;
+
     // Backtester settings
     double initial_cash_ = 100000.0;
     double commission_rate_ = 0.001;
     int min_trade_size_ = 1;
     std::string fill_model_ = "top_of_book";
+    std::string result_format_ = "csv";
+    std::size_t equity_sample_every_ = 1;
 
     // Data paths
     std::string data_base_path_ = "./data";
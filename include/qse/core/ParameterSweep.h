@@ -0,0 +1,127 @@
+#pragma once
+
+#include "qse/core/Config.h"
+#include "qse/data/TickColumns.h"
+#include "qse/data/TickDataset.h"
+#include "qse/order/OrderManager.h"
+#include "qse/strategy/IStrategy.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qse {
+
+/// One configuration of a sweep: parameter name -> value
+using ParameterPoint = std::map<std::string, double>;
+
+/// "fast=10 slow=50" (parameters in name order)
+std::string format_parameters(const ParameterPoint& point);
+
+/**
+ * @brief Cartesian product of named parameter axes.
+ *
+ * points() enumerates every combination with the first axis varying
+ * slowest, so a 2-axis grid reads row by row.
+ */
+class ParameterGrid {
+public:
+    ParameterGrid& add_axis(const std::string& name, std::vector<double> values);
+
+    std::vector<ParameterPoint> points() const;
+    std::size_t size() const;
+
+private:
+    std::vector<std::pair<std::string, std::vector<double>>> axes_;
+};
+
+struct SweepSettings {
+    std::string symbol;                    // Backtester symbol of every cell
+    std::chrono::seconds bar_interval{60}; // strategies' bar size
+
+    // Optional config (slippage, depth book, initial cash) shared by every
+    // cell's OrderManager; without it each starts from initial_cash
+    std::shared_ptr<const Config> config;
+    double initial_cash = 100000.0;
+
+    // Equity is sampled at this spacing (in tick time) for the Sharpe ratio,
+    // annualized by sqrt(periods_per_year); 0 derives the periods from a
+    // 252-day, 6.5-hour trading year
+    std::chrono::seconds sample_interval{60};
+    double periods_per_year = 0.0;
+
+    // Worker threads for the cells; 0 means one per hardware thread, 1 runs
+    // everything on the calling thread
+    unsigned threads = 0;
+
+    // Ticks handed to every cell at a time: small enough that the block
+    // stays in L2 while all cells walk it
+    std::size_t block_ticks = 1024;
+};
+
+/// One row of a sweep's results table
+struct SweepResult {
+    ParameterPoint params;
+    bool ok = false;
+    std::string error;
+    RunSummary summary;
+    double sharpe = 0.0;         // annualized, from sampled equity returns
+    double turnover = 0.0;       // traded notional / initial cash
+    double slippage_bps = 0.0;   // execution cost vs mid per unit traded, in bp
+    std::size_t return_samples = 0;
+};
+
+/**
+ * @brief Evaluates a grid of strategy configurations in one pass over the
+ * tick data.
+ *
+ * Each configuration (a "cell") gets its own strategy, OrderManager (no
+ * output files, only its RunSummary) and Backtester. The sources are merged
+ * into a single time-ordered stream once; the stream is cut into blocks of
+ * `block_ticks`, and every block is handed to all cells, sharded over a
+ * WorkStealingPool, before the next block is read. The data is walked once
+ * however many cells there are, and a block is still cache-resident as the
+ * cells step through it, where rerunning a Backtester per configuration
+ * re-reads and re-merges the ticks every time.
+ *
+ * Results are in point order. A cell whose strategy or OrderManager throws
+ * stops there and reports the error; the rest of the sweep carries on.
+ */
+class ParameterSweep {
+public:
+    using StrategyFactory = std::function<std::unique_ptr<IStrategy>(
+        const ParameterPoint&, const std::shared_ptr<OrderManager>&)>;
+
+    ParameterSweep(SweepSettings settings, StrategyFactory make_strategy);
+
+    /// Replays a shared tick dataset (not copied)
+    void add_source(std::shared_ptr<const TickDataset> ticks);
+    /// Replays an already-loaded tick series (shared, not copied)
+    void add_source(std::shared_ptr<const TickColumns> ticks);
+    /// Maps a tick CSV's binary tick cache (TickDataset::load)
+    void add_source(const std::string& data_file, const std::string& symbol = "");
+
+    std::vector<SweepResult> run(const std::vector<ParameterPoint>& points);
+    std::vector<SweepResult> run(const ParameterGrid& grid) { return run(grid.points()); }
+
+    /// Ticks fed to the cells by the last run()
+    std::size_t ticks_processed() const { return ticks_processed_; }
+
+    /// One CSV row per cell: parameters, then return, Sharpe, max drawdown,
+    /// trades, turnover, slippage
+    static void write_csv(const std::vector<SweepResult>& results, std::ostream& out);
+
+private:
+    SweepSettings settings_;
+    StrategyFactory make_strategy_;
+    std::vector<std::shared_ptr<const TickDataset>> sources_;
+    std::size_t ticks_processed_ = 0;
+};
+
+} // namespace qse
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace qse {
+
+/// On-disk format of a run's equity curve and trade log
+enum class ResultFormat { Csv, Binary, Parquet };
+
+/// Parses "csv", "binary" or "parquet"
+/// @throws std::invalid_argument for anything else
+ResultFormat parse_result_format(const std::string& name);
+
+/// One point of the equity curve
+struct EquityPoint {
+    int64_t timestamp = 0; // unix ms
+    double equity = 0.0;
+};
+
+/// One trade log row
+struct TradeRecord {
+    int64_t timestamp = 0; // unix ms
+    std::string symbol;
+    bool buy = true;
+    int quantity = 0;
+    double price = 0.0;
+    double cash = 0.0; // cash after the trade
+};
+
+namespace detail {
+
+// Format-specific encoder for both result files. Runs on the sink's writer
+// thread; an empty path disables that file.
+class ResultFileWriter {
+public:
+    virtual ~ResultFileWriter() = default;
+    virtual void write_equity(const std::vector<EquityPoint>& points) = 0;
+    virtual void write_trades(const std::vector<TradeRecord>& trades) = 0;
+    // Pushes everything written so far to the OS
+    virtual void flush() = 0;
+    // Finalizes the files (Parquet footers); nothing is written after
+    virtual void finish() = 0;
+};
+
+std::unique_ptr<ResultFileWriter> make_csv_result_writer(const std::string& equity_path,
+                                                         const std::string& trades_path);
+std::unique_ptr<ResultFileWriter> make_binary_result_writer(const std::string& equity_path,
+                                                            const std::string& trades_path);
+// Defined in ParquetResultWriter.cpp (needs Arrow/Parquet)
+std::unique_ptr<ResultFileWriter> make_parquet_result_writer(const std::string& equity_path,
+                                                             const std::string& trades_path);
+
+} // namespace detail
+
+/**
+ * @brief Block-buffered, asynchronous writer for a run's equity curve and
+ *        trade log.
+ *
+ * The producer (OrderManager, once per tick) only appends a record to the
+ * current in-memory block. A full block is handed to a background writer
+ * thread, which formats and writes it while the producer fills a recycled
+ * one, so number formatting and file I/O leave the tick loop. At most
+ * `max_pending_blocks` full blocks wait for the writer; beyond that the
+ * producer blocks, bounding memory when the disk is slower than the run.
+ *
+ * Formats:
+ * - Csv: `timestamp,equity` and `timestamp,symbol,type,quantity,price,cash`,
+ *   numbers formatted as a default std::ostream would (the legacy files).
+ * - Binary: a 16-byte header ("QSEEQUIT"/"QSETRADE", version, byte-order
+ *   marker) then native-endian fixed-width records; read back with
+ *   read_equity_binary / read_trades_binary.
+ * - Parquet: one row group per block, footer written by close().
+ *
+ * Files are created (and CSV headers written) by the constructor. An I/O
+ * error on the writer thread is rethrown by the next flush() or close();
+ * the destructor reports it on std::cerr instead.
+ */
+class ResultSink {
+public:
+    struct Options {
+        ResultFormat format = ResultFormat::Csv;
+        std::size_t block_records = 8192;  // equity points (or trades) per block
+        std::size_t max_pending_blocks = 4; // full blocks queued before the producer waits
+        bool async = true;                  // false: write full blocks on the caller's thread
+    };
+
+    /**
+     * @param equity_path Equity curve file; empty disables it.
+     * @param trades_path Trade log file; empty disables it.
+     * @throws std::runtime_error if a file cannot be opened
+     * @throws std::invalid_argument if block_records or max_pending_blocks is 0
+     */
+    ResultSink(const std::string& equity_path, const std::string& trades_path,
+               const Options& options);
+    ResultSink(const std::string& equity_path, const std::string& trades_path)
+        : ResultSink(equity_path, trades_path, Options{}) {}
+    ~ResultSink();
+
+    ResultSink(const ResultSink&) = delete;
+    ResultSink& operator=(const ResultSink&) = delete;
+
+    void add_equity(int64_t timestamp, double equity) {
+        current_.equity.push_back(EquityPoint{timestamp, equity});
+        if (current_.equity.size() >= options_.block_records) {
+            submit_current();
+        }
+    }
+
+    void add_trade(TradeRecord trade) {
+        current_.trades.push_back(std::move(trade));
+        if (current_.trades.size() >= options_.block_records) {
+            submit_current();
+        }
+    }
+
+    /// Hands off the partial block and waits until everything added so far
+    /// has been written and flushed to the OS
+    void flush();
+
+    /// flush(), then finalizes the files and stops the writer. Further adds
+    /// are ignored. Called by the destructor if not called before.
+    void close();
+
+    const Options& options() const { return options_; }
+
+private:
+    struct Block {
+        std::vector<EquityPoint> equity;
+        std::vector<TradeRecord> trades;
+        bool empty() const { return equity.empty() && trades.empty(); }
+    };
+
+    void submit_current();
+    void write_block(const Block& block);
+    void writer_loop();
+    void rethrow_writer_error();
+
+    Options options_;
+    std::unique_ptr<detail::ResultFileWriter> writer_;
+    Block current_;
+    bool closed_ = false;
+
+    // Writer thread state, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable work_ready_; // writer waits: a block is queued or stop_
+    std::condition_variable work_done_;  // producer waits: queue drained or space freed
+    std::deque<Block> queue_;
+    std::vector<Block> spare_; // written blocks, recycled with their capacity
+    bool writing_ = false;     // the writer holds a block outside the queue
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread thread_;
+};
+
+/// Reads a Binary-format equity curve
+/// @throws std::runtime_error if the file is missing or not an equity file
+std::vector<EquityPoint> read_equity_binary(const std::string& path);
+
+/// Reads a Binary-format trade log
+/// @throws std::runtime_error if the file is missing or not a trade log
+std::vector<TradeRecord> read_trades_binary(const std::string& path);
+
+} // namespace qse
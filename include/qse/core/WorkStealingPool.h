@@ -0,0 +1,317 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qse {
+
+namespace detail {
+
+/**
+ * @brief Type-erased `void()` callable that fits in one 64-byte slot.
+ *
+ * A trivially copyable callable of up to 56 bytes (a lambda capturing a few
+ * pointers, indices or references) is stored inline, so scheduling it
+ * allocates nothing. Anything larger, or with a non-trivial copy/destructor
+ * (std::function, packaged_task, strings), is moved to the heap and the slot
+ * holds the pointer. Because the slot itself is trivially copyable it can
+ * live in the lock-free deques word by word.
+ */
+struct Task {
+    static constexpr std::size_t kWords = 8;
+    static constexpr std::size_t kInlineBytes = (kWords - 1) * sizeof(std::uintptr_t);
+
+    using Invoke = void (*)(void* storage);
+
+    Invoke invoke = nullptr;
+    alignas(std::uintptr_t) unsigned char storage[kInlineBytes];
+
+    void operator()() { invoke(storage); }
+
+    /// True when `F` is stored in the slot itself (no allocation)
+    template <class F>
+    static constexpr bool fits_inline() {
+        using Fn = std::decay_t<F>;
+        return std::is_trivially_copyable_v<Fn> && sizeof(Fn) <= kInlineBytes &&
+               alignof(Fn) <= alignof(std::uintptr_t);
+    }
+
+    template <class F>
+    static Task make(F&& f) {
+        using Fn = std::decay_t<F>;
+        Task task;
+        if constexpr (fits_inline<F>()) {
+            ::new (static_cast<void*>(task.storage)) Fn(std::forward<F>(f));
+            task.invoke = [](void* storage) { (*std::launder(reinterpret_cast<Fn*>(storage)))(); };
+        } else {
+            Fn* boxed = new Fn(std::forward<F>(f));
+            std::memcpy(task.storage, &boxed, sizeof(boxed));
+            task.invoke = [](void* storage) {
+                Fn* fn;
+                std::memcpy(&fn, storage, sizeof(fn));
+                std::unique_ptr<Fn> owner(fn);
+                (*owner)();
+            };
+        }
+        return task;
+    }
+};
+
+static_assert(sizeof(Task) == Task::kWords * sizeof(std::uintptr_t), "Task must fill one slot");
+static_assert(std::is_trivially_copyable_v<Task>, "Task is copied word by word");
+
+/**
+ * @brief Chase-Lev work-stealing deque of Tasks (Le et al., "Correct and
+ * Efficient Work-Stealing for Weak Memory Models", PPoPP 2013).
+ *
+ * The owning worker pushes and pops at the bottom without locks; any other
+ * thread steals from the top with one CAS. Slots are arrays of atomic words,
+ * so a thief's speculative read of a slot the owner is reusing is a benign
+ * relaxed load rather than a data race. The ring grows by doubling; retired
+ * rings stay alive until the deque is destroyed because a thief may still be
+ * reading one.
+ */
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 256);
+
+    // Owner thread only
+    void push(const Task& task);
+    bool pop(Task& task);
+
+    // Any thread
+    bool steal(Task& task);
+    bool empty() const;
+
+private:
+    struct Ring {
+        explicit Ring(std::size_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<std::uintptr_t>[capacity * Task::kWords]) {}
+
+        void put(std::int64_t index, const Task& task);
+        void get(std::int64_t index, Task& task) const;
+
+        std::size_t capacity() const { return mask + 1; }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<std::uintptr_t>[]> slots;
+    };
+
+    Ring* grow(Ring* ring, std::int64_t bottom, std::int64_t top);
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Ring*> ring_;
+    std::vector<std::unique_ptr<Ring>> rings_; // current ring last; owner only
+};
+
+} // namespace detail
+
+class WorkStealingPool;
+
+/**
+ * @brief A set of tasks to fork on a WorkStealingPool and join with wait().
+ *
+ * wait() called on a worker thread runs queued tasks (its own first, then
+ * stolen ones) until the group is done, so nested fork/join never blocks a
+ * worker. From any other thread it sleeps. The first exception thrown by a
+ * task is rethrown by wait(); the remaining tasks still run.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingPool& pool) : pool_(pool) {}
+    ~TaskGroup() { wait_quietly(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template <class F>
+    void run(F&& f);
+
+    void wait();
+
+private:
+    friend class WorkStealingPool;
+
+    void start_one();
+    void finish_one();
+    void capture_exception();
+    void wait_quietly();
+
+    WorkStealingPool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex mutex_;
+    std::condition_variable done_;
+    bool done_flag_ = true; // guarded by mutex_
+    std::exception_ptr error_;
+    std::atomic<bool> failed_{false};
+};
+
+/**
+ * @brief Work-stealing thread pool for many small, possibly nested tasks.
+ *
+ * ThreadPool funnels every task through one mutex-guarded queue and
+ * heap-allocates a packaged_task and a std::function per task; with
+ * thousands of short sweep or per-date jobs the workers serialize on that
+ * mutex. Here every worker owns a lock-free deque: tasks spawned on a worker
+ * go to its own deque (LIFO, cache-warm), idle workers steal the oldest task
+ * from a random victim, and only tasks submitted from outside the pool pass
+ * through a shared injection queue. Small trivially copyable callables are
+ * stored inline and cost no allocation.
+ *
+ * Drop-in for ThreadPool where futures are wanted (enqueue); post(),
+ * TaskGroup and parallel_for skip the future entirely.
+ *
+ * The destructor runs every queued task (including ones they spawn) and
+ * joins the workers.
+ */
+class WorkStealingPool {
+public:
+    /// `num_threads` workers; 0 means one per hardware thread
+    explicit WorkStealingPool(std::size_t num_threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t size() const { return workers_.size(); }
+
+    /// Fire-and-forget. An exception escaping `f` is reported and dropped.
+    template <class F>
+    void post(F&& f) {
+        submit(detail::Task::make([fn = std::forward<F>(f)]() mutable {
+            try {
+                fn();
+            } catch (const std::exception& e) {
+                report_uncaught(e.what());
+            } catch (...) {
+                report_uncaught("unknown exception");
+            }
+        }));
+    }
+
+    /// Same contract as ThreadPool::enqueue
+    template <class F, class... Args>
+    auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        using return_type = std::invoke_result_t<F, Args...>;
+        std::packaged_task<return_type()> task(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<return_type> result = task.get_future();
+        submit(detail::Task::make([task = std::move(task)]() mutable { task(); }));
+        return result;
+    }
+
+    /**
+     * Calls `body(i)` for every i in [begin, end) and returns when all calls
+     * have finished. The range is split recursively down to chunks of
+     * `grain` indices; halves are pushed on the splitting worker's deque for
+     * idle workers to steal, so the load balances without a central queue.
+     * The calling thread (worker or not) takes part if it is a worker.
+     */
+    template <class F>
+    void parallel_for(std::size_t begin, std::size_t end, F&& body, std::size_t grain = 1);
+
+    /// True when the calling thread is one of this pool's workers
+    bool on_worker_thread() const;
+
+private:
+    friend class TaskGroup;
+
+    struct Worker {
+        detail::WorkStealingDeque deque;
+        std::uint64_t rng_state = 0;
+    };
+
+    void submit(const detail::Task& task);
+    void worker_loop(std::size_t index);
+    bool find_task(std::size_t index, detail::Task& task);
+    bool try_steal(std::size_t thief, detail::Task& task);
+    void notify_one_sleeper();
+
+    // Runs one queued task on behalf of a worker blocked in TaskGroup::wait;
+    // false if none was found
+    bool run_pending_task();
+
+    static void report_uncaught(const char* what);
+
+    std::vector<std::unique_ptr<Worker>> queues_;
+    std::vector<std::thread> workers_;
+
+    // Tasks submitted from outside the pool
+    std::mutex inject_mutex_;
+    std::deque<detail::Task> injected_;
+    std::atomic<std::size_t> injected_count_{0};
+
+    // Tasks queued anywhere and not yet taken; idle workers sleep on it
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> sleepers_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> stop_{false};
+};
+
+// --- Template Implementation ---
+
+template <class F>
+void TaskGroup::run(F&& f) {
+    start_one();
+    pool_.submit(detail::Task::make([this, fn = std::forward<F>(f)]() mutable {
+        try {
+            fn();
+        } catch (...) {
+            capture_exception();
+        }
+        finish_one();
+    }));
+}
+
+template <class F>
+void WorkStealingPool::parallel_for(std::size_t begin, std::size_t end, F&& body,
+                                    std::size_t grain) {
+    if (begin >= end) {
+        return;
+    }
+    grain = grain == 0 ? 1 : grain;
+    using Body = std::remove_reference_t<F>;
+
+    // Splits [lo, hi) in halves, forking the upper half each time, until a
+    // chunk of at most `grain` indices is left to run here. Every field is a
+    // pointer or index, so each split task is stored inline.
+    struct Range {
+        Body* body;
+        TaskGroup* group;
+        std::size_t lo, hi, grain;
+
+        void operator()() const {
+            std::size_t top = hi;
+            while (top - lo > grain) {
+                const std::size_t mid = lo + (top - lo) / 2;
+                group->run(Range{body, group, mid, top, grain});
+                top = mid;
+            }
+            for (std::size_t i = lo; i < top; ++i) {
+                (*body)(i);
+            }
+        }
+    };
+
+    TaskGroup group(*this);
+    group.run(Range{&body, &group, begin, end, grain});
+    group.wait();
+}
+
+} // namespace qse
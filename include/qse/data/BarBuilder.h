@@ -3,48 +3,90 @@
 #include "qse/data/Data.h"
 #include <optional>
 #include <chrono>
+#include <cstddef>
 #include <deque>
-#include <vector>
 
 namespace qse {
 
 /**
  * @brief A utility class to construct time-based bars from a stream of ticks.
- * Handles out-of-order ticks by buffering and sorting them before processing.
+ *
+ * Ticks arriving in time order are folded into the current bar in place:
+ * O(1) per tick, no buffering, no Tick copies. Two policies cover ticks that
+ * arrive out of order:
+ *
+ * - allowed_lateness == 0 (the default): a tick earlier than the current
+ *   bar's interval closes that bar and starts one for its own interval, as
+ *   the builder always has. A late tick inside the current interval just
+ *   updates it.
+ * - allowed_lateness > 0: a bounded reorder window. Every interval stays open
+ *   until the newest tick seen is `allowed_lateness` past its end, so ticks
+ *   up to that late land in the right bar, with open/close taken by
+ *   timestamp rather than arrival. Ticks later than that are dropped and
+ *   counted. At most allowed_lateness / bar_interval + 2 bars are open.
  */
 class BarBuilder {
 public:
     /**
      * @brief Constructs a BarBuilder.
      * @param bar_interval The time duration for each bar (e.g., 60s for 1-minute bars).
+     * @param allowed_lateness How far behind the newest tick a tick may arrive
+     *        and still be counted (0 disables the reorder window).
      */
-    explicit BarBuilder(const std::chrono::seconds& bar_interval = std::chrono::seconds(60));
+    explicit BarBuilder(const std::chrono::seconds& bar_interval = std::chrono::seconds(60),
+                        std::chrono::milliseconds allowed_lateness = std::chrono::milliseconds(0));
 
     /**
      * @brief Feed a tick into the builder.  If one or more bars complete, returns
-     *        the _oldest_ completed bar; otherwise std::nullopt.
+     *        the _oldest_ completed bar; otherwise std::nullopt. With a reorder
+     *        window one tick can complete several bars; the rest are returned by
+     *        later calls, or drained with pop_completed().
      */
     std::optional<Bar> add_tick(const Tick& tick);
 
+    /// Next bar already completed but not yet returned, if any
+    std::optional<Bar> pop_completed();
+
     /**
      * @brief Flush any remaining bars.  If there is any completed or in-progress
      *        bar left, returns it (one per call); otherwise std::nullopt.
      */
     std::optional<Bar> flush();
 
+    /// Ticks dropped for arriving later than the reorder window allows
+    std::size_t late_ticks_dropped() const { return late_ticks_dropped_; }
+
+    std::chrono::seconds bar_interval() const { return bar_interval_; }
+
 private:
+    // A bar still accepting ticks in reorder mode. first/last are the
+    // timestamps its open and close came from.
+    struct OpenBar {
+        Bar bar;
+        Timestamp first;
+        Timestamp last;
+    };
+
     // interval and state
     std::chrono::seconds bar_interval_;
+    std::chrono::milliseconds allowed_lateness_;
     Timestamp current_bar_start_time_;
-    std::optional<Bar> current_bar_;
+    Timestamp current_bar_end_time_;
+    std::optional<Bar> current_bar_; // in-order mode
+
+    // reorder mode: open bars oldest first, and the newest tick time seen
+    std::deque<OpenBar> open_bars_;
+    std::optional<Timestamp> newest_tick_;
+    std::size_t late_ticks_dropped_ = 0;
 
-    // buffers and ready queue
-    std::vector<Tick> tick_buffer_;
+    // completed bars not yet returned
     std::deque<Bar> ready_bars_;
 
     // internals
-    void process_buffered_ticks();
+    std::optional<Bar> add_tick_reordering(const Tick& tick);
+    Timestamp bucket_start(Timestamp t) const;
     void start_new_bar(const Tick& tick);
+    Bar make_bar(const Tick& tick, Timestamp start) const;
 };
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
@@ -1,44 +1,85 @@
 #pragma once
 #include "qse/data/IDataReader.h"
 #include <cstddef>
+#include <memory>
 #include <vector>
 #include <string>
 #include "qse/data/Data.h"
+#include "qse/data/TickColumns.h"
 
 namespace qse {
 
 class CSVDataReader : public qse::IDataReader {
 public:
+    // Eager loads the whole file in the constructor (sorted, with the full
+    // data-quality report). Streaming defers tick parsing to cursors opened
+    // with open_tick_cursor(), which parse the file batch by batch in file
+    // order; read_all_ticks() still works and loads the file on first use.
+    // Mapped loads eagerly like Eager, but memory-maps the file and runs the
+    // SIMD/from_chars parser (CSVTickParser.h), optionally on several
+    // threads; bar files fall back to the line reader.
+    // Cached loads like Mapped, but first tries the binary tick cache beside
+    // the CSV (TickCache.h) and writes one after a parse, so repeat runs over
+    // an unchanged file skip text parsing altogether.
+    enum class LoadMode { Eager, Streaming, Mapped, Cached };
+
     explicit CSVDataReader(const std::string& file_path);
     CSVDataReader(const std::string& file_path, const std::string& symbol_override);
+    CSVDataReader(const std::string& file_path, const std::string& symbol_override,
+                  LoadMode mode, unsigned parse_threads = 1);
 
-    // Implement the new tick reading method.
+    // Implement the new tick reading method. Ticks are stored columnar and
+    // materialized into this vector on the first call.
     const std::vector<Tick>& read_all_ticks() const override;
 
+    // The loaded tick series in struct-of-arrays form, sorted by time
+    const TickColumns& read_tick_columns() const;
+
     // We still need to implement the bar reading method from the interface.
     const std::vector<Bar>& read_all_bars() const override;
 
+    // Loaded readers replay their columns (or the materialized vector, zero
+    // copy); streaming readers return a cursor that re-reads the file
+    // kTickBatchSize rows at a time
+    std::unique_ptr<ITickCursor> open_tick_cursor() const override;
+
     // --- Data-quality report (populated during load) ---
 
     // Rows that could not be parsed (missing/non-numeric fields) and were
-    // skipped instead of aborting the whole load
+    // skipped instead of aborting the whole load. In streaming mode the count
+    // is published when a cursor reaches the end of the file.
     std::size_t skipped_row_count() const { return skipped_rows_; }
 
     // Missing rows in the time grid, inferred from the median spacing of the
-    // loaded series (exact for grid data; heuristic for event-time ticks)
+    // loaded series (exact for grid data; heuristic for event-time ticks).
+    // Needs the whole series, so a streaming pass leaves it at 0.
     std::size_t gap_count() const { return gap_count_; }
 
 private:
-    void load_data(); // Renamed to be more generic
+    void load_data() const; // Renamed to be more generic
+    // Mapped-mode tick load; returns false for bar files, which the line
+    // reader handles
+    bool load_mapped_ticks() const;
+    bool load_cached_ticks() const; // false on a cache miss
+    void write_cache() const;
+    void finish_tick_load() const;   // sort + gap count
+    void report_data_quality() const;
     std::string file_path_;
     std::string symbol_override_;
+    LoadMode mode_ = LoadMode::Eager;
+    unsigned parse_threads_ = 1;
+    bool is_bar_file_ = false;
 
-    // The reader now stores both ticks and bars.
-    std::vector<Bar> bars_;
-    std::vector<Tick> ticks_;
+    // The reader now stores both ticks and bars. Ticks load into columns_;
+    // the Tick vector is only built if a caller asks for read_all_ticks().
+    mutable std::vector<Bar> bars_;
+    mutable TickColumns columns_;
+    mutable std::vector<Tick> ticks_;
+    mutable bool loaded_ = false;
+    mutable bool ticks_materialized_ = false;
 
-    std::size_t skipped_rows_ = 0;
-    std::size_t gap_count_ = 0;
+    mutable std::size_t skipped_rows_ = 0;
+    mutable std::size_t gap_count_ = 0;
 };
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
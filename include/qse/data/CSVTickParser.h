@@ -0,0 +1,37 @@
+#pragma once
+
+#include "qse/data/TickColumns.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace qse {
+
+/**
+ * Fast tick-CSV parsing over an in-memory buffer (typically a MappedFile).
+ *
+ * Accepts the same two row layouts as CSVDataReader's line reader:
+ *   timestamp,symbol,price,volume,bid,ask,bid_size,ask_size   (8+ fields)
+ *   timestamp,price,volume                                     (legacy, 3+ fields)
+ * with second timestamps promoted to milliseconds. Field separators are
+ * located with a 16-byte SIMD scan (SSE2 / NEON, scalar fallback) and numbers
+ * are parsed with std::from_chars, so no per-row std::string or stream is
+ * ever built. A row that would make the line reader throw (missing or
+ * non-numeric fields) is counted as skipped instead.
+ *
+ * `text` must start at a row boundary (header already stripped). Rows are
+ * appended to `out` in text order; the return value is the number of
+ * non-empty rows skipped.
+ */
+std::size_t parse_csv_ticks(std::string_view text, const std::string& symbol_override,
+                            TickColumns& out);
+
+/**
+ * Same as parse_csv_ticks(), but splits `text` into up to `threads`
+ * newline-aligned ranges parsed concurrently and concatenated in file order.
+ * Small inputs are parsed on the calling thread.
+ */
+std::size_t parse_csv_ticks_parallel(std::string_view text, const std::string& symbol_override,
+                                     unsigned threads, TickColumns& out);
+
+} // namespace qse
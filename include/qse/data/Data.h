@@ -11,7 +11,25 @@ namespace qse {
 using Timestamp = std::chrono::system_clock::time_point;
 using Price = double;
 using Volume = uint64_t;
-using OrderId = std::string; // Order identifier
+
+// Compact order handle assigned by OrderManager. Orders, depth-book queues
+// and fills are keyed by it on the tick-level fill path; 0 is never assigned.
+using OrderId = uint64_t;
+constexpr OrderId kInvalidOrderId = 0;
+
+// Venue-assigned order identifier (e.g. an Alpaca UUID). String IDs live only
+// at the execution-venue boundary (IExecutionHandler) and in its logs.
+using VenueOrderId = std::string;
+
+// Dense process-wide symbol identifier handed out by SymbolTable. Hot-path
+// state (books, bar builders, last prices) is indexed by it instead of
+// hashing ticker strings on every tick.
+using SymbolId = uint32_t;
+constexpr SymbolId kInvalidSymbolId = UINT32_MAX; // not interned yet
+
+// What closes a bar: elapsed time, or (information-driven sampling) a
+// number of ticks, shares or traded dollars
+enum class BarType : uint8_t { Time, Tick, Volume, Dollar };
 
 /**
  * @brief Represents a single price bar (OHLCV data).
@@ -24,6 +42,9 @@ struct Bar {
     Price low;           // Lowest price during the bar
     Price close;         // Closing price
     Volume volume;       // Total volume traded during the bar
+    SymbolId symbol_id = kInvalidSymbolId; // Interned `symbol`, when known
+    std::chrono::seconds interval{0};      // Time bar length; 0 when unknown
+    BarType type = BarType::Time;          // Time unless built by InformationBarBuilder
 
     // No user-declared constructors: Bar must stay an aggregate so positional
     // brace-initialization works under both C++17 and C++20 rules
@@ -41,6 +62,9 @@ struct Tick {
     Volume bid_size;     // Best bid size
     Volume ask_size;     // Best ask size
     Volume volume;       // Volume of the trade
+    // Interned `symbol`. Readers fill it in; ticks built by hand may leave it
+    // unset and consumers resolve it through SymbolTable on first sight.
+    SymbolId symbol_id = kInvalidSymbolId;
 
     // No user-declared constructors: Tick must stay an aggregate so positional
     // brace-initialization works under both C++17 and C++20 rules
@@ -59,7 +83,8 @@ struct Order {
     enum class Status { PENDING, PARTIALLY_FILLED, FILLED, CANCELLED, REJECTED };
     enum class TimeInForce { DAY, IOC, GTC }; // Day, Immediate-or-Cancel, Good-Till-Cancelled
 
-    std::string order_id;
+    OrderId order_id = kInvalidOrderId;
+    VenueOrderId venue_order_id; // set by execution handlers; empty in the engine
     std::string symbol;
     Type type;
     Side side;
@@ -72,6 +97,7 @@ struct Order {
     Timestamp timestamp;         // When order was placed
     Timestamp expiry_time;       // For IOC orders
     double target_percent = 0.0; // Only used for TARGET_PERCENT orders
+    SymbolId symbol_id = kInvalidSymbolId; // Interned `symbol`
 
     // Helper methods
     bool is_active() const {
@@ -110,6 +136,7 @@ struct Trade {
 // --- NEW: Fill structure for order execution feedback ---
 struct Fill {
     OrderId order_id;
+    VenueOrderId venue_order_id; // set by execution handlers; empty in the engine
     std::string symbol;
     Volume quantity;
     Price price;
@@ -118,7 +145,7 @@ struct Fill {
 
     Fill(OrderId id, const std::string& sym, Volume qty, Price px, Timestamp ts,
          const std::string& s)
-        : order_id(std::move(id)), symbol(sym), quantity(qty), price(px), timestamp(ts), side(s) {}
+        : order_id(id), symbol(sym), quantity(qty), price(px), timestamp(ts), side(s) {}
 };
 
 // --- NEW: Position structure for portfolio holdings ---
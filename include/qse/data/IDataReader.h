@@ -1,5 +1,7 @@
 #pragma once
 #include "qse/data/Data.h"
+#include "qse/data/TickCursor.h"
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -18,6 +20,13 @@ public:
     // --- UPDATED: Returns by const reference for efficiency ---
     // This method remains to support bar-based strategies and tests.
     virtual const std::vector<qse::Bar>& read_all_bars() const = 0;
+
+    // Streaming access to the ticks, in source order. The default hands out
+    // read_all_ticks() as a single zero-copy batch; readers that can parse
+    // incrementally override it so a backtest runs in constant memory.
+    virtual std::unique_ptr<ITickCursor> open_tick_cursor() const {
+        return std::make_unique<VectorTickCursor>(read_all_ticks());
+    }
 };
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
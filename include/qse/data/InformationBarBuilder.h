@@ -0,0 +1,47 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include <cstddef>
+#include <optional>
+
+namespace qse {
+
+/**
+ * @brief Builds information-driven bars from a stream of ticks: a bar closes
+ *        once it holds `threshold` ticks (BarType::Tick), shares
+ *        (BarType::Volume) or traded dollars, price x volume (BarType::Dollar).
+ *
+ * Bars are built incrementally in the same pass as the time bars, O(1) per
+ * tick. The tick that reaches the threshold closes the bar it belongs to and
+ * the bar is returned at once; a large trade is not split across bars (unlike
+ * VPINCalculator's equal-volume buckets), so a bar may overshoot. Bar::timestamp
+ * is the bar's first tick; Bar::type records the sampling.
+ */
+class InformationBarBuilder {
+public:
+    /**
+     * @throws std::invalid_argument for BarType::Time (use BarBuilder) or a
+     *         non-positive threshold.
+     */
+    InformationBarBuilder(BarType type, double threshold);
+
+    /// Feed a tick; returns the bar it completes, if any
+    std::optional<Bar> add_tick(const Tick& tick);
+
+    /// Returns the partial bar in progress, if any, and clears it
+    std::optional<Bar> flush();
+
+    BarType type() const { return type_; }
+    double threshold() const { return threshold_; }
+
+private:
+    // This tick's contribution to the threshold
+    double measure(const Tick& tick) const;
+
+    BarType type_;
+    double threshold_;
+    std::optional<Bar> current_bar_;
+    double accumulated_ = 0.0;
+};
+
+} // namespace qse
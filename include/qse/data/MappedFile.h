@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace qse {
+
+/**
+ * @brief Read-only memory mapping of a whole file (POSIX mmap).
+ *
+ * The kernel pages the file in on demand and readers parse straight out of
+ * the page cache: no read() copies and no per-line std::string. An empty
+ * file maps to an empty view. Throws std::runtime_error if the file cannot
+ * be opened or mapped. Move-only; the mapping is released on destruction.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    void release() noexcept;
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace qse
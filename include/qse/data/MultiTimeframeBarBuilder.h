@@ -0,0 +1,66 @@
+#pragma once
+
+#include "qse/data/BarBuilder.h"
+#include "qse/data/Data.h"
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace qse {
+
+/**
+ * @brief Builds bars at several intervals (e.g. 1s, 1m, 5m, 1d) from one pass
+ *        over a symbol's ticks.
+ *
+ * Only the finest interval is built from ticks, by a BarBuilder. Each coarser
+ * interval is rolled up from the completed bars of the level below it, so a
+ * tick is touched once however many intervals are requested. Each interval
+ * must be a whole multiple of the one before it; bars align to the epoch, so
+ * daily bars are UTC days.
+ *
+ * A coarse bar is emitted as soon as the finer bar that ends it completes,
+ * not when the next coarse interval's first tick arrives. Bars completed by
+ * one tick are emitted finest interval first, each with Bar::interval set.
+ */
+class MultiTimeframeBarBuilder {
+public:
+    /**
+     * @param intervals Bar lengths, finest first, each a multiple of the last.
+     * @param allowed_lateness Reorder window of the finest-level BarBuilder.
+     * @throws std::invalid_argument if the intervals are empty, not ascending,
+     *         or not multiples of each other.
+     */
+    explicit MultiTimeframeBarBuilder(
+        std::vector<std::chrono::seconds> intervals,
+        std::chrono::milliseconds allowed_lateness = std::chrono::milliseconds(0));
+
+    /// Feed a tick; appends the bars it completes to `out`, returns how many
+    std::size_t add_tick(const Tick& tick, std::vector<Bar>& out);
+
+    /// Append every remaining bar, completed or in progress, to `out`
+    std::size_t flush(std::vector<Bar>& out);
+
+    const std::vector<std::chrono::seconds>& intervals() const { return intervals_; }
+
+    /// Ticks the finest level dropped as too late for its reorder window
+    std::size_t late_ticks_dropped() const { return base_.late_ticks_dropped(); }
+
+private:
+    // A coarser interval's bar in progress
+    struct Level {
+        std::chrono::seconds interval;
+        std::optional<Bar> bar;
+        Timestamp end;
+    };
+
+    // Fold a completed bar of level `from` - 1 (the base when from == 0)
+    // into levels from.. and append it and everything it completes to out
+    void roll_up(Bar&& bar, std::size_t from, std::vector<Bar>& out);
+
+    std::vector<std::chrono::seconds> intervals_;
+    BarBuilder base_;
+    std::vector<Level> levels_; // intervals_[1..]
+};
+
+} // namespace qse
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "qse/data/Data.h"
-#include <unordered_map>
 #include <string>
+#include <vector>
 
 namespace qse {
 
@@ -27,6 +27,10 @@ struct TopOfBook {
 /**
  * @brief Simulates an order book that maintains top-of-book for multiple symbols.
  * This is a simplified order book that only tracks the best bid/ask levels.
+ *
+ * Books live in a flat vector indexed by SymbolId, so the per-tick update is
+ * an array store rather than a string hash. The string overloads resolve the
+ * ticker through SymbolTable and are kept for callers off the hot path.
  */
 class OrderBook {
 public:
@@ -44,6 +48,7 @@ public:
      * @return The top of book for the symbol, or empty TopOfBook if not found
      */
     const TopOfBook& top_of_book(const std::string& symbol) const;
+    const TopOfBook& top_of_book(SymbolId symbol_id) const;
 
     /**
      * @brief Consumes liquidity from the order book (for order fills).
@@ -53,9 +58,10 @@ public:
      * @return The actual quantity consumed (may be less than requested)
      */
     Volume consume_liquidity(const std::string& symbol, Order::Side side, Volume quantity);
+    Volume consume_liquidity(SymbolId symbol_id, Order::Side side, Volume quantity);
 
 private:
-    std::unordered_map<std::string, TopOfBook> books_;
+    std::vector<TopOfBook> books_; // indexed by SymbolId; default = no quote yet
 };
 
 } // namespace qse
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "qse/data/Data.h"
 #include "qse/data/OrderBook.h" // for the shared TopOfBook struct
+#include "qse/data/PriceTicks.h"
 #include <map>
 #include <deque>
 #include <vector>
@@ -16,6 +17,15 @@ namespace qse {
 // Queue identifier for FIFO ordering
 using QueueId = std::uint64_t;
 
+// OrderManager hands out order IDs counting up from 1. Liquidity that is
+// not a strategy order (seeded depth, synthetic quotes) takes IDs from the
+// top half of the range so the two can never collide.
+constexpr OrderId kExternalOrderIdBase = OrderId{1} << 63;
+
+// Order IDs of the synthetic displayed liquidity on_tick() keeps at the touch
+constexpr OrderId kQuoteBidOrderId = UINT64_MAX;
+constexpr OrderId kQuoteAskOrderId = UINT64_MAX - 1;
+
 /**
  * @brief Represents a single price level in the order book.
  * Contains the total size at this price and a FIFO queue of order IDs.
@@ -26,7 +36,7 @@ using QueueId = std::uint64_t;
 struct Level {
     Volume total_size = 0;
     std::pmr::deque<OrderId> queue;
-    Price price = 0.0; // Metadata field for convenience
+    Price price = 0.0; // The level's price, snapped to the book's tick size
 
     // Position tracking for O(1) queue position lookups
     std::pmr::unordered_map<OrderId, size_t> position_map;
@@ -49,12 +59,27 @@ struct Level {
  *
  * Pass a qse::Arena (or any pmr resource) to keep every internal allocation
  * in one contiguous block; the default is the global new/delete resource.
+ *
+ * Levels are keyed by integer ticks of the book's TickScale. Every Price
+ * argument is rounded to the nearest tick on the way in, so prices that
+ * differ only by floating-point noise share one level, and prices handed
+ * back (levels, top of book, fills) are the snapped tick prices. The
+ * default scale (kDefaultPriceResolution) leaves prices quoted with up to
+ * 8 decimals unchanged.
  */
 class OrderBookFullDepth {
 public:
     explicit OrderBookFullDepth(
         std::pmr::memory_resource* resource = std::pmr::get_default_resource())
-        : bids_(resource), asks_(resource), queue_id_to_order_id_(resource), resource_(resource) {}
+        : OrderBookFullDepth(TickScale(), resource) {}
+
+    explicit OrderBookFullDepth(
+        TickScale scale, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : scale_(scale), bids_(resource), asks_(resource), queue_id_to_order_id_(resource),
+          resource_(resource) {}
+
+    /// Tick size the book's levels are keyed on
+    const TickScale& tick_scale() const { return scale_; }
 
     // --- Queue ID Management ---
 
@@ -127,7 +152,7 @@ public:
      * @brief Removes and returns the order ID at the front of a price level's queue.
      * @param side The side (BUY/SELL)
      * @param price The price level
-     * @return The order ID, or empty string if queue is empty
+     * @return The order ID, or kInvalidOrderId if the queue is empty
      */
     OrderId dequeue_head(Order::Side side, Price price);
 
@@ -196,11 +221,13 @@ public:
     std::pair<Volume, Price> fill_market(Order::Side side, std::int64_t quantity);
 
 private:
-    // Maps price -> Level, with proper ordering
+    TickScale scale_;
+
+    // Maps price in ticks -> Level, with proper ordering
     // Bids: descending order (best bid first)
     // Asks: ascending order (best ask first)
-    std::pmr::map<Price, Level, std::greater<Price>> bids_; // greater for descending
-    std::pmr::map<Price, Level, std::less<Price>> asks_;    // less for ascending
+    std::pmr::map<PriceTicks, Level, std::greater<PriceTicks>> bids_; // greater for descending
+    std::pmr::map<PriceTicks, Level, std::less<PriceTicks>> asks_;    // less for ascending
 
     // Global queue ID generator for FIFO ordering
     static std::atomic<QueueId> next_queue_id_;
@@ -214,17 +241,28 @@ private:
     // Synthetic displayed liquidity from the latest quote (one per side)
     QueueId synthetic_bid_qid_ = 0;
     QueueId synthetic_ask_qid_ = 0;
-    Price synthetic_bid_price_ = 0.0;
-    Price synthetic_ask_price_ = 0.0;
+    PriceTicks synthetic_bid_tick_ = 0;
+    PriceTicks synthetic_ask_tick_ = 0;
 
     // Removes the synthetic quote order for a side, if it still rests
     void remove_synthetic(Order::Side side);
 
+    // The tick-keyed operations behind the Price overloads
+    void add_level_at(Order::Side side, PriceTicks tick);
+    void remove_level_at_if_empty(Order::Side side, PriceTicks tick);
+    QueueId enqueue_order_front_at(Order::Side side, PriceTicks tick, const OrderId& order_id,
+                                   Volume size);
+    OrderId dequeue_head_at(Order::Side side, PriceTicks tick);
+
     // Helper methods
-    const std::pmr::map<Price, Level, std::greater<Price>>& get_bids() const { return bids_; }
-    const std::pmr::map<Price, Level, std::less<Price>>& get_asks() const { return asks_; }
-    std::pmr::map<Price, Level, std::greater<Price>>& get_bids() { return bids_; }
-    std::pmr::map<Price, Level, std::less<Price>>& get_asks() { return asks_; }
+    const std::pmr::map<PriceTicks, Level, std::greater<PriceTicks>>& get_bids() const {
+        return bids_;
+    }
+    const std::pmr::map<PriceTicks, Level, std::less<PriceTicks>>& get_asks() const {
+        return asks_;
+    }
+    std::pmr::map<PriceTicks, Level, std::greater<PriceTicks>>& get_bids() { return bids_; }
+    std::pmr::map<PriceTicks, Level, std::less<PriceTicks>>& get_asks() { return asks_; }
 };
 
 } // namespace qse
\ No newline at end of file
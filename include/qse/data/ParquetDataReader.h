@@ -1,29 +1,88 @@
 #pragma once
 
 #include "qse/data/IDataReader.h"
+#include "qse/data/TickColumns.h"
 #include <arrow/api.h>
 #include <arrow/io/api.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/writer.h>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace qse {
 
+/**
+ * @brief Reads bar or tick Parquet files.
+ *
+ * Files with a `close` column are bar files. Files with a `price` column are
+ * tick files (timestamp, price, plus optional symbol, volume, bid, ask,
+ * bid_size, ask_size). Both are decoded with Arrow's record batch reader one
+ * row group at a time, so a column may arrive in any number of chunks and a
+ * tick archive never has to be materialized as one arrow::Table.
+ */
 class ParquetDataReader : public qse::IDataReader {
 public:
+    // Eager decodes the file in the constructor (sorted by time). Streaming
+    // defers tick decoding to cursors opened with open_tick_cursor(), which
+    // decode kTickBatchSize rows at a time in file order; read_all_ticks()
+    // still works and loads the file on first use.
+    enum class LoadMode { Eager, Streaming };
+
+    // Optional tick columns (projection). Timestamp and price are always
+    // read; only the selected optional columns are decoded. Anything not read
+    // is filled the way the legacy CSV layout is: bid/ask = price,
+    // bid_size/ask_size = volume, volume = 0, symbol = override or "UNKNOWN".
+    enum TickColumn : unsigned {
+        kSymbolColumn = 1u << 0,
+        kVolumeColumn = 1u << 1,
+        kBidColumn = 1u << 2,
+        kAskColumn = 1u << 3,
+        kBidSizeColumn = 1u << 4,
+        kAskSizeColumn = 1u << 5,
+        kAllTickColumns = (1u << 6) - 1,
+    };
+
     explicit ParquetDataReader(const std::string& file_path);
+    ParquetDataReader(const std::string& file_path, const std::string& symbol_override,
+                      LoadMode mode = LoadMode::Eager, unsigned tick_columns = kAllTickColumns);
 
-    // Implement the IDataReader interface
+    // Implement the IDataReader interface. Ticks are stored columnar and
+    // materialized into a vector on the first read_all_ticks() call.
     const std::vector<qse::Tick>& read_all_ticks() const override;
     const std::vector<qse::Bar>& read_all_bars() const override;
 
+    // The loaded tick series in struct-of-arrays form, sorted by time
+    const TickColumns& read_tick_columns() const;
+
+    // Loaded readers replay their columns; streaming readers return a cursor
+    // that re-reads the file row group by row group
+    std::unique_ptr<ITickCursor> open_tick_cursor() const override;
+
+    // Tick rows dropped because a projected column was null. In streaming
+    // mode the count is published when a cursor reaches the end of the file.
+    std::size_t skipped_row_count() const { return skipped_rows_; }
+
+    int row_group_count() const { return row_group_count_; }
+
 private:
-    void load_data(); // Renamed from load_bars() to be more generic
+    void load_data() const; // Renamed from load_bars() to be more generic
+    void load_bars() const;
+    void load_ticks() const;
     std::string file_path_;
-    std::vector<qse::Tick> ticks_; // Can be empty if Parquet only contains bars
-    std::vector<qse::Bar> bars_;
+    std::string symbol_override_;
+    LoadMode mode_ = LoadMode::Eager;
+    unsigned tick_columns_ = kAllTickColumns;
+    bool is_bar_file_ = false;
+    int row_group_count_ = 0;
+
+    mutable std::vector<qse::Bar> bars_;
+    mutable TickColumns columns_;
+    mutable std::vector<qse::Tick> ticks_;
+    mutable bool loaded_ = false;
+    mutable bool ticks_materialized_ = false;
+    mutable std::size_t skipped_rows_ = 0;
 };
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include "qse/data/OrderBook.h" // for the shared TopOfBook struct
+#include "qse/data/PriceTicks.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace qse {
+
+// Order identifier used by PriceLadderBook: the same compact handle
+// OrderManager assigns
+using LadderOrderId = OrderId;
+
+/**
+ * @brief Full-depth order book on integer price ticks and flat arrays: the
+ *        cache-friendly alternative to OrderBookFullDepth.
+ *
+ * - Prices are converted once to integer ticks of `tick_size`, so levels are
+ *   never keyed by a raw double.
+ * - Each side is a contiguous ladder of level slots indexed by
+ *   `tick & (capacity - 1)`: a ring covering the occupied price range, which
+ *   for a live book is a few ticks around the touch. Finding a level is an
+ *   index; the best price is the edge of the range, and when it empties the
+ *   next one is found by scanning adjacent slots. The ladder doubles when the
+ *   occupied range outgrows it, up to `max_levels` slots. A level that would
+ *   stretch the range past that cap (a fat-finger price far from the rest)
+ *   goes to a small sorted map instead, so one outlier costs a map node, not
+ *   a ladder of billions of slots.
+ * - Orders are nodes in one pooled vector, linked into their level's FIFO by
+ *   32-bit indices (an intrusive list), and found by integer ID through a
+ *   single hash table. Enqueue, cancel, and consuming the head are O(1)
+ *   with no allocation once the pools are warm.
+ *
+ * Same operations as OrderBookFullDepth (enqueue_order, enqueue_order_front,
+ * consume_at_price, fill_market, cancel_order, queue_position, top_of_book),
+ * with integer order IDs. queue_position walks from the level head, O(k) for
+ * the k-th order, instead of keeping every position up to date on each
+ * dequeue. Quote-refresh (on_tick) stays with OrderBookFullDepth.
+ */
+class PriceLadderBook {
+public:
+    /// 65,536 slots per side: $655 of range at a one-cent tick
+    static constexpr std::size_t kDefaultMaxLevels = std::size_t{1} << 16;
+
+    /**
+     * @param tick_size Price increment; prices are rounded to it.
+     * @param levels_hint Initial ladder capacity per side (rounded up to a
+     *        power of two).
+     * @param orders_hint Order nodes to reserve.
+     * @param max_levels Most ladder slots per side (rounded up to a power of
+     *        two); levels beyond that range from the others are kept sparse.
+     * @throws std::invalid_argument if tick_size is not positive.
+     */
+    explicit PriceLadderBook(Price tick_size = 0.01, std::size_t levels_hint = 256,
+                             std::size_t orders_hint = 1024,
+                             std::size_t max_levels = kDefaultMaxLevels);
+
+    std::int64_t to_ticks(Price price) const { return scale_.to_ticks(price); }
+    Price to_price(std::int64_t ticks) const { return scale_.to_price(ticks); }
+
+    // --- Order Queue Management ---
+
+    /**
+     * @brief Adds an order to the back of a price level's queue.
+     * @return False (and nothing is queued) if the ID already rests in the book
+     */
+    bool enqueue_order(Order::Side side, Price price, LadderOrderId order_id, Volume size);
+
+    /**
+     * @brief Adds an order to the FRONT of a price level's queue (displayed
+     *        liquidity modelled as ahead of strategy orders).
+     * @return False if the ID already rests in the book
+     */
+    bool enqueue_order_front(Order::Side side, Price price, LadderOrderId order_id, Volume size);
+
+    /// Removes a resting order; false if the ID is not in the book
+    bool cancel_order(LadderOrderId order_id);
+
+    /**
+     * @brief Consumes up to `quantity` from the FIFO queue at one price level
+     *        and appends (order_id, consumed_size) pairs, in FIFO order, to
+     *        `consumed`. Removes the level if it empties.
+     */
+    void consume_at_price(Order::Side side, Price price, Volume quantity,
+                          std::vector<std::pair<LadderOrderId, Volume>>& consumed);
+    std::vector<std::pair<LadderOrderId, Volume>> consume_at_price(Order::Side side, Price price,
+                                                                   Volume quantity);
+
+    /**
+     * @brief Executes a market order by walking the book best price first.
+     * @param side BUY consumes asks, SELL consumes bids
+     * @param quantity The quantity to fill (non-positive fills nothing)
+     * @return (filled_quantity, average_fill_price)
+     */
+    std::pair<Volume, Price> fill_market(Order::Side side, std::int64_t quantity);
+
+    /// 1-based position of an order in its level's queue; 0 if not found
+    std::size_t queue_position(LadderOrderId order_id) const;
+    std::size_t queue_position(Order::Side side, Price price, LadderOrderId order_id) const;
+
+    // --- Price Level Queries ---
+
+    bool has_level(Order::Side side, Price price) const;
+    Volume level_size(Order::Side side, Price price) const;
+    std::vector<Price> top_n_prices(Order::Side side, std::size_t n) const;
+    TopOfBook top_of_book() const;
+
+    std::size_t order_count() const { return index_.size(); }
+
+    /// Empties the book, keeping its capacity for reuse
+    void clear();
+
+private:
+    static constexpr std::uint32_t kNil = UINT32_MAX;
+
+    struct Level {
+        Volume total = 0;
+        std::uint32_t head = kNil;
+        std::uint32_t tail = kNil;
+        std::uint32_t count = 0;
+    };
+
+    struct Node {
+        LadderOrderId id;
+        Volume size;
+        std::int64_t tick;
+        std::uint32_t prev;
+        std::uint32_t next;
+        Order::Side side;
+    };
+
+    // One side: a ring of level slots over the dense range [lo, hi], and a
+    // sorted map for levels too far from that range to fit the ring. No
+    // sparse level ever lies inside [lo, hi].
+    struct Ladder {
+        std::vector<Level> slots;
+        std::int64_t lo = 0;
+        std::int64_t hi = -1; // lo > hi: no dense levels
+        std::map<std::int64_t, Level> sparse;
+        std::size_t max_slots = 0;
+        bool is_bid = false;
+
+        bool dense_empty() const { return lo > hi; }
+        bool empty() const { return dense_empty() && sparse.empty(); }
+        std::int64_t best() const;
+        Level& at(std::int64_t tick) {
+            return slots[static_cast<std::size_t>(tick) & (slots.size() - 1)];
+        }
+        const Level& at(std::int64_t tick) const {
+            return slots[static_cast<std::size_t>(tick) & (slots.size() - 1)];
+        }
+        // The level at `tick`, which must hold orders
+        Level& level(std::int64_t tick) {
+            return tick >= lo && tick <= hi ? at(tick) : sparse.at(tick);
+        }
+        const Level& level(std::int64_t tick) const {
+            return tick >= lo && tick <= hi ? at(tick) : sparse.at(tick);
+        }
+        // The level at `tick` if it holds orders
+        const Level* find(std::int64_t tick) const;
+        Level& touch(std::int64_t tick); // widens [lo, hi], growing if needed
+        void level_emptied(std::int64_t tick);
+        void clear();
+
+    private:
+        // Moves the sparse levels in [from, to] into the ring
+        void absorb_sparse(std::int64_t from, std::int64_t to);
+    };
+
+    Ladder& ladder(Order::Side side) { return side == Order::Side::BUY ? bids_ : asks_; }
+    const Ladder& ladder(Order::Side side) const {
+        return side == Order::Side::BUY ? bids_ : asks_;
+    }
+
+    std::uint32_t new_node(LadderOrderId id, Volume size, std::int64_t tick, Order::Side side);
+    // Unlinks a node from its level, releases its remaining size and returns
+    // it to the pool; resets the level if it empties
+    void remove_node(std::uint32_t index);
+    // Takes up to `quantity` from the level's head orders; `on_take` sees
+    // (order_id, taken). Returns the quantity taken.
+    template <typename OnTake>
+    Volume take_from_level(Ladder& side, std::int64_t tick, Volume quantity, OnTake&& on_take);
+
+    TickScale scale_;
+    Ladder bids_;
+    Ladder asks_;
+    std::vector<Node> nodes_;
+    std::uint32_t free_head_ = kNil;
+    std::unordered_map<LadderOrderId, std::uint32_t> index_; // order ID -> node
+};
+
+} // namespace qse
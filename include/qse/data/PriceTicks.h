@@ -0,0 +1,82 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace qse {
+
+// A price as a whole number of ticks of some tick size
+using PriceTicks = std::int64_t;
+
+// Grid used when no tick size is configured: fine enough that any price
+// quoted with up to 8 decimals converts to ticks and back unchanged, while
+// 100.1 and 100.10000000001 still land on the same tick
+constexpr Price kDefaultPriceResolution = 1e-8;
+
+/**
+ * @brief Converts between `double` prices and integer ticks of one tick size.
+ *
+ * The order books and the fill logic compare and index prices as ticks, so
+ * two prices that differ only by floating-point noise are the same price,
+ * and levels can be addressed densely. Prices are converted once where they
+ * enter (orders, quotes, prints) and back where they leave (fills, the top
+ * of book, results).
+ *
+ * to_ticks() rounds to the nearest tick. to_price() divides by the number
+ * of ticks per unit rather than multiplying by the tick size: both operands
+ * are exact, so the result is the double nearest the decimal price
+ * (5137 / 100.0 == 51.37, while 5137 * 0.01 is not).
+ *
+ * floor_ticks() and ceil_ticks() round down and up instead, for limits that
+ * must not move past the price they were given. A price that is on the grid
+ * up to floating-point noise (10.03 in cents is 1002.9999999999999 ticks)
+ * counts as on it and keeps its tick either way.
+ */
+class TickScale {
+public:
+    /// @throws std::invalid_argument if tick_size is not positive and finite
+    explicit TickScale(Price tick_size = kDefaultPriceResolution)
+        : tick_size_(tick_size), ticks_per_unit_(1.0 / tick_size) {
+        if (!(tick_size > 0.0) || !std::isfinite(tick_size)) {
+            throw std::invalid_argument("tick size must be positive");
+        }
+    }
+
+    PriceTicks to_ticks(Price price) const {
+        return static_cast<PriceTicks>(std::llround(price * ticks_per_unit_));
+    }
+    Price to_price(PriceTicks ticks) const {
+        return static_cast<Price>(ticks) / ticks_per_unit_;
+    }
+    /// The highest tick at or below `price`
+    PriceTicks floor_ticks(Price price) const {
+        const double x = price * ticks_per_unit_;
+        return on_grid(x) ? nearest(x) : static_cast<PriceTicks>(std::floor(x));
+    }
+    /// The lowest tick at or above `price`
+    PriceTicks ceil_ticks(Price price) const {
+        const double x = price * ticks_per_unit_;
+        return on_grid(x) ? nearest(x) : static_cast<PriceTicks>(std::ceil(x));
+    }
+    /// `price` snapped to the nearest tick
+    Price round(Price price) const { return to_price(to_ticks(price)); }
+
+    Price tick_size() const { return tick_size_; }
+
+private:
+    static PriceTicks nearest(double ticks) { return static_cast<PriceTicks>(std::llround(ticks)); }
+    // Within a few ulps of a whole number of ticks
+    static bool on_grid(double ticks) {
+        return std::abs(ticks - std::round(ticks)) <=
+               4.0 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::abs(ticks));
+    }
+
+    Price tick_size_;
+    Price ticks_per_unit_;
+};
+
+} // namespace qse
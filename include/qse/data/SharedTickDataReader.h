@@ -0,0 +1,40 @@
+#pragma once
+
+#include "qse/data/IDataReader.h"
+#include "qse/data/TickColumns.h"
+#include "qse/data/TickDataset.h"
+#include <memory>
+#include <vector>
+
+namespace qse {
+
+/**
+ * @brief IDataReader over a TickDataset shared read-only.
+ *
+ * Batch runs give every Backtester its own reader, but all readers for a
+ * symbol point at the same immutable dataset, so N strategies on one symbol
+ * cost one load and one copy of the data (none at all for a mapped tick
+ * cache). Cursors replay the shared columns directly; only read_all_ticks()
+ * builds a private Tick vector, on first use.
+ */
+class SharedTickDataReader : public IDataReader {
+public:
+    explicit SharedTickDataReader(std::shared_ptr<const TickDataset> dataset);
+    /// Shares an already-loaded series (wrapped, not copied)
+    explicit SharedTickDataReader(std::shared_ptr<const TickColumns> columns);
+
+    const std::vector<Tick>& read_all_ticks() const override;
+    const std::vector<Bar>& read_all_bars() const override { return bars_; }
+    /// The cursor shares ownership of what it replays (the dataset, or the
+    /// materialized ticks), so it may outlive this reader
+    std::unique_ptr<ITickCursor> open_tick_cursor() const override;
+
+    const TickDataset& dataset() const { return *dataset_; }
+
+private:
+    std::shared_ptr<const TickDataset> dataset_;
+    mutable std::shared_ptr<const std::vector<Tick>> ticks_; // built by read_all_ticks()
+    std::vector<Bar> bars_; // tick-only source
+};
+
+} // namespace qse
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include <cstddef>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace qse {
+
+/**
+ * @brief Process-wide interning table mapping tickers to dense SymbolIds.
+ *
+ * IDs are handed out in first-seen order starting at 0 and never reused, so
+ * per-symbol state can live in flat vectors indexed by ID. Names are stored
+ * in a deque, so references returned by name() stay valid for the life of
+ * the process.
+ *
+ * Thread-safe: lookups take a shared lock, interning a new ticker takes the
+ * exclusive lock once. The file readers (CSV, Parquet, tick columns) intern
+ * once per symbol change, not per row, and set Tick::symbol_id. A tick that
+ * arrives without one (a live feed, the ZeroMQ subscriber, a hand-built
+ * test tick) is interned by resolve_symbol_id in every consumer that sees
+ * it: a hash lookup under the shared lock per tick per consumer. Producers
+ * on a hot path should set symbol_id themselves.
+ */
+class SymbolTable {
+public:
+    static SymbolTable& instance();
+
+    /// ID for `symbol`, assigning the next free one on first sight
+    SymbolId intern(std::string_view symbol);
+
+    /// ID for `symbol`, or kInvalidSymbolId if it was never interned
+    SymbolId find(std::string_view symbol) const;
+
+    /// Ticker for an interned ID; throws std::out_of_range otherwise
+    const std::string& name(SymbolId id) const;
+
+    std::size_t size() const;
+
+    SymbolTable() = default;
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;                       // indexed by SymbolId
+    std::unordered_map<std::string_view, SymbolId> ids_;  // views into names_
+};
+
+inline SymbolId intern_symbol(std::string_view symbol) {
+    return SymbolTable::instance().intern(symbol);
+}
+
+/// The tick's interned ID, interning its ticker (a locked table lookup on
+/// every call) if a producer left it unset
+inline SymbolId resolve_symbol_id(const Tick& tick) {
+    return tick.symbol_id != kInvalidSymbolId ? tick.symbol_id : intern_symbol(tick.symbol);
+}
+
+/**
+ * @brief One-entry intern cache for parsers: rows of a file almost always
+ * repeat the previous row's ticker, so this skips the table lookup (and its
+ * lock) unless the ticker actually changes.
+ */
+class SymbolIdCache {
+public:
+    SymbolId resolve(std::string_view symbol) {
+        if (id_ == kInvalidSymbolId || symbol != last_) {
+            last_.assign(symbol.data(), symbol.size());
+            id_ = intern_symbol(symbol);
+        }
+        return id_;
+    }
+
+private:
+    std::string last_;
+    SymbolId id_ = kInvalidSymbolId;
+};
+
+} // namespace qse
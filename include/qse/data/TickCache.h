@@ -0,0 +1,106 @@
+#pragma once
+
+#include "qse/data/MappedFile.h"
+#include "qse/data/TickColumns.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qse {
+
+/**
+ * @brief Fixed-width binary tick cache kept beside a source CSV.
+ *
+ * `<source>.qtc` holds a loaded, time-sorted tick series so later runs can
+ * skip text parsing. The layout is a TickCacheHeader, then the strings
+ * section (symbol override, then the file-local symbol table, each as a
+ * uint32 length + bytes), then the eight columns in TickColumns order, each
+ * starting on an 8-byte boundary. Integers are native-endian; a byte-order
+ * marker rejects caches written on a different-endian host.
+ *
+ * A cache is only used when it was built from the source's current size
+ * and modification time, with the same symbol override, the same schema
+ * version and the same Timestamp resolution. Anything else is treated as a
+ * miss and the cache is rebuilt.
+ */
+struct TickCacheHeader {
+    char magic[8];                // "QSETICKS"
+    uint32_t version;             // kTickCacheVersion
+    uint32_t byte_order;          // 0x01020304 as written
+    uint64_t source_size;         // bytes of the source file
+    int64_t source_mtime;         // source last_write_time, file_time_type ticks
+    int64_t timestamp_period_num; // Timestamp::period of the stored timestamps
+    int64_t timestamp_period_den;
+    uint64_t row_count;
+    int64_t min_timestamp;        // Timestamp::rep; 0 when empty
+    int64_t max_timestamp;
+    uint64_t skipped_rows;        // data-quality report of the original parse
+    uint64_t gap_count;
+    uint32_t symbol_count;
+    uint32_t override_length;     // symbol override, first entry of the strings section
+    uint64_t strings_bytes;       // size of the strings section, before padding
+};
+
+constexpr uint32_t kTickCacheVersion = 1;
+
+/// Data-quality counts carried through the cache, so a cached load reports
+/// exactly what the original parse did
+struct TickCacheStats {
+    std::size_t skipped_rows = 0;
+    std::size_t gap_count = 0;
+};
+
+/// Where the cache for `source_path` lives: `<source_path>.qtc`
+std::string tick_cache_path(const std::string& source_path);
+
+/**
+ * @brief A validated tick cache, mapped read-only and viewed in place.
+ *
+ * `columns` points straight into the mapping, so the ticks cost page cache
+ * (shared with every other mapping of the file, in any process) rather than
+ * heap. The one exception is the symbol-ID column: stored IDs index the
+ * file's own symbol table, and when this process numbers those symbols
+ * differently the column is rewritten into `remapped_ids` (4 bytes a row).
+ */
+struct MappedTickCache {
+    explicit MappedTickCache(MappedFile mapped) : file(std::move(mapped)) {}
+
+    MappedFile file;
+    TickColumnsView columns;
+    std::vector<SymbolId> remapped_ids; // empty when the stored IDs are used as-is
+    TickCacheStats stats;
+};
+
+/**
+ * Maps `<source_path>.qtc` without copying the columns. Returns nullptr when
+ * the cache is missing or unreadable, stale, written for another symbol
+ * override, or malformed (including a symbol ID outside its symbol table).
+ */
+std::unique_ptr<MappedTickCache> map_tick_cache(const std::string& source_path,
+                                                const std::string& symbol_override);
+
+/**
+ * Maps `<source_path>.qtc` and copies it into `out` (symbol IDs remapped to
+ * this process's SymbolTable). Returns false, leaving `out` untouched, when
+ * the cache is missing or unreadable, stale, written for another symbol
+ * override, or malformed.
+ */
+bool load_tick_cache(const std::string& source_path, const std::string& symbol_override,
+                     TickColumns& out, TickCacheStats& stats);
+
+/**
+ * Writes `columns` (expected time-sorted) as the cache for `source_path`.
+ * The file is written under a temporary name and renamed into place, so
+ * concurrent readers never see a partial cache. Returns false, with a
+ * warning on stderr, if it cannot be written (e.g. a read-only data dir).
+ */
+bool write_tick_cache(const std::string& source_path, const std::string& symbol_override,
+                      const TickColumns& columns, const TickCacheStats& stats);
+
+/// Reads just the header of a cache file; false if it is not a valid cache
+bool read_tick_cache_header(const std::string& cache_path, TickCacheHeader& header);
+
+} // namespace qse
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include "qse/data/SymbolTable.h"
+#include "qse/data/TickCursor.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace qse {
+
+/**
+ * @brief Read-only struct-of-arrays view over a tick series.
+ *
+ * Each field is a separate contiguous column, so a pass that only needs
+ * timestamps and prices streams 16 bytes per tick instead of dragging a whole
+ * Tick (and its std::string symbol) through the cache. The view does not own
+ * the columns; the owner (TickColumns, or a mapped file) must outlive it.
+ */
+struct TickColumnsView {
+    std::size_t size = 0;
+    const Timestamp::rep* timestamps = nullptr; // Timestamp::duration counts since epoch
+    const SymbolId* symbol_ids = nullptr;
+    const Price* prices = nullptr;
+    const Price* bids = nullptr;
+    const Price* asks = nullptr;
+    const Volume* volumes = nullptr;
+    const Volume* bid_sizes = nullptr;
+    const Volume* ask_sizes = nullptr;
+
+    bool empty() const { return size == 0; }
+    Timestamp timestamp(std::size_t i) const {
+        return Timestamp(Timestamp::duration(timestamps[i]));
+    }
+
+    /// Writes row i into `out`, leaving out.symbol untouched when it already
+    /// holds this row's symbol (same symbol_id), so reused buffers never
+    /// reallocate the string
+    void fill_tick(std::size_t i, Tick& out) const;
+};
+
+/**
+ * @brief Owning columnar tick store with interned symbol IDs.
+ *
+ * Row order is whatever was appended; sort_by_time() reorders every column
+ * together. Rows carry only the SymbolId; the ticker string is recovered
+ * from SymbolTable when a row is materialized back into a Tick.
+ */
+class TickColumns {
+public:
+    std::size_t size() const { return timestamps_.size(); }
+    bool empty() const { return timestamps_.empty(); }
+
+    void reserve(std::size_t n);
+    void clear();
+
+    /// Appends one row, interning tick.symbol if tick.symbol_id is unset
+    void push_back(const Tick& tick) { push_back(tick, resolve_symbol_id(tick)); }
+    /// Appends one row under an already-resolved symbol ID
+    void push_back(const Tick& tick, SymbolId symbol_id) {
+        append_row(tick.timestamp, symbol_id, tick.price, tick.bid, tick.ask, tick.volume,
+                   tick.bid_size, tick.ask_size);
+    }
+    /// Appends one row from already-parsed fields (parsers skip building a Tick)
+    void append_row(Timestamp timestamp, SymbolId symbol_id, Price price, Price bid, Price ask,
+                    Volume volume, Volume bid_size, Volume ask_size);
+    /// Appends every row of `other`, in order
+    void append(const TickColumns& other);
+    /// Replaces the contents with a copy of `columns` (one bulk copy per
+    /// column, e.g. out of a mapped cache file)
+    void assign(const TickColumnsView& columns);
+
+    /// Materializes row i as a Tick
+    Tick tick_at(std::size_t i) const;
+
+    bool is_time_sorted() const;
+    /// Stable sort of all columns by timestamp (no-op when already sorted)
+    void sort_by_time();
+
+    TickColumnsView view() const;
+
+    std::vector<Tick> to_ticks() const;
+    static TickColumns from_ticks(const std::vector<Tick>& ticks);
+
+    const std::vector<Timestamp::rep>& timestamps() const { return timestamps_; }
+    const std::vector<SymbolId>& symbol_ids() const { return symbol_ids_; }
+    const std::vector<Price>& prices() const { return prices_; }
+
+private:
+    std::vector<Timestamp::rep> timestamps_;
+    std::vector<SymbolId> symbol_ids_;
+    std::vector<Price> prices_;
+    std::vector<Price> bids_;
+    std::vector<Price> asks_;
+    std::vector<Volume> volumes_;
+    std::vector<Volume> bid_sizes_;
+    std::vector<Volume> ask_sizes_;
+};
+
+/**
+ * @brief Cursor that replays a columnar series as Tick batches.
+ *
+ * Rows are materialized kTickBatchSize at a time into one reused buffer; a
+ * slot that already holds the same symbol keeps its string, so steady-state
+ * replay does not allocate. The columns must outlive the cursor.
+ */
+class ColumnarTickCursor : public ITickCursor {
+public:
+    explicit ColumnarTickCursor(TickColumnsView columns);
+
+    TickBatch next_batch() override;
+
+private:
+    TickColumnsView columns_;
+    std::size_t next_row_ = 0;
+    std::vector<Tick> batch_;
+};
+
+} // namespace qse
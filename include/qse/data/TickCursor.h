@@ -0,0 +1,64 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include <cstddef>
+#include <vector>
+
+namespace qse {
+
+// Ticks handed out per next_batch() call by the streaming readers: large
+// enough to amortize the virtual call and I/O, small enough to stay in L2
+constexpr std::size_t kTickBatchSize = 4096;
+
+/**
+ * @brief A contiguous run of ticks handed out by an ITickCursor.
+ *
+ * The view borrows the cursor's storage: it stays valid until the next call
+ * to next_batch() or until the cursor is destroyed.
+ */
+struct TickBatch {
+    const Tick* data = nullptr;
+    std::size_t size = 0;
+
+    const Tick* begin() const { return data; }
+    const Tick* end() const { return data + size; }
+    bool empty() const { return size == 0; }
+};
+
+/**
+ * @brief Pull-based stream of ticks in source order.
+ *
+ * Readers hand out cursors so the backtester can walk a tick file batch by
+ * batch in constant memory instead of materializing read_all_ticks() and then
+ * copying it again. An empty batch marks the end of the stream.
+ */
+class ITickCursor {
+public:
+    virtual ~ITickCursor() = default;
+
+    virtual TickBatch next_batch() = 0;
+};
+
+/**
+ * @brief Cursor over ticks that are already resident in memory. The whole
+ * vector is handed out as one zero-copy batch; the vector must outlive the
+ * cursor.
+ */
+class VectorTickCursor : public ITickCursor {
+public:
+    explicit VectorTickCursor(const std::vector<Tick>& ticks) : ticks_(ticks) {}
+
+    TickBatch next_batch() override {
+        if (consumed_) {
+            return {};
+        }
+        consumed_ = true;
+        return {ticks_.data(), ticks_.size()};
+    }
+
+private:
+    const std::vector<Tick>& ticks_;
+    bool consumed_ = false;
+};
+
+} // namespace qse
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "qse/data/TickColumns.h"
+#include "qse/data/TickCursor.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace qse {
+
+struct MappedTickCache;
+
+/**
+ * @brief Immutable, reference-counted tick series that any number of
+ * Backtesters replay concurrently.
+ *
+ * A dataset is either a loaded TickColumns (shared, never copied) or the
+ * binary tick cache beside a CSV mapped read-only (TickCache.h), whose
+ * columns are replayed straight out of the page cache. Every reader and
+ * cursor over a dataset sees the same memory, so adding strategies on a
+ * symbol adds only their per-cursor batch buffers; the load is paid once,
+ * and a mapped dataset's pages are shared with every other process mapping
+ * the same file.
+ *
+ * Datasets are only handed out as shared_ptr<const TickDataset>; the last
+ * owner releases the columns or the mapping.
+ */
+class TickDataset : public std::enable_shared_from_this<TickDataset> {
+public:
+    /// Shares an already-loaded series
+    static std::shared_ptr<const TickDataset> from_columns(
+        std::shared_ptr<const TickColumns> columns);
+    /// Takes over a series
+    static std::shared_ptr<const TickDataset> from_columns(TickColumns columns);
+
+    /**
+     * Maps the tick cache of `data_file`, building it first (one parse, as
+     * CSVDataReader::LoadMode::Cached does) when it is missing or stale. If
+     * the cache cannot be written (e.g. a read-only data directory) the
+     * parsed columns are kept on the heap instead. Throws what
+     * CSVDataReader throws for an unreadable file.
+     */
+    static std::shared_ptr<const TickDataset> load(const std::string& data_file,
+                                                   const std::string& symbol_override = "");
+
+    ~TickDataset();
+    TickDataset(const TickDataset&) = delete;
+    TickDataset& operator=(const TickDataset&) = delete;
+
+    const TickColumnsView& view() const { return view_; }
+    std::size_t size() const { return view_.size; }
+    bool empty() const { return view_.empty(); }
+
+    /// True when the columns live in a mapped tick cache
+    bool is_mapped() const { return mapped_ != nullptr; }
+    /// Bytes of tick data held on the heap: all of it for loaded columns,
+    /// only a remapped symbol-ID column (if any) for a mapped cache
+    std::size_t heap_bytes() const;
+
+    /// A cursor replaying the shared columns in order. The cursor holds a
+    /// reference to the dataset, so it stays valid after every other owner
+    /// (e.g. the reader that opened it) is gone.
+    std::unique_ptr<ITickCursor> open_cursor() const;
+
+private:
+    TickDataset() = default;
+
+    std::shared_ptr<const TickColumns> columns_;
+    std::unique_ptr<const MappedTickCache> mapped_;
+    TickColumnsView view_;
+};
+
+} // namespace qse
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include "qse/data/TickCursor.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace qse {
+
+/**
+ * @brief Heap-based k-way merge of per-source tick cursors into one
+ * timestamp-ordered stream.
+ *
+ * Every data source we load (CSV, Parquet, the ZeroMQ replay) is already
+ * time-ordered, so interleaving k of them costs O(N log k) comparisons on a
+ * heap of source indices instead of an O(N log N) sort that swaps whole
+ * Tick objects (string symbols included). Ticks are never copied: next()
+ * returns a pointer into the owning source's current batch.
+ *
+ * Order is verified as batches arrive. A source whose batch runs backwards
+ * in time falls back to draining its remaining ticks and sorting only that
+ * source. In-memory sources hand out everything in one batch, so for them
+ * the check is complete before the first tick is emitted; for a streaming
+ * source, ticks older than what it already emitted come out late.
+ *
+ * Ties on timestamp are broken by source index (the order add_source() was
+ * called), which keeps replays deterministic.
+ */
+class TickMerger {
+public:
+    void add_source(std::unique_ptr<ITickCursor> cursor);
+
+    /// Next tick in timestamp order, or nullptr once every source is
+    /// exhausted. The pointer stays valid until the following call.
+    const Tick* next();
+
+    /// Number of sources that were out of order and had to be sorted
+    std::size_t sorted_fallback_count() const { return sorted_fallbacks_; }
+
+private:
+    struct Source {
+        std::unique_ptr<ITickCursor> cursor;
+        TickBatch batch;
+        std::size_t pos = 0;
+        Timestamp last{};
+        bool has_last = false;
+        bool drained = false;      // cursor exhausted (or fully drained by the fallback)
+        std::vector<Tick> sorted;  // owns the ticks of an out-of-order source
+    };
+
+    // Loads the next batch of a source, verifying order; false when exhausted
+    bool refill(std::size_t index);
+    // Steps past the source's current tick; false when it has none left
+    bool advance(std::size_t index);
+    const Tick& head(std::size_t index) const {
+        return sources_[index].batch.data[sources_[index].pos];
+    }
+    bool later(std::size_t a, std::size_t b) const;
+    void push(std::size_t index);
+
+    std::vector<Source> sources_;
+    std::vector<std::size_t> heap_; // min-heap of source indices on head timestamp
+    static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+    std::size_t pending_ = kNone; // source whose head was last handed out
+    bool primed_ = false;
+    std::size_t sorted_fallbacks_ = 0;
+};
+
+} // namespace qse
@@ -41,6 +41,14 @@ public:
      */
     const std::vector<Bar>& read_all_bars() const override;
 
+    /**
+     * @brief Stream ticks as they arrive instead of buffering the whole feed
+     * @return Cursor yielding up to kTickBatchSize ticks per batch until
+     *         END_OF_STREAM; once the feed has been fully received it serves
+     *         the buffered ticks instead
+     */
+    std::unique_ptr<ITickCursor> open_tick_cursor() const override;
+
     /**
      * @brief Start receiving data from the publisher
      * This method will block until all data is received or timeout occurs
@@ -71,6 +79,16 @@ private:
      */
     Tick deserialize_tick(const std::string& data) const;
 
+    /**
+     * @brief Block until the next tick arrives
+     * @param out Receives the decoded tick
+     * @return false once END_OF_STREAM has been received
+     */
+    bool receive_tick(Tick& out) const;
+
+    // Cursor that pulls ticks straight off the socket (see open_tick_cursor)
+    class StreamCursor;
+
     /**
      * @brief Convert Protocol Buffers timestamp to C++ timestamp
      * @param timestamp_s Unix timestamp in seconds
@@ -41,14 +41,14 @@ public:
              std::string base_url = "https://paper-api.alpaca.markets");
 
     // --- IExecutionHandler ---
-    OrderId submit_market_order(const std::string& symbol, Order::Side side,
-                                Volume quantity) override;
-    OrderId submit_limit_order(const std::string& symbol, Order::Side side, Volume quantity,
-                               Price limit_price, Order::TimeInForce tif) override;
-    bool cancel_order(const OrderId& order_id) override;
-    OrderId replace_order(const OrderId& order_id, Volume new_quantity,
-                          Price new_limit_price) override;
-    std::optional<Order> get_order(const OrderId& order_id) const override;
+    VenueOrderId submit_market_order(const std::string& symbol, Order::Side side,
+                                     Volume quantity) override;
+    VenueOrderId submit_limit_order(const std::string& symbol, Order::Side side, Volume quantity,
+                                    Price limit_price, Order::TimeInForce tif) override;
+    bool cancel_order(const VenueOrderId& order_id) override;
+    VenueOrderId replace_order(const VenueOrderId& order_id, Volume new_quantity,
+                               Price new_limit_price) override;
+    std::optional<Order> get_order(const VenueOrderId& order_id) const override;
     void set_fill_callback(FillCallback callback) override;
 
     /// Polls every tracked (non-terminal) order and emits a Fill for newly
@@ -57,7 +57,7 @@ public:
 
 private:
     std::vector<std::string> auth_headers() const;
-    OrderId submit(const std::string& body_json);
+    VenueOrderId submit(const std::string& body_json);
 
     std::shared_ptr<IHttpClient> http_;
     std::string key_id_;
@@ -66,7 +66,7 @@ private:
     FillCallback fill_callback_;
 
     // filled quantity already emitted per tracked order id
-    std::unordered_map<OrderId, Volume> emitted_fill_qty_;
+    std::unordered_map<VenueOrderId, Volume> emitted_fill_qty_;
 };
 
 } // namespace qse
@@ -26,27 +26,27 @@ public:
 
     /// Submits a market order; returns the venue-assigned order id
     /// (empty on rejection).
-    virtual OrderId submit_market_order(const std::string& symbol, Order::Side side,
-                                        Volume quantity) = 0;
+    virtual VenueOrderId submit_market_order(const std::string& symbol, Order::Side side,
+                                             Volume quantity) = 0;
 
     /// Submits a limit order; returns the venue-assigned order id
     /// (empty on rejection).
-    virtual OrderId submit_limit_order(const std::string& symbol, Order::Side side, Volume quantity,
-                                       Price limit_price,
-                                       Order::TimeInForce tif = Order::TimeInForce::DAY) = 0;
+    virtual VenueOrderId submit_limit_order(const std::string& symbol, Order::Side side,
+                                            Volume quantity, Price limit_price,
+                                            Order::TimeInForce tif = Order::TimeInForce::DAY) = 0;
 
     /// Cancels a working order. False if unknown or no longer cancellable.
-    virtual bool cancel_order(const OrderId& order_id) = 0;
+    virtual bool cancel_order(const VenueOrderId& order_id) = 0;
 
     /// Replaces a working limit order's quantity and limit price
     /// (cancel-and-resubmit semantics on venues without a native replace).
     /// Returns the working order id after the replace — which may differ
     /// from the original — or an empty id on failure.
-    virtual OrderId replace_order(const OrderId& order_id, Volume new_quantity,
-                                  Price new_limit_price) = 0;
+    virtual VenueOrderId replace_order(const VenueOrderId& order_id, Volume new_quantity,
+                                       Price new_limit_price) = 0;
 
     /// Queries the current state of an order at the venue.
-    virtual std::optional<Order> get_order(const OrderId& order_id) const = 0;
+    virtual std::optional<Order> get_order(const VenueOrderId& order_id) const = 0;
 
     /// Registers the asynchronous fill stream.
     virtual void set_fill_callback(FillCallback callback) = 0;
@@ -3,6 +3,8 @@
 #include "qse/exe/IExecutionHandler.h"
 #include "qse/order/IOrderManager.h"
 
+#include <charconv>
+#include <string>
 #include <utility>
 
 namespace qse {
@@ -19,6 +21,10 @@ namespace qse {
  * The handler takes over the OrderManager's fill callback: consumers must
  * subscribe to fills through set_fill_callback on the handler, not on the
  * underlying OrderManager.
+ *
+ * The simulated venue's order id is the engine's integer OrderId in decimal;
+ * it is formatted only here, at the venue boundary, and stamped on the
+ * orders and fills the handler returns (venue_order_id).
  */
 class SimulatedExecutionHandler : public IExecutionHandler {
 public:
@@ -26,47 +32,67 @@ public:
         : order_manager_(order_manager) {
         order_manager_.set_fill_callback([this](const Fill& fill) {
             if (fill_callback_) {
-                fill_callback_(fill);
+                Fill venue_fill = fill;
+                venue_fill.venue_order_id = to_venue_id(fill.order_id);
+                fill_callback_(venue_fill);
             }
         });
     }
 
-    OrderId submit_market_order(const std::string& symbol, Order::Side side,
-                                Volume quantity) override {
-        return order_manager_.submit_market_order(symbol, side, quantity);
+    VenueOrderId submit_market_order(const std::string& symbol, Order::Side side,
+                                     Volume quantity) override {
+        return to_venue_id(order_manager_.submit_market_order(symbol, side, quantity));
     }
 
-    OrderId submit_limit_order(const std::string& symbol, Order::Side side, Volume quantity,
-                               Price limit_price, Order::TimeInForce tif) override {
-        return order_manager_.submit_limit_order(symbol, side, quantity, limit_price, tif);
+    VenueOrderId submit_limit_order(const std::string& symbol, Order::Side side, Volume quantity,
+                                    Price limit_price, Order::TimeInForce tif) override {
+        return to_venue_id(
+            order_manager_.submit_limit_order(symbol, side, quantity, limit_price, tif));
     }
 
-    bool cancel_order(const OrderId& order_id) override {
-        return order_manager_.cancel_order(order_id);
+    bool cancel_order(const VenueOrderId& order_id) override {
+        return order_manager_.cancel_order(from_venue_id(order_id));
     }
 
-    OrderId replace_order(const OrderId& order_id, Volume new_quantity,
-                          Price new_limit_price) override {
+    VenueOrderId replace_order(const VenueOrderId& order_id, Volume new_quantity,
+                               Price new_limit_price) override {
         // Cancel-and-resubmit: the simulated venue has no native replace.
         // Only working limit orders are replaceable, matching brokerage
         // semantics (a market order is gone the moment it is accepted).
-        auto existing = order_manager_.get_order(order_id);
+        const OrderId id = from_venue_id(order_id);
+        auto existing = order_manager_.get_order(id);
         if (!existing || !existing->is_active() || existing->type != Order::Type::LIMIT) {
             return {};
         }
-        if (!order_manager_.cancel_order(order_id)) {
+        if (!order_manager_.cancel_order(id)) {
             return {};
         }
-        return order_manager_.submit_limit_order(existing->symbol, existing->side, new_quantity,
-                                                 new_limit_price, existing->time_in_force);
+        return to_venue_id(order_manager_.submit_limit_order(
+            existing->symbol, existing->side, new_quantity, new_limit_price,
+            existing->time_in_force));
     }
 
-    std::optional<Order> get_order(const OrderId& order_id) const override {
-        return order_manager_.get_order(order_id);
+    std::optional<Order> get_order(const VenueOrderId& order_id) const override {
+        auto order = order_manager_.get_order(from_venue_id(order_id));
+        if (order) {
+            order->venue_order_id = order_id;
+        }
+        return order;
     }
 
     void set_fill_callback(FillCallback callback) override { fill_callback_ = std::move(callback); }
 
+    static VenueOrderId to_venue_id(OrderId id) {
+        return id == kInvalidOrderId ? VenueOrderId{} : std::to_string(id);
+    }
+    // kInvalidOrderId unless the whole string is a decimal order id
+    static OrderId from_venue_id(const VenueOrderId& id) {
+        OrderId parsed = kInvalidOrderId;
+        const char* end = id.data() + id.size();
+        auto [ptr, ec] = std::from_chars(id.data(), end, parsed);
+        return (ec == std::errc() && ptr == end) ? parsed : kInvalidOrderId;
+    }
+
 private:
     IOrderManager& order_manager_;
     FillCallback fill_callback_;
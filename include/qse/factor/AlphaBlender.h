@@ -8,6 +8,9 @@
 
 namespace qse {
 
+class FactorStore;
+struct FactorQuery;
+
 /**
  * @brief AlphaBlender for combining factor scores into final alpha scores
  *
@@ -59,6 +62,16 @@ public:
                                  const std::vector<std::string>& factor_cols,
                                  const std::string& return_col, const std::string& date_col);
 
+    /**
+     * @brief Blend the factors of the FactorStore rows that match `query`
+     *
+     * Reads only the selected dates and symbols, and only `factor_cols` and
+     * `return_col` (query.columns is ignored).
+     */
+    BlendingResult blend_factors(const FactorStore& store, const FactorQuery& query,
+                                 const std::vector<std::string>& factor_cols,
+                                 const std::string& return_col);
+
     /**
      * @brief Calculate Information Ratio for a factor
      * @param factor_values Factor values
@@ -1,4 +1,7 @@
 #pragma once
+#include "qse/factor/FactorPanel.h"
+
+#include <Eigen/Dense>
 #include <vector>
 #include <string>
 #include <memory>
@@ -10,6 +13,18 @@ class Table;
 
 namespace qse {
 
+class FactorStore;
+struct FactorQuery;
+
+/// A long panel for CrossSectionalRegression::run_cross_sections: one row per
+/// (symbol, date), rows in any order
+struct CrossSectionInput {
+    std::vector<DateKey> dates;
+    std::vector<double> returns;
+    /// One column per factor, each as long as `dates`
+    std::vector<std::vector<double>> exposures;
+};
+
 /**
  * @class CrossSectionalRegression
  * @brief Implements Barra-style cross-sectional regression for factor analysis
@@ -19,6 +34,14 @@ namespace qse {
  * 2. Calculate factor risk and alpha decomposition
  * 3. Generate factor attribution reports
  * 4. Handle missing data and outliers
+ *
+ * Each regression is a no-intercept OLS of returns on exposures. Rows with
+ * a missing value are dropped, and the returns and every exposure are
+ * winsorized at the configured quantile. The exposures are copied into one
+ * contiguous column-major matrix, X'X and X'y are formed once, and the fit,
+ * the standard errors and every per-factor R² come from a single Cholesky
+ * factorization of X'X (a pivoted QR of X when the exposures are
+ * collinear).
  */
 class CrossSectionalRegression {
 public:
@@ -37,11 +60,12 @@ public:
         std::vector<double> factor_returns;    // Factor returns for the period
         std::vector<double> factor_std_errors; // Standard errors
         std::vector<double> factor_t_stats;    // T-statistics
-        std::vector<double> factor_r_squared;  // R-squared values
+        std::vector<double> factor_r_squared;  // R² of each factor on its own
         std::vector<double> residuals;         // Regression residuals
-        double total_r_squared;                // Overall R-squared
-        int num_observations;                  // Number of observations
-        int num_factors;                       // Number of factors
+        double total_r_squared = 0.0;          // Overall R-squared
+        int num_observations = 0;              // Rows used, after dropping missing ones
+        int num_factors = 0;                   // Number of factors
+        DateKey date = 0;                      // Set by run_cross_sections only
     };
 
     RegressionResult run_regression(const std::shared_ptr<arrow::Table>& factor_table,
@@ -49,6 +73,16 @@ public:
                                     const std::string& return_column,
                                     const std::vector<std::string>& factor_columns);
 
+    /**
+     * @brief Run the regression on the FactorStore rows that match `query`
+     *
+     * Reads only the selected dates and symbols, and only the return and
+     * factor columns (query.columns is ignored).
+     */
+    RegressionResult run_regression(const FactorStore& store, const FactorQuery& query,
+                                    const std::string& return_column,
+                                    const std::vector<std::string>& factor_columns);
+
     /**
      * @brief Compute rolling cross-sectional regression over time
      * @param factor_table Arrow table with time series factor data
@@ -63,6 +97,47 @@ public:
                            const std::string& date_column, const std::string& return_column,
                            const std::vector<std::string>& factor_columns, int window_size = 252);
 
+    /// Rolling regression over the FactorStore rows that match `query`,
+    /// which are read in date order with only the needed columns
+    std::vector<RegressionResult>
+    run_rolling_regression(const FactorStore& store, const FactorQuery& query,
+                           const std::string& return_column,
+                           const std::vector<std::string>& factor_columns, int window_size = 252);
+
+    /**
+     * @brief One regression per date: the daily Fama-MacBeth pass
+     *
+     * Rows are grouped by date and each date's cross-section is fitted on
+     * its own, one date per task on a WorkStealingPool. Within a date rows
+     * keep their input order, so the results do not depend on the number of
+     * threads. Dates with no more usable rows than factors are skipped.
+     * @return One result per fitted date, in ascending date order
+     * @throws std::invalid_argument if `returns` or an exposure column is
+     * not as long as `dates`
+     */
+    std::vector<RegressionResult> run_cross_sections(const CrossSectionInput& input);
+
+    /// run_cross_sections over a table with a utf8 yyyy-mm-dd date column
+    /// and double return and factor columns
+    std::vector<RegressionResult>
+    run_cross_sections(const std::shared_ptr<arrow::Table>& factor_table,
+                       const std::string& date_column, const std::string& return_column,
+                       const std::vector<std::string>& factor_columns);
+
+    /// run_cross_sections over the FactorStore rows that match `query`
+    std::vector<RegressionResult>
+    run_cross_sections(const FactorStore& store, const FactorQuery& query,
+                       const std::string& return_column,
+                       const std::vector<std::string>& factor_columns);
+
+    /// Worker threads for run_cross_sections; 0 (the default) means one per
+    /// hardware thread, 1 runs on the calling thread
+    void set_num_threads(unsigned threads) { threads_ = threads; }
+
+    /// Quantile clamped on each side of the returns and of every exposure
+    /// before a fit; 0 turns winsorization off
+    void set_winsor_quantile(double quantile) { winsor_quantile_ = quantile; }
+
     /**
      * @brief Compute factor risk decomposition
      * @param factor_returns Time series of factor returns
@@ -91,34 +166,23 @@ public:
                                             const std::vector<std::string>& factor_names);
 
 private:
-    // Helper methods for regression computation
-    std::vector<double> compute_ols_estimates(const std::vector<std::vector<double>>& X,
-                                              const std::vector<double>& y);
-
-    std::vector<double> compute_standard_errors(const std::vector<std::vector<double>>& X,
-                                                const std::vector<double>& residuals,
-                                                int num_observations);
-
-    std::vector<double> compute_t_statistics(const std::vector<double>& coefficients,
-                                             const std::vector<double>& std_errors);
-
-    double compute_r_squared(const std::vector<double>& y, const std::vector<double>& y_pred);
-
-    std::vector<double> compute_residuals(const std::vector<std::vector<double>>& X,
-                                          const std::vector<double>& y,
-                                          const std::vector<double>& coefficients);
+    // One cross-section: observations x factors, column-major, and the
+    // returns, with every row that has a missing value already dropped
+    struct RegressionData {
+        Eigen::MatrixXd X;
+        Eigen::VectorXd y;
+    };
 
-    // Data preprocessing
-    std::pair<std::vector<std::vector<double>>, std::vector<double>> prepare_regression_data(
-        const std::shared_ptr<arrow::Table>& factor_table, const std::string& return_column,
-        const std::vector<std::string>& factor_columns, int start_row, int end_row);
+    // Rows order[begin, end) of `input` that have no missing value
+    static RegressionData gather_rows(const CrossSectionInput& input,
+                                      const std::vector<std::size_t>& order, std::size_t begin,
+                                      std::size_t end);
 
-    // Handle missing data
-    void handle_missing_data(std::vector<std::vector<double>>& X, std::vector<double>& y);
+    // Winsorizes `data` in place, then fits it
+    RegressionResult fit_cross_section(RegressionData& data) const;
 
-    // Remove outliers using winsorization
-    void winsorize_data(std::vector<std::vector<double>>& X, std::vector<double>& y,
-                        double percentile = 0.01);
+    unsigned threads_ = 0;
+    double winsor_quantile_ = 0.01;
 };
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qse {
+
+/// A trading date as a sortable integer, yyyymmdd
+using DateKey = std::int32_t;
+
+/// "2023-01-03" (or "20230103") -> 20230103
+/// @throws std::invalid_argument if `date` is not a yyyy-mm-dd date
+DateKey parse_date_key(const std::string& date);
+
+/// 20230103 -> "2023-01-03"
+std::string format_date_key(DateKey date);
+
+struct FactorPanelSettings {
+    // 12-1 momentum on daily rows: twelve months back to one month back
+    std::size_t momentum_lookback = 252;
+    std::size_t momentum_skip = 21;
+    // Volatility of daily returns over this many rows
+    std::size_t vol_window = 20;
+    // Cross-sections are clamped to this quantile on each side before the
+    // z-score
+    double winsor_quantile = 0.01;
+
+    // Composite weights for momentum, volatility and value
+    double momentum_weight = 0.5;
+    double vol_weight = 0.3;
+    double value_weight = 0.2;
+
+    // Worker threads; 0 means one per hardware thread, 1 runs everything on
+    // the calling thread
+    unsigned threads = 0;
+};
+
+/// A long daily panel: one row per (symbol, date), rows in any order
+struct FactorPanelInput {
+    std::vector<std::string> symbols;
+    std::vector<DateKey> dates;
+    std::vector<double> close;
+    std::vector<double> pb; // price-to-book
+};
+
+/// Cross-sectional z-scores and the composite, in input row order
+struct FactorPanelOutput {
+    std::vector<double> mom_z;
+    std::vector<double> vol_z;
+    std::vector<double> val_z;
+    std::vector<double> alpha;
+    std::size_t num_symbols = 0;
+    std::size_t num_dates = 0;
+};
+
+/**
+ * @brief Computes momentum, volatility and value factors over a
+ * multi-symbol daily panel.
+ *
+ * Rows are grouped by symbol and ordered by date within each symbol, so a
+ * look-back never crosses from one symbol into another. Each symbol's
+ * history is then a contiguous slice, and the time-series factors run as the
+ * column kernels of qse/math/FactorKernels.h, one symbol per task on a
+ * WorkStealingPool. The rows are then regrouped by date, and every date's
+ * cross-section is winsorized and z-scored on its own, one date per task.
+ *
+ * Look-backs count the symbol's own rows (its trading days). A row inside a
+ * factor's warm-up (fewer than `momentum_lookback` or `vol_window` earlier
+ * rows), or whose value is not finite (a zero P/B, a NaN close), takes no
+ * part in its date's statistics and scores 0, the cross-sectional mean.
+ *
+ * Each cross-section is visited in symbol order, so the result is the same
+ * bit for bit whatever order the rows arrive in and however many threads
+ * run.
+ */
+class FactorPanel {
+public:
+    explicit FactorPanel(FactorPanelSettings settings = {});
+
+    /// @throws std::invalid_argument if the columns differ in length or a
+    /// (symbol, date) pair appears twice
+    FactorPanelOutput compute(const FactorPanelInput& input) const;
+
+    const FactorPanelSettings& settings() const { return settings_; }
+
+private:
+    FactorPanelSettings settings_;
+};
+
+} // namespace qse
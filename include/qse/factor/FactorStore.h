@@ -0,0 +1,139 @@
+#pragma once
+
+#include "qse/factor/FactorPanel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arrow {
+class Table;
+}
+
+namespace qse {
+
+/// Which rows and columns a FactorStore read returns. Empty lists mean all.
+struct FactorQuery {
+    DateKey first_date = std::numeric_limits<DateKey>::min(); // inclusive
+    DateKey last_date = std::numeric_limits<DateKey>::max();  // inclusive
+    std::vector<std::string> symbols;
+    /// Columns besides `date` and `symbol`, which are always returned
+    std::vector<std::string> columns;
+
+    bool wants_date(DateKey date) const { return date >= first_date && date <= last_date; }
+
+    /// False only if no wanted symbol lies in [min_symbol, max_symbol], the
+    /// range a row group's statistics record
+    bool may_contain_symbols(const std::string& min_symbol, const std::string& max_symbol) const;
+};
+
+struct FactorStoreSettings {
+    /// Symbol partitions per date; used when a store is created
+    std::uint32_t symbol_buckets = 4;
+    /// Rows per Parquet row group. Rows are sorted by symbol, so each row
+    /// group's min/max symbol statistics bound a narrow name range.
+    std::int64_t row_group_rows = 128;
+};
+
+/// One Parquet file of a store: one date's rows whose symbols hash to
+/// `bucket`
+struct FactorPartition {
+    DateKey date = 0;
+    std::uint32_t bucket = 0;
+    std::string path;
+};
+
+/// What a FactorStore read touched
+struct FactorReadStats {
+    std::size_t files = 0;
+    std::size_t row_groups_read = 0;
+    std::size_t row_groups_skipped = 0; // pruned by symbol statistics
+    std::size_t rows = 0;
+};
+
+/// Stable bucket of `symbol` among `buckets` (FNV-1a; the same on every
+/// platform, unlike std::hash)
+std::uint32_t symbol_bucket(std::string_view symbol, std::uint32_t buckets);
+
+/// "date=2023-01-03/symbol_bucket=2", relative to the store root
+std::string partition_directory(DateKey date, std::uint32_t bucket);
+
+/// The one file in each partition directory
+inline constexpr char kFactorPartFile[] = "part-0.parquet";
+
+/**
+ * @brief Factor panel stored as a Hive-partitioned Parquet dataset.
+ *
+ * Layout under the root directory:
+ *
+ *     _factor_store                          symbol bucket count
+ *     date=2023-01-03/symbol_bucket=0/part-0.parquet
+ *     date=2023-01-03/symbol_bucket=1/part-0.parquet
+ *     ...
+ *
+ * Each file holds one date's rows for the symbols in one bucket, sorted
+ * by symbol, in row groups with min/max statistics. The date lives in the
+ * directory name only, as Hive, Spark and Arrow datasets expect.
+ *
+ * A read is pruned in three steps:
+ * - date directories outside the query's range are never opened;
+ * - with a symbol list, only the buckets those symbols hash to are read;
+ * - row groups whose symbol range holds none of them are skipped.
+ * Only the requested columns are decoded. A query over a month and a few
+ * symbols therefore reads a few dozen small row groups, not the history.
+ *
+ * plan() and the layout are plain filesystem work; write() and read() use
+ * Arrow and live in FactorStoreParquet.cpp.
+ */
+class FactorStore {
+public:
+    /**
+     * Opens the store at `root`. An existing store keeps the bucket count
+     * it was created with; `settings.symbol_buckets` applies to a new one.
+     * @throws std::runtime_error if `root` has an unreadable layout file
+     * @throws std::invalid_argument if a setting is zero
+     */
+    explicit FactorStore(std::string root, FactorStoreSettings settings = {});
+
+    /**
+     * Writes a panel with utf8 `date` (yyyy-mm-dd) and `symbol` columns.
+     * Each date in `table` is replaced whole: its partitions are rewritten
+     * and buckets it no longer has are removed. Other dates are untouched,
+     * so appending a day writes only that day's files. Each file is written
+     * under a temporary name and renamed into place.
+     * @throws std::invalid_argument if `date` or `symbol` is missing or not
+     * utf8, or a date is malformed
+     * @throws std::runtime_error on I/O failure
+     */
+    void write(const std::shared_ptr<arrow::Table>& table);
+
+    /**
+     * Rows matching `query`: `date` (utf8), `symbol`, then the requested
+     * columns in order (all stored columns when none are named), one chunk
+     * per column, ordered by date, then bucket, then symbol. A column a
+     * file lacks reads as nulls.
+     * @throws std::runtime_error if a file cannot be read or a column's
+     * type differs between files
+     */
+    std::shared_ptr<arrow::Table> read(const FactorQuery& query,
+                                       FactorReadStats* stats = nullptr) const;
+
+    /// The files read(query) opens, by date then bucket
+    std::vector<FactorPartition> plan(const FactorQuery& query) const;
+
+    const std::string& root() const { return root_; }
+    std::uint32_t symbol_buckets() const { return settings_.symbol_buckets; }
+    const FactorStoreSettings& settings() const { return settings_; }
+
+private:
+    void save_layout() const;
+
+    std::string root_;
+    FactorStoreSettings settings_;
+};
+
+} // namespace qse
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "qse/factor/FactorPanel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+
+namespace qse {
+
+/**
+ * @brief Daily factor scoring from persisted per-symbol state.
+ *
+ * Holds what each symbol's time-series factors need to take one more row:
+ * - the last `momentum_lookback + 1` closes;
+ * - the last `vol_window` daily returns, with their running sum and sum of
+ *   squares;
+ * - the number of rows seen.
+ * update() advances that state by new dates only, and scores each new
+ * date's cross-section the way FactorPanel does. A date needs nothing from
+ * other dates' cross-sections.
+ *
+ * The running sums are carried exactly as math::rolling_std carries them,
+ * so scoring a history in one FactorPanel run or as any sequence of
+ * update() calls (with save/load in between) gives the same values, bit
+ * for bit. The first update() over the full history builds the state.
+ *
+ * State files are native-endian binary: a FactorStateHeader, then one
+ * record per symbol in name order. save() writes to a temporary file and
+ * renames it into place, so a crash leaves the previous state intact.
+ */
+class FactorUpdater {
+public:
+    explicit FactorUpdater(FactorPanelSettings settings = {});
+
+    /**
+     * Ingests rows for dates after last_date(), oldest date first, and
+     * returns their scores in input row order. A symbol missing on a date
+     * keeps its state; a symbol seen for the first time starts a warm-up.
+     * @throws std::invalid_argument if the columns differ in length, a row
+     * is dated on or before last_date(), or a (symbol, date) pair repeats.
+     * The state is left unchanged.
+     */
+    FactorPanelOutput update(const FactorPanelInput& rows);
+
+    /// Latest date ingested; 0 before the first update
+    DateKey last_date() const { return last_date_; }
+    std::size_t num_symbols() const { return symbols_.size(); }
+    const FactorPanelSettings& settings() const { return settings_; }
+
+    /// @throws std::runtime_error if the file cannot be written
+    void save(const std::string& path) const;
+
+    /**
+     * Restores a saved state. `settings` supplies the weights, quantile and
+     * threads, which may change between runs; its windows must match the
+     * ones the state was built with.
+     * @throws std::runtime_error if the file is unreadable, not a state
+     * file, or built with other windows
+     */
+    static FactorUpdater load(const std::string& path, FactorPanelSettings settings = {});
+
+private:
+    struct SymbolState {
+        std::uint64_t rows = 0;
+        std::deque<double> closes;  // newest last
+        std::deque<double> returns; // newest last
+        double sum = 0.0;           // of `returns`
+        double sum2 = 0.0;
+    };
+
+    // Advances `state` by one close and returns the row's raw momentum,
+    // volatility and value (NaN where not defined yet)
+    void step(SymbolState& state, double close, double pb, double out[3]) const;
+
+    FactorPanelSettings settings_;
+    DateKey last_date_ = 0;
+    std::map<std::string, SymbolState> symbols_; // name order = cross-section order
+};
+
+/// Header of a FactorUpdater state file
+struct FactorStateHeader {
+    char magic[8];        // "QSEFSTAT"
+    uint32_t version;     // kFactorStateVersion
+    uint32_t byte_order;  // 0x01020304 as written
+    uint64_t momentum_lookback;
+    uint64_t momentum_skip;
+    uint64_t vol_window;
+    int32_t last_date;    // DateKey
+    uint32_t symbol_count;
+};
+
+constexpr uint32_t kFactorStateVersion = 1;
+
+} // namespace qse
@@ -9,6 +9,9 @@ class Table;
 
 namespace qse {
 
+class FactorStore;
+struct FactorQuery;
+
 /**
  * @class ICMonitor
  * @brief Computes Spearman rank information coefficient (IC) between factor and next-day return,
@@ -41,6 +44,16 @@ public:
                         const std::string& return_col, const std::string& date_col,
                         int window_size = 252);
 
+    /**
+     * @brief Compute IC over the rows of a FactorStore that match `query`
+     *
+     * Reads only the dates and symbols `query` selects, and only the factor
+     * and return columns (query.columns is ignored).
+     */
+    ICResult compute_ic(const FactorStore& store, const FactorQuery& query,
+                        const std::string& factor_col, const std::string& return_col,
+                        int window_size = 252);
+
 private:
     double spearman_rank_corr(const std::vector<double>& x, const std::vector<double>& y);
 };
@@ -17,10 +17,16 @@ namespace qse {
  * This class implements the factor computation pipeline:
  * 1. Load daily price data
  * 2. Apply universe filters and data hygiene
- * 3. Compute momentum, volatility, and value factors
+ * 3. Compute momentum, volatility, and value factors (column kernels in
+ *    qse/math/FactorKernels.h over each column's contiguous buffer)
  * 4. Apply winsorization and z-score normalization
  * 5. Create composite alpha scores
  * 6. Output to Parquet format
+ *
+ * A table with a `symbol` column is a multi-symbol panel: it goes through
+ * FactorPanel, which keeps every look-back within one symbol and
+ * normalizes each date's cross-section on its own, in parallel. A table
+ * without one is a single symbol's history.
  */
 class MultiFactorCalculator {
 public:
@@ -36,6 +42,22 @@ public:
     void compute_factors(const std::string& in_csv, const std::string& out_parquet,
                          const std::string& weights_yaml);
 
+    /**
+     * @brief Score only the dates a saved factor state has not seen
+     *
+     * Loads `state_path` (a FactorUpdater state) if it exists, or starts an
+     * empty one, then ingests the panel rows of `in_csv` dated after the
+     * state's last date. The new dates are written to the FactorStore at
+     * `out_dir` (one `date=yyyy-mm-dd` partition each, split by symbol
+     * bucket); the state is saved once all of them are written. The first
+     * run over the full history builds the state; each later run needs
+     * only the new day's rows.
+     * @throws std::runtime_error if `in_csv` has no `symbol` column or the
+     * state was built with other look-back windows
+     */
+    void update_factors(const std::string& in_csv, const std::string& state_path,
+                        const std::string& out_dir, const std::string& weights_yaml);
+
     /**
      * @brief Set universe filter criteria
      * @param min_price Minimum stock price
@@ -46,18 +68,26 @@ public:
     void set_filter_criteria(double min_price, double min_volume, int min_listing_age,
                              double max_price);
 
+    /// Worker threads for panel tables; 0 (the default) means one per
+    /// hardware thread
+    void set_num_threads(unsigned threads) { threads_ = threads; }
+
 private:
+    std::shared_ptr<arrow::Table> load_clean_table(const std::string& in_csv);
+    void compute_panel_factors(const std::shared_ptr<arrow::Table>& table,
+                               const std::string& out_parquet, const std::string& weights_yaml);
+
     // Helper methods for Arrow table operations
     std::shared_ptr<arrow::Table> load_arrow_table(const std::string& csv_path);
     void save_parquet(const std::shared_ptr<arrow::Table>& table, const std::string& path);
-    void append_column(const std::shared_ptr<arrow::Table>& table, const std::string& name,
+    /// Replaces `table` with a copy that has `data` as a float64 column
+    /// named `name`; throws if `data` is not one value per row
+    void append_column(std::shared_ptr<arrow::Table>& table, const std::string& name,
                        const std::vector<double>& data);
 
-    template <typename T>
-    T col(const std::shared_ptr<arrow::Table>& table, const std::string& name, int row);
-
     // Universe filter
     std::unique_ptr<UniverseFilter> universe_filter_;
+    unsigned threads_ = 0;
 };
 
 } // namespace qse
\ No newline at end of file
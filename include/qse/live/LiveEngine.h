@@ -52,7 +52,7 @@ public:
     void stop() { running_.store(false, std::memory_order_relaxed); }
 
     // --- Local books ---
-    const std::vector<OrderId>& submitted_orders() const { return submitted_; }
+    const std::vector<VenueOrderId>& submitted_orders() const { return submitted_; }
     const std::vector<Fill>& local_fills() const { return fills_; }
     std::size_t bars_seen() const { return bars_seen_; }
 
@@ -61,7 +61,7 @@ public:
 
     // --- Reconciliation (the done-when) ---
     struct ReconciliationLine {
-        OrderId order_id;
+        VenueOrderId order_id;
         Volume local_fill_qty = 0;
         Volume venue_fill_qty = 0;
         bool venue_reachable = false;
@@ -87,7 +87,7 @@ private:
     bool is_long_ = false;
     std::size_t bars_seen_ = 0;
 
-    std::vector<OrderId> submitted_;
+    std::vector<VenueOrderId> submitted_;
     std::vector<Fill> fills_;
     std::atomic<bool> running_{true};
 };
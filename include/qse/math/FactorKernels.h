@@ -0,0 +1,126 @@
+#pragma once
+#include "qse/math/StatsUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace qse::math {
+
+/// ----------------------------------------------
+/// Column kernels for the factor pipeline
+///
+/// Each kernel reads one or more contiguous input columns and writes a
+/// contiguous output column of the same length (which may not alias an
+/// input unless stated). Element-wise kernels have no loop-carried state, so
+/// the compiler vectorizes them; rolling kernels carry only running sums.
+/// ----------------------------------------------
+
+/// Simple return of `now` over `prev`; 0 when `prev` is 0 (and `now` is
+/// finite). A zero `prev` divides by infinity instead of branching, so loops
+/// over it have no control flow and vectorize.
+inline double pct_change(double now, double prev) {
+    return (now - prev) / (prev == 0.0 ? HUGE_VAL : prev);
+}
+
+/// out[i] = pct_change(x[i], x[i - 1]); out[0] = 0
+inline void simple_returns(const double* x, std::size_t n, double* out) {
+    if (n == 0)
+        return;
+    out[0] = 0.0;
+    for (std::size_t i = 1; i < n; ++i)
+        out[i] = pct_change(x[i], x[i - 1]);
+}
+
+/// Momentum from `lookback` rows back to `skip` rows back (12-1 momentum is
+/// lookback 252, skip 21 on daily rows): out[i] = pct_change(x[i - skip],
+/// x[i - lookback]) once i >= lookback, 0 before. Requires skip <= lookback.
+inline void momentum(const double* x, std::size_t n, std::size_t lookback, std::size_t skip,
+                     double* out) {
+    const std::size_t warm = lookback < n ? lookback : n;
+    for (std::size_t i = 0; i < warm; ++i)
+        out[i] = 0.0;
+    for (std::size_t i = warm; i < n; ++i)
+        out[i] = pct_change(x[i - skip], x[i - lookback]);
+}
+
+/// Population standard deviation of `count` values from their running sum
+/// and sum of squares, as RollingStdDev computes it
+inline double std_from_sums(double sum, double sum2, double count) {
+    const double mean = sum / count;
+    return std::sqrt(std::max(0.0, (sum2 / count) - mean * mean));
+}
+
+/// Rolling population standard deviation over the last `window` values:
+/// the same values, bit for bit, as feeding x through RollingStdDev(window)
+/// (0 while fewer than two values are in the window). `out` may alias `x`
+/// only when window is 1.
+inline void rolling_std(const double* x, std::size_t n, std::size_t window, double* out) {
+    double sum = 0.0;
+    double sum2 = 0.0;
+    // Warm-up: the window is still filling
+    const std::size_t warm = window < n ? window : n;
+    for (std::size_t i = 0; i < warm; ++i) {
+        sum += x[i];
+        sum2 += x[i] * x[i];
+        out[i] = i == 0 ? 0.0 : std_from_sums(sum, sum2, static_cast<double>(i + 1));
+    }
+    // Full window: one value in, one out, no branches
+    const double count = static_cast<double>(window);
+    for (std::size_t i = warm; i < n; ++i) {
+        const double old = x[i - window];
+        sum += x[i];
+        sum2 += x[i] * x[i];
+        sum -= old;
+        sum2 -= old * old;
+        out[i] = window < 2 ? 0.0 : std_from_sums(sum, sum2, count);
+    }
+}
+
+/// out[i] = 1 / x[i]; 0 where x[i] is 0 (branch-free like pct_change)
+inline void reciprocal(const double* x, std::size_t n, double* out) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = 1.0 / (x[i] == 0.0 ? HUGE_VAL : x[i]);
+}
+
+/// out[i] += w * x[i]
+inline void axpy(double w, const double* x, std::size_t n, double* out) {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] += w * x[i];
+}
+
+/// out[i] = sum over c of weights[c] * columns[c][i], added in column order.
+/// Each row reads every column and writes `out` once, which beats one axpy
+/// pass per column as soon as the columns outgrow the cache.
+inline void weighted_sum(const double* const* columns, const double* weights, std::size_t k,
+                         std::size_t n, double* out) {
+    if (k == 0) {
+        std::fill(out, out + n, 0.0);
+        return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        double acc = weights[0] * columns[0][i];
+        for (std::size_t c = 1; c < k; ++c)
+            acc += weights[c] * columns[c][i];
+        out[i] = acc;
+    }
+}
+
+/// One factor's cross-section: the finite values of x are winsorized at
+/// quantile q on each side and z-scored in place; the others become 0.
+/// `finite` is scratch storage reused between calls.
+inline void cross_section_zscore(double* x, std::size_t n, double q,
+                                 std::vector<double>& finite) {
+    finite.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::isfinite(x[i]))
+            finite.push_back(x[i]);
+    }
+    winsorize(finite, q);
+    zscore(finite);
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = std::isfinite(x[i]) ? finite[next++] : 0.0;
+}
+
+} // namespace qse::math
@@ -4,6 +4,7 @@
 #include <numeric>
 #include <cmath>
 #include <algorithm>
+#include <functional>
 
 namespace qse::math {
 
@@ -43,18 +44,61 @@ private:
     double sum2_{0.0};
 };
 
-/// Winsorise in-place – clamp values to the q-th / (1-q) quantile.
-inline void winsorize(std::vector<double>& v, double q = 0.01) {
-    if (v.empty())
+namespace detail {
+
+/// The value at 0-based position `count - 1` of x[0, n) in `Less` order, by
+/// one pass that keeps the `count` best values seen in a heap. For a small
+/// `count` nearly every value is rejected by one compare with the top.
+template <class Less>
+double heap_select(const double* x, std::size_t n, std::size_t count,
+                   std::vector<double>& heap, Less less) {
+    heap.assign(x, x + count);
+    std::make_heap(heap.begin(), heap.end(), less);
+    for (std::size_t i = count; i < n; ++i) {
+        if (less(x[i], heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            heap.back() = x[i];
+            std::push_heap(heap.begin(), heap.end(), less);
+        }
+    }
+    return heap.front();
+}
+
+} // namespace detail
+
+/// Winsorise x[0, n) in-place – clamp values to the q-th / (1-q) quantile.
+/// `scratch` holds the values the quantiles are selected from, so a caller
+/// winsorizing many columns allocates it once.
+inline void winsorize(double* x, std::size_t n, double q, std::vector<double>& scratch) {
+    if (n == 0)
         return;
-    auto w = v; // copy for quantile lookup
-    std::nth_element(w.begin(), w.begin() + w.size() * q, w.end());
-    double lo = w[static_cast<std::size_t>(w.size() * q)];
-    std::nth_element(w.begin(), w.begin() + w.size() * (1 - q), w.end());
-    double hi = w[static_cast<std::size_t>(w.size() * (1 - q))];
+    const auto lo_at = static_cast<std::size_t>(n * q);
+    const auto hi_at = std::min(static_cast<std::size_t>(n * (1 - q)), n - 1);
+    double lo, hi;
+    if (lo_at < hi_at && (lo_at + 1) + (n - hi_at) <= n / 16) {
+        // Thin tails (q of a few percent): two heap passes over x, no copy
+        lo = detail::heap_select(x, n, lo_at + 1, scratch, std::less<double>());
+        hi = detail::heap_select(x, n, n - hi_at, scratch, std::greater<double>());
+    } else {
+        scratch.assign(x, x + n);
+        auto& w = scratch;
+        std::nth_element(w.begin(), w.begin() + lo_at, w.end());
+        lo = w[lo_at];
+        // Everything after lo_at is already >= lo, so the upper quantile is
+        // selected from that part alone
+        auto upper = hi_at > lo_at ? w.begin() + lo_at + 1 : w.begin();
+        std::nth_element(upper, w.begin() + hi_at, w.end());
+        hi = w[hi_at];
+    }
 
-    for (auto& x : v)
-        x = std::clamp(x, lo, hi);
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = std::clamp(x[i], lo, hi);
+}
+
+/// Winsorise in-place – clamp values to the q-th / (1-q) quantile.
+inline void winsorize(std::vector<double>& v, double q = 0.01) {
+    std::vector<double> scratch;
+    winsorize(v.data(), v.size(), q, scratch);
 }
 
 /// Simple z-score (vector is modified in-place)
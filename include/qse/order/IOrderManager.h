@@ -69,6 +69,10 @@ public:
     // prices.
     virtual void record_equity(long long timestamp,
                                const std::map<std::string, double>& market_prices) = 0;
+
+    // Records equity with every position valued at the last trade price
+    // process_tick() saw for its symbol (the Backtester's per-tick call)
+    virtual void record_equity(long long timestamp) = 0;
 };
 
 } // namespace qse
\ No newline at end of file
@@ -5,12 +5,14 @@
 #include "qse/data/OrderBook.h"
 #include "qse/data/OrderBookFullDepth.h"
 #include "qse/core/Config.h"
+#include "qse/core/ResultSink.h"
+#include "qse/order/Portfolio.h"
 #include "qse/microstructure/OFICalculator.h"
 #include "qse/microstructure/VPINCalculator.h"
 
+#include <cstddef>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <map>
 #include <memory>
 #include <optional>
@@ -18,6 +20,24 @@
 
 namespace qse {
 
+// Running performance summary of one OrderManager, kept up to date as
+// trades are logged and equity is recorded, so batch runners can report a
+// run without re-reading its equity curve file
+struct RunSummary {
+    double initial_cash = 0.0;
+    double final_equity = 0.0; // last recorded equity (initial cash before any)
+    double peak_equity = 0.0;
+    double max_drawdown = 0.0; // largest drop from a running peak, as a fraction of it
+    std::size_t equity_points = 0;
+    std::size_t trades = 0;
+    double traded_notional = 0.0; // sum of |quantity * price| over all trades
+    double slippage_cost = 0.0;   // sum of fill price vs quote mid, signed against the trader
+
+    double total_return() const {
+        return initial_cash != 0.0 ? final_equity / initial_cash - 1.0 : 0.0;
+    }
+};
+
 // A concrete implementation of the IOrderManager interface.
 // This class handles order execution, position tracking, and logging for multiple assets.
 class OrderManager : public IOrderManager {
@@ -31,6 +51,11 @@ public:
                  const std::string& tradelog_path);
 
     // Legacy constructor for backward compatibility
+    //
+    // In every constructor an empty path disables that output file; the
+    // RunSummary is kept either way (parameter sweeps use nothing else).
+    // Both files go through a ResultSink (buffered, written on a background
+    // thread) in backtester.result_format; the legacy constructor writes CSV.
     OrderManager(double initial_cash, const std::string& equity_curve_path,
                  const std::string& tradelog_path);
 
@@ -44,8 +69,16 @@ public:
     double get_cash() const override;
     void record_equity(long long timestamp,
                        const std::map<std::string, double>& market_prices) override;
+    void record_equity(long long timestamp) override;
+
+    const Portfolio& portfolio() const { return portfolio_; }
 
     // Tick-level order management methods
+    //
+    // Prices are compared in integer ticks of the symbol's tick size
+    // (Config::get_tick_size; kDefaultPriceResolution without a Config): a
+    // limit price is rounded to the tick grid on submission, and a quote
+    // crosses it only by a whole tick, never by floating-point noise.
     OrderId submit_market_order(const std::string& symbol, Order::Side side,
                                 Volume quantity) override;
     OrderId submit_limit_order(const std::string& symbol, Order::Side side, Volume quantity,
@@ -54,6 +87,9 @@ public:
     void process_tick(const Tick& tick) override;
 
     // --- NEW: Attempt fills against current order book ---
+    // Rematches only the symbols that saw a tick (process_tick), a new order
+    // or depth_book() access since the last call; a shared OrderBook updated
+    // directly by the caller is picked up on the symbol's next tick.
     void attempt_fills() override;
 
     // --- NEW: Set fill callback for strategy notifications ---
@@ -82,8 +118,21 @@ public:
     bool is_toxic() const;       ///< VPIN ready and above the threshold
 
     // Access (creating if needed) the full-depth book for a symbol, so
-    // callers and tests can seed multi-level liquidity directly.
-    OrderBookFullDepth& depth_book(const std::string& symbol) { return depth_books_[symbol]; }
+    // callers and tests can seed multi-level liquidity directly. The symbol
+    // is rematched by the next attempt_fills().
+    OrderBookFullDepth& depth_book(const std::string& symbol);
+
+    const RunSummary& run_summary() const { return summary_; }
+
+    // --- Result output (config: backtester.result_format / equity_sample_every) ---
+    // Write one equity point per `every` record_equity() calls; the first
+    // and the last points are always written and the RunSummary still sees
+    // every call. Throws std::invalid_argument for 0.
+    void set_equity_sample_every(std::size_t every);
+    std::size_t equity_sample_every() const { return equity_sample_every_; }
+
+    // Waits until everything recorded so far is in the output files
+    void flush_results();
 
 private:
     // Configuration for slippage coefficients
@@ -96,23 +145,55 @@ private:
     bool use_full_depth_ = false;
     std::unordered_map<std::string, OrderBookFullDepth> depth_books_;
 
+    // Tick grid of each symbol, from the config on first use
+    std::vector<TickScale> tick_scales_; // indexed by SymbolId
+
     // QueueId of each strategy limit order resting in a depth book
     std::unordered_map<OrderId, QueueId> limit_queue_ids_;
 
-    // Portfolio state
-    double cash_;
-    std::map<std::string, int> positions_;
+    // Cash and positions, marked to market by process_tick
+    Portfolio portfolio_;
 
     // Order book
     std::unordered_map<OrderId, Order> orders_;
-    std::unordered_map<std::string, std::vector<OrderId>> symbol_orders_;
 
-    // Order ID generation
-    int next_order_id_;
-
-    // File outputs
-    std::ofstream equity_curve_file_;
-    std::ofstream tradelog_file_;
+    // Active orders of one symbol, stored contiguously for the matching
+    // loops: market orders in arrival order, limit orders in price priority
+    // (best limit first, then arrival) so a pass stops at the first limit
+    // that cannot cross
+    struct LimitEntry {
+        PriceTicks limit;
+        OrderId id;
+    };
+    struct SymbolOrders {
+        std::vector<OrderId> market;
+        std::vector<LimitEntry> buys;  // highest limit first
+        std::vector<LimitEntry> sells; // lowest limit first
+        std::size_t ioc = 0;           // IOC orders among the limits
+
+        bool empty() const { return market.empty() && buys.empty() && sells.empty(); }
+    };
+    std::vector<SymbolOrders> symbol_orders_; // indexed by SymbolId
+
+    // Symbols with a new quote, trade print or order since the last
+    // attempt_fills(); only these can have anything new to match
+    std::vector<SymbolId> dirty_symbols_;
+    std::vector<char> dirty_flags_; // indexed by SymbolId
+
+    // Reused by the matching loops for the IDs of one pass
+    std::vector<OrderId> match_ids_;
+
+    // Order ID generation: compact handles counting up from 1
+    OrderId next_order_id_;
+
+    // File outputs; null when both paths are empty
+    std::unique_ptr<ResultSink> results_;
+    std::size_t equity_sample_every_ = 1;
+    // Last equity point skipped by sampling, written on destruction so the
+    // curve always ends at the final recorded equity
+    std::optional<EquityPoint> skipped_equity_;
+
+    RunSummary summary_;
 
     // --- NEW: Fill callback for strategy notifications ---
     FillCallback fill_callback_;
@@ -127,13 +208,21 @@ private:
     OrderId generate_order_id();
     void add_order_to_book(const Order& order);
     void remove_order_from_book(const OrderId& order_id);
-    void match_orders_for_symbol(const std::string& symbol, const Tick& tick);
+    void mark_dirty(SymbolId symbol);
+    const TickScale& tick_scale(SymbolId symbol);
+    // The symbol's depth book, created on its tick grid if needed
+    OrderBookFullDepth& depth_book_for(const std::string& symbol, SymbolId id);
+    // Whether `quote` (the ask for a buy, the bid for a sell) reaches the
+    // limit order's price, compared in ticks
+    bool limit_crosses(const Order& order, Price quote) const;
+    void match_orders_for_symbol(SymbolId symbol, const Tick& tick);
+    void attempt_fills_for_symbol(SymbolId symbol);
     // price_includes_impact: true when fill_price came from walking the
     // depth book (VWAP), so the linear slippage coefficient must not be
     // applied on top of it
     void fill_order(Order& order, Volume fill_qty, Price fill_price, const Tick& tick,
                     bool price_includes_impact = false);
-    void cancel_ioc_orders(const std::string& symbol, const Tick& tick);
+    void cancel_ioc_orders(SymbolId symbol);
 
     // New helper methods for OrderBook integration
     Volume process_limit_order_fill(Order& order, const TopOfBook& tob);
@@ -152,10 +241,12 @@ private:
     // (order ids not tracked in orders_ are synthetic/seeded liquidity).
     void apply_maker_fill(const OrderId& maker_id, Volume qty, Price price, const Tick& tick);
 
+    void open_outputs(const std::string& equity_curve_path, const std::string& tradelog_path);
+    void init_run_summary();
+
     // Legacy helper methods
     void log_trade(long long timestamp, const std::string& symbol, const std::string& type,
                    int quantity, double price);
-    double calculate_holdings_value(const std::map<std::string, double>& market_prices) const;
 };
 
 } // namespace qse
\ No newline at end of file
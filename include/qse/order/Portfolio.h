@@ -0,0 +1,102 @@
+#pragma once
+
+#include "qse/data/Data.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qse {
+
+/**
+ * @brief Cash, positions and mark-to-market value of one account, kept
+ *        current in O(1) per price or fill.
+ *
+ * Per-symbol state lives in one flat vector indexed by SymbolId: position,
+ * last marked price, and the value it contributes (position x last price).
+ * mark() and trade() replace that one symbol's contribution in the running
+ * holdings total, so equity() never walks the positions.
+ *
+ * The total is updated by subtracting the old contribution and adding the
+ * new one, so with a single symbol it stays bit-identical to position x
+ * price. With several symbols it can drift from a fresh sum by rounding
+ * only; recompute_holdings_value() is the full pass, kept for cross-checks.
+ *
+ * A symbol that was never marked is valued at zero, as a missing price was
+ * by the old per-tick recompute.
+ */
+class Portfolio {
+public:
+    explicit Portfolio(double cash = 0.0) : cash_(cash) {}
+
+    /// Marks `symbol` to market at `price`
+    void mark(SymbolId symbol, Price price) {
+        Holding& h = slot(symbol);
+        h.last_price = price;
+        revalue(h);
+    }
+
+    /// Applies a fill: `quantity` is signed (positive buys), cash moves by
+    /// quantity x price. The position is valued at the last mark, not at
+    /// the fill price.
+    void trade(SymbolId symbol, int64_t quantity, Price price) {
+        Holding& h = slot(symbol);
+        cash_ -= static_cast<double>(quantity) * price;
+        h.position += quantity;
+        revalue(h);
+    }
+
+    int64_t position(SymbolId symbol) const {
+        return symbol < holdings_.size() ? holdings_[symbol].position : 0;
+    }
+    /// Last marked price; 0 if the symbol was never marked
+    Price last_price(SymbolId symbol) const {
+        return symbol < holdings_.size() ? holdings_[symbol].last_price : 0.0;
+    }
+
+    double cash() const { return cash_; }
+    double holdings_value() const { return holdings_value_; }
+    double equity() const { return cash_ + holdings_value_; }
+
+    /// Sum of position x last price over every symbol: O(symbols)
+    double recompute_holdings_value() const;
+
+    /// Replaces the running total with recompute_holdings_value()
+    void resync() { holdings_value_ = recompute_holdings_value(); }
+
+    /// Calls f(symbol, position) for every symbol with a non-zero position,
+    /// in SymbolId order
+    template <typename F> void for_each_position(F&& f) const {
+        for (std::size_t id = 0; id < holdings_.size(); ++id) {
+            if (holdings_[id].position != 0) {
+                f(static_cast<SymbolId>(id), holdings_[id].position);
+            }
+        }
+    }
+
+private:
+    struct Holding {
+        int64_t position = 0;
+        Price last_price = 0.0;
+        double value = 0.0; // position * last_price as last added to the total
+    };
+
+    Holding& slot(SymbolId symbol) {
+        if (symbol >= holdings_.size()) {
+            holdings_.resize(static_cast<std::size_t>(symbol) + 1);
+        }
+        return holdings_[symbol];
+    }
+
+    void revalue(Holding& h) {
+        const double value = static_cast<double>(h.position) * h.last_price;
+        holdings_value_ -= h.value;
+        holdings_value_ += value;
+        h.value = value;
+    }
+
+    double cash_;
+    double holdings_value_ = 0.0;
+    std::vector<Holding> holdings_; // indexed by SymbolId
+};
+
+} // namespace qse
@@ -0,0 +1,128 @@
+#include "qse/core/BacktestBatchRunner.h"
+#include "qse/core/Backtester.h"
+#include "qse/core/WorkStealingPool.h"
+#include "qse/data/SharedTickDataReader.h"
+#include "qse/data/TickDataset.h"
+
+#include <algorithm>
+#include <future>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+namespace qse {
+
+BacktestBatchRunner::BacktestBatchRunner(unsigned threads)
+    : threads_(threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+void BacktestBatchRunner::add_job(BacktestJob job) {
+    if (job.sources.empty()) {
+        throw std::invalid_argument("Backtest job '" + job.name + "' has no tick source");
+    }
+    if (!job.make_strategy) {
+        throw std::invalid_argument("Backtest job '" + job.name + "' has no strategy factory");
+    }
+    jobs_.push_back(std::move(job));
+}
+
+std::vector<BacktestJobResult> BacktestBatchRunner::run() {
+    WorkStealingPool pool(threads_);
+
+    // Phase 1: load every distinct source once, in parallel
+    std::map<SourceKey, std::future<std::shared_ptr<const TickDataset>>> loads;
+    for (const BacktestJob& job : jobs_) {
+        for (const TickSource& source : job.sources) {
+            SourceKey key{source.data_file, source.symbol};
+            if (datasets_.count(key) != 0 || loads.count(key) != 0) {
+                continue;
+            }
+            loads.emplace(key, pool.enqueue([source] {
+                return TickDataset::load(source.data_file, source.symbol);
+            }));
+        }
+    }
+    for (auto& [key, load] : loads) {
+        try {
+            datasets_[key] = load.get();
+        } catch (const std::exception& e) {
+            datasets_[key] = nullptr;
+            load_errors_[key] = e.what();
+        }
+    }
+
+    // Phase 2: fan the jobs out. Longest-first would balance better, but
+    // job cost is not known up front and batches are usually uniform.
+    std::vector<std::future<BacktestJobResult>> pending;
+    pending.reserve(jobs_.size());
+    for (const BacktestJob& job : jobs_) {
+        pending.push_back(pool.enqueue([this, &job] { return run_job(job); }));
+    }
+    std::vector<BacktestJobResult> results;
+    results.reserve(jobs_.size());
+    for (auto& result : pending) {
+        results.push_back(result.get());
+    }
+    return results;
+}
+
+BacktestJobResult BacktestBatchRunner::run_job(const BacktestJob& job) const {
+    BacktestJobResult result;
+    result.name = job.name;
+    result.symbol = job.symbol;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        auto shared_reader = [this](const TickSource& source) {
+            const SourceKey key{source.data_file, source.symbol};
+            const auto& dataset = datasets_.at(key);
+            if (!dataset) {
+                throw std::runtime_error(load_errors_.at(key));
+            }
+            return std::make_unique<SharedTickDataReader>(dataset);
+        };
+
+        auto order_manager =
+            job.config
+                ? std::make_shared<OrderManager>(*job.config, job.equity_file, job.tradelog_file)
+                : std::make_shared<OrderManager>(job.initial_cash, job.equity_file,
+                                                 job.tradelog_file);
+        auto strategy = job.make_strategy(order_manager);
+        {
+            Backtester backtester(job.symbol, shared_reader(job.sources.front()),
+                                  std::move(strategy), order_manager, job.bar_interval);
+            for (std::size_t i = 1; i < job.sources.size(); ++i) {
+                backtester.add_data_source(shared_reader(job.sources[i]));
+            }
+            backtester.run();
+        }
+        result.summary = order_manager->run_summary();
+        result.ok = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    result.wall_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+void BacktestBatchRunner::print_results(const std::vector<BacktestJobResult>& results,
+                                        std::ostream& out) {
+    out << std::left << std::setw(28) << "job" << std::setw(8) << "symbol" << std::right
+        << std::setw(10) << "return%" << std::setw(10) << "maxDD%" << std::setw(8) << "trades"
+        << std::setw(14) << "turnover" << std::setw(10) << "wall_s" << "\n";
+    for (const BacktestJobResult& r : results) {
+        out << std::left << std::setw(28) << r.name << std::setw(8) << r.symbol << std::right;
+        if (!r.ok) {
+            out << "  FAILED: " << r.error << "\n";
+            continue;
+        }
+        out << std::fixed << std::setprecision(3) << std::setw(10)
+            << r.summary.total_return() * 100.0 << std::setw(10)
+            << r.summary.max_drawdown * 100.0 << std::setw(8) << r.summary.trades
+            << std::setprecision(0) << std::setw(14) << r.summary.traded_notional
+            << std::setprecision(3) << std::setw(10) << r.wall_seconds << "\n";
+        out.unsetf(std::ios::floatfield);
+    }
+}
+
+} // namespace qse
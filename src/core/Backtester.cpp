@@ -8,6 +8,8 @@
 #include <map>
 #include <algorithm>
 #include "qse/core/BarRouter.h"
+#include "qse/data/SymbolTable.h"
+#include "qse/data/TickMerger.h"
 
 namespace qse {
 
@@ -17,7 +19,7 @@ Backtester::Backtester(const std::string& symbol, std::unique_ptr<IDataReader> d
                        std::shared_ptr<IOrderManager> order_manager,
                        const std::chrono::seconds& bar_interval)
     : symbol_(symbol), strategy_(std::move(strategy)), order_manager_(std::move(order_manager)),
-      bar_builders_(), bar_router_(), order_book_(), bar_interval_(bar_interval) {
+      bar_router_(), order_book_(), bar_interval_(bar_interval), bar_intervals_{bar_interval} {
     if (data_reader) {
         data_readers_.push_back(std::move(data_reader));
     }
@@ -39,90 +41,155 @@ void Backtester::add_data_source(std::unique_ptr<IDataReader> data_reader) {
     }
 }
 
+void Backtester::set_bar_intervals(std::vector<std::chrono::seconds> intervals) {
+    // Validate now rather than on the first tick
+    MultiTimeframeBarBuilder check(intervals);
+    bar_intervals_ = std::move(intervals);
+    bar_interval_ = bar_intervals_.front();
+}
+
+void Backtester::add_information_bars(BarType type, double threshold) {
+    information_bars_.emplace_back(type, threshold);
+}
+
 void Backtester::run() {
     std::cout << "[Backtester] Starting backtest for " << symbol_ << "..." << std::endl;
 
-    std::vector<Tick> all_ticks;
+    // Every source is already time-ordered, so the per-source cursors are
+    // interleaved with a k-way merge instead of concatenating and sorting.
+    // Each source streams in constant memory and no tick is copied.
+    TickMerger merger;
     for (const auto& reader : data_readers_) {
-        const auto& ticks = reader->read_all_ticks();
-        all_ticks.insert(all_ticks.end(), ticks.begin(), ticks.end());
+        merger.add_source(reader->open_tick_cursor());
     }
 
-    if (all_ticks.empty()) {
+    const Tick* tick = merger.next();
+    if (tick == nullptr) {
         std::cout << "[Backtester] No ticks to process for " << symbol_ << "." << std::endl;
         return;
     }
 
-    std::cout << "[Backtester] Processing " << all_ticks.size() << " ticks for " << symbol_
-              << std::endl;
+    std::cout << "[Backtester] Processing ticks for " << symbol_ << std::endl;
 
-    std::sort(all_ticks.begin(), all_ticks.end(),
-              [](const Tick& a, const Tick& b) { return a.timestamp < b.timestamp; });
+    std::size_t processed = 0;
+    for (; tick != nullptr; tick = merger.next()) {
+        if (!process_tick(*tick)) {
+            break; // stop processing further ticks
+        }
+        ++processed;
+    }
 
-    bool abort_due_to_error = false;
-    std::map<std::string, double> last_prices;
-    for (const auto& tick : all_ticks) {
-        if (abort_due_to_error)
-            break;
+    std::cout << "[Backtester] Processed " << processed << " ticks for " << symbol_ << std::endl;
 
-        // Register symbol with router once
-        if (registered_symbols_.insert(tick.symbol).second) {
-            bar_router_.register_strategy(tick.symbol, strategy_.get());
-        }
+    finish();
 
-        // The strategy's on_tick is the primary event handler
-        try {
-            strategy_->on_tick(tick);
-        } catch (const std::exception& ex) {
-            std::cerr << "[Backtester] Strategy exception: " << ex.what() << std::endl;
-            // Still feed the tick into the bar builder so we can flush a bar
-            auto& builder =
-                bar_builders_.try_emplace(tick.symbol, BarBuilder(bar_interval_)).first->second;
-            builder.add_tick(tick);
-            abort_due_to_error = true;
-            break; // stop processing further ticks
+    // --- Unit-test visible summary hooks ---
+    // Some tests expect the backtester to query cash and position once the
+    // run has finished. These calls are effectively no-ops for production but
+    // allow the mocks in tests to verify that the backtester provides a
+    // summary opportunity.
+    if (order_manager_) {
+        (void)order_manager_->get_cash();
+        (void)order_manager_->get_position(symbol_);
+    }
+}
+
+void Backtester::finish() {
+    // Flush remaining bars for each symbol
+    for (auto& state : symbol_states_) {
+        if (!state.bar_builder) {
+            continue;
+        }
+        state.bar_builder->flush(completed_bars_);
+        for (auto& builder : state.information_bar_builders) {
+            if (auto bar = builder.flush()) {
+                completed_bars_.push_back(std::move(*bar));
+            }
         }
+    }
+    route_completed_bars();
+
+    if (order_manager_ && unrecorded_equity_ts_) {
+        order_manager_->record_equity(*unrecorded_equity_ts_);
+        unrecorded_equity_ts_.reset();
+    }
+}
+
+void Backtester::route_completed_bars() {
+    for (const Bar& bar : completed_bars_) {
+        bar_router_.route_bar(bar);
+    }
+    completed_bars_.clear();
+}
 
-        // Feed this tick into the per-symbol bar builder
-        auto& builder =
-            bar_builders_.try_emplace(tick.symbol, BarBuilder(bar_interval_)).first->second;
+Backtester::SymbolState& Backtester::symbol_state(SymbolId id) {
+    if (id >= symbol_states_.size()) {
+        symbol_states_.resize(static_cast<std::size_t>(id) + 1);
+    }
+    SymbolState& state = symbol_states_[id];
+    if (!state.registered) {
+        // First tick for this symbol: register with the router once and set
+        // up its bar builders
+        state.registered = true;
+        bar_router_.register_strategy(id, strategy_.get());
+        bar_router_.subscribe_ticks(id, strategy_.get());
+        state.bar_builder.emplace(bar_intervals_);
+        state.information_bar_builders = information_bars_;
+    }
+    return state;
+}
 
+bool Backtester::add_to_bars(SymbolState& state, const Tick& tick) {
+    bool completed = state.bar_builder->add_tick(tick, completed_bars_) > 0;
+    for (auto& builder : state.information_bar_builders) {
         if (auto bar = builder.add_tick(tick)) {
-            // Dispatch bar via router so strategies interested in this symbol get it
-            bar_router_.route_bar(*bar);
+            completed_bars_.push_back(std::move(*bar));
+            completed = true;
         }
+    }
+    return completed;
+}
 
-        // Now let the order manager ingest the tick and then attempt fills.
-        if (order_manager_) {
-            order_manager_->process_tick(tick);
-            order_manager_->attempt_fills();
-
-            // Mark the portfolio to market so the equity curve gets a point
-            // per tick (valued at the latest price seen for each symbol)
-            last_prices[tick.symbol] = tick.price;
-            auto ts_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                             tick.timestamp.time_since_epoch())
-                             .count();
-            order_manager_->record_equity(ts_ms, last_prices);
-        }
+bool Backtester::process_tick(const Tick& tick) {
+    const SymbolId id = resolve_symbol_id(tick);
+    SymbolState& state = symbol_state(id);
+
+    // The strategy's on_tick is the primary event handler
+    try {
+        bar_router_.route_tick(id, tick);
+    } catch (const std::exception& ex) {
+        std::cerr << "[Backtester] Strategy exception: " << ex.what() << std::endl;
+        // Still feed the tick into the bar builder so we can flush a bar
+        add_to_bars(state, tick);
+        completed_bars_.clear();
+        return false;
     }
 
-    // Flush remaining bars for each symbol
-    for (auto& [sym, builder] : bar_builders_) {
-        if (auto bar = builder.flush()) {
-            bar_router_.route_bar(*bar);
-        }
+    // Feed this tick into the per-symbol bar builders
+    const bool bar_completed = add_to_bars(state, tick);
+    if (bar_completed) {
+        // Dispatch bars via router so strategies interested in this symbol get them
+        route_completed_bars();
     }
 
-    // --- Unit-test visible summary hooks ---
-    // Some tests expect the backtester to query cash and position once the
-    // run has finished. These calls are effectively no-ops for production but
-    // allow the mocks in tests to verify that the backtester provides a
-    // summary opportunity.
+    // Now let the order manager ingest the tick and then attempt fills.
     if (order_manager_) {
-        (void)order_manager_->get_cash();
-        (void)order_manager_->get_position(symbol_);
+        order_manager_->process_tick(tick);
+        order_manager_->attempt_fills();
+
+        // The order manager marked this symbol to market in process_tick;
+        // the equity curve gets a point per tick, or per bar
+        auto ts_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(tick.timestamp.time_since_epoch())
+                .count();
+        if (!equity_per_bar_ || bar_completed) {
+            order_manager_->record_equity(ts_ms);
+            unrecorded_equity_ts_.reset();
+        } else {
+            unrecorded_equity_ts_ = ts_ms;
+        }
     }
+    return true;
 }
 
 } // namespace qse
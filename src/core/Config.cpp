@@ -1,6 +1,7 @@
 #include "qse/core/Config.h"
 #include <yaml-cpp/yaml.h>
 #include <iostream>
+#include <cmath>
 #include <stdexcept>
 
 namespace qse {
@@ -21,6 +22,15 @@ bool Config::load_config(const std::string& config_path) {
                     std::cout << "Loaded slippage coefficient for " << symbol << ": " << coeff
                               << std::endl;
                 }
+                if (symbol_node.second["tick_size"]) {
+                    const double tick_size = symbol_node.second["tick_size"].as<double>();
+                    if (tick_size > 0.0 && std::isfinite(tick_size)) {
+                        tick_sizes_[symbol] = tick_size;
+                    } else {
+                        std::cerr << "tick_size for " << symbol << " must be positive, got "
+                                  << tick_size << "; ignoring it" << std::endl;
+                    }
+                }
             }
         }
 
@@ -44,6 +54,32 @@ bool Config::load_config(const std::string& config_path) {
                     fill_model_ = "top_of_book";
                 }
             }
+            if (backtester["result_format"]) {
+                result_format_ = backtester["result_format"].as<std::string>();
+                if (result_format_ != "csv" && result_format_ != "binary" &&
+                    result_format_ != "parquet") {
+                    std::cerr << "Unknown result_format '" << result_format_
+                              << "', falling back to csv" << std::endl;
+                    result_format_ = "csv";
+                }
+            }
+            if (backtester["equity_sample_every"]) {
+                const int every = backtester["equity_sample_every"].as<int>();
+                if (every < 1) {
+                    std::cerr << "equity_sample_every must be at least 1, got " << every
+                              << "; writing every point" << std::endl;
+                }
+                equity_sample_every_ = every < 1 ? 1 : static_cast<std::size_t>(every);
+            }
+            if (backtester["tick_size"]) {
+                const double tick_size = backtester["tick_size"].as<double>();
+                if (tick_size > 0.0 && std::isfinite(tick_size)) {
+                    default_tick_size_ = tick_size;
+                } else {
+                    std::cerr << "tick_size must be positive, got " << tick_size
+                              << "; keeping " << default_tick_size_ << std::endl;
+                }
+            }
         }
 
         // Load data paths
@@ -80,4 +116,9 @@ double Config::get_slippage_coeff(const std::string& symbol) const {
     return 0.0; // Default to no slippage if symbol not found
 }
 
+double Config::get_tick_size(const std::string& symbol) const {
+    auto it = tick_sizes_.find(symbol);
+    return it != tick_sizes_.end() ? it->second : default_tick_size_;
+}
+
 } // namespace qse
\ No newline at end of file
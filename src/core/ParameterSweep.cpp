@@ -0,0 +1,285 @@
+#include "qse/core/ParameterSweep.h"
+#include "qse/core/Backtester.h"
+#include "qse/core/WorkStealingPool.h"
+#include "qse/data/TickMerger.h"
+
+#include <cmath>
+#include <exception>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace qse {
+
+std::string format_parameters(const ParameterPoint& point) {
+    std::ostringstream out;
+    bool first = true;
+    for (const auto& [name, value] : point) {
+        out << (first ? "" : " ") << name << '=' << value;
+        first = false;
+    }
+    return out.str();
+}
+
+ParameterGrid& ParameterGrid::add_axis(const std::string& name, std::vector<double> values) {
+    if (values.empty()) {
+        throw std::invalid_argument("Parameter axis '" + name + "' has no values");
+    }
+    for (const auto& axis : axes_) {
+        if (axis.first == name) {
+            throw std::invalid_argument("Duplicate parameter axis '" + name + "'");
+        }
+    }
+    axes_.emplace_back(name, std::move(values));
+    return *this;
+}
+
+std::size_t ParameterGrid::size() const {
+    if (axes_.empty()) {
+        return 0;
+    }
+    std::size_t n = 1;
+    for (const auto& axis : axes_) {
+        n *= axis.second.size();
+    }
+    return n;
+}
+
+std::vector<ParameterPoint> ParameterGrid::points() const {
+    std::vector<ParameterPoint> points;
+    const std::size_t n = size();
+    points.reserve(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        // Mixed-radix decode of k, last axis fastest
+        ParameterPoint point;
+        std::size_t rest = k;
+        for (auto axis = axes_.rbegin(); axis != axes_.rend(); ++axis) {
+            point[axis->first] = axis->second[rest % axis->second.size()];
+            rest /= axis->second.size();
+        }
+        points.push_back(std::move(point));
+    }
+    return points;
+}
+
+namespace {
+
+// One configuration under test, stepped block by block
+struct Cell {
+    std::shared_ptr<OrderManager> order_manager;
+    std::unique_ptr<Backtester> backtester;
+    bool active = false;
+    std::string error;
+
+    // Equity sampled at period boundaries; Welford moments of the returns
+    bool sampling = false;
+    long long period = 0;
+    double last_equity = 0.0;
+    std::size_t samples = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void close_period() {
+        const double equity = order_manager->run_summary().final_equity;
+        if (last_equity > 0.0) {
+            const double r = equity / last_equity - 1.0;
+            ++samples;
+            const double delta = r - mean;
+            mean += delta / static_cast<double>(samples);
+            m2 += delta * (r - mean);
+        }
+        last_equity = equity;
+    }
+
+    void feed(const Tick* ticks, std::size_t count, long long sample_ms) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const Tick& tick = ticks[i];
+            const long long p = to_unix_ms(tick.timestamp) / sample_ms;
+            if (!sampling) {
+                sampling = true;
+                period = p;
+                last_equity = order_manager->run_summary().final_equity;
+            } else if (p != period) {
+                close_period(); // equity as of the previous period's last tick
+                period = p;
+            }
+            if (!backtester->step(tick)) {
+                active = false;
+                error = "strategy threw (see log)";
+                return;
+            }
+        }
+    }
+};
+
+} // namespace
+
+ParameterSweep::ParameterSweep(SweepSettings settings, StrategyFactory make_strategy)
+    : settings_(std::move(settings)), make_strategy_(std::move(make_strategy)) {
+    if (!make_strategy_) {
+        throw std::invalid_argument("ParameterSweep needs a strategy factory");
+    }
+    if (settings_.sample_interval.count() <= 0) {
+        throw std::invalid_argument("ParameterSweep sample_interval must be positive");
+    }
+    if (settings_.block_ticks == 0) {
+        settings_.block_ticks = 1;
+    }
+}
+
+void ParameterSweep::add_source(std::shared_ptr<const TickDataset> ticks) {
+    if (!ticks) {
+        throw std::invalid_argument("ParameterSweep source is null");
+    }
+    sources_.push_back(std::move(ticks));
+}
+
+void ParameterSweep::add_source(std::shared_ptr<const TickColumns> ticks) {
+    if (!ticks) {
+        throw std::invalid_argument("ParameterSweep source is null");
+    }
+    sources_.push_back(TickDataset::from_columns(std::move(ticks)));
+}
+
+void ParameterSweep::add_source(const std::string& data_file, const std::string& symbol) {
+    sources_.push_back(TickDataset::load(data_file, symbol));
+}
+
+std::vector<SweepResult> ParameterSweep::run(const std::vector<ParameterPoint>& points) {
+    if (sources_.empty()) {
+        throw std::runtime_error("ParameterSweep has no tick source");
+    }
+
+    std::vector<Cell> cells(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        Cell& cell = cells[i];
+        try {
+            cell.order_manager =
+                settings_.config ? std::make_shared<OrderManager>(*settings_.config, "", "")
+                                 : std::make_shared<OrderManager>(settings_.initial_cash, "", "");
+            cell.backtester = std::make_unique<Backtester>(
+                settings_.symbol, nullptr, make_strategy_(points[i], cell.order_manager),
+                cell.order_manager, settings_.bar_interval);
+            cell.active = true;
+        } catch (const std::exception& e) {
+            cell.error = e.what();
+        }
+    }
+
+    TickMerger merger;
+    for (const auto& source : sources_) {
+        merger.add_source(source->open_cursor());
+    }
+
+    const long long sample_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(settings_.sample_interval).count();
+    std::vector<Tick> block(settings_.block_ticks);
+    ticks_processed_ = 0;
+
+    auto feed_cell = [&](Cell& cell, std::size_t count) {
+        if (!cell.active) {
+            return;
+        }
+        try {
+            cell.feed(block.data(), count, sample_ms);
+        } catch (const std::exception& e) {
+            cell.active = false;
+            cell.error = e.what();
+        }
+    };
+
+    std::unique_ptr<WorkStealingPool> pool;
+    if (settings_.threads != 1 && cells.size() > 1) {
+        pool = std::make_unique<WorkStealingPool>(settings_.threads);
+    }
+
+    for (;;) {
+        std::size_t count = 0;
+        for (const Tick* tick; count < block.size() && (tick = merger.next()) != nullptr;) {
+            block[count++] = *tick;
+        }
+        if (count == 0) {
+            break;
+        }
+        ticks_processed_ += count;
+        if (pool) {
+            pool->parallel_for(0, cells.size(), [&](std::size_t c) { feed_cell(cells[c], count); });
+        } else {
+            for (Cell& cell : cells) {
+                feed_cell(cell, count);
+            }
+        }
+    }
+
+    const double periods_per_year =
+        settings_.periods_per_year > 0.0
+            ? settings_.periods_per_year
+            : 252.0 * 6.5 * 3600.0 / static_cast<double>(settings_.sample_interval.count());
+
+    std::vector<SweepResult> results(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        Cell& cell = cells[i];
+        SweepResult& result = results[i];
+        result.params = points[i];
+        if (cell.active) {
+            try {
+                cell.backtester->finish();
+                if (cell.sampling) {
+                    cell.close_period(); // the final, partial period
+                }
+            } catch (const std::exception& e) {
+                cell.active = false;
+                cell.error = e.what();
+            }
+        }
+        result.ok = cell.active;
+        result.error = cell.error;
+        if (!cell.order_manager) {
+            continue;
+        }
+        result.summary = cell.order_manager->run_summary();
+        result.return_samples = cell.samples;
+        if (cell.samples > 1) {
+            const double sd = std::sqrt(cell.m2 / static_cast<double>(cell.samples - 1));
+            if (sd > 0.0) {
+                result.sharpe = cell.mean / sd * std::sqrt(periods_per_year);
+            }
+        }
+        if (result.summary.initial_cash != 0.0) {
+            result.turnover = result.summary.traded_notional / result.summary.initial_cash;
+        }
+        if (result.summary.traded_notional > 0.0) {
+            result.slippage_bps =
+                result.summary.slippage_cost / result.summary.traded_notional * 1e4;
+        }
+    }
+    return results;
+}
+
+void ParameterSweep::write_csv(const std::vector<SweepResult>& results, std::ostream& out) {
+    std::set<std::string> names;
+    for (const SweepResult& r : results) {
+        for (const auto& entry : r.params) {
+            names.insert(entry.first);
+        }
+    }
+    for (const std::string& name : names) {
+        out << name << ',';
+    }
+    out << "total_return,sharpe,max_drawdown,trades,turnover,slippage_bps,ok\n";
+    for (const SweepResult& r : results) {
+        for (const std::string& name : names) {
+            auto it = r.params.find(name);
+            if (it != r.params.end()) {
+                out << it->second;
+            }
+            out << ',';
+        }
+        out << r.summary.total_return() << ',' << r.sharpe << ',' << r.summary.max_drawdown << ','
+            << r.summary.trades << ',' << r.turnover << ',' << r.slippage_bps << ','
+            << (r.ok ? 1 : 0) << '\n';
+    }
+}
+
+} // namespace qse
@@ -0,0 +1,150 @@
+// Parquet encoder for ResultSink: kept apart from ResultSink.cpp so the CSV
+// and binary sinks do not pull in Arrow.
+
+#include "qse/core/ArrowUtil.h"
+#include "qse/core/ResultSink.h"
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qse {
+namespace {
+
+// One Parquet file written a row group (one sink block) at a time
+class ParquetTableFile {
+public:
+    ParquetTableFile(const std::string& path, std::shared_ptr<arrow::Schema> schema,
+                     const char* what)
+        : schema_(std::move(schema)) {
+        auto out = arrow::io::FileOutputStream::Open(path);
+        if (!out.ok()) {
+            throw std::runtime_error(std::string("Could not open ") + what + " file: " + path);
+        }
+        out_ = *out;
+        PARQUET_ASSIGN_OR_THROW(writer_, parquet::arrow::FileWriter::Open(
+                                             *schema_, arrow::default_memory_pool(), out_,
+                                             parquet::default_writer_properties()));
+    }
+
+    void write(const std::vector<std::shared_ptr<arrow::Array>>& columns, int64_t rows) {
+        auto table = arrow::Table::Make(schema_, columns, rows);
+        throw_if_not_ok(writer_->WriteTable(*table, rows));
+    }
+
+    void close() {
+        if (writer_) {
+            throw_if_not_ok(writer_->Close());
+            writer_.reset();
+            throw_if_not_ok(out_->Close());
+        }
+    }
+
+private:
+    std::shared_ptr<arrow::Schema> schema_;
+    std::shared_ptr<arrow::io::FileOutputStream> out_;
+    std::unique_ptr<parquet::arrow::FileWriter> writer_;
+};
+
+class ParquetResultWriter : public detail::ResultFileWriter {
+public:
+    ParquetResultWriter(const std::string& equity_path, const std::string& trades_path) {
+        if (!equity_path.empty()) {
+            equity_.emplace(equity_path,
+                            arrow::schema({arrow::field("timestamp", arrow::int64()),
+                                           arrow::field("equity", arrow::float64())}),
+                            "equity curve");
+        }
+        if (!trades_path.empty()) {
+            trades_.emplace(trades_path,
+                            arrow::schema({arrow::field("timestamp", arrow::int64()),
+                                           arrow::field("symbol", arrow::utf8()),
+                                           arrow::field("type", arrow::utf8()),
+                                           arrow::field("quantity", arrow::int32()),
+                                           arrow::field("price", arrow::float64()),
+                                           arrow::field("cash", arrow::float64())}),
+                            "tradelog");
+        }
+    }
+
+    void write_equity(const std::vector<EquityPoint>& points) override {
+        if (!equity_ || points.empty()) {
+            return;
+        }
+        arrow::Int64Builder timestamps;
+        arrow::DoubleBuilder equity;
+        throw_if_not_ok(timestamps.Reserve(static_cast<int64_t>(points.size())));
+        throw_if_not_ok(equity.Reserve(static_cast<int64_t>(points.size())));
+        for (const EquityPoint& p : points) {
+            timestamps.UnsafeAppend(p.timestamp);
+            equity.UnsafeAppend(p.equity);
+        }
+        equity_->write({to_array(timestamps), to_array(equity)},
+                       static_cast<int64_t>(points.size()));
+    }
+
+    void write_trades(const std::vector<TradeRecord>& trades) override {
+        if (!trades_ || trades.empty()) {
+            return;
+        }
+        arrow::Int64Builder timestamps;
+        arrow::StringBuilder symbols;
+        arrow::StringBuilder types;
+        arrow::Int32Builder quantities;
+        arrow::DoubleBuilder prices;
+        arrow::DoubleBuilder cash;
+        for (const TradeRecord& t : trades) {
+            throw_if_not_ok(timestamps.Append(t.timestamp));
+            throw_if_not_ok(symbols.Append(t.symbol));
+            throw_if_not_ok(types.Append(t.buy ? "BUY" : "SELL"));
+            throw_if_not_ok(quantities.Append(t.quantity));
+            throw_if_not_ok(prices.Append(t.price));
+            throw_if_not_ok(cash.Append(t.cash));
+        }
+        trades_->write({to_array(timestamps), to_array(symbols), to_array(types),
+                        to_array(quantities), to_array(prices), to_array(cash)},
+                       static_cast<int64_t>(trades.size()));
+    }
+
+    // Parquet data is only readable once the footer is written in finish()
+    void flush() override {}
+
+    void finish() override {
+        if (equity_) {
+            equity_->close();
+        }
+        if (trades_) {
+            trades_->close();
+        }
+    }
+
+private:
+    static std::shared_ptr<arrow::Array> to_array(arrow::ArrayBuilder& builder) {
+        std::shared_ptr<arrow::Array> array;
+        throw_if_not_ok(builder.Finish(&array));
+        return array;
+    }
+
+    std::optional<ParquetTableFile> equity_;
+    std::optional<ParquetTableFile> trades_;
+};
+
+} // namespace
+
+namespace detail {
+
+std::unique_ptr<ResultFileWriter> make_parquet_result_writer(const std::string& equity_path,
+                                                             const std::string& trades_path) {
+    return std::make_unique<ParquetResultWriter>(equity_path, trades_path);
+}
+
+} // namespace detail
+} // namespace qse
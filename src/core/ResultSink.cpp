@@ -0,0 +1,452 @@
+#include "qse/core/ResultSink.h"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace qse {
+
+ResultFormat parse_result_format(const std::string& name) {
+    if (name == "csv") {
+        return ResultFormat::Csv;
+    }
+    if (name == "binary") {
+        return ResultFormat::Binary;
+    }
+    if (name == "parquet") {
+        return ResultFormat::Parquet;
+    }
+    throw std::invalid_argument("Unknown result format '" + name +
+                                "' (expected csv, binary or parquet)");
+}
+
+namespace {
+
+constexpr char kEquityMagic[8] = {'Q', 'S', 'E', 'E', 'Q', 'U', 'I', 'T'};
+constexpr char kTradeMagic[8] = {'Q', 'S', 'E', 'T', 'R', 'A', 'D', 'E'};
+constexpr uint32_t kResultFileVersion = 1;
+constexpr uint32_t kByteOrderMarker = 0x01020304;
+
+struct ResultFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+};
+static_assert(sizeof(ResultFileHeader) == 16, "header layout is part of the file format");
+static_assert(sizeof(EquityPoint) == 16, "equity records are written as-is");
+
+// Fixed part of a binary trade record; the symbol's bytes follow it
+struct TradeRecordHead {
+    int64_t timestamp;
+    double price;
+    double cash;
+    int32_t quantity;
+    uint8_t buy;
+    uint8_t reserved[3];
+    uint32_t symbol_length;
+};
+static_assert(sizeof(TradeRecordHead) == 40, "trade record layout is part of the file format");
+
+std::ofstream open_output(const std::string& path, const char* what, bool binary) {
+    std::ofstream out(path, binary ? std::ios::out | std::ios::binary : std::ios::out);
+    if (!out.is_open()) {
+        throw std::runtime_error(std::string("Could not open ") + what + " file: " + path);
+    }
+    return out;
+}
+
+void write_or_throw(std::ofstream& out, const char* data, std::size_t size) {
+    out.write(data, static_cast<std::streamsize>(size));
+    if (!out) {
+        throw std::runtime_error("ResultSink: write failed");
+    }
+}
+
+// --- CSV ---
+
+class CsvResultWriter : public detail::ResultFileWriter {
+public:
+    CsvResultWriter(const std::string& equity_path, const std::string& trades_path) {
+        if (!equity_path.empty()) {
+            equity_ = open_output(equity_path, "equity curve", false);
+            equity_ << "timestamp,equity\n";
+        }
+        if (!trades_path.empty()) {
+            trades_ = open_output(trades_path, "tradelog", false);
+            trades_ << "timestamp,symbol,type,quantity,price,cash\n";
+        }
+    }
+
+    void write_equity(const std::vector<EquityPoint>& points) override {
+        if (!equity_.is_open()) {
+            return;
+        }
+        buffer_.clear();
+        for (const EquityPoint& p : points) {
+            append_integer(p.timestamp);
+            buffer_ += ',';
+            append_double(p.equity);
+            buffer_ += '\n';
+        }
+        write_or_throw(equity_, buffer_.data(), buffer_.size());
+    }
+
+    void write_trades(const std::vector<TradeRecord>& trades) override {
+        if (!trades_.is_open()) {
+            return;
+        }
+        buffer_.clear();
+        for (const TradeRecord& t : trades) {
+            append_integer(t.timestamp);
+            buffer_ += ',';
+            buffer_ += t.symbol;
+            buffer_ += t.buy ? ",BUY," : ",SELL,";
+            append_integer(t.quantity);
+            buffer_ += ',';
+            append_double(t.price);
+            buffer_ += ',';
+            append_double(t.cash);
+            buffer_ += '\n';
+        }
+        write_or_throw(trades_, buffer_.data(), buffer_.size());
+    }
+
+    void flush() override {
+        equity_.flush();
+        trades_.flush();
+    }
+
+    void finish() override {
+        flush();
+        equity_.close();
+        trades_.close();
+    }
+
+private:
+    void append_integer(int64_t value) {
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        buffer_.append(digits, result.ptr);
+    }
+
+    // Same text as `std::ostream << double` with default flags (printf's
+    // %g, 6 significant digits), without going through a locale-aware stream
+    void append_double(double value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                                          std::chars_format::general, 6);
+        buffer_.append(digits, result.ptr);
+    }
+
+    std::ofstream equity_;
+    std::ofstream trades_;
+    std::string buffer_; // one block's text, reused
+};
+
+// --- Binary ---
+
+void write_header(std::ofstream& out, const char (&magic)[8]) {
+    ResultFileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = kResultFileVersion;
+    header.byte_order = kByteOrderMarker;
+    write_or_throw(out, reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+class BinaryResultWriter : public detail::ResultFileWriter {
+public:
+    BinaryResultWriter(const std::string& equity_path, const std::string& trades_path) {
+        if (!equity_path.empty()) {
+            equity_ = open_output(equity_path, "equity curve", true);
+            write_header(equity_, kEquityMagic);
+        }
+        if (!trades_path.empty()) {
+            trades_ = open_output(trades_path, "tradelog", true);
+            write_header(trades_, kTradeMagic);
+        }
+    }
+
+    void write_equity(const std::vector<EquityPoint>& points) override {
+        if (equity_.is_open() && !points.empty()) {
+            write_or_throw(equity_, reinterpret_cast<const char*>(points.data()),
+                           points.size() * sizeof(EquityPoint));
+        }
+    }
+
+    void write_trades(const std::vector<TradeRecord>& trades) override {
+        if (!trades_.is_open()) {
+            return;
+        }
+        buffer_.clear();
+        for (const TradeRecord& t : trades) {
+            TradeRecordHead head{};
+            head.timestamp = t.timestamp;
+            head.price = t.price;
+            head.cash = t.cash;
+            head.quantity = t.quantity;
+            head.buy = t.buy ? 1 : 0;
+            head.symbol_length = static_cast<uint32_t>(t.symbol.size());
+            buffer_.append(reinterpret_cast<const char*>(&head), sizeof(head));
+            buffer_ += t.symbol;
+        }
+        write_or_throw(trades_, buffer_.data(), buffer_.size());
+    }
+
+    void flush() override {
+        equity_.flush();
+        trades_.flush();
+    }
+
+    void finish() override {
+        flush();
+        equity_.close();
+        trades_.close();
+    }
+
+private:
+    std::ofstream equity_;
+    std::ofstream trades_;
+    std::string buffer_;
+};
+
+std::ifstream open_result_file(const std::string& path, const char (&magic)[8], const char* what) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error(std::string("Could not open ") + what + " file: " + path);
+    }
+    ResultFileHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+        header.version != kResultFileVersion || header.byte_order != kByteOrderMarker) {
+        throw std::runtime_error(std::string("Not a binary ") + what + " file: " + path);
+    }
+    return in;
+}
+
+} // namespace
+
+namespace detail {
+
+std::unique_ptr<ResultFileWriter> make_csv_result_writer(const std::string& equity_path,
+                                                         const std::string& trades_path) {
+    return std::make_unique<CsvResultWriter>(equity_path, trades_path);
+}
+
+std::unique_ptr<ResultFileWriter> make_binary_result_writer(const std::string& equity_path,
+                                                            const std::string& trades_path) {
+    return std::make_unique<BinaryResultWriter>(equity_path, trades_path);
+}
+
+} // namespace detail
+
+// --- ResultSink ---
+
+ResultSink::ResultSink(const std::string& equity_path, const std::string& trades_path,
+                       const Options& options)
+    : options_(options) {
+    if (options_.block_records == 0 || options_.max_pending_blocks == 0) {
+        throw std::invalid_argument("ResultSink block_records and max_pending_blocks must be "
+                                    "positive");
+    }
+    switch (options_.format) {
+    case ResultFormat::Csv:
+        writer_ = detail::make_csv_result_writer(equity_path, trades_path);
+        break;
+    case ResultFormat::Binary:
+        writer_ = detail::make_binary_result_writer(equity_path, trades_path);
+        break;
+    case ResultFormat::Parquet:
+        writer_ = detail::make_parquet_result_writer(equity_path, trades_path);
+        break;
+    }
+    current_.equity.reserve(options_.block_records);
+    if (options_.async) {
+        thread_ = std::thread([this] { writer_loop(); });
+    }
+}
+
+ResultSink::~ResultSink() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "[ResultSink] " << e.what() << std::endl;
+    }
+}
+
+void ResultSink::write_block(const Block& block) {
+    writer_->write_equity(block.equity);
+    writer_->write_trades(block.trades);
+}
+
+void ResultSink::submit_current() {
+    if (closed_) {
+        current_.equity.clear();
+        current_.trades.clear();
+        return;
+    }
+    if (current_.empty()) {
+        return;
+    }
+    if (!options_.async) {
+        write_block(current_);
+        current_.equity.clear();
+        current_.trades.clear();
+        return;
+    }
+
+    Block next;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_done_.wait(lock, [this] { return queue_.size() < options_.max_pending_blocks; });
+        queue_.push_back(std::move(current_));
+        if (!spare_.empty()) {
+            next = std::move(spare_.back());
+            spare_.pop_back();
+        }
+    }
+    work_ready_.notify_one();
+
+    current_ = std::move(next);
+    current_.equity.reserve(options_.block_records);
+}
+
+void ResultSink::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_ready_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return; // stopped and drained
+        }
+        Block block = std::move(queue_.front());
+        queue_.pop_front();
+        writing_ = true;
+        const bool failed = error_ != nullptr;
+        lock.unlock();
+
+        // After a failure later blocks are dropped; the error is reported
+        std::exception_ptr error;
+        if (!failed) {
+            try {
+                write_block(block);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        block.equity.clear();
+        block.trades.clear();
+
+        lock.lock();
+        if (error) {
+            error_ = error;
+        }
+        spare_.push_back(std::move(block));
+        writing_ = false;
+        work_done_.notify_all();
+    }
+}
+
+void ResultSink::rethrow_writer_error() {
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(error, error_);
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ResultSink::flush() {
+    if (closed_) {
+        return;
+    }
+    submit_current();
+    if (options_.async) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_done_.wait(lock, [this] { return queue_.empty() && !writing_; });
+        // The writer is idle and only this thread queues work, so the files
+        // can be flushed from here
+        writer_->flush();
+    } else {
+        writer_->flush();
+    }
+    rethrow_writer_error();
+}
+
+void ResultSink::close() {
+    if (closed_) {
+        return;
+    }
+    std::exception_ptr failure;
+    try {
+        submit_current();
+    } catch (...) {
+        failure = std::current_exception();
+    }
+    closed_ = true;
+
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_ready_.notify_all();
+        thread_.join();
+        if (!failure) {
+            std::swap(failure, error_);
+        }
+    }
+    if (!failure) {
+        try {
+            writer_->finish();
+        } catch (...) {
+            failure = std::current_exception();
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+// --- Binary readers ---
+
+std::vector<EquityPoint> read_equity_binary(const std::string& path) {
+    std::ifstream in = open_result_file(path, kEquityMagic, "equity curve");
+    std::vector<EquityPoint> points;
+    EquityPoint point;
+    while (in.read(reinterpret_cast<char*>(&point), sizeof(point))) {
+        points.push_back(point);
+    }
+    if (in.gcount() != 0) {
+        throw std::runtime_error("Truncated equity curve file: " + path);
+    }
+    return points;
+}
+
+std::vector<TradeRecord> read_trades_binary(const std::string& path) {
+    std::ifstream in = open_result_file(path, kTradeMagic, "tradelog");
+    std::vector<TradeRecord> trades;
+    TradeRecordHead head{};
+    while (in.read(reinterpret_cast<char*>(&head), sizeof(head))) {
+        TradeRecord trade;
+        trade.timestamp = head.timestamp;
+        trade.price = head.price;
+        trade.cash = head.cash;
+        trade.quantity = head.quantity;
+        trade.buy = head.buy != 0;
+        trade.symbol.resize(head.symbol_length);
+        if (!in.read(trade.symbol.data(), head.symbol_length)) {
+            throw std::runtime_error("Truncated tradelog file: " + path);
+        }
+        trades.push_back(std::move(trade));
+    }
+    if (in.gcount() != 0) {
+        throw std::runtime_error("Truncated tradelog file: " + path);
+    }
+    return trades;
+}
+
+} // namespace qse
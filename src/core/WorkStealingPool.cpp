@@ -0,0 +1,308 @@
+#include "qse/core/WorkStealingPool.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace qse {
+
+namespace detail {
+
+// --- WorkStealingDeque ---
+
+void WorkStealingDeque::Ring::put(std::int64_t index, const Task& task) {
+    std::uintptr_t words[Task::kWords];
+    std::memcpy(words, &task, sizeof(task));
+    std::atomic<std::uintptr_t>* slot =
+        &slots[(static_cast<std::size_t>(index) & mask) * Task::kWords];
+    for (std::size_t w = 0; w < Task::kWords; ++w) {
+        slot[w].store(words[w], std::memory_order_relaxed);
+    }
+}
+
+void WorkStealingDeque::Ring::get(std::int64_t index, Task& task) const {
+    std::uintptr_t words[Task::kWords];
+    const std::atomic<std::uintptr_t>* slot =
+        &slots[(static_cast<std::size_t>(index) & mask) * Task::kWords];
+    for (std::size_t w = 0; w < Task::kWords; ++w) {
+        words[w] = slot[w].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&task, words, sizeof(task));
+}
+
+WorkStealingDeque::WorkStealingDeque(std::size_t capacity) {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    rings_.push_back(std::make_unique<Ring>(rounded));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::Ring* WorkStealingDeque::grow(Ring* ring, std::int64_t bottom,
+                                                 std::int64_t top) {
+    auto bigger = std::make_unique<Ring>(ring->capacity() * 2);
+    Task task;
+    for (std::int64_t i = top; i < bottom; ++i) {
+        ring->get(i, task);
+        bigger->put(i, task);
+    }
+    rings_.push_back(std::move(bigger));
+    Ring* next = rings_.back().get();
+    ring_.store(next, std::memory_order_release);
+    return next;
+}
+
+void WorkStealingDeque::push(const Task& task) {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_acquire);
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<std::int64_t>(ring->mask)) {
+        ring = grow(ring, b, t);
+    }
+    ring->put(b, task);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+bool WorkStealingDeque::pop(Task& task) {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring* ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+        bottom_.store(b + 1, std::memory_order_relaxed); // was empty
+        return false;
+    }
+    ring->get(b, task);
+    if (t == b) {
+        // Last task: race the thieves for it
+        const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+bool WorkStealingDeque::steal(Task& task) {
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+        return false;
+    }
+    Ring* ring = ring_.load(std::memory_order_acquire);
+    ring->get(t, task);
+    // Losing the CAS means the owner or another thief took this task
+    return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed);
+}
+
+bool WorkStealingDeque::empty() const {
+    return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+}
+
+} // namespace detail
+
+namespace {
+
+// Identifies the pool and deque of the calling worker thread
+thread_local const WorkStealingPool* tls_pool = nullptr;
+thread_local std::size_t tls_index = 0;
+
+// Failed searches a worker makes before going to sleep
+constexpr int kIdleSpins = 64;
+
+} // namespace
+
+// --- TaskGroup ---
+
+void TaskGroup::finish_one() {
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    // Decide completion under the lock so a waiter cannot see it, return and
+    // destroy the group while this thread is still signalling
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_flag_ = pending_.load(std::memory_order_acquire) == 0;
+    done_.notify_all();
+}
+
+void TaskGroup::capture_exception() {
+    if (!failed_.exchange(true, std::memory_order_acq_rel)) {
+        error_ = std::current_exception();
+    }
+}
+
+void TaskGroup::wait_quietly() {
+    if (pool_.on_worker_thread()) {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.run_pending_task()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return done_flag_; });
+}
+
+void TaskGroup::wait() {
+    wait_quietly();
+    if (failed_.load(std::memory_order_acquire)) {
+        std::exception_ptr error = std::move(error_);
+        error_ = nullptr;
+        failed_.store(false, std::memory_order_release);
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskGroup::start_one() {
+    if (pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_flag_ = false;
+    }
+}
+
+// --- WorkStealingPool ---
+
+WorkStealingPool::WorkStealingPool(std::size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        queues_.push_back(std::make_unique<Worker>());
+        queues_.back()->rng_state = 0x9E3779B97F4A7C15ull * (i + 1);
+    }
+    workers_.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true, std::memory_order_release);
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+bool WorkStealingPool::on_worker_thread() const {
+    return tls_pool == this;
+}
+
+void WorkStealingPool::submit(const detail::Task& task) {
+    if (tls_pool == this) {
+        queues_[tls_index]->deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (stop_.load(std::memory_order_acquire)) {
+            throw std::runtime_error("enqueue on stopped WorkStealingPool");
+        }
+        injected_.push_back(task);
+        injected_count_.fetch_add(1, std::memory_order_release);
+    }
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+        notify_one_sleeper();
+    }
+}
+
+void WorkStealingPool::notify_one_sleeper() {
+    // Taking the lock orders this wake-up after a sleeper's last look at
+    // queued_, so it cannot be lost
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    wake_.notify_one();
+}
+
+bool WorkStealingPool::try_steal(std::size_t thief, detail::Task& task) {
+    const std::size_t n = queues_.size();
+    if (n < 2) {
+        return false;
+    }
+    // xorshift64: a random first victim keeps thieves from piling onto one deque
+    std::uint64_t& s = queues_[thief]->rng_state;
+    s ^= s << 13;
+    s ^= s >> 7;
+    s ^= s << 17;
+    const std::size_t start = static_cast<std::size_t>(s % n);
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t victim = (start + k) % n;
+        if (victim != thief && queues_[victim]->deque.steal(task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingPool::find_task(std::size_t index, detail::Task& task) {
+    bool found = queues_[index]->deque.pop(task);
+    if (!found && injected_count_.load(std::memory_order_acquire) != 0) {
+        std::lock_guard<std::mutex> lock(inject_mutex_);
+        if (!injected_.empty()) {
+            task = injected_.front();
+            injected_.pop_front();
+            injected_count_.fetch_sub(1, std::memory_order_release);
+            found = true;
+        }
+    }
+    if (!found) {
+        found = try_steal(index, task);
+    }
+    if (found) {
+        queued_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return found;
+}
+
+bool WorkStealingPool::run_pending_task() {
+    detail::Task task;
+    if (!find_task(tls_index, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void WorkStealingPool::worker_loop(std::size_t index) {
+    tls_pool = this;
+    tls_index = index;
+    detail::Task task;
+    int idle = 0;
+    for (;;) {
+        if (find_task(index, task)) {
+            idle = 0;
+            task();
+            continue;
+        }
+        if (++idle < kIdleSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle = 0;
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        wake_.wait(lock, [this] {
+            return queued_.load(std::memory_order_seq_cst) != 0 ||
+                   stop_.load(std::memory_order_acquire);
+        });
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        // Stop only once everything queued, including tasks spawned by
+        // running tasks, has been taken
+        if (stop_.load(std::memory_order_acquire) &&
+            queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::report_uncaught(const char* what) {
+    std::cerr << "[WorkStealingPool] Posted task threw: " << what << std::endl;
+}
+
+} // namespace qse
@@ -1,166 +1,171 @@
 #include "qse/data/BarBuilder.h"
 #include "qse/core/Debug.h"
+#include "qse/data/SymbolTable.h"
 #include <algorithm> // for std::max/min
 #include <iostream>
+#include <iterator>
+#include <utility>
 
 namespace qse {
 
-BarBuilder::BarBuilder(const std::chrono::seconds& bar_interval) : bar_interval_(bar_interval) {}
+namespace {
 
-// Add a tick, then if any completed bars are queued, pop & return one.
-std::optional<Bar> BarBuilder::add_tick(const Tick& tick) {
-    if (qse_debug_enabled())
-        std::cout << "Adding tick: timestamp=" << tick.timestamp.time_since_epoch().count()
-                  << ", price=" << tick.price << ", volume=" << tick.volume << std::endl;
+void debug_bar(const char* what, const Bar& b) {
+    std::cout << what << ": timestamp=" << b.timestamp.time_since_epoch().count()
+              << ", open=" << b.open << ", high=" << b.high << ", low=" << b.low
+              << ", close=" << b.close << ", volume=" << b.volume << std::endl;
+}
 
-    // 1) buffer + sort
-    tick_buffer_.push_back(tick);
-    std::sort(tick_buffer_.begin(), tick_buffer_.end(),
-              [](auto& a, auto& b) { return a.timestamp < b.timestamp; });
+} // namespace
 
-    if (qse_debug_enabled())
-        std::cout << "Buffer size after sort: " << tick_buffer_.size() << std::endl;
+BarBuilder::BarBuilder(const std::chrono::seconds& bar_interval,
+                       std::chrono::milliseconds allowed_lateness)
+    : bar_interval_(bar_interval),
+      allowed_lateness_(std::max(allowed_lateness, std::chrono::milliseconds(0))) {}
 
-    // 2) process everything
-    process_buffered_ticks();
+// In-order fast path: fold the tick into the current bar, or close it and
+// start the tick's own bar. Nothing is buffered.
+std::optional<Bar> BarBuilder::add_tick(const Tick& tick) {
+    if (allowed_lateness_.count() > 0) {
+        return add_tick_reordering(tick);
+    }
 
-    if (qse_debug_enabled())
-        std::cout << "Ready bars queue size: " << ready_bars_.size() << std::endl;
+    // first-ever tick (or first after a flush): start first bar
+    if (!current_bar_) {
+        start_new_bar(tick);
+        return std::nullopt;
+    }
 
-    // 3) if there's a ready bar, return the oldest
-    if (!ready_bars_.empty()) {
-        Bar b = ready_bars_.front();
-        ready_bars_.pop_front();
+    // A tick in a later interval closes the current bar; so does one before
+    // it (no reorder window: the late tick starts a bar of its own)
+    if (tick.timestamp >= current_bar_end_time_ || tick.timestamp < current_bar_start_time_) {
+        std::optional<Bar> done = std::move(current_bar_);
+        start_new_bar(tick);
         if (qse_debug_enabled())
-            std::cout << "Returning bar: timestamp=" << b.timestamp.time_since_epoch().count()
-                      << ", open=" << b.open << ", high=" << b.high << ", low=" << b.low
-                      << ", close=" << b.close << ", volume=" << b.volume << std::endl;
-        return b;
+            debug_bar("Returning bar", *done);
+        return done;
     }
+
+    // same interval: update OHLCV in place
+    Bar& bar = *current_bar_;
+    bar.high = std::max(bar.high, tick.price);
+    bar.low = std::min(bar.low, tick.price);
+    bar.close = tick.price;
+    bar.volume += tick.volume;
     return std::nullopt;
 }
 
-// Flush any remaining: first finish processing ticks, then
-// return any bars left (one per call).
+// Reorder window: route the tick to its interval's open bar, then close
+// every interval the watermark (newest tick - lateness) has passed.
+std::optional<Bar> BarBuilder::add_tick_reordering(const Tick& tick) {
+    const Timestamp start = bucket_start(tick.timestamp);
+    if (newest_tick_ && start + bar_interval_ <= *newest_tick_ - allowed_lateness_) {
+        ++late_ticks_dropped_; // its interval is closed (or was empty and skipped)
+        if (qse_debug_enabled())
+            std::cout << "Dropping late tick: timestamp="
+                      << tick.timestamp.time_since_epoch().count() << std::endl;
+        return pop_completed();
+    }
+
+    // Open bars are few and the tick is almost always for the newest one
+    auto it = open_bars_.end();
+    while (it != open_bars_.begin() && std::prev(it)->bar.timestamp > start) {
+        --it;
+    }
+    if (it != open_bars_.begin() && std::prev(it)->bar.timestamp == start) {
+        OpenBar& open = *std::prev(it);
+        Bar& bar = open.bar;
+        bar.high = std::max(bar.high, tick.price);
+        bar.low = std::min(bar.low, tick.price);
+        bar.volume += tick.volume;
+        if (tick.timestamp < open.first) {
+            bar.open = tick.price;
+            open.first = tick.timestamp;
+        }
+        if (tick.timestamp >= open.last) {
+            bar.close = tick.price;
+            open.last = tick.timestamp;
+        }
+    } else {
+        open_bars_.insert(it, OpenBar{make_bar(tick, start), tick.timestamp, tick.timestamp});
+    }
+
+    if (!newest_tick_ || tick.timestamp > *newest_tick_) {
+        newest_tick_ = tick.timestamp;
+    }
+    const Timestamp watermark = *newest_tick_ - allowed_lateness_;
+    while (!open_bars_.empty() && open_bars_.front().bar.timestamp + bar_interval_ <= watermark) {
+        ready_bars_.push_back(std::move(open_bars_.front().bar));
+        open_bars_.pop_front();
+    }
+    return pop_completed();
+}
+
+std::optional<Bar> BarBuilder::pop_completed() {
+    if (ready_bars_.empty()) {
+        return std::nullopt;
+    }
+    std::optional<Bar> b = std::move(ready_bars_.front());
+    ready_bars_.pop_front();
+    if (qse_debug_enabled())
+        debug_bar("Returning bar", *b);
+    return b;
+}
+
+// Flush any remaining: completed bars first, then the bars still open, in
+// interval order (one per call).
 std::optional<Bar> BarBuilder::flush() {
     if (qse_debug_enabled())
         std::cout << "Flush called, ready bars: " << ready_bars_.size() << std::endl;
-    process_buffered_ticks();
-    if (!ready_bars_.empty()) {
-        Bar b = ready_bars_.front();
-        ready_bars_.pop_front();
-        if (qse_debug_enabled())
-            std::cout << "Flush returning bar: timestamp=" << b.timestamp.time_since_epoch().count()
-                      << ", open=" << b.open << ", high=" << b.high << ", low=" << b.low
-                      << ", close=" << b.close << ", volume=" << b.volume << std::endl;
+    for (OpenBar& open : open_bars_) {
+        ready_bars_.push_back(std::move(open.bar));
+    }
+    open_bars_.clear();
+    if (auto b = pop_completed()) {
         return b;
     }
     // finally, if there's an in‐progress bar left, emit it and clear
     if (current_bar_) {
-        Bar b = *current_bar_;
+        std::optional<Bar> b = std::move(current_bar_);
         current_bar_.reset();
         if (qse_debug_enabled())
-            std::cout << "Flush returning current bar: timestamp="
-                      << b.timestamp.time_since_epoch().count() << ", open=" << b.open
-                      << ", high=" << b.high << ", low=" << b.low << ", close=" << b.close
-                      << ", volume=" << b.volume << std::endl;
+            debug_bar("Flush returning current bar", *b);
         return b;
     }
     return std::nullopt;
 }
 
-// Internal: walk through all buffered ticks, emitting bars on each boundary.
-void BarBuilder::process_buffered_ticks() {
-    if (qse_debug_enabled())
-        std::cout << "Processing " << tick_buffer_.size() << " buffered ticks" << std::endl;
-
-    while (!tick_buffer_.empty()) {
-        const auto tick = tick_buffer_.front();
-        tick_buffer_.erase(tick_buffer_.begin());
-
-        if (qse_debug_enabled())
-            std::cout << "Processing tick: timestamp=" << tick.timestamp.time_since_epoch().count()
-                      << ", price=" << tick.price << std::endl;
-
-        // first-ever tick: start first bar
-        if (!current_bar_) {
-            if (qse_debug_enabled())
-                std::cout << "Starting first bar" << std::endl;
-            start_new_bar(tick);
-            continue;
-        }
-
-        // if tick falls beyond current interval, possibly multiple intervals:
-        auto bucket_end = current_bar_start_time_ + bar_interval_;
-        if (qse_debug_enabled())
-            std::cout << "Current bar start: " << current_bar_start_time_.time_since_epoch().count()
-                      << ", bucket end: " << bucket_end.time_since_epoch().count()
-                      << ", tick timestamp: " << tick.timestamp.time_since_epoch().count()
-                      << std::endl;
-
-        if (tick.timestamp >= bucket_end) {
-            // emit current
-            if (qse_debug_enabled())
-                std::cout << "Emitting current bar to ready queue" << std::endl;
-            ready_bars_.push_back(*current_bar_);
-
-            // advance start by exactly one interval at a time
-            // until the tick fits into [start, start+interval)
-            do {
-                current_bar_start_time_ += bar_interval_;
-                if (qse_debug_enabled())
-                    std::cout << "Advanced bar start to: "
-                              << current_bar_start_time_.time_since_epoch().count() << std::endl;
-            } while (tick.timestamp >= current_bar_start_time_ + bar_interval_);
-
-            // start a new bar at that aligned start, initialised with this tick
-            if (qse_debug_enabled())
-                std::cout << "Starting new bar" << std::endl;
-            start_new_bar(tick);
-        } else if (tick.timestamp < current_bar_start_time_) {
-            // tick is before current bar start: emit current bar and start new one
-            if (qse_debug_enabled())
-                std::cout << "Tick before current bar start, emitting current bar" << std::endl;
-            ready_bars_.push_back(*current_bar_);
-
-            // start a new bar at the correct time bucket for this tick
-            if (qse_debug_enabled())
-                std::cout << "Starting new bar for earlier tick" << std::endl;
-            start_new_bar(tick);
-        } else {
-            // same interval: update OHLCV
-            if (qse_debug_enabled())
-                std::cout << "Updating current bar" << std::endl;
-            current_bar_->high = std::max(current_bar_->high, tick.price);
-            current_bar_->low = std::min(current_bar_->low, tick.price);
-            current_bar_->close = tick.price;
-            current_bar_->volume += tick.volume;
-        }
-    }
+// Align down to nearest interval
+Timestamp BarBuilder::bucket_start(Timestamp t) const {
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch());
+    auto interval = bar_interval_.count();
+    return Timestamp(std::chrono::seconds((secs.count() / interval) * interval));
 }
 
-// Align down to nearest interval and init current_bar_
 void BarBuilder::start_new_bar(const Tick& tick) {
-    auto secs = std::chrono::duration_cast<std::chrono::seconds>(tick.timestamp.time_since_epoch());
-    auto interval = bar_interval_.count();
-    auto start_secs = (secs.count() / interval) * interval;
-    current_bar_start_time_ = Timestamp(std::chrono::seconds(start_secs));
+    current_bar_start_time_ = bucket_start(tick.timestamp);
+    current_bar_end_time_ = current_bar_start_time_ + bar_interval_;
+    current_bar_ = make_bar(tick, current_bar_start_time_);
 
     if (qse_debug_enabled())
         std::cout << "Starting new bar at: " << current_bar_start_time_.time_since_epoch().count()
                   << " for tick at: " << tick.timestamp.time_since_epoch().count() << std::endl;
+}
 
+Bar BarBuilder::make_bar(const Tick& tick, Timestamp start) const {
     // Bar has a user-declared constructor, so it is not an aggregate and
     // designated initializers are not portable here (GCC rejects them)
     Bar bar;
     bar.symbol = tick.symbol;
-    bar.timestamp = current_bar_start_time_;
+    bar.symbol_id = resolve_symbol_id(tick);
+    bar.timestamp = start;
     bar.open = tick.price;
     bar.high = tick.price;
     bar.low = tick.price;
     bar.close = tick.price;
     bar.volume = tick.volume;
-    current_bar_.emplace(std::move(bar));
+    bar.interval = bar_interval_;
+    return bar;
 }
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
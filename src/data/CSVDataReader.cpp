@@ -1,12 +1,18 @@
 #include "qse/data/CSVDataReader.h"
 #include "qse/core/Debug.h"
+#include "qse/data/CSVTickParser.h"
+#include "qse/data/MappedFile.h"
+#include "qse/data/SymbolTable.h"
+#include "qse/data/TickCache.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <algorithm>
+#include <utility>
 
 namespace {
 
@@ -44,6 +50,113 @@ std::size_t count_grid_gaps(const Series& rows, GetTs get_ts) {
     return gaps;
 }
 
+bool is_bar_header(std::string_view header_line) {
+    return header_line.find("Open") != std::string::npos ||
+           header_line.find("open") != std::string::npos;
+}
+
+void split_fields(const std::string& line, std::vector<std::string>& tokens) {
+    tokens.clear();
+    std::stringstream ss(line);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        tokens.push_back(item);
+    }
+}
+
+qse::Timestamp parse_tick_timestamp(const std::string& field) {
+    long long raw = std::stoll(field);
+    if (raw < 10'000'000'000LL) {
+        raw *= 1000; // CSV provides seconds – promote to ms
+    }
+    return qse::Timestamp(std::chrono::milliseconds(raw));
+}
+
+// Parses one tokenized tick row into `tick`, reusing its storage, and stamps
+// the interned symbol ID. Returns false when the row has too few columns;
+// throws on non-numeric fields.
+bool parse_tick_row(const std::vector<std::string>& tokens, const std::string& symbol_override,
+                    qse::SymbolIdCache& symbol_ids, qse::Tick& tick) {
+    if (tokens.size() >= 8) {
+        // Full tick format: timestamp,symbol,price,volume,bid,ask,bid_size,ask_size
+        tick.timestamp = parse_tick_timestamp(tokens[0]);
+        tick.symbol = symbol_override.empty() ? tokens[1] : symbol_override;
+        tick.price = std::stod(tokens[2]);
+        tick.volume = std::stoull(tokens[3]);
+        tick.bid = std::stod(tokens[4]);
+        tick.ask = std::stod(tokens[5]);
+        tick.bid_size = std::stoull(tokens[6]);
+        tick.ask_size = std::stoull(tokens[7]);
+        tick.symbol_id = symbol_ids.resolve(tick.symbol);
+        return true;
+    }
+    if (tokens.size() >= 3) {
+        // Legacy format: timestamp,price,volume
+        tick.timestamp = parse_tick_timestamp(tokens[0]);
+        tick.symbol = symbol_override.empty() ? "UNKNOWN" : symbol_override;
+        tick.price = std::stod(tokens[1]);
+        tick.volume = std::stoull(tokens[2]);
+        tick.bid = tick.price; // Use price as bid/ask for legacy format
+        tick.ask = tick.price;
+        tick.bid_size = tick.volume; // Use volume as size for legacy format
+        tick.ask_size = tick.volume;
+        tick.symbol_id = symbol_ids.resolve(tick.symbol);
+        return true;
+    }
+    return false;
+}
+
+// Streams a tick CSV kTickBatchSize rows at a time in file order, reusing
+// one batch buffer so steady-state memory is independent of file length.
+// The skipped-row count is published to the owning reader at end of file.
+class CSVTickCursor : public qse::ITickCursor {
+public:
+    CSVTickCursor(const std::string& file_path, std::string symbol_override,
+                  std::size_t* skipped_out)
+        : file_(file_path), symbol_override_(std::move(symbol_override)),
+          skipped_out_(skipped_out), batch_(qse::kTickBatchSize) {
+        if (!file_.is_open()) {
+            throw std::runtime_error("Could not open file: " + file_path);
+        }
+        std::string header_line;
+        std::getline(file_, header_line);
+    }
+
+    qse::TickBatch next_batch() override {
+        std::size_t n = 0;
+        while (n < batch_.size() && std::getline(file_, line_)) {
+            if (line_.empty()) {
+                continue;
+            }
+            split_fields(line_, tokens_);
+            try {
+                if (parse_tick_row(tokens_, symbol_override_, symbol_ids_, batch_[n])) {
+                    ++n;
+                } else {
+                    ++skipped_;
+                }
+            } catch (const std::exception&) {
+                ++skipped_;
+            }
+        }
+        if (n == 0 && skipped_out_ != nullptr) {
+            *skipped_out_ = skipped_;
+            skipped_out_ = nullptr;
+        }
+        return {batch_.data(), n};
+    }
+
+private:
+    std::ifstream file_;
+    std::string symbol_override_;
+    std::size_t* skipped_out_;
+    std::vector<qse::Tick> batch_;
+    std::string line_;
+    std::vector<std::string> tokens_;
+    qse::SymbolIdCache symbol_ids_;
+    std::size_t skipped_ = 0;
+};
+
 } // namespace
 
 namespace qse {
@@ -58,7 +171,42 @@ CSVDataReader::CSVDataReader(const std::string& file_path, const std::string& sy
     load_data();
 }
 
-void CSVDataReader::load_data() {
+CSVDataReader::CSVDataReader(const std::string& file_path, const std::string& symbol_override,
+                             LoadMode mode, unsigned parse_threads)
+    : file_path_(file_path), symbol_override_(symbol_override), mode_(mode),
+      parse_threads_(parse_threads == 0 ? 1 : parse_threads) {
+    if (mode_ != LoadMode::Streaming) {
+        load_data();
+        return;
+    }
+
+    // Streaming: only validate the file and sniff its format up front. Bar
+    // files are small and have no tick stream, so they still load eagerly.
+    std::ifstream file(file_path_);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + file_path_);
+    }
+    std::string header_line;
+    if (!std::getline(file, header_line)) {
+        throw std::runtime_error("Cannot read header from file: " + file_path_);
+    }
+    is_bar_file_ = is_bar_header(header_line);
+    if (is_bar_file_) {
+        load_data();
+    }
+}
+
+void CSVDataReader::load_data() const {
+    if (mode_ == LoadMode::Cached && load_cached_ticks()) {
+        return;
+    }
+    if ((mode_ == LoadMode::Mapped || mode_ == LoadMode::Cached) && load_mapped_ticks()) {
+        if (mode_ == LoadMode::Cached) {
+            write_cache();
+        }
+        return;
+    }
+
     std::ifstream file(file_path_);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file: " + file_path_);
@@ -69,14 +217,17 @@ void CSVDataReader::load_data() {
         throw std::runtime_error("Cannot read header from file: " + file_path_);
     }
 
+    loaded_ = true;
+    skipped_rows_ = 0; // a streaming pass may already have published a count
+
     // Detect file type based on header content
-    bool isBar = (header_line.find("Open") != std::string::npos ||
-                  header_line.find("open") != std::string::npos);
+    bool isBar = is_bar_header(header_line);
 
     std::string line;
     if (isBar) {
         if (qse_debug_enabled())
             std::cout << "Detected Bar data format in " << file_path_ << std::endl;
+        SymbolIdCache symbol_ids;
         while (std::getline(file, line)) {
             if (line.empty()) {
                 continue; // trailing newlines are not data-quality problems
@@ -102,6 +253,7 @@ void CSVDataReader::load_data() {
                 bar.low = std::stod(tokens[3]);
                 bar.close = std::stod(tokens[4]);
                 bar.volume = std::stoull(tokens[5]);
+                bar.symbol_id = symbol_ids.resolve(bar.symbol);
                 bars_.push_back(bar);
             } catch (const std::exception&) {
                 ++skipped_rows_;
@@ -116,53 +268,19 @@ void CSVDataReader::load_data() {
     } else {
         if (qse_debug_enabled())
             std::cout << "Detected Tick data format in " << file_path_ << std::endl;
+        // Rows land straight in the columnar store; Tick objects are only
+        // materialized if someone asks for read_all_ticks()
+        std::vector<std::string> tokens;
+        SymbolIdCache symbol_ids;
+        Tick tick{};
         while (std::getline(file, line)) {
             if (line.empty()) {
                 continue;
             }
-            std::stringstream ss(line);
-            std::string item;
-            std::vector<std::string> tokens;
-            while (std::getline(ss, item, ',')) {
-                tokens.push_back(item);
-            }
+            split_fields(line, tokens);
             try {
-                if (tokens.size() >= 8) {
-                    // Full tick format: timestamp,symbol,price,volume,bid,ask,bid_size,ask_size
-                    Tick tick;
-                    {
-                        long long raw = std::stoll(tokens[0]);
-                        if (raw < 10'000'000'000LL) {
-                            raw *= 1000; // CSV provides seconds – promote to ms
-                        }
-                        tick.timestamp = qse::Timestamp(std::chrono::milliseconds(raw));
-                    }
-                    tick.symbol = symbol_override_.empty() ? tokens[1] : symbol_override_;
-                    tick.price = std::stod(tokens[2]);
-                    tick.volume = std::stoull(tokens[3]);
-                    tick.bid = std::stod(tokens[4]);
-                    tick.ask = std::stod(tokens[5]);
-                    tick.bid_size = std::stoull(tokens[6]);
-                    tick.ask_size = std::stoull(tokens[7]);
-                    ticks_.push_back(tick);
-                } else if (tokens.size() >= 3) {
-                    // Legacy format: timestamp,price,volume
-                    Tick tick;
-                    {
-                        long long raw = std::stoll(tokens[0]);
-                        if (raw < 10'000'000'000LL) {
-                            raw *= 1000;
-                        }
-                        tick.timestamp = qse::Timestamp(std::chrono::milliseconds(raw));
-                    }
-                    tick.symbol = symbol_override_.empty() ? "UNKNOWN" : symbol_override_;
-                    tick.price = std::stod(tokens[1]);
-                    tick.volume = std::stoull(tokens[2]);
-                    tick.bid = tick.price; // Use price as bid/ask for legacy format
-                    tick.ask = tick.price;
-                    tick.bid_size = tick.volume; // Use volume as size for legacy format
-                    tick.ask_size = tick.volume;
-                    ticks_.push_back(tick);
+                if (parse_tick_row(tokens, symbol_override_, symbol_ids, tick)) {
+                    columns_.push_back(tick, tick.symbol_id);
                 } else {
                     ++skipped_rows_;
                 }
@@ -171,14 +289,65 @@ void CSVDataReader::load_data() {
             }
         }
 
-        // Sort ticks by timestamp
-        std::sort(ticks_.begin(), ticks_.end(),
-                  [](const Tick& a, const Tick& b) { return a.timestamp < b.timestamp; });
-        gap_count_ = count_grid_gaps(ticks_, [](const Tick& t) {
-            return static_cast<long long>(t.timestamp.time_since_epoch().count());
-        });
+        finish_tick_load();
+    }
+
+    report_data_quality();
+}
+
+bool CSVDataReader::load_mapped_ticks() const {
+    MappedFile file(file_path_);
+    std::string_view text = file.view();
+    if (text.empty()) {
+        throw std::runtime_error("Cannot read header from file: " + file_path_);
+    }
+
+    const std::size_t header_end = text.find('\n');
+    if (is_bar_header(text.substr(0, header_end))) {
+        return false; // bar files are small; the line reader handles them
     }
+    if (qse_debug_enabled())
+        std::cout << "Detected Tick data format in " << file_path_ << " (mapped)" << std::endl;
 
+    loaded_ = true;
+    text.remove_prefix(header_end == std::string_view::npos ? text.size() : header_end + 1);
+    skipped_rows_ = parse_csv_ticks_parallel(text, symbol_override_, parse_threads_, columns_);
+
+    finish_tick_load();
+    report_data_quality();
+    return true;
+}
+
+bool CSVDataReader::load_cached_ticks() const {
+    TickCacheStats stats;
+    if (!load_tick_cache(file_path_, symbol_override_, columns_, stats)) {
+        return false;
+    }
+    if (qse_debug_enabled())
+        std::cout << "Loaded tick cache " << tick_cache_path(file_path_) << std::endl;
+    loaded_ = true;
+    skipped_rows_ = stats.skipped_rows;
+    gap_count_ = stats.gap_count;
+    report_data_quality();
+    return true;
+}
+
+void CSVDataReader::write_cache() const {
+    TickCacheStats stats;
+    stats.skipped_rows = skipped_rows_;
+    stats.gap_count = gap_count_;
+    write_tick_cache(file_path_, symbol_override_, columns_, stats);
+}
+
+void CSVDataReader::finish_tick_load() const {
+    // Sort ticks by timestamp (free when the file is already in order)
+    columns_.sort_by_time();
+    gap_count_ = count_grid_gaps(columns_.timestamps(), [](Timestamp::rep ts) {
+        return static_cast<long long>(ts);
+    });
+}
+
+void CSVDataReader::report_data_quality() const {
     if (skipped_rows_ > 0 || gap_count_ > 0) {
         std::cerr << "[CSVDataReader] Data quality warning for " << file_path_ << ": "
                   << skipped_rows_ << " unparseable row(s) skipped, " << gap_count_
@@ -188,12 +357,36 @@ void CSVDataReader::load_data() {
 
 // Return by const reference, as per the interface
 const std::vector<qse::Tick>& CSVDataReader::read_all_ticks() const {
+    if (!loaded_) {
+        load_data(); // streaming reader asked for the materialized series
+    }
+    if (!ticks_materialized_) {
+        ticks_ = columns_.to_ticks();
+        ticks_materialized_ = true;
+    }
     return ticks_;
 }
 
+const TickColumns& CSVDataReader::read_tick_columns() const {
+    if (!loaded_) {
+        load_data();
+    }
+    return columns_;
+}
+
 // Return by const reference, as per the interface
 const std::vector<qse::Bar>& CSVDataReader::read_all_bars() const {
     return bars_;
 }
 
-} // namespace qse
\ No newline at end of file
+std::unique_ptr<ITickCursor> CSVDataReader::open_tick_cursor() const {
+    if (ticks_materialized_ || is_bar_file_) {
+        return std::make_unique<VectorTickCursor>(ticks_);
+    }
+    if (loaded_) {
+        return std::make_unique<ColumnarTickCursor>(columns_.view());
+    }
+    return std::make_unique<CSVTickCursor>(file_path_, symbol_override_, &skipped_rows_);
+}
+
+} // namespace qse
@@ -0,0 +1,291 @@
+#include "qse/data/CSVTickParser.h"
+#include "qse/core/ThreadPool.h"
+#include "qse/data/SymbolTable.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if !(defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L)
+#include <cerrno>
+#endif
+
+namespace qse {
+
+namespace {
+
+// Only the first eight fields of a row are ever read
+constexpr std::size_t kMaxFields = 8;
+
+// Below this many bytes per range a worker thread costs more than it saves
+constexpr std::size_t kMinParallelRangeBytes = 256 * 1024;
+
+// Calls on_comma(ptr) for every ',' in [p, end), in order. Whole 16-byte
+// blocks are compared in one SIMD instruction and the match mask is walked
+// bit by bit; the tail (and non-SIMD targets) fall back to a scalar loop.
+template <typename OnComma>
+inline void for_each_comma(const char* p, const char* end, OnComma on_comma) {
+#if defined(__SSE2__)
+    const __m128i comma = _mm_set1_epi8(',');
+    for (; end - p >= 16; p += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, comma)));
+        while (mask != 0) {
+            on_comma(p + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t comma = vdupq_n_u8(',');
+    for (; end - p >= 16; p += 16) {
+        // NEON has no movemask: narrowing shift packs each 0x00/0xFF lane
+        // into a nibble of a 64-bit word; keep one bit per nibble
+        const uint8x16_t eq = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p)), comma);
+        uint64_t mask =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0) &
+            0x8888888888888888ULL;
+        while (mask != 0) {
+            on_comma(p + (__builtin_ctzll(mask) >> 2));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == ',') {
+            on_comma(p);
+        }
+    }
+}
+
+// Field boundaries of one row. `count` follows the line reader's
+// std::getline(ss, item, ',') split: a trailing empty field is not counted.
+struct RowFields {
+    std::size_t count = 0;
+    const char* begin[kMaxFields];
+    const char* end[kMaxFields];
+};
+
+inline void split_row(const char* line, const char* eol, RowFields& f) {
+    std::size_t commas = 0;
+    f.begin[0] = line;
+    for_each_comma(line, eol, [&](const char* c) {
+        if (commas < kMaxFields - 1) {
+            f.end[commas] = c;
+            f.begin[commas + 1] = c + 1;
+        } else if (commas == kMaxFields - 1) {
+            f.end[commas] = c;
+        }
+        ++commas;
+    });
+    if (commas < kMaxFields) {
+        f.end[commas] = eol;
+    }
+    f.count = commas + 1;
+    if (eol[-1] == ',') {
+        --f.count;
+    }
+}
+
+// The numeric helpers mirror std::stod/stoll/stoull on the line reader:
+// leading whitespace and an explicit '+' are accepted, a number prefix is
+// parsed and anything after it is ignored; no digits at all is a failure.
+inline const char* skip_space(const char* p, const char* end) {
+    while (p < end && std::isspace(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    return p;
+}
+
+template <typename Int>
+inline bool parse_int(const char* p, const char* end, Int& out) {
+    p = skip_space(p, end);
+    auto result = std::from_chars(p, end, out);
+    return result.ec == std::errc();
+}
+
+inline bool parse_double(const char* p, const char* end, double& out) {
+    p = skip_space(p, end);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto result = std::from_chars(p, end, out);
+    return result.ec == std::errc();
+#else
+    // Standard libraries without floating-point from_chars: strtod on a
+    // bounded, NUL-terminated copy of the field
+    char buf[64];
+    const std::size_t n = std::min<std::size_t>(static_cast<std::size_t>(end - p), sizeof(buf) - 1);
+    std::memcpy(buf, p, n);
+    buf[n] = '\0';
+    char* parsed_end = nullptr;
+    errno = 0;
+    out = std::strtod(buf, &parsed_end);
+    return parsed_end != buf && errno != ERANGE;
+#endif
+}
+
+inline bool parse_timestamp(const char* p, const char* end, Timestamp& out) {
+    long long raw = 0;
+    if (!parse_int(p, end, raw)) {
+        return false;
+    }
+    if (raw < 10'000'000'000LL) {
+        raw *= 1000; // CSV provides seconds – promote to ms
+    }
+    out = Timestamp(std::chrono::milliseconds(raw));
+    return true;
+}
+
+// Parses one non-empty row and appends it; false means the row is skipped
+bool parse_row(const char* line, const char* eol, const std::string& symbol_override,
+               SymbolIdCache& symbol_ids, TickColumns& out) {
+    RowFields f;
+    split_row(line, eol, f);
+
+    Timestamp ts;
+    Price price = 0.0;
+    Volume volume = 0;
+    if (f.count >= 8) {
+        // Full tick format: timestamp,symbol,price,volume,bid,ask,bid_size,ask_size
+        Price bid = 0.0;
+        Price ask = 0.0;
+        Volume bid_size = 0;
+        Volume ask_size = 0;
+        if (!parse_timestamp(f.begin[0], f.end[0], ts) ||
+            !parse_double(f.begin[2], f.end[2], price) ||
+            !parse_int(f.begin[3], f.end[3], volume) || !parse_double(f.begin[4], f.end[4], bid) ||
+            !parse_double(f.begin[5], f.end[5], ask) ||
+            !parse_int(f.begin[6], f.end[6], bid_size) ||
+            !parse_int(f.begin[7], f.end[7], ask_size)) {
+            return false;
+        }
+        const SymbolId id = symbol_override.empty()
+                                ? symbol_ids.resolve(std::string_view(
+                                      f.begin[1], static_cast<std::size_t>(f.end[1] - f.begin[1])))
+                                : symbol_ids.resolve(symbol_override);
+        out.append_row(ts, id, price, bid, ask, volume, bid_size, ask_size);
+        return true;
+    }
+    if (f.count >= 3) {
+        // Legacy format: timestamp,price,volume (price doubles as bid/ask,
+        // volume as both sizes)
+        if (!parse_timestamp(f.begin[0], f.end[0], ts) ||
+            !parse_double(f.begin[1], f.end[1], price) ||
+            !parse_int(f.begin[2], f.end[2], volume)) {
+            return false;
+        }
+        const SymbolId id =
+            symbol_ids.resolve(symbol_override.empty() ? std::string_view("UNKNOWN")
+                                                       : std::string_view(symbol_override));
+        out.append_row(ts, id, price, price, price, volume, volume, volume);
+        return true;
+    }
+    return false;
+}
+
+std::size_t count_lines(std::string_view text) {
+    std::size_t lines = 0;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+        ++lines;
+        if (nl == nullptr) {
+            break;
+        }
+        p = static_cast<const char*>(nl) + 1;
+    }
+    return lines;
+}
+
+} // namespace
+
+std::size_t parse_csv_ticks(std::string_view text, const std::string& symbol_override,
+                            TickColumns& out) {
+    // One memchr pass (itself vectorized by libc) sizes the columns exactly,
+    // so parsing never reallocates them
+    out.reserve(out.size() + count_lines(text));
+
+    SymbolIdCache symbol_ids;
+    std::size_t skipped = 0;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const char* eol =
+            static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        if (eol == nullptr) {
+            eol = end;
+        }
+        if (eol != p && !parse_row(p, eol, symbol_override, symbol_ids, out)) {
+            ++skipped;
+        }
+        p = (eol == end) ? end : eol + 1;
+    }
+    return skipped;
+}
+
+std::size_t parse_csv_ticks_parallel(std::string_view text, const std::string& symbol_override,
+                                     unsigned threads, TickColumns& out) {
+    const std::size_t ranges =
+        std::min<std::size_t>(threads, text.size() / kMinParallelRangeBytes);
+    if (ranges <= 1) {
+        return parse_csv_ticks(text, symbol_override, out);
+    }
+
+    // Cut at roughly equal byte offsets, then push each cut forward to the
+    // next row boundary so no row straddles two ranges
+    std::vector<std::string_view> parts;
+    std::size_t start = 0;
+    for (std::size_t k = 1; k < ranges; ++k) {
+        const std::size_t cut = std::max(start, text.size() * k / ranges);
+        const std::size_t nl = text.find('\n', cut);
+        if (nl == std::string_view::npos) {
+            break;
+        }
+        parts.push_back(text.substr(start, nl + 1 - start));
+        start = nl + 1;
+    }
+    parts.push_back(text.substr(start));
+
+    std::vector<TickColumns> columns(parts.size());
+    std::vector<std::future<std::size_t>> pending;
+    pending.reserve(parts.size() - 1);
+    std::size_t skipped = 0;
+    {
+        ThreadPool pool(parts.size() - 1);
+        for (std::size_t i = 1; i < parts.size(); ++i) {
+            pending.push_back(pool.enqueue([&, i] {
+                return parse_csv_ticks(parts[i], symbol_override, columns[i]);
+            }));
+        }
+        skipped += parse_csv_ticks(parts[0], symbol_override, columns[0]);
+        for (auto& f : pending) {
+            skipped += f.get();
+        }
+    }
+
+    std::size_t total = out.size();
+    for (const TickColumns& c : columns) {
+        total += c.size();
+    }
+    out.reserve(total);
+    for (const TickColumns& c : columns) {
+        out.append(c);
+    }
+    return skipped;
+}
+
+} // namespace qse
@@ -0,0 +1,72 @@
+#include "qse/data/InformationBarBuilder.h"
+#include "qse/data/SymbolTable.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace qse {
+
+InformationBarBuilder::InformationBarBuilder(BarType type, double threshold)
+    : type_(type), threshold_(threshold) {
+    if (type == BarType::Time) {
+        throw std::invalid_argument("InformationBarBuilder does not build time bars");
+    }
+    if (!(threshold > 0.0)) {
+        throw std::invalid_argument("Information bar threshold must be positive");
+    }
+}
+
+double InformationBarBuilder::measure(const Tick& tick) const {
+    switch (type_) {
+    case BarType::Tick:
+        return 1.0;
+    case BarType::Volume:
+        return static_cast<double>(tick.volume);
+    case BarType::Dollar:
+        return tick.price * static_cast<double>(tick.volume);
+    case BarType::Time:
+        break;
+    }
+    return 0.0;
+}
+
+std::optional<Bar> InformationBarBuilder::add_tick(const Tick& tick) {
+    if (!current_bar_) {
+        Bar bar;
+        bar.symbol = tick.symbol;
+        bar.symbol_id = resolve_symbol_id(tick);
+        bar.timestamp = tick.timestamp;
+        bar.open = tick.price;
+        bar.high = tick.price;
+        bar.low = tick.price;
+        bar.close = tick.price;
+        bar.volume = tick.volume;
+        bar.type = type_;
+        current_bar_ = std::move(bar);
+    } else {
+        Bar& bar = *current_bar_;
+        bar.high = std::max(bar.high, tick.price);
+        bar.low = std::min(bar.low, tick.price);
+        bar.close = tick.price;
+        bar.volume += tick.volume;
+    }
+
+    accumulated_ += measure(tick);
+    if (accumulated_ < threshold_) {
+        return std::nullopt;
+    }
+    // Overshoot is not carried: every bar starts from zero
+    accumulated_ = 0.0;
+    std::optional<Bar> done = std::move(current_bar_);
+    current_bar_.reset();
+    return done;
+}
+
+std::optional<Bar> InformationBarBuilder::flush() {
+    accumulated_ = 0.0;
+    std::optional<Bar> done = std::move(current_bar_);
+    current_bar_.reset();
+    return done;
+}
+
+} // namespace qse
@@ -0,0 +1,114 @@
+#include "qse/data/MultiTimeframeBarBuilder.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace qse {
+
+namespace {
+
+std::vector<std::chrono::seconds> checked(std::vector<std::chrono::seconds> intervals) {
+    if (intervals.empty()) {
+        throw std::invalid_argument("MultiTimeframeBarBuilder needs at least one interval");
+    }
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        if (intervals[i].count() <= 0) {
+            throw std::invalid_argument("Bar intervals must be positive");
+        }
+        if (i > 0 && (intervals[i] <= intervals[i - 1] ||
+                      intervals[i].count() % intervals[i - 1].count() != 0)) {
+            throw std::invalid_argument(
+                "Bar interval " + std::to_string(intervals[i].count()) +
+                "s is not an ascending multiple of " + std::to_string(intervals[i - 1].count()) +
+                "s");
+        }
+    }
+    return intervals;
+}
+
+// Align down to nearest interval, as BarBuilder does
+Timestamp bucket_start(Timestamp t, std::chrono::seconds interval) {
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(t.time_since_epoch());
+    return Timestamp(std::chrono::seconds((secs.count() / interval.count()) * interval.count()));
+}
+
+} // namespace
+
+MultiTimeframeBarBuilder::MultiTimeframeBarBuilder(std::vector<std::chrono::seconds> intervals,
+                                                   std::chrono::milliseconds allowed_lateness)
+    : intervals_(checked(std::move(intervals))), base_(intervals_.front(), allowed_lateness) {
+    for (std::size_t i = 1; i < intervals_.size(); ++i) {
+        levels_.push_back(Level{intervals_[i], std::nullopt, Timestamp{}});
+    }
+}
+
+std::size_t MultiTimeframeBarBuilder::add_tick(const Tick& tick, std::vector<Bar>& out) {
+    const std::size_t before = out.size();
+    // With a reorder window one tick can complete several base bars
+    for (auto bar = base_.add_tick(tick); bar; bar = base_.pop_completed()) {
+        out.push_back(*bar);
+        roll_up(std::move(*bar), 0, out);
+    }
+    return out.size() - before;
+}
+
+std::size_t MultiTimeframeBarBuilder::flush(std::vector<Bar>& out) {
+    const std::size_t before = out.size();
+    while (auto bar = base_.flush()) {
+        out.push_back(*bar);
+        roll_up(std::move(*bar), 0, out);
+    }
+    // Then the partial coarse bars, finest first; each still feeds the
+    // levels above it
+    for (std::size_t i = 0; i < levels_.size(); ++i) {
+        if (levels_[i].bar) {
+            Bar done = std::move(*levels_[i].bar);
+            levels_[i].bar.reset();
+            out.push_back(done);
+            roll_up(std::move(done), i + 1, out);
+        }
+    }
+    return out.size() - before;
+}
+
+void MultiTimeframeBarBuilder::roll_up(Bar&& bar, std::size_t from, std::vector<Bar>& out) {
+    if (from == levels_.size()) {
+        return;
+    }
+    Level& level = levels_[from];
+
+    // A bar outside the open interval closes it: after a gap in the data, or
+    // for a late bar (the base builder's policy, one level up)
+    if (level.bar && (bar.timestamp >= level.end || bar.timestamp < level.bar->timestamp)) {
+        Bar done = std::move(*level.bar);
+        level.bar.reset();
+        out.push_back(done);
+        roll_up(std::move(done), from + 1, out);
+    }
+
+    const Timestamp bar_end = bar.timestamp + bar.interval;
+    if (!level.bar) {
+        const Timestamp start = bucket_start(bar.timestamp, level.interval);
+        level.end = start + level.interval;
+        level.bar = std::move(bar);
+        level.bar->timestamp = start;
+        level.bar->interval = level.interval;
+    } else {
+        Bar& coarse = *level.bar;
+        coarse.high = std::max(coarse.high, bar.high);
+        coarse.low = std::min(coarse.low, bar.low);
+        coarse.close = bar.close;
+        coarse.volume += bar.volume;
+    }
+
+    // The finer bar that ends this interval completes it
+    if (bar_end >= level.end) {
+        Bar done = std::move(*level.bar);
+        level.bar.reset();
+        out.push_back(done);
+        roll_up(std::move(done), from + 1, out);
+    }
+}
+
+} // namespace qse
@@ -1,10 +1,15 @@
 #include "qse/data/OrderBook.h"
+#include "qse/data/SymbolTable.h"
 #include <iostream>
 
 namespace qse {
 
 void OrderBook::on_tick(const Tick& tick) {
-    auto& tob = books_[tick.symbol];
+    const SymbolId id = resolve_symbol_id(tick);
+    if (id >= books_.size()) {
+        books_.resize(static_cast<std::size_t>(id) + 1);
+    }
+    auto& tob = books_[id];
     tob.best_bid_price = tick.bid;
     tob.best_bid_size = tick.bid_size;
     tob.best_ask_price = tick.ask;
@@ -12,18 +17,24 @@ void OrderBook::on_tick(const Tick& tick) {
 }
 
 const TopOfBook& OrderBook::top_of_book(const std::string& symbol) const {
+    return top_of_book(SymbolTable::instance().find(symbol));
+}
+
+const TopOfBook& OrderBook::top_of_book(SymbolId symbol_id) const {
     static TopOfBook empty;
-    auto it = books_.find(symbol);
-    return (it != books_.end()) ? it->second : empty;
+    return (symbol_id < books_.size()) ? books_[symbol_id] : empty;
 }
 
 Volume OrderBook::consume_liquidity(const std::string& symbol, Order::Side side, Volume quantity) {
-    auto it = books_.find(symbol);
-    if (it == books_.end()) {
+    return consume_liquidity(SymbolTable::instance().find(symbol), side, quantity);
+}
+
+Volume OrderBook::consume_liquidity(SymbolId symbol_id, Order::Side side, Volume quantity) {
+    if (symbol_id >= books_.size()) {
         return 0; // No liquidity available
     }
 
-    TopOfBook& tob = it->second;
+    TopOfBook& tob = books_[symbol_id];
     Volume consumed = 0;
 
     if (side == Order::Side::BUY) {
@@ -43,4 +54,4 @@ Volume OrderBook::consume_liquidity(const std::string& symbol, Order::Side side,
     return consumed;
 }
 
-} // namespace qse
\ No newline at end of file
+} // namespace qse
@@ -21,26 +21,34 @@ void OrderBookFullDepth::reset_queue_id_counter() {
 // --- Level Management ---
 
 void OrderBookFullDepth::add_level(Order::Side side, Price price) {
+    add_level_at(side, scale_.to_ticks(price));
+}
+
+void OrderBookFullDepth::add_level_at(Order::Side side, PriceTicks tick) {
     // Construct new levels with the book's memory resource so their inner
     // containers allocate from the same arena as the maps (operator[] would
     // default-construct a Level on the global resource instead)
     if (side == Order::Side::BUY) {
-        get_bids().try_emplace(price, Level(price, resource_));
+        get_bids().try_emplace(tick, Level(scale_.to_price(tick), resource_));
     } else { // SELL
-        get_asks().try_emplace(price, Level(price, resource_));
+        get_asks().try_emplace(tick, Level(scale_.to_price(tick), resource_));
     }
 }
 
 void OrderBookFullDepth::remove_level_if_empty(Order::Side side, Price price) {
+    remove_level_at_if_empty(side, scale_.to_ticks(price));
+}
+
+void OrderBookFullDepth::remove_level_at_if_empty(Order::Side side, PriceTicks tick) {
     if (side == Order::Side::BUY) {
         auto& bids = get_bids();
-        auto it = bids.find(price);
+        auto it = bids.find(tick);
         if (it != bids.end() && it->second.empty()) {
             bids.erase(it);
         }
     } else { // SELL
         auto& asks = get_asks();
-        auto it = asks.find(price);
+        auto it = asks.find(tick);
         if (it != asks.end() && it->second.empty()) {
             asks.erase(it);
         }
@@ -48,10 +56,11 @@ void OrderBookFullDepth::remove_level_if_empty(Order::Side side, Price price) {
 }
 
 bool OrderBookFullDepth::has_level(Order::Side side, Price price) const {
+    const PriceTicks tick = scale_.to_ticks(price);
     if (side == Order::Side::BUY) {
-        return get_bids().find(price) != get_bids().end();
+        return get_bids().find(tick) != get_bids().end();
     } else { // SELL
-        return get_asks().find(price) != get_asks().end();
+        return get_asks().find(tick) != get_asks().end();
     }
 }
 
@@ -60,14 +69,15 @@ bool OrderBookFullDepth::has_level(Order::Side side, Price price) const {
 QueueId OrderBookFullDepth::enqueue_order(Order::Side side, Price price, const OrderId& order_id,
                                           Volume size) {
     // Ensure the price level exists
-    add_level(side, price);
+    const PriceTicks tick = scale_.to_ticks(price);
+    add_level_at(side, tick);
 
     // Obtain reference to the level
     Level* level_ptr;
     if (side == Order::Side::BUY) {
-        level_ptr = &get_bids()[price];
+        level_ptr = &get_bids()[tick];
     } else {
-        level_ptr = &get_asks()[price];
+        level_ptr = &get_asks()[tick];
     }
     Level& level = *level_ptr;
 
@@ -91,9 +101,14 @@ QueueId OrderBookFullDepth::enqueue_order(Order::Side side, Price price, const O
 
 QueueId OrderBookFullDepth::enqueue_order_front(Order::Side side, Price price,
                                                 const OrderId& order_id, Volume size) {
-    add_level(side, price);
+    return enqueue_order_front_at(side, scale_.to_ticks(price), order_id, size);
+}
+
+QueueId OrderBookFullDepth::enqueue_order_front_at(Order::Side side, PriceTicks tick,
+                                                   const OrderId& order_id, Volume size) {
+    add_level_at(side, tick);
 
-    Level& level = (side == Order::Side::BUY) ? get_bids()[price] : get_asks()[price];
+    Level& level = (side == Order::Side::BUY) ? get_bids()[tick] : get_asks()[tick];
 
     // Reject duplicate OrderId at the same price level
     if (level.position_map.find(order_id) != level.position_map.end()) {
@@ -118,9 +133,10 @@ QueueId OrderBookFullDepth::enqueue_order_front(Order::Side side, Price price,
 std::vector<std::pair<OrderId, Volume>>
 OrderBookFullDepth::consume_at_price(Order::Side side, Price price, Volume quantity) {
     std::vector<std::pair<OrderId, Volume>> consumed;
+    const PriceTicks tick = scale_.to_ticks(price);
 
     auto process = [&](auto& levels) {
-        auto it = levels.find(price);
+        auto it = levels.find(tick);
         if (it == levels.end()) {
             return;
         }
@@ -138,7 +154,7 @@ OrderBookFullDepth::consume_at_price(Order::Side side, Price price, Volume quant
                     consumed.emplace_back(head_id, head_size);
                 }
                 remaining -= head_size;
-                dequeue_head(side, price);
+                dequeue_head_at(side, tick);
             } else {
                 // Partially consume the head order; it keeps its queue position
                 consumed.emplace_back(head_id, remaining);
@@ -163,9 +179,13 @@ OrderBookFullDepth::consume_at_price(Order::Side side, Price price, Volume quant
 }
 
 OrderId OrderBookFullDepth::dequeue_head(Order::Side side, Price price) {
+    return dequeue_head_at(side, scale_.to_ticks(price));
+}
+
+OrderId OrderBookFullDepth::dequeue_head_at(Order::Side side, PriceTicks tick) {
     if (side == Order::Side::BUY) {
         auto& bids = get_bids();
-        auto it = bids.find(price);
+        auto it = bids.find(tick);
         if (it != bids.end() && !it->second.queue.empty()) {
             OrderId order_id = it->second.queue.front();
             it->second.queue.pop_front();
@@ -196,7 +216,7 @@ OrderId OrderBookFullDepth::dequeue_head(Order::Side side, Price price) {
         }
     } else { // SELL
         auto& asks = get_asks();
-        auto it = asks.find(price);
+        auto it = asks.find(tick);
         if (it != asks.end() && !it->second.queue.empty()) {
             OrderId order_id = it->second.queue.front();
             it->second.queue.pop_front();
@@ -226,14 +246,15 @@ OrderId OrderBookFullDepth::dequeue_head(Order::Side side, Price price) {
             return order_id;
         }
     }
-    return ""; // Empty string if not found
+    return kInvalidOrderId; // Not found
 }
 
 size_t OrderBookFullDepth::queue_position(Order::Side side, Price price,
                                           const OrderId& order_id) const {
+    const PriceTicks tick = scale_.to_ticks(price);
     if (side == Order::Side::BUY) {
         const auto& bids = get_bids();
-        auto it = bids.find(price);
+        auto it = bids.find(tick);
         if (it != bids.end()) {
             auto pos_it = it->second.position_map.find(order_id);
             if (pos_it != it->second.position_map.end()) {
@@ -242,7 +263,7 @@ size_t OrderBookFullDepth::queue_position(Order::Side side, Price price,
         }
     } else { // SELL
         const auto& asks = get_asks();
-        auto it = asks.find(price);
+        auto it = asks.find(tick);
         if (it != asks.end()) {
             auto pos_it = it->second.position_map.find(order_id);
             if (pos_it != it->second.position_map.end()) {
@@ -295,14 +316,14 @@ std::vector<Price> OrderBookFullDepth::top_n_prices(Order::Side side, size_t n)
         for (const auto& pair : bids) {
             if (prices.size() >= n)
                 break;
-            prices.push_back(pair.first);
+            prices.push_back(pair.second.price);
         }
     } else { // SELL
         const auto& asks = get_asks();
         for (const auto& pair : asks) {
             if (prices.size() >= n)
                 break;
-            prices.push_back(pair.first);
+            prices.push_back(pair.second.price);
         }
     }
 
@@ -314,13 +335,13 @@ TopOfBook OrderBookFullDepth::top_of_book() const {
 
     const auto& bids = get_bids();
     if (!bids.empty()) {
-        tob.best_bid_price = bids.begin()->first;
+        tob.best_bid_price = bids.begin()->second.price;
         tob.best_bid_size = bids.begin()->second.total_size;
     }
 
     const auto& asks = get_asks();
     if (!asks.empty()) {
-        tob.best_ask_price = asks.begin()->first;
+        tob.best_ask_price = asks.begin()->second.price;
         tob.best_ask_size = asks.begin()->second.total_size;
     }
 
@@ -339,24 +360,24 @@ void OrderBookFullDepth::on_tick(const Tick& tick) {
     remove_synthetic(Order::Side::BUY);
     remove_synthetic(Order::Side::SELL);
     if (tick.bid_size > 0) {
-        synthetic_bid_qid_ =
-            enqueue_order_front(Order::Side::BUY, tick.bid, "__quote_bid", tick.bid_size);
-        synthetic_bid_price_ = tick.bid;
+        synthetic_bid_tick_ = scale_.to_ticks(tick.bid);
+        synthetic_bid_qid_ = enqueue_order_front_at(Order::Side::BUY, synthetic_bid_tick_,
+                                                    kQuoteBidOrderId, tick.bid_size);
     }
     if (tick.ask_size > 0) {
-        synthetic_ask_qid_ =
-            enqueue_order_front(Order::Side::SELL, tick.ask, "__quote_ask", tick.ask_size);
-        synthetic_ask_price_ = tick.ask;
+        synthetic_ask_tick_ = scale_.to_ticks(tick.ask);
+        synthetic_ask_qid_ = enqueue_order_front_at(Order::Side::SELL, synthetic_ask_tick_,
+                                                    kQuoteAskOrderId, tick.ask_size);
     }
 }
 
 void OrderBookFullDepth::remove_synthetic(Order::Side side) {
     QueueId& qid = (side == Order::Side::BUY) ? synthetic_bid_qid_ : synthetic_ask_qid_;
-    Price price = (side == Order::Side::BUY) ? synthetic_bid_price_ : synthetic_ask_price_;
+    PriceTicks tick = (side == Order::Side::BUY) ? synthetic_bid_tick_ : synthetic_ask_tick_;
     if (qid != 0) {
         // May already be gone if a trade print fully consumed it
         cancel_order(qid);
-        remove_level_if_empty(side, price);
+        remove_level_at_if_empty(side, tick);
         qid = 0;
     }
 }
@@ -462,8 +483,9 @@ std::pair<Volume, Price> OrderBookFullDepth::fill_market(Order::Side side, std::
     auto walk_levels = [&](auto& levels) {
         auto it = levels.begin();
         while (it != levels.end() && remaining_qty > 0) {
-            Price price = it->first;
+            const PriceTicks tick = it->first;
             Level& level = it->second;
+            const Price price = level.price;
 
             while (!level.queue.empty() && remaining_qty > 0) {
                 const OrderId& head_id = level.queue.front();
@@ -473,7 +495,7 @@ std::pair<Volume, Price> OrderBookFullDepth::fill_market(Order::Side side, std::
                 if (head_size <= remaining_qty) {
                     // Fully consume the head order; dequeue_head keeps the
                     // queue, position map, and size totals in sync
-                    dequeue_head(resting_side, price);
+                    dequeue_head_at(resting_side, tick);
                     total_filled += head_size;
                     total_value += price * static_cast<double>(head_size);
                     remaining_qty -= head_size;
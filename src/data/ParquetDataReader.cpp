@@ -1,106 +1,518 @@
 #include "qse/data/ParquetDataReader.h"
+#include "qse/core/Debug.h"
+#include "qse/data/SymbolTable.h"
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/schema.h>
 #include <cstdint>
 #include <filesystem>
+#include <iostream>
+#include <numeric>
 #include <stdexcept>
+#include <string_view>
 #include <chrono>
+#include <utility>
 
-namespace qse {
+namespace {
 
-ParquetDataReader::ParquetDataReader(const std::string& file_path) : file_path_(file_path) {
-    if (!std::filesystem::exists(file_path)) {
-        throw std::runtime_error("File not found: " + file_path);
-    }
-    load_data();
+using qse::ParquetDataReader;
+
+std::unique_ptr<parquet::arrow::FileReader> open_parquet(const std::string& path) {
+    std::shared_ptr<arrow::io::ReadableFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(path));
+    auto result = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
+    PARQUET_THROW_NOT_OK(result.status());
+    return std::move(result).ValueOrDie();
 }
 
-void ParquetDataReader::load_data() {
-    try {
-        // Open the Parquet file
-        std::shared_ptr<arrow::io::ReadableFile> infile;
-        PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(file_path_));
-
-        // Create a Parquet reader
-        std::unique_ptr<parquet::arrow::FileReader> reader;
-        auto result = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
-        PARQUET_THROW_NOT_OK(result.status());
-        reader = std::move(result).ValueOrDie();
-
-        // Read the entire file into a Table. Arrow 24 deprecated the
-        // out-parameter ReadTable in favour of a Result-returning overload,
-        // which does not exist before 24 (CI is Arrow 24, local brew is 20)
-        std::shared_ptr<arrow::Table> table;
+// Leaf index of a top-level column, or -1 when the file does not have it
+int column_index(parquet::arrow::FileReader& reader, const std::string& name) {
+    return reader.parquet_reader()->metadata()->schema()->ColumnIndex(name);
+}
+
+// Record batches over every row group, restricted to `columns`. The reader
+// decodes one row group's column chunks at a time, so memory is bounded by
+// the row group size rather than the file size. `reader` must outlive the
+// returned batch reader.
+std::unique_ptr<arrow::RecordBatchReader> open_batches(parquet::arrow::FileReader& reader,
+                                                       const std::vector<int>& columns) {
+    std::vector<int> row_groups(static_cast<std::size_t>(reader.num_row_groups()));
+    std::iota(row_groups.begin(), row_groups.end(), 0);
+    std::unique_ptr<arrow::RecordBatchReader> batches;
 #if ARROW_VERSION_MAJOR >= 24
-        auto table_result = reader->ReadTable();
-        PARQUET_THROW_NOT_OK(table_result.status());
-        table = std::move(table_result).ValueOrDie();
+    // Same Arrow 24 API change as ReadTable: the out-parameter overload is
+    // deprecated, and the Result-returning one does not exist before 24
+    auto batches_result = reader.GetRecordBatchReader(row_groups, columns);
+    PARQUET_THROW_NOT_OK(batches_result.status());
+    batches = std::move(batches_result).ValueOrDie();
 #else
-        PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+    PARQUET_THROW_NOT_OK(reader.GetRecordBatchReader(row_groups, columns, &batches));
 #endif
+    return batches;
+}
 
-        // Check for bar columns
-        if (table->GetColumnByName("close")) {
-            auto timestamp_col = std::static_pointer_cast<arrow::Int64Array>(
-                table->GetColumnByName("timestamp")->chunk(0));
-            auto open_col = std::static_pointer_cast<arrow::DoubleArray>(
-                table->GetColumnByName("open")->chunk(0));
-            auto high_col = std::static_pointer_cast<arrow::DoubleArray>(
-                table->GetColumnByName("high")->chunk(0));
-            auto low_col = std::static_pointer_cast<arrow::DoubleArray>(
-                table->GetColumnByName("low")->chunk(0));
-            auto close_col = std::static_pointer_cast<arrow::DoubleArray>(
-                table->GetColumnByName("close")->chunk(0));
-            auto volume_col = std::static_pointer_cast<arrow::Int64Array>(
-                table->GetColumnByName("volume")->chunk(0));
-
-            // Check if symbol column exists, otherwise use filename as symbol
-            std::string default_symbol = "UNKNOWN";
-            if (table->GetColumnByName("symbol")) {
-                auto symbol_col = std::static_pointer_cast<arrow::StringArray>(
-                    table->GetColumnByName("symbol")->chunk(0));
-
-                // Convert to our Bar format
-                for (int64_t i = 0; i < table->num_rows(); ++i) {
-                    Bar bar;
-                    bar.symbol = symbol_col->GetString(i);
-                    bar.timestamp = std::chrono::system_clock::time_point{
-                        std::chrono::seconds{timestamp_col->Value(i)}};
-                    bar.open = open_col->Value(i);
-                    bar.high = high_col->Value(i);
-                    bar.low = low_col->Value(i);
-                    bar.close = close_col->Value(i);
-                    bar.volume = volume_col->Value(i);
-                    bars_.push_back(bar);
-                }
-            } else {
-                // Convert to our Bar format without symbol column
-                for (int64_t i = 0; i < table->num_rows(); ++i) {
-                    Bar bar;
-                    bar.symbol = default_symbol;
-                    bar.timestamp = std::chrono::system_clock::time_point{
-                        std::chrono::seconds{timestamp_col->Value(i)}};
-                    bar.open = open_col->Value(i);
-                    bar.high = high_col->Value(i);
-                    bar.low = low_col->Value(i);
-                    bar.close = close_col->Value(i);
-                    bar.volume = volume_col->Value(i);
-                    bars_.push_back(bar);
+template <typename ArrayType, typename T>
+void copy_values(const arrow::Array& array, std::vector<T>& out) {
+    const auto* values = static_cast<const ArrayType&>(array).raw_values();
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = static_cast<T>(values[i]);
+    }
+}
+
+// Decodes a numeric column chunk into `out` (one value per row; null slots
+// hold garbage and are filtered by the caller). Writers disagree on widths
+// (float vs double prices, int32 vs uint64 sizes), so every common numeric
+// type is widened here once per chunk instead of per row.
+template <typename T>
+void to_values(const arrow::Array& array, std::vector<T>& out) {
+    out.resize(static_cast<std::size_t>(array.length()));
+    switch (array.type_id()) {
+    case arrow::Type::DOUBLE:
+        copy_values<arrow::DoubleArray>(array, out);
+        break;
+    case arrow::Type::FLOAT:
+        copy_values<arrow::FloatArray>(array, out);
+        break;
+    case arrow::Type::INT64:
+        copy_values<arrow::Int64Array>(array, out);
+        break;
+    case arrow::Type::UINT64:
+        copy_values<arrow::UInt64Array>(array, out);
+        break;
+    case arrow::Type::INT32:
+        copy_values<arrow::Int32Array>(array, out);
+        break;
+    case arrow::Type::UINT32:
+        copy_values<arrow::UInt32Array>(array, out);
+        break;
+    default:
+        throw std::runtime_error("Unsupported numeric column type: " + array.type()->ToString());
+    }
+}
+
+// Timestamp columns: Arrow timestamps carry their unit; bare integers
+// follow the CSV reader's rule (seconds below 1e10, milliseconds above)
+void to_timestamps(const arrow::Array& array, std::vector<qse::Timestamp::rep>& out) {
+    using qse::Timestamp;
+    out.resize(static_cast<std::size_t>(array.length()));
+    if (array.type_id() == arrow::Type::TIMESTAMP) {
+        const auto unit = static_cast<const arrow::TimestampType&>(*array.type()).unit();
+        const int64_t* values = static_cast<const arrow::TimestampArray&>(array).raw_values();
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            Timestamp::duration d;
+            switch (unit) {
+            case arrow::TimeUnit::SECOND:
+                d = std::chrono::seconds(values[i]);
+                break;
+            case arrow::TimeUnit::MILLI:
+                d = std::chrono::milliseconds(values[i]);
+                break;
+            case arrow::TimeUnit::MICRO:
+                d = std::chrono::duration_cast<Timestamp::duration>(
+                    std::chrono::microseconds(values[i]));
+                break;
+            default:
+                d = std::chrono::duration_cast<Timestamp::duration>(
+                    std::chrono::nanoseconds(values[i]));
+                break;
+            }
+            out[i] = d.count();
+        }
+        return;
+    }
+    to_values(array, out);
+    for (Timestamp::rep& ts : out) {
+        const int64_t ms = ts < 10'000'000'000LL ? ts * 1000 : ts;
+        ts = Timestamp::duration(std::chrono::milliseconds(ms)).count();
+    }
+}
+
+// Per-row symbol IDs for a string, large-string or dictionary column. A
+// dictionary is interned once per chunk; plain strings go through the
+// one-entry cache, since consecutive rows almost always share a ticker.
+void to_symbol_ids(const arrow::Array& array, qse::SymbolIdCache& cache,
+                   std::vector<qse::SymbolId>& out) {
+    const auto n = array.length();
+    out.resize(static_cast<std::size_t>(n));
+    switch (array.type_id()) {
+    case arrow::Type::STRING: {
+        const auto& strings = static_cast<const arrow::StringArray&>(array);
+        for (int64_t i = 0; i < n; ++i) {
+            out[i] = strings.IsNull(i) ? qse::kInvalidSymbolId : cache.resolve(strings.GetView(i));
+        }
+        break;
+    }
+    case arrow::Type::LARGE_STRING: {
+        const auto& strings = static_cast<const arrow::LargeStringArray&>(array);
+        for (int64_t i = 0; i < n; ++i) {
+            out[i] = strings.IsNull(i) ? qse::kInvalidSymbolId : cache.resolve(strings.GetView(i));
+        }
+        break;
+    }
+    case arrow::Type::DICTIONARY: {
+        const auto& dict = static_cast<const arrow::DictionaryArray&>(array);
+        std::vector<qse::SymbolId> entries;
+        to_symbol_ids(*dict.dictionary(), cache, entries);
+        for (int64_t i = 0; i < n; ++i) {
+            out[i] = dict.IsNull(i) ? qse::kInvalidSymbolId
+                                    : entries[static_cast<std::size_t>(dict.GetValueIndex(i))];
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error("Unsupported symbol column type: " + array.type()->ToString());
+    }
+}
+
+/**
+ * Turns tick record batches into TickColumns rows. Holds the projection
+ * (which optional columns to read) and reuses its per-column scratch
+ * vectors, so decoding a batch does not allocate once warmed up.
+ */
+class TickBatchDecoder {
+public:
+    TickBatchDecoder(parquet::arrow::FileReader& reader, const std::string& symbol_override,
+                     unsigned tick_columns) {
+        if (!symbol_override.empty()) {
+            override_id_ = qse::intern_symbol(symbol_override);
+            tick_columns &= ~ParquetDataReader::kSymbolColumn; // never read
+        }
+        add_column(reader, "timestamp", true);
+        add_column(reader, "price", true);
+        const std::pair<unsigned, const char*> optional[] = {
+            {ParquetDataReader::kSymbolColumn, "symbol"},
+            {ParquetDataReader::kVolumeColumn, "volume"},
+            {ParquetDataReader::kBidColumn, "bid"},
+            {ParquetDataReader::kAskColumn, "ask"},
+            {ParquetDataReader::kBidSizeColumn, "bid_size"},
+            {ParquetDataReader::kAskSizeColumn, "ask_size"},
+        };
+        for (const auto& [flag, name] : optional) {
+            if ((tick_columns & flag) != 0) {
+                add_column(reader, name, false);
+            }
+        }
+    }
+
+    const std::vector<int>& columns() const { return columns_; }
+
+    // Appends the batch's rows to `out` in batch order; returns the number of
+    // rows dropped because a projected column was null
+    std::size_t decode(const arrow::RecordBatch& batch, qse::TickColumns& out) {
+        const auto ts = batch.GetColumnByName("timestamp");
+        const auto price = batch.GetColumnByName("price");
+        const auto symbol = batch.GetColumnByName("symbol");
+        const auto volume = batch.GetColumnByName("volume");
+        const auto bid = batch.GetColumnByName("bid");
+        const auto ask = batch.GetColumnByName("ask");
+        const auto bid_size = batch.GetColumnByName("bid_size");
+        const auto ask_size = batch.GetColumnByName("ask_size");
+
+        const std::size_t n = static_cast<std::size_t>(batch.num_rows());
+        to_timestamps(*ts, timestamps_);
+        to_values(*price, prices_);
+        if (symbol) {
+            to_symbol_ids(*symbol, symbol_cache_, symbol_ids_);
+        } else {
+            symbol_ids_.assign(n, override_id_ != qse::kInvalidSymbolId
+                                      ? override_id_
+                                      : symbol_cache_.resolve("UNKNOWN"));
+        }
+        if (volume) {
+            to_values(*volume, volumes_);
+        } else {
+            volumes_.assign(n, 0);
+        }
+        // Missing quote columns fall back to the legacy CSV convention
+        if (bid) {
+            to_values(*bid, bids_);
+        } else {
+            bids_ = prices_;
+        }
+        if (ask) {
+            to_values(*ask, asks_);
+        } else {
+            asks_ = prices_;
+        }
+        if (bid_size) {
+            to_values(*bid_size, bid_sizes_);
+        } else {
+            bid_sizes_ = volumes_;
+        }
+        if (ask_size) {
+            to_values(*ask_size, ask_sizes_);
+        } else {
+            ask_sizes_ = volumes_;
+        }
+
+        bool any_nulls = false;
+        for (const auto& column : batch.columns()) {
+            any_nulls = any_nulls || column->null_count() > 0;
+        }
+
+        std::size_t skipped = 0;
+        out.reserve(out.size() + n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (any_nulls && has_null(batch, static_cast<int64_t>(i))) {
+                ++skipped;
+                continue;
+            }
+            out.append_row(qse::Timestamp(qse::Timestamp::duration(timestamps_[i])),
+                           symbol_ids_[i], prices_[i], bids_[i], asks_[i], volumes_[i],
+                           bid_sizes_[i], ask_sizes_[i]);
+        }
+        return skipped;
+    }
+
+private:
+    void add_column(parquet::arrow::FileReader& reader, const char* name, bool required) {
+        const int index = column_index(reader, name);
+        if (index >= 0) {
+            columns_.push_back(index);
+        } else if (required) {
+            throw std::runtime_error(std::string("Tick file has no '") + name + "' column");
+        }
+    }
+
+    static bool has_null(const arrow::RecordBatch& batch, int64_t row) {
+        for (const auto& column : batch.columns()) {
+            if (column->IsNull(row)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<int> columns_;
+    qse::SymbolId override_id_ = qse::kInvalidSymbolId;
+    qse::SymbolIdCache symbol_cache_;
+    std::vector<qse::Timestamp::rep> timestamps_;
+    std::vector<qse::SymbolId> symbol_ids_;
+    std::vector<qse::Price> prices_;
+    std::vector<qse::Price> bids_;
+    std::vector<qse::Price> asks_;
+    std::vector<qse::Volume> volumes_;
+    std::vector<qse::Volume> bid_sizes_;
+    std::vector<qse::Volume> ask_sizes_;
+};
+
+// Streams a tick Parquet file one record batch (kTickBatchSize rows, row
+// group by row group) at a time, reusing one decoded-column buffer and one
+// Tick buffer. The skipped-row count is published to the owning reader at
+// end of file.
+class ParquetTickCursor : public qse::ITickCursor {
+public:
+    ParquetTickCursor(const std::string& file_path, const std::string& symbol_override,
+                      unsigned tick_columns, std::size_t* skipped_out)
+        : reader_(open_parquet(file_path)),
+          decoder_(*reader_, symbol_override, tick_columns), skipped_out_(skipped_out) {
+        reader_->set_batch_size(static_cast<int64_t>(qse::kTickBatchSize));
+        batches_ = open_batches(*reader_, decoder_.columns());
+    }
+
+    qse::TickBatch next_batch() override {
+        while (true) {
+            std::shared_ptr<arrow::RecordBatch> batch;
+            PARQUET_THROW_NOT_OK(batches_->ReadNext(&batch));
+            if (!batch) {
+                if (skipped_out_ != nullptr) {
+                    *skipped_out_ = skipped_;
+                    skipped_out_ = nullptr;
                 }
+                return {};
+            }
+            rows_.clear();
+            skipped_ += decoder_.decode(*batch, rows_);
+            if (rows_.empty()) {
+                continue; // every row of this batch was null somewhere
             }
+            const qse::TickColumnsView view = rows_.view();
+            if (ticks_.size() < view.size) {
+                ticks_.resize(view.size);
+            }
+            for (std::size_t i = 0; i < view.size; ++i) {
+                view.fill_tick(i, ticks_[i]);
+            }
+            return {ticks_.data(), view.size};
+        }
+    }
+
+private:
+    std::unique_ptr<parquet::arrow::FileReader> reader_;
+    TickBatchDecoder decoder_;
+    std::unique_ptr<arrow::RecordBatchReader> batches_; // borrows *reader_
+    std::size_t* skipped_out_;
+    qse::TickColumns rows_;
+    std::vector<qse::Tick> ticks_;
+    std::size_t skipped_ = 0;
+};
+
+} // namespace
+
+namespace qse {
+
+ParquetDataReader::ParquetDataReader(const std::string& file_path)
+    : ParquetDataReader(file_path, "") {}
+
+ParquetDataReader::ParquetDataReader(const std::string& file_path,
+                                     const std::string& symbol_override, LoadMode mode,
+                                     unsigned tick_columns)
+    : file_path_(file_path), symbol_override_(symbol_override), mode_(mode),
+      tick_columns_(tick_columns) {
+    if (!std::filesystem::exists(file_path)) {
+        throw std::runtime_error("File not found: " + file_path);
+    }
+    try {
+        // Only the footer is read here: it tells bar files from tick files
+        auto reader = open_parquet(file_path_);
+        row_group_count_ = reader->num_row_groups();
+        is_bar_file_ = column_index(*reader, "close") >= 0;
+        if (!is_bar_file_ && column_index(*reader, "price") < 0) {
+            throw std::runtime_error("no 'close' (bar) or 'price' (tick) column");
         }
-        // You could add a similar check for tick columns ('price', 'volume') here in the future
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Error reading Parquet file: " + std::string(e.what()));
+    }
+    // Bar files are small and have no tick stream, so they always load eagerly
+    if (mode_ == LoadMode::Eager || is_bar_file_) {
+        load_data();
+    }
+}
 
+void ParquetDataReader::load_data() const {
+    try {
+        if (is_bar_file_) {
+            load_bars();
+        } else {
+            load_ticks();
+        }
     } catch (const std::exception& e) {
         throw std::runtime_error("Error reading Parquet file: " + std::string(e.what()));
     }
+    loaded_ = true;
+}
+
+void ParquetDataReader::load_bars() const {
+    if (qse_debug_enabled())
+        std::cout << "Detected Bar data format in " << file_path_ << std::endl;
+    auto reader = open_parquet(file_path_);
+    std::vector<int> columns;
+    for (const char* name : {"timestamp", "open", "high", "low", "close", "volume", "symbol"}) {
+        const int index = column_index(*reader, name);
+        if (index >= 0) {
+            columns.push_back(index);
+        } else if (std::string_view(name) != "symbol") {
+            throw std::runtime_error(std::string("Bar file has no '") + name + "' column");
+        }
+    }
+
+    // Check if symbol column exists, otherwise use the override or UNKNOWN
+    const std::string default_symbol = symbol_override_.empty() ? "UNKNOWN" : symbol_override_;
+    SymbolIdCache symbol_ids;
+    std::vector<Timestamp::rep> timestamps;
+    std::vector<double> open, high, low, close;
+    std::vector<Volume> volume;
+    std::vector<SymbolId> ids;
+
+    auto batches = open_batches(*reader, columns);
+    bars_.reserve(static_cast<std::size_t>(reader->parquet_reader()->metadata()->num_rows()));
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (true) {
+        PARQUET_THROW_NOT_OK(batches->ReadNext(&batch));
+        if (!batch) {
+            break;
+        }
+        to_timestamps(*batch->GetColumnByName("timestamp"), timestamps);
+        to_values(*batch->GetColumnByName("open"), open);
+        to_values(*batch->GetColumnByName("high"), high);
+        to_values(*batch->GetColumnByName("low"), low);
+        to_values(*batch->GetColumnByName("close"), close);
+        to_values(*batch->GetColumnByName("volume"), volume);
+        const auto symbol_col = symbol_override_.empty() ? batch->GetColumnByName("symbol")
+                                                         : nullptr;
+        if (symbol_col) {
+            to_symbol_ids(*symbol_col, symbol_ids, ids);
+        }
+
+        // Convert to our Bar format
+        for (std::size_t i = 0; i < timestamps.size(); ++i) {
+            Bar bar;
+            bar.symbol_id = symbol_col ? ids[i] : symbol_ids.resolve(default_symbol);
+            bar.symbol = bar.symbol_id != kInvalidSymbolId
+                             ? SymbolTable::instance().name(bar.symbol_id)
+                             : default_symbol;
+            bar.timestamp = Timestamp(Timestamp::duration(timestamps[i]));
+            bar.open = open[i];
+            bar.high = high[i];
+            bar.low = low[i];
+            bar.close = close[i];
+            bar.volume = volume[i];
+            bars_.push_back(std::move(bar));
+        }
+    }
+}
+
+void ParquetDataReader::load_ticks() const {
+    if (qse_debug_enabled())
+        std::cout << "Detected Tick data format in " << file_path_ << std::endl;
+    auto reader = open_parquet(file_path_);
+    TickBatchDecoder decoder(*reader, symbol_override_, tick_columns_);
+    // Larger batches than the cursor's: nothing is materialized per batch
+    // here, so fewer batches just means less per-batch overhead
+    reader->set_batch_size(64 * 1024);
+    auto batches = open_batches(*reader, decoder.columns());
+
+    columns_.clear();
+    columns_.reserve(static_cast<std::size_t>(reader->parquet_reader()->metadata()->num_rows()));
+    skipped_rows_ = 0; // a streaming pass may already have published a count
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (true) {
+        PARQUET_THROW_NOT_OK(batches->ReadNext(&batch));
+        if (!batch) {
+            break;
+        }
+        skipped_rows_ += decoder.decode(*batch, columns_);
+    }
+    // Sort ticks by timestamp (free when the archive is already in order)
+    columns_.sort_by_time();
+
+    if (skipped_rows_ > 0) {
+        std::cerr << "[ParquetDataReader] Data quality warning for " << file_path_ << ": "
+                  << skipped_rows_ << " row(s) with null fields skipped" << std::endl;
+    }
 }
 
 const std::vector<qse::Tick>& ParquetDataReader::read_all_ticks() const {
-    // For now, return empty ticks since ParquetDataReader is bar-focused
+    if (!loaded_) {
+        load_data(); // streaming reader asked for the materialized series
+    }
+    if (!ticks_materialized_) {
+        ticks_ = columns_.to_ticks();
+        ticks_materialized_ = true;
+    }
     return ticks_;
 }
 
+const TickColumns& ParquetDataReader::read_tick_columns() const {
+    if (!loaded_) {
+        load_data();
+    }
+    return columns_;
+}
+
 const std::vector<qse::Bar>& ParquetDataReader::read_all_bars() const {
     return bars_;
 }
 
-} // namespace qse
\ No newline at end of file
+std::unique_ptr<ITickCursor> ParquetDataReader::open_tick_cursor() const {
+    if (ticks_materialized_ || is_bar_file_) {
+        return std::make_unique<VectorTickCursor>(ticks_);
+    }
+    if (loaded_) {
+        return std::make_unique<ColumnarTickCursor>(columns_.view());
+    }
+    return std::make_unique<ParquetTickCursor>(file_path_, symbol_override_, tick_columns_,
+                                               &skipped_rows_);
+}
+
+} // namespace qse
@@ -0,0 +1,396 @@
+#include "qse/data/PriceLadderBook.h"
+#include <algorithm>
+
+namespace qse {
+
+namespace {
+
+std::size_t next_pow2(std::size_t n) {
+    std::size_t p = 2;
+    while (p < n) {
+        p *= 2;
+    }
+    return p;
+}
+
+} // namespace
+
+PriceLadderBook::PriceLadderBook(Price tick_size, std::size_t levels_hint,
+                                 std::size_t orders_hint, std::size_t max_levels)
+    : scale_(tick_size) {
+    bids_.is_bid = true;
+    for (Ladder* side : {&bids_, &asks_}) {
+        side->max_slots = next_pow2(max_levels);
+        side->slots.resize(std::min(next_pow2(levels_hint), side->max_slots));
+    }
+    nodes_.reserve(orders_hint);
+    index_.reserve(orders_hint);
+}
+
+// --- Ladder ---
+
+std::int64_t PriceLadderBook::Ladder::best() const {
+    if (sparse.empty()) {
+        return is_bid ? hi : lo;
+    }
+    const std::int64_t outlier = is_bid ? sparse.rbegin()->first : sparse.begin()->first;
+    if (dense_empty()) {
+        return outlier;
+    }
+    return is_bid ? std::max(hi, outlier) : std::min(lo, outlier);
+}
+
+const PriceLadderBook::Level* PriceLadderBook::Ladder::find(std::int64_t tick) const {
+    if (tick >= lo && tick <= hi) {
+        const Level& level = at(tick);
+        return level.count > 0 ? &level : nullptr;
+    }
+    auto it = sparse.find(tick);
+    return it != sparse.end() ? &it->second : nullptr;
+}
+
+PriceLadderBook::Level& PriceLadderBook::Ladder::touch(std::int64_t tick) {
+    if (tick >= lo && tick <= hi) {
+        return at(tick);
+    }
+    auto it = sparse.find(tick);
+    if (it != sparse.end()) {
+        return it->second;
+    }
+    if (dense_empty()) {
+        lo = hi = tick;
+        return at(tick);
+    }
+    const std::int64_t new_lo = std::min(lo, tick);
+    const std::int64_t new_hi = std::max(hi, tick);
+    const auto span = static_cast<std::uint64_t>(new_hi - new_lo) + 1;
+    if (span > max_slots) {
+        // Too far from the dense range to widen it
+        return sparse[tick];
+    }
+    if (span > slots.size()) {
+        // Rehome the occupied levels into a ring with headroom; slots
+        // outside [lo, hi] are always clean, so only the range moves
+        std::vector<Level> grown(std::min(next_pow2(span * 2), max_slots));
+        const std::size_t mask = grown.size() - 1;
+        for (std::int64_t t = lo; t <= hi; ++t) {
+            grown[static_cast<std::size_t>(t) & mask] = at(t);
+        }
+        slots.swap(grown);
+    }
+    const std::int64_t old_lo = lo;
+    const std::int64_t old_hi = hi;
+    lo = new_lo;
+    hi = new_hi;
+    absorb_sparse(new_lo, old_lo - 1);
+    absorb_sparse(old_hi + 1, new_hi);
+    return at(tick);
+}
+
+void PriceLadderBook::Ladder::absorb_sparse(std::int64_t from, std::int64_t to) {
+    for (auto it = sparse.lower_bound(from); it != sparse.end() && it->first <= to;) {
+        at(it->first) = it->second;
+        it = sparse.erase(it);
+    }
+}
+
+void PriceLadderBook::Ladder::level_emptied(std::int64_t tick) {
+    if (tick < lo || tick > hi) {
+        sparse.erase(tick);
+        return;
+    }
+    at(tick) = Level{};
+    // Only an edge of the range moves; the next best level is usually the
+    // adjacent slot
+    if (tick == lo) {
+        while (lo <= hi && at(lo).count == 0) {
+            ++lo;
+        }
+    } else if (tick == hi) {
+        while (hi >= lo && at(hi).count == 0) {
+            --hi;
+        }
+    }
+    if (lo > hi) {
+        lo = 0;
+        hi = -1;
+    }
+}
+
+void PriceLadderBook::Ladder::clear() {
+    for (std::int64_t t = lo; t <= hi; ++t) {
+        at(t) = Level{};
+    }
+    lo = 0;
+    hi = -1;
+    sparse.clear();
+}
+
+// --- Order nodes ---
+
+std::uint32_t PriceLadderBook::new_node(LadderOrderId id, Volume size, std::int64_t tick,
+                                        Order::Side side) {
+    std::uint32_t index;
+    if (free_head_ != kNil) {
+        index = free_head_;
+        free_head_ = nodes_[index].next;
+    } else {
+        index = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    nodes_[index] = Node{id, size, tick, kNil, kNil, side};
+    index_.emplace(id, index);
+    return index;
+}
+
+void PriceLadderBook::remove_node(std::uint32_t index) {
+    Node& node = nodes_[index];
+    Ladder& side = ladder(node.side);
+    Level& level = side.level(node.tick);
+
+    if (node.prev != kNil) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        level.head = node.next;
+    }
+    if (node.next != kNil) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        level.tail = node.prev;
+    }
+    level.total -= node.size;
+    --level.count;
+
+    index_.erase(node.id);
+    node.next = free_head_;
+    free_head_ = index;
+
+    if (level.count == 0) {
+        side.level_emptied(node.tick);
+    }
+}
+
+// --- Order Queue Management ---
+
+bool PriceLadderBook::enqueue_order(Order::Side side, Price price, LadderOrderId order_id,
+                                    Volume size) {
+    if (index_.count(order_id) != 0) {
+        return false;
+    }
+    const std::int64_t tick = to_ticks(price);
+    Level& level = ladder(side).touch(tick);
+    const std::uint32_t index = new_node(order_id, size, tick, side);
+
+    nodes_[index].prev = level.tail;
+    if (level.tail != kNil) {
+        nodes_[level.tail].next = index;
+    } else {
+        level.head = index;
+    }
+    level.tail = index;
+    level.total += size;
+    ++level.count;
+    return true;
+}
+
+bool PriceLadderBook::enqueue_order_front(Order::Side side, Price price, LadderOrderId order_id,
+                                          Volume size) {
+    if (index_.count(order_id) != 0) {
+        return false;
+    }
+    const std::int64_t tick = to_ticks(price);
+    Level& level = ladder(side).touch(tick);
+    const std::uint32_t index = new_node(order_id, size, tick, side);
+
+    nodes_[index].next = level.head;
+    if (level.head != kNil) {
+        nodes_[level.head].prev = index;
+    } else {
+        level.tail = index;
+    }
+    level.head = index;
+    level.total += size;
+    ++level.count;
+    return true;
+}
+
+bool PriceLadderBook::cancel_order(LadderOrderId order_id) {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) {
+        return false;
+    }
+    remove_node(it->second);
+    return true;
+}
+
+template <typename OnTake>
+Volume PriceLadderBook::take_from_level(Ladder& side, std::int64_t tick, Volume quantity,
+                                        OnTake&& on_take) {
+    Level& level = side.level(tick);
+    Volume taken = 0;
+    while (level.head != kNil && taken < quantity) {
+        const std::uint32_t index = level.head;
+        Node& head = nodes_[index];
+        const Volume wanted = quantity - taken;
+        if (head.size <= wanted) {
+            // Fully consume the head order (skip zero-size stragglers). The
+            // last one empties the level, which may free a sparse level.
+            if (head.size > 0) {
+                on_take(head.id, head.size);
+            }
+            taken += head.size;
+            const bool last = level.count == 1;
+            remove_node(index);
+            if (last) {
+                break;
+            }
+        } else {
+            // Partially consume the head order; it keeps its queue position
+            on_take(head.id, wanted);
+            head.size -= wanted;
+            level.total -= wanted;
+            taken = quantity;
+        }
+    }
+    return taken;
+}
+
+void PriceLadderBook::consume_at_price(Order::Side side, Price price, Volume quantity,
+                                       std::vector<std::pair<LadderOrderId, Volume>>& consumed) {
+    Ladder& resting = ladder(side);
+    const std::int64_t tick = to_ticks(price);
+    if (resting.find(tick) == nullptr) {
+        return;
+    }
+    take_from_level(resting, tick, quantity,
+                    [&](LadderOrderId id, Volume taken) { consumed.emplace_back(id, taken); });
+}
+
+std::vector<std::pair<LadderOrderId, Volume>>
+PriceLadderBook::consume_at_price(Order::Side side, Price price, Volume quantity) {
+    std::vector<std::pair<LadderOrderId, Volume>> consumed;
+    consume_at_price(side, price, quantity, consumed);
+    return consumed;
+}
+
+std::pair<Volume, Price> PriceLadderBook::fill_market(Order::Side side, std::int64_t quantity) {
+    if (quantity <= 0) {
+        return {0, 0.0};
+    }
+    // The resting side is the opposite of the aggressing order's side
+    Ladder& resting = (side == Order::Side::BUY) ? asks_ : bids_;
+
+    Volume remaining = static_cast<Volume>(quantity);
+    Volume total_filled = 0;
+    double total_value = 0.0;
+    while (remaining > 0 && !resting.empty()) {
+        const std::int64_t tick = resting.best();
+        const Volume taken =
+            take_from_level(resting, tick, remaining, [](LadderOrderId, Volume) {});
+        total_filled += taken;
+        total_value += to_price(tick) * static_cast<double>(taken);
+        remaining -= taken;
+    }
+
+    Price avg_price = (total_filled > 0) ? (total_value / static_cast<double>(total_filled)) : 0.0;
+    return {total_filled, avg_price};
+}
+
+std::size_t PriceLadderBook::queue_position(LadderOrderId order_id) const {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) {
+        return 0;
+    }
+    std::size_t position = 1;
+    for (std::uint32_t i = nodes_[it->second].prev; i != kNil; i = nodes_[i].prev) {
+        ++position;
+    }
+    return position;
+}
+
+std::size_t PriceLadderBook::queue_position(Order::Side side, Price price,
+                                            LadderOrderId order_id) const {
+    auto it = index_.find(order_id);
+    if (it == index_.end()) {
+        return 0;
+    }
+    const Node& node = nodes_[it->second];
+    if (node.side != side || node.tick != to_ticks(price)) {
+        return 0;
+    }
+    return queue_position(order_id);
+}
+
+// --- Price Level Queries ---
+
+bool PriceLadderBook::has_level(Order::Side side, Price price) const {
+    return ladder(side).find(to_ticks(price)) != nullptr;
+}
+
+Volume PriceLadderBook::level_size(Order::Side side, Price price) const {
+    const Level* level = ladder(side).find(to_ticks(price));
+    return level ? level->total : 0;
+}
+
+std::vector<Price> PriceLadderBook::top_n_prices(Order::Side side, std::size_t n) const {
+    std::vector<Price> prices;
+    const Ladder& levels = ladder(side);
+    // Walk away from the touch: bids downwards, asks upwards. Sparse levels
+    // lie wholly outside the dense range, so they come before it (better
+    // prices) or after it.
+    if (levels.is_bid) {
+        auto it = levels.sparse.rbegin();
+        for (; it != levels.sparse.rend() && prices.size() < n &&
+               (levels.dense_empty() || it->first > levels.hi);
+             ++it) {
+            prices.push_back(to_price(it->first));
+        }
+        for (std::int64_t t = levels.hi; t >= levels.lo && prices.size() < n; --t) {
+            if (levels.at(t).count > 0) {
+                prices.push_back(to_price(t));
+            }
+        }
+        for (; it != levels.sparse.rend() && prices.size() < n; ++it) {
+            prices.push_back(to_price(it->first));
+        }
+    } else {
+        auto it = levels.sparse.begin();
+        for (; it != levels.sparse.end() && prices.size() < n &&
+               (levels.dense_empty() || it->first < levels.lo);
+             ++it) {
+            prices.push_back(to_price(it->first));
+        }
+        for (std::int64_t t = levels.lo; t <= levels.hi && prices.size() < n; ++t) {
+            if (levels.at(t).count > 0) {
+                prices.push_back(to_price(t));
+            }
+        }
+        for (; it != levels.sparse.end() && prices.size() < n; ++it) {
+            prices.push_back(to_price(it->first));
+        }
+    }
+    return prices;
+}
+
+TopOfBook PriceLadderBook::top_of_book() const {
+    TopOfBook tob;
+    if (!bids_.empty()) {
+        tob.best_bid_price = to_price(bids_.best());
+        tob.best_bid_size = bids_.level(bids_.best()).total;
+    }
+    if (!asks_.empty()) {
+        tob.best_ask_price = to_price(asks_.best());
+        tob.best_ask_size = asks_.level(asks_.best()).total;
+    }
+    return tob;
+}
+
+void PriceLadderBook::clear() {
+    bids_.clear();
+    asks_.clear();
+    nodes_.clear();
+    free_head_ = kNil;
+    index_.clear();
+}
+
+} // namespace qse
@@ -0,0 +1,57 @@
+#include "qse/data/SharedTickDataReader.h"
+#include <stdexcept>
+#include <utility>
+
+namespace qse {
+
+namespace {
+
+// A VectorTickCursor that owns a reference to the ticks it hands out
+class SharedVectorTickCursor : public ITickCursor {
+public:
+    explicit SharedVectorTickCursor(std::shared_ptr<const std::vector<Tick>> ticks)
+        : ticks_(std::move(ticks)), cursor_(*ticks_) {}
+
+    TickBatch next_batch() override { return cursor_.next_batch(); }
+
+private:
+    std::shared_ptr<const std::vector<Tick>> ticks_;
+    VectorTickCursor cursor_;
+};
+
+} // namespace
+
+SharedTickDataReader::SharedTickDataReader(std::shared_ptr<const TickDataset> dataset)
+    : dataset_(std::move(dataset)) {
+    if (!dataset_) {
+        throw std::invalid_argument("SharedTickDataReader needs a tick series");
+    }
+}
+
+SharedTickDataReader::SharedTickDataReader(std::shared_ptr<const TickColumns> columns)
+    : dataset_(columns ? TickDataset::from_columns(std::move(columns)) : nullptr) {
+    if (!dataset_) {
+        throw std::invalid_argument("SharedTickDataReader needs a tick series");
+    }
+}
+
+const std::vector<Tick>& SharedTickDataReader::read_all_ticks() const {
+    if (!ticks_) {
+        const TickColumnsView& view = dataset_->view();
+        auto ticks = std::make_shared<std::vector<Tick>>(view.size);
+        for (std::size_t i = 0; i < view.size; ++i) {
+            view.fill_tick(i, (*ticks)[i]);
+        }
+        ticks_ = std::move(ticks);
+    }
+    return *ticks_;
+}
+
+std::unique_ptr<ITickCursor> SharedTickDataReader::open_tick_cursor() const {
+    if (ticks_) {
+        return std::make_unique<SharedVectorTickCursor>(ticks_);
+    }
+    return dataset_->open_cursor();
+}
+
+} // namespace qse
@@ -0,0 +1,54 @@
+#include "qse/data/SymbolTable.h"
+#include <mutex>
+#include <stdexcept>
+
+namespace qse {
+
+SymbolTable& SymbolTable::instance() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(std::string_view symbol) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(symbol);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(symbol); // another thread may have won the race
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (names_.size() >= static_cast<std::size_t>(kInvalidSymbolId)) {
+        throw std::length_error("SymbolTable: symbol ID space exhausted");
+    }
+    const auto id = static_cast<SymbolId>(names_.size());
+    names_.emplace_back(symbol);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    return it != ids_.end() ? it->second : kInvalidSymbolId;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id >= names_.size()) {
+        throw std::out_of_range("SymbolTable: unknown symbol id " + std::to_string(id));
+    }
+    return names_[id];
+}
+
+std::size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+} // namespace qse
@@ -0,0 +1,302 @@
+#include "qse/data/TickCache.h"
+#include "qse/data/MappedFile.h"
+#include "qse/data/SymbolTable.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace qse {
+
+namespace {
+
+constexpr char kMagic[8] = {'Q', 'S', 'E', 'T', 'I', 'C', 'K', 'S'};
+constexpr uint32_t kByteOrderMarker = 0x01020304;
+
+constexpr std::size_t align8(std::size_t n) {
+    return (n + 7) & ~std::size_t(7);
+}
+
+// Byte size of the eight columns for `rows` rows, each column 8-aligned
+constexpr std::size_t columns_bytes(std::size_t rows) {
+    return 7 * align8(rows * 8) + align8(rows * sizeof(SymbolId));
+}
+
+static_assert(sizeof(Timestamp::rep) == 8 && sizeof(Price) == 8 && sizeof(Volume) == 8,
+              "tick cache columns are 8 bytes wide");
+static_assert(sizeof(TickCacheHeader) % 8 == 0, "header keeps the columns 8-aligned");
+
+// Identity of the source file the cache was built from. Size plus mtime is
+// what make(1) trusts too; hashing the CSV would cost as much as parsing it.
+bool source_identity(const std::string& source_path, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(source_path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto write_time = std::filesystem::last_write_time(source_path, ec);
+    if (ec) {
+        return false;
+    }
+    size = static_cast<uint64_t>(file_size);
+    mtime = static_cast<int64_t>(write_time.time_since_epoch().count());
+    return true;
+}
+
+// True if `header` is a well-formed cache of this schema for this host
+bool header_is_valid(const TickCacheHeader& header) {
+    return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+           header.version == kTickCacheVersion && header.byte_order == kByteOrderMarker &&
+           header.timestamp_period_num == Timestamp::period::num &&
+           header.timestamp_period_den == Timestamp::period::den;
+}
+
+void write_string(std::string& out, std::string_view s) {
+    const auto length = static_cast<uint32_t>(s.size());
+    out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.append(s.data(), s.size());
+}
+
+// Reads one length-prefixed string at `offset`; false if it overruns `section`
+bool read_string(std::string_view section, std::size_t& offset, std::string_view& out) {
+    uint32_t length = 0;
+    if (section.size() - offset < sizeof(length)) {
+        return false;
+    }
+    std::memcpy(&length, section.data() + offset, sizeof(length));
+    offset += sizeof(length);
+    if (section.size() - offset < length) {
+        return false;
+    }
+    out = section.substr(offset, length);
+    offset += length;
+    return true;
+}
+
+template <typename T>
+void write_column(std::ofstream& file, const T* values, std::size_t rows) {
+    const std::size_t bytes = rows * sizeof(T);
+    file.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(bytes));
+    static constexpr char kPadding[8] = {};
+    file.write(kPadding, static_cast<std::streamsize>(align8(bytes) - bytes));
+}
+
+} // namespace
+
+std::string tick_cache_path(const std::string& source_path) {
+    return source_path + ".qtc";
+}
+
+bool read_tick_cache_header(const std::string& cache_path, TickCacheHeader& header) {
+    std::ifstream file(cache_path, std::ios::binary);
+    return file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+           header_is_valid(header);
+}
+
+std::unique_ptr<MappedTickCache> map_tick_cache(const std::string& source_path,
+                                                const std::string& symbol_override) {
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    if (!source_identity(source_path, source_size, source_mtime)) {
+        return nullptr;
+    }
+    const std::string cache_path = tick_cache_path(source_path);
+    std::error_code ec;
+    if (!std::filesystem::exists(cache_path, ec)) {
+        return nullptr;
+    }
+
+    // The cache can vanish or lose its permissions after the check above;
+    // either way it is just not there to use
+    std::unique_ptr<MappedTickCache> cache;
+    try {
+        cache = std::make_unique<MappedTickCache>(MappedFile(cache_path));
+    } catch (const std::runtime_error&) {
+        return nullptr;
+    }
+    const MappedFile& file = cache->file;
+    TickCacheHeader header{};
+    if (file.size() < sizeof(header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!header_is_valid(header) || header.source_size != source_size ||
+        header.source_mtime != source_mtime) {
+        return nullptr; // stale: the CSV changed since the cache was written
+    }
+    const std::size_t rows = static_cast<std::size_t>(header.row_count);
+    const std::size_t strings_at = sizeof(header);
+    const std::size_t columns_at = strings_at + align8(header.strings_bytes);
+    if (header.strings_bytes > file.size() || columns_at > file.size() ||
+        file.size() - columns_at != columns_bytes(rows)) {
+        return nullptr; // truncated or corrupt
+    }
+
+    // Strings: the override the cache was built with, then the symbols
+    const std::string_view strings(file.data() + strings_at, header.strings_bytes);
+    std::size_t offset = 0;
+    std::string_view cached_override;
+    if (!read_string(strings, offset, cached_override) || cached_override != symbol_override) {
+        return nullptr;
+    }
+    std::vector<SymbolId> to_global(header.symbol_count);
+    bool identity = true;
+    for (uint32_t local = 0; local < header.symbol_count; ++local) {
+        std::string_view name;
+        if (!read_string(strings, offset, name)) {
+            return nullptr;
+        }
+        to_global[local] = intern_symbol(name);
+        identity = identity && to_global[local] == local;
+    }
+
+    // Columns, in TickColumns order. The mapping is page-aligned and every
+    // column starts on an 8-byte boundary, so they can be read in place.
+    const char* p = file.data() + columns_at;
+    auto next_column = [&p, rows](std::size_t width) {
+        const char* column = p;
+        p += align8(rows * width);
+        return column;
+    };
+    TickColumnsView& view = cache->columns;
+    view.size = rows;
+    view.timestamps = reinterpret_cast<const Timestamp::rep*>(next_column(8));
+    const auto* local_ids = reinterpret_cast<const SymbolId*>(next_column(sizeof(SymbolId)));
+    view.prices = reinterpret_cast<const Price*>(next_column(8));
+    view.bids = reinterpret_cast<const Price*>(next_column(8));
+    view.asks = reinterpret_cast<const Price*>(next_column(8));
+    view.volumes = reinterpret_cast<const Volume*>(next_column(8));
+    view.bid_sizes = reinterpret_cast<const Volume*>(next_column(8));
+    view.ask_sizes = reinterpret_cast<const Volume*>(next_column(8));
+
+    // Every stored ID must index the file's own symbol table, or a corrupt
+    // file would hand out IDs the SymbolTable never issued
+    const bool ids_valid = std::all_of(local_ids, local_ids + rows, [&](SymbolId id) {
+        return id < header.symbol_count;
+    });
+    if (!ids_valid) {
+        return nullptr;
+    }
+
+    // IDs are process-local: the stored ones only need rewriting if this
+    // process numbered the symbols otherwise
+    if (identity) {
+        view.symbol_ids = local_ids;
+    } else {
+        cache->remapped_ids.resize(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            cache->remapped_ids[i] = to_global[local_ids[i]];
+        }
+        view.symbol_ids = cache->remapped_ids.data();
+    }
+
+    cache->stats.skipped_rows = static_cast<std::size_t>(header.skipped_rows);
+    cache->stats.gap_count = static_cast<std::size_t>(header.gap_count);
+    return cache;
+}
+
+bool load_tick_cache(const std::string& source_path, const std::string& symbol_override,
+                     TickColumns& out, TickCacheStats& stats) {
+    const auto cache = map_tick_cache(source_path, symbol_override);
+    if (!cache) {
+        return false;
+    }
+    out.assign(cache->columns);
+    stats = cache->stats;
+    return true;
+}
+
+bool write_tick_cache(const std::string& source_path, const std::string& symbol_override,
+                      const TickColumns& columns, const TickCacheStats& stats) {
+    const std::string cache_path = tick_cache_path(source_path);
+    TickCacheHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kTickCacheVersion;
+    header.byte_order = kByteOrderMarker;
+    if (!source_identity(source_path, header.source_size, header.source_mtime)) {
+        return false;
+    }
+    header.timestamp_period_num = Timestamp::period::num;
+    header.timestamp_period_den = Timestamp::period::den;
+
+    // File-local symbol table in first-seen order, so a process that loads
+    // only this file gets the stored IDs unchanged
+    const TickColumnsView view = columns.view();
+    std::unordered_map<SymbolId, SymbolId> to_local;
+    std::vector<SymbolId> local_ids(view.size);
+    std::string strings;
+    write_string(strings, symbol_override);
+    for (std::size_t i = 0; i < view.size; ++i) {
+        auto [it, inserted] =
+            to_local.try_emplace(view.symbol_ids[i], static_cast<SymbolId>(to_local.size()));
+        if (inserted) {
+            write_string(strings, SymbolTable::instance().name(view.symbol_ids[i]));
+        }
+        local_ids[i] = it->second;
+    }
+
+    header.row_count = view.size;
+    if (!view.empty()) {
+        const auto [min_it, max_it] =
+            std::minmax_element(view.timestamps, view.timestamps + view.size);
+        header.min_timestamp = *min_it;
+        header.max_timestamp = *max_it;
+    }
+    header.skipped_rows = stats.skipped_rows;
+    header.gap_count = stats.gap_count;
+    header.symbol_count = static_cast<uint32_t>(to_local.size());
+    header.override_length = static_cast<uint32_t>(symbol_override.size());
+    header.strings_bytes = strings.size();
+    strings.resize(align8(strings.size()), '\0');
+
+    // Write under a process- and thread-unique name and rename into place:
+    // rename is atomic, so a concurrent reader sees either no cache or a
+    // whole one (batch runs load several overrides of one CSV at once)
+    const std::string tmp_path =
+        cache_path + ".tmp." + std::to_string(::getpid()) + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (file) {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+            write_column(file, view.timestamps, view.size);
+            write_column(file, local_ids.data(), view.size);
+            write_column(file, view.prices, view.size);
+            write_column(file, view.bids, view.size);
+            write_column(file, view.asks, view.size);
+            write_column(file, view.volumes, view.size);
+            write_column(file, view.bid_sizes, view.size);
+            write_column(file, view.ask_sizes, view.size);
+        }
+        if (!file) {
+            std::cerr << "[TickCache] Could not write tick cache " << tmp_path << std::endl;
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, cache_path, ec);
+    if (ec) {
+        std::cerr << "[TickCache] Could not install tick cache " << cache_path << ": "
+                  << ec.message() << std::endl;
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace qse
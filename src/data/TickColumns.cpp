@@ -0,0 +1,168 @@
+#include "qse/data/TickColumns.h"
+#include <algorithm>
+#include <numeric>
+
+namespace qse {
+
+namespace {
+
+template <typename T>
+void permute(std::vector<T>& column, const std::vector<std::size_t>& order) {
+    std::vector<T> sorted;
+    sorted.reserve(column.size());
+    for (std::size_t i : order) {
+        sorted.push_back(column[i]);
+    }
+    column.swap(sorted);
+}
+
+} // namespace
+
+void TickColumnsView::fill_tick(std::size_t i, Tick& out) const {
+    const SymbolId id = symbol_ids[i];
+    if (out.symbol_id != id) {
+        out.symbol = SymbolTable::instance().name(id);
+        out.symbol_id = id;
+    }
+    out.timestamp = timestamp(i);
+    out.price = prices[i];
+    out.bid = bids[i];
+    out.ask = asks[i];
+    out.volume = volumes[i];
+    out.bid_size = bid_sizes[i];
+    out.ask_size = ask_sizes[i];
+}
+
+void TickColumns::reserve(std::size_t n) {
+    timestamps_.reserve(n);
+    symbol_ids_.reserve(n);
+    prices_.reserve(n);
+    bids_.reserve(n);
+    asks_.reserve(n);
+    volumes_.reserve(n);
+    bid_sizes_.reserve(n);
+    ask_sizes_.reserve(n);
+}
+
+void TickColumns::clear() {
+    timestamps_.clear();
+    symbol_ids_.clear();
+    prices_.clear();
+    bids_.clear();
+    asks_.clear();
+    volumes_.clear();
+    bid_sizes_.clear();
+    ask_sizes_.clear();
+}
+
+void TickColumns::append_row(Timestamp timestamp, SymbolId symbol_id, Price price, Price bid,
+                             Price ask, Volume volume, Volume bid_size, Volume ask_size) {
+    timestamps_.push_back(timestamp.time_since_epoch().count());
+    symbol_ids_.push_back(symbol_id);
+    prices_.push_back(price);
+    bids_.push_back(bid);
+    asks_.push_back(ask);
+    volumes_.push_back(volume);
+    bid_sizes_.push_back(bid_size);
+    ask_sizes_.push_back(ask_size);
+}
+
+void TickColumns::append(const TickColumns& other) {
+    timestamps_.insert(timestamps_.end(), other.timestamps_.begin(), other.timestamps_.end());
+    symbol_ids_.insert(symbol_ids_.end(), other.symbol_ids_.begin(), other.symbol_ids_.end());
+    prices_.insert(prices_.end(), other.prices_.begin(), other.prices_.end());
+    bids_.insert(bids_.end(), other.bids_.begin(), other.bids_.end());
+    asks_.insert(asks_.end(), other.asks_.begin(), other.asks_.end());
+    volumes_.insert(volumes_.end(), other.volumes_.begin(), other.volumes_.end());
+    bid_sizes_.insert(bid_sizes_.end(), other.bid_sizes_.begin(), other.bid_sizes_.end());
+    ask_sizes_.insert(ask_sizes_.end(), other.ask_sizes_.begin(), other.ask_sizes_.end());
+}
+
+void TickColumns::assign(const TickColumnsView& columns) {
+    const std::size_t n = columns.size;
+    timestamps_.assign(columns.timestamps, columns.timestamps + n);
+    symbol_ids_.assign(columns.symbol_ids, columns.symbol_ids + n);
+    prices_.assign(columns.prices, columns.prices + n);
+    bids_.assign(columns.bids, columns.bids + n);
+    asks_.assign(columns.asks, columns.asks + n);
+    volumes_.assign(columns.volumes, columns.volumes + n);
+    bid_sizes_.assign(columns.bid_sizes, columns.bid_sizes + n);
+    ask_sizes_.assign(columns.ask_sizes, columns.ask_sizes + n);
+}
+
+Tick TickColumns::tick_at(std::size_t i) const {
+    Tick tick{};
+    view().fill_tick(i, tick);
+    return tick;
+}
+
+bool TickColumns::is_time_sorted() const {
+    return std::is_sorted(timestamps_.begin(), timestamps_.end());
+}
+
+void TickColumns::sort_by_time() {
+    if (is_time_sorted()) {
+        return; // the common case: files are written in time order
+    }
+    std::vector<std::size_t> order(size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+        return timestamps_[a] < timestamps_[b];
+    });
+    permute(timestamps_, order);
+    permute(symbol_ids_, order);
+    permute(prices_, order);
+    permute(bids_, order);
+    permute(asks_, order);
+    permute(volumes_, order);
+    permute(bid_sizes_, order);
+    permute(ask_sizes_, order);
+}
+
+TickColumnsView TickColumns::view() const {
+    TickColumnsView v;
+    v.size = size();
+    v.timestamps = timestamps_.data();
+    v.symbol_ids = symbol_ids_.data();
+    v.prices = prices_.data();
+    v.bids = bids_.data();
+    v.asks = asks_.data();
+    v.volumes = volumes_.data();
+    v.bid_sizes = bid_sizes_.data();
+    v.ask_sizes = ask_sizes_.data();
+    return v;
+}
+
+std::vector<Tick> TickColumns::to_ticks() const {
+    std::vector<Tick> ticks(size());
+    const TickColumnsView v = view();
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        v.fill_tick(i, ticks[i]);
+    }
+    return ticks;
+}
+
+TickColumns TickColumns::from_ticks(const std::vector<Tick>& ticks) {
+    TickColumns columns;
+    columns.reserve(ticks.size());
+    SymbolIdCache ids;
+    for (const Tick& tick : ticks) {
+        columns.push_back(tick, tick.symbol_id != kInvalidSymbolId ? tick.symbol_id
+                                                                    : ids.resolve(tick.symbol));
+    }
+    return columns;
+}
+
+ColumnarTickCursor::ColumnarTickCursor(TickColumnsView columns)
+    : columns_(columns), batch_(std::min(kTickBatchSize, columns.size)) {}
+
+TickBatch ColumnarTickCursor::next_batch() {
+    const std::size_t n = std::min(batch_.size(), columns_.size - next_row_);
+    for (std::size_t i = 0; i < n; ++i) {
+        columns_.fill_tick(next_row_ + i, batch_[i]);
+    }
+    next_row_ += n;
+    return {batch_.data(), n};
+}
+
+} // namespace qse
@@ -0,0 +1,90 @@
+#include "qse/data/TickDataset.h"
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/TickCache.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace qse {
+
+namespace {
+
+// Bytes per row of an owned TickColumns: seven 8-byte columns plus the IDs
+constexpr std::size_t kColumnsRowBytes = 7 * 8 + sizeof(SymbolId);
+
+// A ColumnarTickCursor that owns a reference to the dataset it borrows from
+class DatasetTickCursor : public ITickCursor {
+public:
+    explicit DatasetTickCursor(std::shared_ptr<const TickDataset> dataset)
+        : dataset_(std::move(dataset)), cursor_(dataset_->view()) {}
+
+    TickBatch next_batch() override { return cursor_.next_batch(); }
+
+private:
+    std::shared_ptr<const TickDataset> dataset_;
+    ColumnarTickCursor cursor_;
+};
+
+} // namespace
+
+TickDataset::~TickDataset() = default;
+
+std::shared_ptr<const TickDataset> TickDataset::from_columns(
+    std::shared_ptr<const TickColumns> columns) {
+    if (!columns) {
+        throw std::invalid_argument("TickDataset needs a tick series");
+    }
+    std::shared_ptr<TickDataset> dataset(new TickDataset());
+    dataset->view_ = columns->view();
+    dataset->columns_ = std::move(columns);
+    return dataset;
+}
+
+std::shared_ptr<const TickDataset> TickDataset::from_columns(TickColumns columns) {
+    return from_columns(std::make_shared<const TickColumns>(std::move(columns)));
+}
+
+std::shared_ptr<const TickDataset> TickDataset::load(const std::string& data_file,
+                                                     const std::string& symbol_override) {
+    auto adopt = [](std::unique_ptr<MappedTickCache> cache) {
+        std::shared_ptr<TickDataset> dataset(new TickDataset());
+        dataset->view_ = cache->columns;
+        dataset->mapped_ = std::move(cache);
+        return std::shared_ptr<const TickDataset>(std::move(dataset));
+    };
+
+    if (auto cache = map_tick_cache(data_file, symbol_override)) {
+        const TickCacheStats& stats = cache->stats;
+        if (stats.skipped_rows > 0 || stats.gap_count > 0) {
+            std::cerr << "[TickDataset] Data quality warning for " << data_file << ": "
+                      << stats.skipped_rows << " unparseable row(s) skipped, " << stats.gap_count
+                      << " missing row(s) in the time grid" << std::endl;
+        }
+        return adopt(std::move(cache));
+    }
+
+    // Miss: one parse, which also writes the cache (and reports data
+    // quality); then serve the mapping so the parsed copy can go
+    auto reader = std::make_shared<CSVDataReader>(data_file, symbol_override,
+                                                  CSVDataReader::LoadMode::Cached);
+    if (auto cache = map_tick_cache(data_file, symbol_override)) {
+        return adopt(std::move(cache));
+    }
+    // No cache (bar file, or an unwritable directory): keep the reader's
+    // columns, and the reader with them
+    return from_columns(std::shared_ptr<const TickColumns>(reader, &reader->read_tick_columns()));
+}
+
+std::size_t TickDataset::heap_bytes() const {
+    if (mapped_) {
+        return mapped_->remapped_ids.size() * sizeof(SymbolId);
+    }
+    return view_.size * kColumnsRowBytes;
+}
+
+std::unique_ptr<ITickCursor> TickDataset::open_cursor() const {
+    return std::make_unique<DatasetTickCursor>(shared_from_this());
+}
+
+} // namespace qse
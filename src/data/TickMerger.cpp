@@ -0,0 +1,112 @@
+#include "qse/data/TickMerger.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace qse {
+
+namespace {
+
+bool earlier(const Tick& a, const Tick& b) {
+    return a.timestamp < b.timestamp;
+}
+
+} // namespace
+
+void TickMerger::add_source(std::unique_ptr<ITickCursor> cursor) {
+    if (!cursor) {
+        return;
+    }
+    Source source;
+    source.cursor = std::move(cursor);
+    sources_.push_back(std::move(source));
+}
+
+const Tick* TickMerger::next() {
+    if (!primed_) {
+        primed_ = true;
+        heap_.reserve(sources_.size());
+        for (std::size_t i = 0; i < sources_.size(); ++i) {
+            if (refill(i)) {
+                push(i);
+            }
+        }
+    }
+
+    // The previous head is only stepped past now, so the pointer handed out
+    // last time stayed valid even if stepping pulls in a fresh batch
+    if (pending_ != kNone) {
+        if (advance(pending_)) {
+            push(pending_);
+        }
+        pending_ = kNone;
+    }
+
+    if (heap_.empty()) {
+        return nullptr;
+    }
+    std::pop_heap(heap_.begin(), heap_.end(),
+                  [this](std::size_t a, std::size_t b) { return later(a, b); });
+    pending_ = heap_.back();
+    heap_.pop_back();
+    return &head(pending_);
+}
+
+bool TickMerger::refill(std::size_t index) {
+    Source& src = sources_[index];
+    if (src.drained) {
+        return false;
+    }
+
+    TickBatch batch = src.cursor->next_batch();
+    if (batch.empty()) {
+        src.drained = true;
+        return false;
+    }
+
+    bool ordered = (!src.has_last || !(batch.data[0].timestamp < src.last)) &&
+                   std::is_sorted(batch.begin(), batch.end(), earlier);
+    if (!ordered) {
+        // Copy the offending batch before the cursor reuses its buffer, pull
+        // in everything the source has left, and sort just this source
+        src.sorted.assign(batch.begin(), batch.end());
+        for (TickBatch rest = src.cursor->next_batch(); !rest.empty();
+             rest = src.cursor->next_batch()) {
+            src.sorted.insert(src.sorted.end(), rest.begin(), rest.end());
+        }
+        std::stable_sort(src.sorted.begin(), src.sorted.end(), earlier);
+        src.drained = true;
+        ++sorted_fallbacks_;
+        std::cerr << "[TickMerger] Source " << index << " is not time-ordered; sorted its "
+                  << src.sorted.size() << " remaining tick(s)" << std::endl;
+        batch = {src.sorted.data(), src.sorted.size()};
+    }
+
+    src.batch = batch;
+    src.pos = 0;
+    src.last = batch.data[batch.size - 1].timestamp;
+    src.has_last = true;
+    return true;
+}
+
+bool TickMerger::advance(std::size_t index) {
+    Source& src = sources_[index];
+    if (++src.pos < src.batch.size) {
+        return true;
+    }
+    return refill(index);
+}
+
+bool TickMerger::later(std::size_t a, std::size_t b) const {
+    const Timestamp ta = head(a).timestamp;
+    const Timestamp tb = head(b).timestamp;
+    return tb < ta || (ta == tb && b < a);
+}
+
+void TickMerger::push(std::size_t index) {
+    heap_.push_back(index);
+    std::push_heap(heap_.begin(), heap_.end(),
+                   [this](std::size_t a, std::size_t b) { return later(a, b); });
+}
+
+} // namespace qse
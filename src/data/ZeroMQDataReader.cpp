@@ -85,45 +85,13 @@ void ZeroMQDataReader::start_receiving() const {
     ZMQ_LOG(std::cout << "Starting to receive data from publisher..." << std::endl;);
 
     try {
-        // Stage-3 optimisation: poll-based async loop (1-ms timeout)
-        zmq::pollitem_t pi{*socket_, 0, ZMQ_POLLIN, 0};
-
-        while (!reception_complete_) {
-            zmq::poll(&pi, 1, std::chrono::milliseconds(1)); // 1 ms poll
-            if (!(pi.revents & ZMQ_POLLIN)) {
-                continue; // nothing ready
-            }
-
-            zmq::message_t message;
-            auto recv_result = socket_->recv(message, zmq::recv_flags::none);
-            if (!recv_result) {
-                continue; // spurious wakeup with nothing to read
-            }
-
-            // Extract message data (zero-copy string view)
-            std::string data(static_cast<char*>(message.data()), message.size());
-
-            // Check for end-of-stream message
-            if (data == "END_OF_STREAM") {
-                ZMQ_LOG(std::cout << "Received end-of-stream signal" << std::endl;);
-                reception_complete_ = true;
-                break;
-            }
-
-            // Deserialize the tick data
-            try {
-                Tick tick = deserialize_tick(data);
-                received_ticks_.push_back(tick);
-
-                received_ticks_.push_back(tick);
+        Tick tick;
+        while (receive_tick(tick)) {
+            received_ticks_.push_back(tick);
 #if ZMQ_READER_DEBUG
-                ZMQ_LOG(std::cout << "Received tick: price=" << tick.price
-                                  << ", volume=" << tick.volume << std::endl;);
+            ZMQ_LOG(std::cout << "Received tick: price=" << tick.price
+                              << ", volume=" << tick.volume << std::endl;);
 #endif
-            } catch (const std::exception& e) {
-                std::cerr << "Failed to deserialize tick: " << e.what() << std::endl;
-                continue;
-            }
         }
 
         data_loaded_ = true;
@@ -140,6 +108,75 @@ void ZeroMQDataReader::start_receiving() const {
     }
 }
 
+bool ZeroMQDataReader::receive_tick(Tick& out) const {
+    // Stage-3 optimisation: poll-based async loop (1-ms timeout)
+    zmq::pollitem_t pi{*socket_, 0, ZMQ_POLLIN, 0};
+
+    while (!reception_complete_) {
+        zmq::poll(&pi, 1, std::chrono::milliseconds(1)); // 1 ms poll
+        if (!(pi.revents & ZMQ_POLLIN)) {
+            continue; // nothing ready
+        }
+
+        zmq::message_t message;
+        auto recv_result = socket_->recv(message, zmq::recv_flags::none);
+        if (!recv_result) {
+            continue; // spurious wakeup with nothing to read
+        }
+
+        // Extract message data (zero-copy string view)
+        std::string data(static_cast<char*>(message.data()), message.size());
+
+        // Check for end-of-stream message
+        if (data == "END_OF_STREAM") {
+            ZMQ_LOG(std::cout << "Received end-of-stream signal" << std::endl;);
+            reception_complete_ = true;
+            break;
+        }
+
+        // Deserialize the tick data
+        try {
+            out = deserialize_tick(data);
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to deserialize tick: " << e.what() << std::endl;
+            continue;
+        }
+    }
+    return false;
+}
+
+// Hands out ticks as they arrive, kTickBatchSize at a time, without ever
+// buffering the whole feed. A batch is returned early when the stream ends.
+class ZeroMQDataReader::StreamCursor : public ITickCursor {
+public:
+    explicit StreamCursor(const ZeroMQDataReader& reader)
+        : reader_(reader), batch_(kTickBatchSize) {}
+
+    TickBatch next_batch() override {
+        std::size_t n = 0;
+        try {
+            while (n < batch_.size() && reader_.receive_tick(batch_[n])) {
+                ++n;
+            }
+        } catch (const zmq::error_t& e) {
+            std::cerr << "Error receiving data: " << e.what() << std::endl;
+        }
+        return {batch_.data(), n};
+    }
+
+private:
+    const ZeroMQDataReader& reader_;
+    std::vector<Tick> batch_;
+};
+
+std::unique_ptr<ITickCursor> ZeroMQDataReader::open_tick_cursor() const {
+    if (data_loaded_) {
+        return std::make_unique<VectorTickCursor>(received_ticks_);
+    }
+    return std::make_unique<StreamCursor>(*this);
+}
+
 bool ZeroMQDataReader::is_complete() const {
     return reception_complete_;
 }
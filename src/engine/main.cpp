@@ -22,7 +22,10 @@ int main() {
 
         // --- Create Components ---
         std::cout << "Initializing components..." << std::endl;
-        auto data_reader = std::make_unique<qse::CSVDataReader>(data_file, symbol);
+        // Cached: the first run parses the CSV and writes a binary tick cache
+        // beside it; later runs over the unchanged file just map the cache
+        auto data_reader = std::make_unique<qse::CSVDataReader>(
+            data_file, symbol, qse::CSVDataReader::LoadMode::Cached);
         auto order_manager = std::make_unique<qse::OrderManager>(
             initial_capital, "equity_curve.csv", "tradelog.csv");
         auto strategy =
@@ -7,13 +7,12 @@
 #include <iomanip>
 #include <sstream>
 
-#include "qse/data/CSVDataReader.h"
+#include "qse/core/BacktestBatchRunner.h"
 #include "qse/strategy/SMACrossoverStrategy.h"
 #include "qse/strategy/FillTrackingStrategy.h"
 #include "qse/strategy/PairsTradingStrategy.h"
 #include "qse/strategy/DoNothingStrategy.h"
 #include "qse/order/OrderManager.h"
-#include "qse/core/Backtester.h"
 
 std::string get_timestamp_suffix() {
     auto now = std::chrono::system_clock::now();
@@ -26,117 +25,66 @@ std::string get_timestamp_suffix() {
     return ss.str();
 }
 
-void run_all_strategies_for_symbol(const std::string& symbol, const std::string& timestamp_suffix) {
-    try {
-        std::cout << "\n=== Running All Strategies for " << symbol << " ===" << std::endl;
-
-        // Configuration
-        const std::string data_file = "data/raw_ticks_" + symbol + ".csv";
-        const double initial_capital = 100000.0;
-
-        std::cout << "Data file: " << data_file << std::endl;
-
-        // ---------- Strategy 1: SMA Crossover (20/50) ----------
-        {
-            std::cout << "Running SMA Crossover Strategy..." << std::endl;
-            auto om_sma = std::make_unique<qse::OrderManager>(
-                initial_capital,
-                "results/equity_" + symbol + "_SMA_20_50_" + timestamp_suffix + ".csv",
-                "results/tradelog_" + symbol + "_SMA_20_50_" + timestamp_suffix + ".csv");
-
-            auto strat_sma =
-                std::make_unique<qse::SMACrossoverStrategy>(om_sma.get(), 20, 50, symbol);
-
-            qse::Backtester bt_sma(symbol, std::make_unique<qse::CSVDataReader>(data_file),
-                                   std::move(strat_sma), std::move(om_sma),
-                                   std::chrono::seconds(60));
-
-            bt_sma.run();
-        }
-
-        // ---------- Strategy 2: Fill Tracking (Smoke Test) ----------
-        {
-            std::cout << "Running Fill Tracking Strategy..." << std::endl;
-            auto om_fill = std::make_shared<qse::OrderManager>(
-                initial_capital,
-                "results/equity_" + symbol + "_FillTracking_" + timestamp_suffix + ".csv",
-                "results/tradelog_" + symbol + "_FillTracking_" + timestamp_suffix + ".csv");
-
-            auto strat_fill = std::make_unique<qse::FillTrackingStrategy>(om_fill);
-
-            qse::Backtester bt_fill(symbol, std::make_unique<qse::CSVDataReader>(data_file),
-                                    std::move(strat_fill), om_fill, std::chrono::seconds(60));
-
-            bt_fill.run();
-        }
-
-        // ---------- Strategy 3: Do Nothing (Baseline) ----------
-        {
-            std::cout << "Running Do Nothing Strategy (Baseline)..." << std::endl;
-            auto om_do_nothing = std::make_unique<qse::OrderManager>(
-                initial_capital,
-                "results/equity_" + symbol + "_DoNothing_" + timestamp_suffix + ".csv",
-                "results/tradelog_" + symbol + "_DoNothing_" + timestamp_suffix + ".csv");
-
-            auto strat_do_nothing = std::make_unique<qse::DoNothingStrategy>();
-
-            qse::Backtester bt_do_nothing(symbol, std::make_unique<qse::CSVDataReader>(data_file),
-                                          std::move(strat_do_nothing), std::move(om_do_nothing),
-                                          std::chrono::seconds(60));
-
-            bt_do_nothing.run();
-        }
-
-        std::cout << "Completed " << symbol << " with all individual strategies" << std::endl;
-
-    } catch (const std::exception& e) {
-        std::cerr << "Error running strategies for " << symbol << ": " << e.what() << std::endl;
-    }
+qse::BacktestJob make_job(const std::string& symbol, const std::string& label,
+                         const std::string& timestamp_suffix,
+                         qse::BacktestJob::StrategyFactory make_strategy) {
+    qse::BacktestJob job;
+    job.name = symbol + "_" + label;
+    job.symbol = symbol;
+    job.sources = {{"data/raw_ticks_" + symbol + ".csv", ""}};
+    job.make_strategy = std::move(make_strategy);
+    job.equity_file = "results/equity_" + symbol + "_" + label + "_" + timestamp_suffix + ".csv";
+    job.tradelog_file =
+        "results/tradelog_" + symbol + "_" + label + "_" + timestamp_suffix + ".csv";
+    return job;
 }
 
-void run_pairs_trading(const std::string& timestamp_suffix) {
-    try {
-        std::cout << "\n=== Running Pairs Trading Strategy (Aggressive) ===" << std::endl;
-
-        // Pairs trading needs two symbols - using AAPL and GOOG as an example
-        const std::string symbol1 = "AAPL";
-        const std::string symbol2 = "GOOG";
-        const std::string data_file1 = "data/raw_ticks_" + symbol1 + ".csv";
-        const std::string data_file2 = "data/raw_ticks_" + symbol2 + ".csv";
-        const double initial_capital = 100000.0;
-
-        std::cout << "Pairs Trading: " << symbol1 << " vs " << symbol2 << std::endl;
-        std::cout << "Using AGGRESSIVE parameters:" << std::endl;
-        std::cout << "  - Spread window: 10 (was 20)" << std::endl;
-        std::cout << "  - Entry threshold: 1.0 (was 2.0)" << std::endl;
-        std::cout << "  - Exit threshold: 0.2 (was 0.5)" << std::endl;
-
-        auto om_pairs =
-            std::make_shared<qse::OrderManager>(initial_capital,
-                                                "results/equity_PairsTrading_" + symbol1 + "_" +
-                                                    symbol2 + "_" + timestamp_suffix + ".csv",
-                                                "results/tradelog_PairsTrading_" + symbol1 + "_" +
-                                                    symbol2 + "_" + timestamp_suffix + ".csv");
-
-        // Use aggressive parameters that should generate trades
-        auto strat_pairs = std::make_unique<qse::PairsTradingStrategy>(symbol1, symbol2, 1.0, 20,
-                                                                       2.0, 0.5, om_pairs);
-
-        qse::Backtester bt_pairs(
-            symbol1 + "_" + symbol2,                                   // Combined symbol name
-            std::make_unique<qse::CSVDataReader>(data_file1, symbol1), // Primary data source
-            std::move(strat_pairs), om_pairs, std::chrono::seconds(60));
-
-        // Add the second leg's data source so the backtester processes both streams
-        bt_pairs.add_data_source(std::make_unique<qse::CSVDataReader>(data_file2, symbol2));
-
-        bt_pairs.run();
-
-        std::cout << "Completed Pairs Trading Strategy (Aggressive)" << std::endl;
+void add_all_strategies_for_symbol(qse::BacktestBatchRunner& runner, const std::string& symbol,
+                                   const std::string& timestamp_suffix) {
+    std::cout << "Queued SMA 20/50, FillTracking and DoNothing for " << symbol << std::endl;
+
+    // ---------- Strategy 1: SMA Crossover (20/50) ----------
+    runner.add_job(make_job(symbol, "SMA_20_50", timestamp_suffix,
+                            [symbol](const std::shared_ptr<qse::OrderManager>& om) {
+                                return std::make_unique<qse::SMACrossoverStrategy>(
+                                    om.get(), 20, 50, symbol);
+                            }));
+
+    // ---------- Strategy 2: Fill Tracking (Smoke Test) ----------
+    runner.add_job(make_job(symbol, "FillTracking", timestamp_suffix,
+                            [](const std::shared_ptr<qse::OrderManager>& om) {
+                                return std::make_unique<qse::FillTrackingStrategy>(om);
+                            }));
+
+    // ---------- Strategy 3: Do Nothing (Baseline) ----------
+    runner.add_job(make_job(symbol, "DoNothing", timestamp_suffix,
+                            [](const std::shared_ptr<qse::OrderManager>&) {
+                                return std::make_unique<qse::DoNothingStrategy>();
+                            }));
+}
 
-    } catch (const std::exception& e) {
-        std::cerr << "Error running pairs trading: " << e.what() << std::endl;
-    }
+void add_pairs_trading(qse::BacktestBatchRunner& runner, const std::string& timestamp_suffix) {
+    // Pairs trading needs two symbols - using AAPL and GOOG as an example
+    const std::string symbol1 = "AAPL";
+    const std::string symbol2 = "GOOG";
+    const std::string pair = symbol1 + "_" + symbol2;
+
+    std::cout << "Queued Pairs Trading: " << symbol1 << " vs " << symbol2 << std::endl;
+
+    qse::BacktestJob job;
+    job.name = "PairsTrading_" + pair;
+    job.symbol = pair; // Combined symbol name
+    // Primary data source first, then the second leg; each leg is its own
+    // shared dataset because the reader tags it with the leg's symbol
+    job.sources = {{"data/raw_ticks_" + symbol1 + ".csv", symbol1},
+                   {"data/raw_ticks_" + symbol2 + ".csv", symbol2}};
+    job.make_strategy = [symbol1, symbol2](const std::shared_ptr<qse::OrderManager>& om) {
+        return std::make_unique<qse::PairsTradingStrategy>(symbol1, symbol2, 1.0, 20, 2.0, 0.5,
+                                                           om);
+    };
+    job.equity_file = "results/equity_PairsTrading_" + pair + "_" + timestamp_suffix + ".csv";
+    job.tradelog_file = "results/tradelog_PairsTrading_" + pair + "_" + timestamp_suffix + ".csv";
+    runner.add_job(std::move(job));
 }
 
 int main() {
@@ -151,13 +99,17 @@ int main() {
         // List of symbols to process
         std::vector<std::string> symbols = {"AAPL", "GOOG", "MSFT", "SPY"};
 
-        // Run all individual strategies for each symbol
+        // Every strategy on every symbol, plus the pair, is one job of a
+        // single parallel batch; each data file is loaded once
+        qse::BacktestBatchRunner runner;
         for (const auto& symbol : symbols) {
-            run_all_strategies_for_symbol(symbol, timestamp_suffix);
+            add_all_strategies_for_symbol(runner, symbol, timestamp_suffix);
         }
+        add_pairs_trading(runner, timestamp_suffix);
 
-        // Run pairs trading strategy
-        run_pairs_trading(timestamp_suffix);
+        const auto results = runner.run();
+        std::cout << std::endl;
+        qse::BacktestBatchRunner::print_results(results, std::cout);
 
         // Overall timing
         auto overall_end = std::chrono::high_resolution_clock::now();
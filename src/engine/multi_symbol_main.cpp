@@ -7,10 +7,9 @@
 #include <iomanip>
 #include <sstream>
 
-#include "qse/data/CSVDataReader.h"
+#include "qse/core/BacktestBatchRunner.h"
 #include "qse/strategy/SMACrossoverStrategy.h"
 #include "qse/order/OrderManager.h"
-#include "qse/core/Backtester.h"
 #include "qse/strategy/FillTrackingStrategy.h"
 
 std::string get_timestamp_suffix() {
@@ -24,64 +23,35 @@ std::string get_timestamp_suffix() {
     return ss.str();
 }
 
-void run_strategy_for_symbol(const std::string& symbol, const std::string& timestamp_suffix) {
-    try {
-        std::cout << "\n=== Running Strategy for " << symbol << " ===" << std::endl;
-
-        // Configuration
-        const std::string data_file = "data/raw_ticks_" + symbol + ".csv";
-        const double initial_capital = 100000.0;
-
-        // Create unique output filenames with timestamp
-        const std::string equity_file =
-            "results/equity_" + symbol + "_" + timestamp_suffix + ".csv";
-        const std::string tradelog_file =
-            "results/tradelog_" + symbol + "_" + timestamp_suffix + ".csv";
-
-        std::cout << "Data file: " << data_file << std::endl;
-        std::cout << "Equity output: " << equity_file << std::endl;
-        std::cout << "Tradelog output: " << tradelog_file << std::endl;
-
-        // Shared data reader (can be reused by both strategies)
-        auto data_reader = std::make_unique<qse::CSVDataReader>(data_file);
-
-        // ---------- Strategy 1: Long-term SMA (20/50) ----------
-        {
-            auto om_sma = std::make_unique<qse::OrderManager>(
-                initial_capital, "results/equity_" + symbol + "_sma_" + timestamp_suffix + ".csv",
-                "results/tradelog_" + symbol + "_sma_" + timestamp_suffix + ".csv");
-
-            auto strat_sma =
-                std::make_unique<qse::SMACrossoverStrategy>(om_sma.get(), 20, 50, symbol);
-
-            qse::Backtester bt_sma(symbol,
-                                   std::make_unique<qse::CSVDataReader>(data_file), // fresh reader
-                                   std::move(strat_sma), std::move(om_sma),
-                                   std::chrono::seconds(60));
-
-            bt_sma.run();
-        }
-
-        // ---------- Strategy 2: Fill-tracking smoke test ----------
-        {
-            auto om_fill = std::make_shared<qse::OrderManager>(
-                initial_capital, "results/equity_" + symbol + "_fill_" + timestamp_suffix + ".csv",
-                "results/tradelog_" + symbol + "_fill_" + timestamp_suffix + ".csv");
-
-            auto strat_fill = std::make_unique<qse::FillTrackingStrategy>(om_fill);
-
-            qse::Backtester bt_fill(symbol,
-                                    std::make_unique<qse::CSVDataReader>(data_file), // fresh reader
-                                    std::move(strat_fill), om_fill, std::chrono::seconds(60));
-
-            bt_fill.run();
-        }
-
-        std::cout << "Completed " << symbol << " with SMA & FillTracking" << std::endl;
-
-    } catch (const std::exception& e) {
-        std::cerr << "Error running strategy for " << symbol << ": " << e.what() << std::endl;
-    }
+// Two strategies per symbol; both replay the symbol's one shared dataset
+void add_jobs_for_symbol(qse::BacktestBatchRunner& runner, const std::string& symbol,
+                         const std::string& timestamp_suffix) {
+    const std::string data_file = "data/raw_ticks_" + symbol + ".csv";
+    std::cout << "Queued " << symbol << " (" << data_file << ")" << std::endl;
+
+    // ---------- Strategy 1: Long-term SMA (20/50) ----------
+    qse::BacktestJob sma;
+    sma.name = symbol + "_sma";
+    sma.symbol = symbol;
+    sma.sources = {{data_file, ""}};
+    sma.make_strategy = [symbol](const std::shared_ptr<qse::OrderManager>& om) {
+        return std::make_unique<qse::SMACrossoverStrategy>(om.get(), 20, 50, symbol);
+    };
+    sma.equity_file = "results/equity_" + symbol + "_sma_" + timestamp_suffix + ".csv";
+    sma.tradelog_file = "results/tradelog_" + symbol + "_sma_" + timestamp_suffix + ".csv";
+    runner.add_job(std::move(sma));
+
+    // ---------- Strategy 2: Fill-tracking smoke test ----------
+    qse::BacktestJob fill;
+    fill.name = symbol + "_fill";
+    fill.symbol = symbol;
+    fill.sources = {{data_file, ""}};
+    fill.make_strategy = [](const std::shared_ptr<qse::OrderManager>& om) {
+        return std::make_unique<qse::FillTrackingStrategy>(om);
+    };
+    fill.equity_file = "results/equity_" + symbol + "_fill_" + timestamp_suffix + ".csv";
+    fill.tradelog_file = "results/tradelog_" + symbol + "_fill_" + timestamp_suffix + ".csv";
+    runner.add_job(std::move(fill));
 }
 
 int main() {
@@ -96,10 +66,15 @@ int main() {
         // List of symbols to process
         std::vector<std::string> symbols = {"AAPL", "GOOG", "MSFT", "SPY"};
 
-        // Run strategy for each symbol
+        // Every (symbol, strategy) pair is one job; the runner loads each
+        // symbol once and runs the jobs in parallel
+        qse::BacktestBatchRunner runner;
         for (const auto& symbol : symbols) {
-            run_strategy_for_symbol(symbol, timestamp_suffix);
+            add_jobs_for_symbol(runner, symbol, timestamp_suffix);
         }
+        const auto results = runner.run();
+        std::cout << std::endl;
+        qse::BacktestBatchRunner::print_results(results, std::cout);
 
         // Overall timing
         auto overall_end = std::chrono::high_resolution_clock::now();
@@ -71,7 +71,7 @@ bool is_terminal(qse::Order::Status status) {
 
 qse::Order parse_order(const json& j) {
     qse::Order order;
-    order.order_id = j.value("id", "");
+    order.venue_order_id = j.value("id", "");
     order.symbol = j.value("symbol", "");
     order.side = j.value("side", "buy") == std::string("buy") ? qse::Order::Side::BUY
                                                               : qse::Order::Side::SELL;
@@ -120,7 +120,7 @@ std::vector<std::string> AlpacaExecutionHandler::auth_headers() const {
             "Content-Type: application/json"};
 }
 
-OrderId AlpacaExecutionHandler::submit(const std::string& body_json) {
+VenueOrderId AlpacaExecutionHandler::submit(const std::string& body_json) {
     HttpResponse response = http_->post(base_url_ + "/v2/orders", auth_headers(), body_json);
     if (!response.ok()) {
         std::cerr << "[Alpaca] order rejected (HTTP " << response.status << "): " << response.body
@@ -129,7 +129,7 @@ OrderId AlpacaExecutionHandler::submit(const std::string& body_json) {
     }
     try {
         auto parsed = json::parse(response.body);
-        OrderId id = parsed.value("id", "");
+        VenueOrderId id = parsed.value("id", "");
         if (!id.empty()) {
             emitted_fill_qty_[id] = 0; // start tracking for poll_fills
         }
@@ -140,8 +140,8 @@ OrderId AlpacaExecutionHandler::submit(const std::string& body_json) {
     }
 }
 
-OrderId AlpacaExecutionHandler::submit_market_order(const std::string& symbol, Order::Side side,
-                                                    Volume quantity) {
+VenueOrderId AlpacaExecutionHandler::submit_market_order(const std::string& symbol,
+                                                         Order::Side side, Volume quantity) {
     json body = {{"symbol", symbol},
                  {"qty", std::to_string(quantity)},
                  {"side", side_to_string(side)},
@@ -150,9 +150,10 @@ OrderId AlpacaExecutionHandler::submit_market_order(const std::string& symbol, O
     return submit(body.dump());
 }
 
-OrderId AlpacaExecutionHandler::submit_limit_order(const std::string& symbol, Order::Side side,
-                                                   Volume quantity, Price limit_price,
-                                                   Order::TimeInForce tif) {
+VenueOrderId AlpacaExecutionHandler::submit_limit_order(const std::string& symbol,
+                                                        Order::Side side, Volume quantity,
+                                                        Price limit_price,
+                                                        Order::TimeInForce tif) {
     json body = {{"symbol", symbol},
                  {"qty", std::to_string(quantity)},
                  {"side", side_to_string(side)},
@@ -162,13 +163,13 @@ OrderId AlpacaExecutionHandler::submit_limit_order(const std::string& symbol, Or
     return submit(body.dump());
 }
 
-bool AlpacaExecutionHandler::cancel_order(const OrderId& order_id) {
+bool AlpacaExecutionHandler::cancel_order(const VenueOrderId& order_id) {
     HttpResponse response = http_->del(base_url_ + "/v2/orders/" + order_id, auth_headers());
     return response.ok(); // Alpaca answers 204 on success
 }
 
-OrderId AlpacaExecutionHandler::replace_order(const OrderId& order_id, Volume new_quantity,
-                                              Price new_limit_price) {
+VenueOrderId AlpacaExecutionHandler::replace_order(const VenueOrderId& order_id,
+                                                   Volume new_quantity, Price new_limit_price) {
     json body = {{"qty", std::to_string(new_quantity)},
                  {"limit_price", std::to_string(new_limit_price)}};
     HttpResponse response =
@@ -178,7 +179,7 @@ OrderId AlpacaExecutionHandler::replace_order(const OrderId& order_id, Volume ne
     }
     try {
         auto parsed = json::parse(response.body);
-        OrderId new_id = parsed.value("id", "");
+        VenueOrderId new_id = parsed.value("id", "");
         if (!new_id.empty() && new_id != order_id) {
             // Alpaca issues a fresh order id on replace: carry over the
             // already-emitted fill count so partial fills are not re-emitted
@@ -191,7 +192,7 @@ OrderId AlpacaExecutionHandler::replace_order(const OrderId& order_id, Volume ne
     }
 }
 
-std::optional<Order> AlpacaExecutionHandler::get_order(const OrderId& order_id) const {
+std::optional<Order> AlpacaExecutionHandler::get_order(const VenueOrderId& order_id) const {
     HttpResponse response = http_->get(base_url_ + "/v2/orders/" + order_id, auth_headers());
     if (!response.ok()) {
         return std::nullopt;
@@ -218,8 +219,9 @@ std::size_t AlpacaExecutionHandler::poll_fills() {
         if (order->filled_quantity > it->second) {
             Volume delta = order->filled_quantity - it->second;
             if (fill_callback_) {
-                Fill fill(order->order_id, order->symbol, delta, order->avg_fill_price,
+                Fill fill(kInvalidOrderId, order->symbol, delta, order->avg_fill_price,
                           order->timestamp, order->side == Order::Side::BUY ? "BUY" : "SELL");
+                fill.venue_order_id = order->venue_order_id;
                 fill_callback_(fill);
             }
             it->second = order->filled_quantity;
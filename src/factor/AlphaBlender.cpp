@@ -1,4 +1,5 @@
 #include "qse/factor/AlphaBlender.h"
+#include "qse/factor/FactorStore.h"
 #include <cstdint>
 #include <arrow/array.h>
 #include <arrow/array/array_primitive.h>
@@ -58,6 +59,16 @@ void AlphaBlender::set_config(const BlendingConfig& config) {
     config_ = config;
 }
 
+AlphaBlender::BlendingResult
+AlphaBlender::blend_factors(const FactorStore& store, const FactorQuery& query,
+                            const std::vector<std::string>& factor_cols,
+                            const std::string& return_col) {
+    FactorQuery projected = query;
+    projected.columns = factor_cols;
+    projected.columns.push_back(return_col);
+    return blend_factors(store.read(projected), factor_cols, return_col, "date");
+}
+
 AlphaBlender::BlendingResult
 AlphaBlender::blend_factors(const std::shared_ptr<arrow::Table>& table,
                             const std::vector<std::string>& factor_cols,
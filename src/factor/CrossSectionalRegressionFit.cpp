@@ -0,0 +1,195 @@
+// The CrossSectionalRegression numerics: one cross-section's OLS fit and the
+// per-date pass over a panel. No Arrow here; reading tables and stores is in
+// CrossSectionalRegression.cpp.
+
+#include "qse/factor/CrossSectionalRegression.h"
+#include "qse/core/WorkStealingPool.h"
+#include "qse/math/StatsUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+namespace qse {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// A Cholesky factor whose smallest diagonal entry is below this fraction of
+// its largest belongs to an X'X with a condition number above about 1e14:
+// the exposures are collinear and the fit goes through QR instead
+constexpr double kMinPivotRatio = 1e-7;
+
+// body(i) for i in [0, n), on the pool when there is one
+template <class F>
+void for_each_index(WorkStealingPool* pool, std::size_t n, F&& body) {
+    if (pool) {
+        pool->parallel_for(0, n, body);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            body(i);
+        }
+    }
+}
+
+} // namespace
+
+CrossSectionalRegression::RegressionData
+CrossSectionalRegression::gather_rows(const CrossSectionInput& input,
+                                      const std::vector<std::size_t>& order, std::size_t begin,
+                                      std::size_t end) {
+    const std::size_t k = input.exposures.size();
+    RegressionData data;
+    data.X.resize(static_cast<Eigen::Index>(end - begin), static_cast<Eigen::Index>(k));
+    data.y.resize(static_cast<Eigen::Index>(end - begin));
+    Eigen::Index n = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        const std::size_t row = order[i];
+        bool complete = !std::isnan(input.returns[row]);
+        for (std::size_t j = 0; j < k && complete; ++j) {
+            complete = !std::isnan(input.exposures[j][row]);
+        }
+        if (!complete) {
+            continue;
+        }
+        data.y(n) = input.returns[row];
+        for (std::size_t j = 0; j < k; ++j) {
+            data.X(n, static_cast<Eigen::Index>(j)) = input.exposures[j][row];
+        }
+        ++n;
+    }
+    data.X.conservativeResize(n, Eigen::NoChange);
+    data.y.conservativeResize(n);
+    return data;
+}
+
+CrossSectionalRegression::RegressionResult
+CrossSectionalRegression::fit_cross_section(RegressionData& data) const {
+    const Eigen::Index n = data.X.rows();
+    const Eigen::Index k = data.X.cols();
+
+    RegressionResult result;
+    result.num_factors = static_cast<int>(k);
+    result.num_observations = static_cast<int>(n);
+    if (n == 0 || k == 0) {
+        return result;
+    }
+
+    std::vector<double> scratch;
+    math::winsorize(data.y.data(), n, winsor_quantile_, scratch);
+    for (Eigen::Index j = 0; j < k; ++j) {
+        math::winsorize(data.X.col(j).data(), n, winsor_quantile_, scratch);
+    }
+
+    // The only passes over the observations: X'X, X'y and the residuals.
+    // Everything else is k x k.
+    Eigen::MatrixXd gram = Eigen::MatrixXd::Zero(k, k);
+    gram.selfadjointView<Eigen::Lower>().rankUpdate(data.X.transpose());
+    gram = gram.selfadjointView<Eigen::Lower>();
+    const Eigen::VectorXd xty = data.X.transpose() * data.y;
+
+    Eigen::VectorXd beta;
+    Eigen::VectorXd inverse_diagonal; // diag((X'X)^-1)
+    const Eigen::LLT<Eigen::MatrixXd> llt(gram);
+    const Eigen::VectorXd pivots = llt.matrixLLT().diagonal();
+    if (llt.info() == Eigen::Success && pivots.minCoeff() > kMinPivotRatio * pivots.maxCoeff()) {
+        beta = llt.solve(xty);
+        inverse_diagonal = llt.solve(Eigen::MatrixXd::Identity(k, k)).diagonal();
+    } else {
+        // Collinear exposures: a basic solution that zeroes the redundant
+        // factors, and no standard errors since (X'X)^-1 does not exist
+        beta = data.X.colPivHouseholderQr().solve(data.y);
+        inverse_diagonal = Eigen::VectorXd::Constant(k, kNaN);
+    }
+
+    const Eigen::VectorXd residuals = data.y - data.X * beta;
+    const double ssr = residuals.squaredNorm();
+    const double yty = data.y.squaredNorm();
+    const double sst = (data.y.array() - data.y.mean()).square().sum();
+    const double residual_variance = n > k ? ssr / static_cast<double>(n - k) : kNaN;
+
+    result.factor_returns.assign(beta.data(), beta.data() + k);
+    result.residuals.assign(residuals.data(), residuals.data() + n);
+    result.total_r_squared = sst == 0.0 ? 0.0 : 1.0 - ssr / sst;
+    result.factor_std_errors.resize(k);
+    result.factor_t_stats.resize(k);
+    result.factor_r_squared.resize(k);
+    for (Eigen::Index i = 0; i < k; ++i) {
+        const double std_error = std::sqrt(residual_variance * inverse_diagonal(i));
+        result.factor_std_errors[i] = std_error;
+        result.factor_t_stats[i] = std_error != 0.0 ? beta(i) / std_error : 0.0;
+
+        // Factor i on its own, from the same cross-products: the univariate
+        // no-intercept fit leaves y'y - (x'y)^2 / x'x unexplained
+        const double xx = gram(i, i);
+        const double single_ssr = xx > 0.0 ? yty - xty(i) * xty(i) / xx : yty;
+        result.factor_r_squared[i] = sst == 0.0 ? 0.0 : 1.0 - single_ssr / sst;
+    }
+    return result;
+}
+
+std::vector<CrossSectionalRegression::RegressionResult>
+CrossSectionalRegression::run_cross_sections(const CrossSectionInput& input) {
+    const std::size_t rows = input.dates.size();
+    if (input.returns.size() != rows) {
+        throw std::invalid_argument("run_cross_sections: returns and dates differ in length");
+    }
+    for (const std::vector<double>& column : input.exposures) {
+        if (column.size() != rows) {
+            throw std::invalid_argument(
+                "run_cross_sections: an exposure column and dates differ in length");
+        }
+    }
+    const std::size_t k = input.exposures.size();
+
+    // Rows grouped by date, input order kept within a date. Panels read from
+    // a store are already date-major, so the sort is usually skipped.
+    std::vector<std::size_t> order(rows);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    const auto by_date = [&](std::size_t a, std::size_t b) {
+        return input.dates[a] < input.dates[b];
+    };
+    if (!std::is_sorted(order.begin(), order.end(), by_date)) {
+        std::stable_sort(order.begin(), order.end(), by_date);
+    }
+    std::vector<std::size_t> starts;
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (i == 0 || input.dates[order[i]] != input.dates[order[i - 1]]) {
+            starts.push_back(i);
+        }
+    }
+    starts.push_back(rows);
+    const std::size_t num_dates = starts.size() - 1;
+
+    std::unique_ptr<WorkStealingPool> pool;
+    if (threads_ != 1 && num_dates > 1) {
+        pool = std::make_unique<WorkStealingPool>(threads_);
+    }
+
+    std::vector<RegressionResult> fitted(num_dates);
+    std::vector<char> usable(num_dates, 0);
+    for_each_index(pool.get(), num_dates, [&](std::size_t d) {
+        RegressionData data = gather_rows(input, order, starts[d], starts[d + 1]);
+        if (data.y.size() <= static_cast<Eigen::Index>(k)) {
+            return;
+        }
+        fitted[d] = fit_cross_section(data);
+        fitted[d].date = input.dates[order[starts[d]]];
+        usable[d] = 1;
+    });
+
+    std::vector<RegressionResult> results;
+    results.reserve(num_dates);
+    for (std::size_t d = 0; d < num_dates; ++d) {
+        if (usable[d]) {
+            results.push_back(std::move(fitted[d]));
+        }
+    }
+    return results;
+}
+
+} // namespace qse
@@ -0,0 +1,257 @@
+#include "qse/factor/FactorPanel.h"
+#include "qse/core/WorkStealingPool.h"
+#include "qse/math/FactorKernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace qse {
+
+namespace {
+
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+// body(i) for i in [0, n), on the pool when there is one
+template <class F>
+void for_each_index(WorkStealingPool* pool, std::size_t n, F&& body) {
+    if (pool) {
+        pool->parallel_for(0, n, body);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            body(i);
+        }
+    }
+}
+
+// Dense ids numbered in key order, so the result does not depend on the
+// order rows arrive in.
+//
+// A panel lists its keys periodically: a symbol-major file repeats a symbol
+// on consecutive rows, a date-major one repeats the whole list of symbols
+// every date. Each row is first compared with the row one period back, and
+// only hashed when that guess fails; a failed guess that finds a known key
+// re-learns the period from that key's previous row.
+template <class Key>
+std::size_t assign_ids(const std::vector<Key>& keys, std::vector<std::uint32_t>& ids) {
+    std::unordered_map<Key, std::uint32_t> seen;
+    std::vector<const Key*> distinct;
+    std::vector<std::size_t> last_row;
+    ids.resize(keys.size());
+    std::size_t period = 1;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (i >= period && keys[i] == keys[i - period]) {
+            ids[i] = ids[i - period];
+        } else {
+            const auto next_id = static_cast<std::uint32_t>(distinct.size());
+            auto [it, inserted] = seen.try_emplace(keys[i], next_id);
+            if (inserted) {
+                distinct.push_back(&keys[i]);
+                last_row.push_back(i);
+            } else {
+                period = i - last_row[it->second];
+            }
+            ids[i] = it->second;
+        }
+        last_row[ids[i]] = i;
+    }
+
+    std::vector<std::uint32_t> by_key(distinct.size());
+    std::iota(by_key.begin(), by_key.end(), 0u);
+    std::sort(by_key.begin(), by_key.end(),
+              [&](std::uint32_t a, std::uint32_t b) { return *distinct[a] < *distinct[b]; });
+    std::vector<std::uint32_t> rank(distinct.size());
+    for (std::size_t r = 0; r < by_key.size(); ++r) {
+        rank[by_key[r]] = static_cast<std::uint32_t>(r);
+    }
+    for (std::uint32_t& id : ids) {
+        id = rank[id];
+    }
+    return distinct.size();
+}
+
+// Row positions grouped by id: positions of group g are
+// order[begin[g] .. begin[g + 1]), in increasing position
+void group_by(const std::vector<std::uint32_t>& ids, std::size_t groups,
+              std::vector<std::size_t>& order, std::vector<std::size_t>& begin) {
+    begin.assign(groups + 1, 0);
+    for (std::uint32_t id : ids) {
+        ++begin[id + 1];
+    }
+    for (std::size_t g = 0; g < groups; ++g) {
+        begin[g + 1] += begin[g];
+    }
+    order.resize(ids.size());
+    std::vector<std::size_t> next(begin.begin(), begin.end() - 1);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        order[next[ids[i]]++] = i;
+    }
+}
+
+// One row's factors, laid out by symbol then date. The three values share a
+// cache line, so the per-date pass loads each row once.
+struct FactorCell {
+    double mom;
+    double vol;
+    double value;
+    std::size_t row; // input row
+};
+
+constexpr double FactorCell::*kFactors[] = {&FactorCell::mom, &FactorCell::vol,
+                                            &FactorCell::value};
+
+} // namespace
+
+DateKey parse_date_key(const std::string& date) {
+    std::string digits = date;
+    if (date.size() == 10 && date[4] == '-' && date[7] == '-') {
+        digits = date.substr(0, 4) + date.substr(5, 2) + date.substr(8, 2);
+    }
+    const bool all_digits = std::all_of(digits.begin(), digits.end(), [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c)) != 0;
+    });
+    if (digits.size() != 8 || !all_digits) {
+        throw std::invalid_argument("Invalid date '" + date + "', expected yyyy-mm-dd");
+    }
+    const auto key = static_cast<DateKey>(std::stol(digits));
+    const int month = key / 100 % 100;
+    const int day = key % 100;
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        throw std::invalid_argument("Invalid date '" + date + "', expected yyyy-mm-dd");
+    }
+    return key;
+}
+
+std::string format_date_key(DateKey date) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", date / 10000, date / 100 % 100,
+                  date % 100);
+    return text;
+}
+
+FactorPanel::FactorPanel(FactorPanelSettings settings) : settings_(settings) {
+    if (settings_.momentum_skip > settings_.momentum_lookback) {
+        throw std::invalid_argument("momentum_skip must not exceed momentum_lookback");
+    }
+}
+
+FactorPanelOutput FactorPanel::compute(const FactorPanelInput& input) const {
+    const std::size_t n = input.symbols.size();
+    if (input.dates.size() != n || input.close.size() != n || input.pb.size() != n) {
+        throw std::invalid_argument("FactorPanel: input columns differ in length");
+    }
+
+    FactorPanelOutput out;
+    std::vector<std::uint32_t> symbol_ids, date_ids;
+    out.num_symbols = assign_ids(input.symbols, symbol_ids);
+    out.num_dates = assign_ids(input.dates, date_ids);
+
+    std::unique_ptr<WorkStealingPool> pool;
+    if (settings_.threads != 1 && out.num_symbols > 1) {
+        pool = std::make_unique<WorkStealingPool>(settings_.threads);
+    }
+
+    // Symbol-major layout: by_symbol[sym_begin[s] .. sym_begin[s + 1]) are
+    // the input rows of symbol s, sorted by date. cells and cell_dates
+    // follow the same order.
+    std::vector<std::size_t> by_symbol, sym_begin;
+    group_by(symbol_ids, out.num_symbols, by_symbol, sym_begin);
+    symbol_ids = {};
+
+    // Every cell is written before it is read; skip zeroing a large array
+    std::unique_ptr<FactorCell[]> cells(new FactorCell[n]);
+    std::vector<std::uint32_t> cell_dates(n);
+
+    for_each_index(pool.get(), out.num_symbols, [&](std::size_t s) {
+        const std::size_t begin = sym_begin[s];
+        const std::size_t len = sym_begin[s + 1] - begin;
+        auto first = by_symbol.begin() + static_cast<std::ptrdiff_t>(begin);
+        auto last = first + static_cast<std::ptrdiff_t>(len);
+        auto earlier = [&](std::size_t a, std::size_t b) {
+            return input.dates[a] < input.dates[b];
+        };
+        if (!std::is_sorted(first, last, earlier)) {
+            std::sort(first, last, earlier);
+        }
+        auto same_date = [&](std::size_t a, std::size_t b) {
+            return input.dates[a] == input.dates[b];
+        };
+        auto duplicate = std::adjacent_find(first, last, same_date);
+        if (duplicate != last) {
+            throw std::invalid_argument("FactorPanel: two rows for " + input.symbols[*duplicate] +
+                                        " on " + std::to_string(input.dates[*duplicate]));
+        }
+
+        // The symbol's columns, contiguous, then one kernel per factor
+        std::vector<double> close(len), pb(len), mom(len), returns(len), vol(len), value(len);
+        for (std::size_t k = 0; k < len; ++k) {
+            const std::size_t row = first[static_cast<std::ptrdiff_t>(k)];
+            close[k] = input.close[row];
+            pb[k] = input.pb[row];
+            cell_dates[begin + k] = date_ids[row];
+        }
+        math::momentum(close.data(), len, settings_.momentum_lookback, settings_.momentum_skip,
+                       mom.data());
+        std::fill_n(mom.begin(), std::min(settings_.momentum_lookback, len), kMissing);
+        math::simple_returns(close.data(), len, returns.data());
+        math::rolling_std(returns.data(), len, settings_.vol_window, vol.data());
+        std::fill_n(vol.begin(), std::min(settings_.vol_window, len), kMissing);
+        math::reciprocal(pb.data(), len, value.data());
+
+        for (std::size_t k = 0; k < len; ++k) {
+            cells[begin + k] = {mom[k], vol[k], pb[k] == 0.0 ? kMissing : value[k],
+                                first[static_cast<std::ptrdiff_t>(k)]};
+        }
+    });
+    date_ids = {};
+
+    // Date-major view: by_date[date_begin[d] .. date_begin[d + 1]) are the
+    // positions in `cells` of date d's rows, in symbol order
+    std::vector<std::size_t> by_date, date_begin;
+    group_by(cell_dates, out.num_dates, by_date, date_begin);
+    cell_dates = {};
+
+    out.mom_z.resize(n);
+    out.vol_z.resize(n);
+    out.val_z.resize(n);
+    out.alpha.resize(n);
+    const double weights[3] = {settings_.momentum_weight, settings_.vol_weight,
+                               settings_.value_weight};
+
+    for_each_index(pool.get(), out.num_dates, [&](std::size_t d) {
+        const std::size_t begin = date_begin[d];
+        const std::size_t count = date_begin[d + 1] - begin;
+        std::vector<FactorCell> section(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            section[k] = cells[by_date[begin + k]];
+        }
+        std::vector<double> column(count), finite;
+        finite.reserve(count);
+        for (double FactorCell::*factor : kFactors) {
+            for (std::size_t k = 0; k < count; ++k) {
+                column[k] = section[k].*factor;
+            }
+            math::cross_section_zscore(column.data(), count, settings_.winsor_quantile, finite);
+            for (std::size_t k = 0; k < count; ++k) {
+                section[k].*factor = column[k];
+            }
+        }
+        for (const FactorCell& cell : section) {
+            out.mom_z[cell.row] = cell.mom;
+            out.vol_z[cell.row] = cell.vol;
+            out.val_z[cell.row] = cell.value;
+            // Same sum, in the same order, as math::weighted_sum
+            out.alpha[cell.row] =
+                weights[0] * cell.mom + weights[1] * cell.vol + weights[2] * cell.value;
+        }
+    });
+    return out;
+}
+
+} // namespace qse
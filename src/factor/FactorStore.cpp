@@ -0,0 +1,134 @@
+// FactorStore layout and partition pruning. No Arrow here: the Parquet
+// encoding is in FactorStoreParquet.cpp.
+
+#include "qse/factor/FactorStore.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace qse {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr const char* kLayoutFile = "_factor_store";
+constexpr const char* kLayoutTag = "qse_factor_store";
+constexpr int kLayoutVersion = 1;
+
+// "date=2023-01-03" -> 20230103; false for anything else in the root
+bool parse_date_directory(const std::string& name, DateKey& date) {
+    const std::string prefix = "date=";
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    try {
+        date = parse_date_key(name.substr(prefix.size()));
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool FactorQuery::may_contain_symbols(const std::string& min_symbol,
+                                      const std::string& max_symbol) const {
+    if (symbols.empty()) {
+        return true;
+    }
+    return std::any_of(symbols.begin(), symbols.end(), [&](const std::string& symbol) {
+        return min_symbol <= symbol && symbol <= max_symbol;
+    });
+}
+
+std::uint32_t symbol_bucket(std::string_view symbol, std::uint32_t buckets) {
+    std::uint32_t hash = 2166136261u;
+    for (unsigned char c : symbol) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash % buckets;
+}
+
+std::string partition_directory(DateKey date, std::uint32_t bucket) {
+    return "date=" + format_date_key(date) + "/symbol_bucket=" + std::to_string(bucket);
+}
+
+FactorStore::FactorStore(std::string root, FactorStoreSettings settings)
+    : root_(std::move(root)), settings_(settings) {
+    const fs::path layout = fs::path(root_) / kLayoutFile;
+    std::error_code ec;
+    if (fs::exists(layout, ec)) {
+        std::ifstream file(layout);
+        std::string tag, key;
+        int version = 0;
+        std::uint32_t buckets = 0;
+        if (!(file >> tag >> version >> key >> buckets) || tag != kLayoutTag ||
+            version != kLayoutVersion || key != "symbol_buckets") {
+            throw std::runtime_error(layout.string() + " is not a factor store layout file");
+        }
+        settings_.symbol_buckets = buckets;
+    }
+    if (settings_.symbol_buckets == 0 || settings_.row_group_rows <= 0) {
+        throw std::invalid_argument("FactorStore: symbol_buckets and row_group_rows must be "
+                                    "positive");
+    }
+}
+
+void FactorStore::save_layout() const {
+    const fs::path layout = fs::path(root_) / kLayoutFile;
+    std::error_code ec;
+    if (fs::exists(layout, ec)) {
+        return;
+    }
+    fs::create_directories(root_);
+    std::ofstream file(layout, std::ios::trunc);
+    file << kLayoutTag << ' ' << kLayoutVersion << "\nsymbol_buckets " << settings_.symbol_buckets
+         << '\n';
+    if (!file) {
+        throw std::runtime_error("Could not write " + layout.string());
+    }
+}
+
+std::vector<FactorPartition> FactorStore::plan(const FactorQuery& query) const {
+    std::vector<FactorPartition> partitions;
+    std::error_code ec;
+    if (!fs::is_directory(root_, ec)) {
+        return partitions;
+    }
+
+    // Buckets holding the requested symbols; every bucket without a list
+    std::vector<bool> wanted(settings_.symbol_buckets, query.symbols.empty());
+    for (const std::string& symbol : query.symbols) {
+        wanted[symbol_bucket(symbol, settings_.symbol_buckets)] = true;
+    }
+
+    for (const fs::directory_entry& entry : fs::directory_iterator(root_)) {
+        DateKey date = 0;
+        if (!entry.is_directory(ec) ||
+            !parse_date_directory(entry.path().filename().string(), date) ||
+            !query.wants_date(date)) {
+            continue;
+        }
+        for (std::uint32_t bucket = 0; bucket < settings_.symbol_buckets; ++bucket) {
+            if (!wanted[bucket]) {
+                continue;
+            }
+            const fs::path file =
+                entry.path() / ("symbol_bucket=" + std::to_string(bucket)) / kFactorPartFile;
+            if (fs::is_regular_file(file, ec)) {
+                partitions.push_back({date, bucket, file.string()});
+            }
+        }
+    }
+    std::sort(partitions.begin(), partitions.end(),
+              [](const FactorPartition& a, const FactorPartition& b) {
+                  return a.date != b.date ? a.date < b.date : a.bucket < b.bucket;
+              });
+    return partitions;
+}
+
+} // namespace qse
@@ -0,0 +1,353 @@
+// Parquet encoding for FactorStore: kept apart from FactorStore.cpp so the
+// layout and pruning logic do not pull in Arrow.
+
+#include "qse/core/ArrowUtil.h"
+#include "qse/factor/FactorStore.h"
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+#include <parquet/metadata.h>
+#include <parquet/properties.h>
+#include <parquet/schema.h>
+#include <parquet/statistics.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace qse {
+namespace {
+
+namespace fs = std::filesystem;
+
+// A utf8 column of a table whose columns are one chunk each
+std::shared_ptr<arrow::StringArray> string_array(const arrow::Table& table,
+                                                 const std::string& name) {
+    auto column = table.GetColumnByName(name);
+    if (!column || column->type()->id() != arrow::Type::STRING) {
+        throw std::invalid_argument("FactorStore: the table needs a utf8 '" + name + "' column");
+    }
+    return std::static_pointer_cast<arrow::StringArray>(column->chunk(0));
+}
+
+std::unique_ptr<arrow::ArrayBuilder> make_builder(const std::shared_ptr<arrow::DataType>& type) {
+    auto builder = arrow::MakeBuilder(type, arrow::default_memory_pool());
+    throw_if_not_ok(builder.status());
+    return std::move(builder).ValueOrDie();
+}
+
+std::shared_ptr<arrow::Array> finish(arrow::ArrayBuilder& builder) {
+    std::shared_ptr<arrow::Array> array;
+    throw_if_not_ok(builder.Finish(&array));
+    return array;
+}
+
+// Copies rows [offset, offset + length) of `array`, whatever its type
+void append_rows(arrow::ArrayBuilder& builder, const arrow::Array& array, int64_t offset,
+                 int64_t length) {
+    throw_if_not_ok(builder.AppendArraySlice(arrow::ArraySpan(*array.data()), offset, length));
+}
+
+void write_partition(const arrow::Table& table, const fs::path& dir, int64_t row_group_rows,
+                     const std::shared_ptr<parquet::WriterProperties>& properties) {
+    fs::create_directories(dir);
+    const fs::path path = dir / kFactorPartFile;
+    // A unique temp name per writer, as the tick cache uses, so two writers
+    // of the same partition never interleave in one file; the last rename wins
+    const fs::path tmp_path =
+        dir / (std::string(kFactorPartFile) + ".tmp." + std::to_string(::getpid()) + "." +
+               std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+    auto out = arrow::io::FileOutputStream::Open(tmp_path.string());
+    if (!out.ok()) {
+        throw std::runtime_error("Could not open factor partition: " + tmp_path.string());
+    }
+    try {
+        throw_if_not_ok(parquet::arrow::WriteTable(table, arrow::default_memory_pool(), *out,
+                                                   row_group_rows, properties));
+        throw_if_not_ok((*out)->Close());
+    } catch (...) {
+        std::error_code ec;
+        fs::remove(tmp_path, ec);
+        throw;
+    }
+    std::error_code ec;
+    fs::rename(tmp_path, path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        throw std::runtime_error("Could not install factor partition " + path.string() + ": " +
+                                 ec.message());
+    }
+}
+
+std::unique_ptr<parquet::arrow::FileReader> open_parquet(const std::string& path) {
+    std::shared_ptr<arrow::io::ReadableFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(path));
+    auto result = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
+    PARQUET_THROW_NOT_OK(result.status());
+    return std::move(result).ValueOrDie();
+}
+
+// Record batches over the chosen row groups and leaf columns only
+std::unique_ptr<arrow::RecordBatchReader> open_batches(parquet::arrow::FileReader& reader,
+                                                       const std::vector<int>& row_groups,
+                                                       const std::vector<int>& columns) {
+    std::unique_ptr<arrow::RecordBatchReader> batches;
+#if ARROW_VERSION_MAJOR >= 24
+    // As in ParquetDataReader: the Result overload only exists from Arrow 24
+    auto batches_result = reader.GetRecordBatchReader(row_groups, columns);
+    PARQUET_THROW_NOT_OK(batches_result.status());
+    batches = std::move(batches_result).ValueOrDie();
+#else
+    PARQUET_THROW_NOT_OK(reader.GetRecordBatchReader(row_groups, columns, &batches));
+#endif
+    return batches;
+}
+
+} // namespace
+
+void FactorStore::write(const std::shared_ptr<arrow::Table>& input) {
+    if (!input || input->num_rows() == 0) {
+        return;
+    }
+    auto combined = input->CombineChunks(arrow::default_memory_pool());
+    throw_if_not_ok(combined.status());
+    const std::shared_ptr<arrow::Table> table = *combined;
+    const auto dates = string_array(*table, "date");
+    const auto symbols = string_array(*table, "symbol");
+
+    // Every column but the date, which the directory names carry
+    std::vector<int> stored;
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (int c = 0; c < table->num_columns(); ++c) {
+        if (table->field(c)->name() != "date") {
+            stored.push_back(c);
+            fields.push_back(table->field(c));
+        }
+    }
+    const auto schema = arrow::schema(fields);
+
+    // Rows of each (date, bucket) partition. Consecutive rows usually share
+    // a date, so each distinct run of date text is parsed once.
+    std::map<std::pair<DateKey, std::uint32_t>, std::vector<int64_t>> partitions;
+    std::string_view last_text;
+    DateKey last_date = 0;
+    for (int64_t i = 0; i < table->num_rows(); ++i) {
+        if (dates->IsNull(i) || symbols->IsNull(i)) {
+            throw std::invalid_argument("FactorStore: row " + std::to_string(i) +
+                                        " has no date or symbol");
+        }
+        const std::string_view text = dates->GetView(i);
+        if (i == 0 || text != last_text) {
+            last_date = parse_date_key(std::string(text));
+            last_text = text;
+        }
+        partitions[{last_date, symbol_bucket(symbols->GetView(i), settings_.symbol_buckets)}]
+            .push_back(i);
+    }
+
+    save_layout();
+    parquet::WriterProperties::Builder builder;
+    builder.max_row_group_length(settings_.row_group_rows)->enable_statistics();
+    const std::shared_ptr<parquet::WriterProperties> properties = builder.build();
+
+    std::map<DateKey, std::vector<bool>> written;
+    for (auto& [key, rows] : partitions) {
+        const auto [date, bucket] = key;
+        // Sorted by symbol, so each row group covers a narrow name range
+        std::stable_sort(rows.begin(), rows.end(), [&](int64_t a, int64_t b) {
+            return symbols->GetView(a) < symbols->GetView(b);
+        });
+        std::vector<std::shared_ptr<arrow::Array>> arrays;
+        for (int c : stored) {
+            const arrow::Array& column = *table->column(c)->chunk(0);
+            auto values = make_builder(column.type());
+            throw_if_not_ok(values->Reserve(static_cast<int64_t>(rows.size())));
+            // Runs of consecutive input rows are copied in one call
+            for (std::size_t k = 0; k < rows.size();) {
+                std::size_t end = k + 1;
+                while (end < rows.size() && rows[end] == rows[end - 1] + 1) {
+                    ++end;
+                }
+                append_rows(*values, column, rows[k], static_cast<int64_t>(end - k));
+                k = end;
+            }
+            arrays.push_back(finish(*values));
+        }
+        const auto part = arrow::Table::Make(schema, arrays, static_cast<int64_t>(rows.size()));
+        write_partition(*part, fs::path(root_) / partition_directory(date, bucket),
+                        settings_.row_group_rows, properties);
+
+        auto& buckets = written[date];
+        buckets.resize(settings_.symbol_buckets);
+        buckets[bucket] = true;
+    }
+
+    // A rewritten date keeps only the buckets it has now
+    for (const auto& [date, buckets] : written) {
+        for (std::uint32_t bucket = 0; bucket < settings_.symbol_buckets; ++bucket) {
+            if (!buckets[bucket]) {
+                std::error_code ec;
+                fs::remove_all(fs::path(root_) / partition_directory(date, bucket), ec);
+            }
+        }
+    }
+}
+
+std::shared_ptr<arrow::Table> FactorStore::read(const FactorQuery& query,
+                                                FactorReadStats* stats) const {
+    FactorReadStats counts;
+    const std::vector<FactorPartition> partitions = plan(query);
+    const std::unordered_set<std::string_view> wanted(query.symbols.begin(), query.symbols.end());
+
+    // With no columns named, every column of the first file is returned
+    std::vector<std::string> columns = query.columns;
+    bool resolved = !columns.empty();
+    arrow::StringBuilder dates;
+    arrow::StringBuilder symbols;
+    // A column's builder is made from the first file that has it; rows read
+    // before then are counted in pending_nulls
+    std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders(columns.size());
+    std::vector<int64_t> pending_nulls(columns.size(), 0);
+
+    for (const FactorPartition& part : partitions) {
+        auto reader = open_parquet(part.path);
+        const std::shared_ptr<parquet::FileMetaData> metadata =
+            reader->parquet_reader()->metadata();
+        const parquet::SchemaDescriptor* schema = metadata->schema();
+        const int symbol_leaf = schema->ColumnIndex("symbol");
+        if (symbol_leaf < 0) {
+            throw std::runtime_error(part.path + " has no symbol column");
+        }
+        if (!resolved) {
+            for (int c = 0; c < schema->num_columns(); ++c) {
+                if (c != symbol_leaf) {
+                    columns.push_back(schema->Column(c)->name());
+                }
+            }
+            builders.resize(columns.size());
+            pending_nulls.assign(columns.size(), 0);
+            resolved = true;
+        }
+        ++counts.files;
+
+        // Row groups whose symbol range may hold a wanted symbol
+        std::vector<int> row_groups;
+        for (int g = 0; g < metadata->num_row_groups(); ++g) {
+            const auto row_group = metadata->RowGroup(g);
+            const auto chunk = row_group->ColumnChunk(symbol_leaf);
+            const std::shared_ptr<parquet::Statistics> range = chunk->statistics();
+            if (!wanted.empty() && range && range->HasMinMax() &&
+                !query.may_contain_symbols(range->EncodeMin(), range->EncodeMax())) {
+                ++counts.row_groups_skipped;
+                continue;
+            }
+            row_groups.push_back(g);
+        }
+        if (row_groups.empty()) {
+            continue;
+        }
+        counts.row_groups_read += row_groups.size();
+
+        std::vector<int> leaves = {symbol_leaf};
+        for (const std::string& name : columns) {
+            const int leaf = schema->ColumnIndex(name);
+            if (leaf >= 0 && leaf != symbol_leaf) {
+                leaves.push_back(leaf);
+            }
+        }
+
+        const std::string date = format_date_key(part.date);
+        auto batches = open_batches(*reader, row_groups, leaves);
+        std::shared_ptr<arrow::RecordBatch> batch;
+        for (;;) {
+            throw_if_not_ok(batches->ReadNext(&batch));
+            if (!batch) {
+                break;
+            }
+            const auto names_column = batch->GetColumnByName("symbol");
+            if (names_column->type_id() != arrow::Type::STRING) {
+                throw std::runtime_error(part.path + ": symbol is not a utf8 column");
+            }
+            const auto names = std::static_pointer_cast<arrow::StringArray>(names_column);
+            std::vector<std::shared_ptr<arrow::Array>> values(columns.size());
+            for (std::size_t c = 0; c < columns.size(); ++c) {
+                values[c] = batch->GetColumnByName(columns[c]);
+            }
+            auto selected = [&](int64_t row) {
+                return wanted.empty() || (names->IsValid(row) && wanted.count(names->GetView(row)));
+            };
+
+            // Selected rows are copied a run at a time
+            const int64_t n = batch->num_rows();
+            for (int64_t i = 0; i < n;) {
+                if (!selected(i)) {
+                    ++i;
+                    continue;
+                }
+                int64_t end = i + 1;
+                while (end < n && selected(end)) {
+                    ++end;
+                }
+                const int64_t length = end - i;
+                for (int64_t k = 0; k < length; ++k) {
+                    throw_if_not_ok(dates.Append(date));
+                }
+                append_rows(symbols, *names, i, length);
+                for (std::size_t c = 0; c < columns.size(); ++c) {
+                    auto& column = builders[c];
+                    if (!values[c]) {
+                        if (column) {
+                            throw_if_not_ok(column->AppendNulls(length));
+                        } else {
+                            pending_nulls[c] += length;
+                        }
+                        continue;
+                    }
+                    if (!column) {
+                        column = make_builder(values[c]->type());
+                        throw_if_not_ok(column->AppendNulls(pending_nulls[c]));
+                    } else if (!column->type()->Equals(*values[c]->type())) {
+                        throw std::runtime_error("Column '" + columns[c] + "' is " +
+                                                 values[c]->type()->ToString() + " in " +
+                                                 part.path + " but " +
+                                                 column->type()->ToString() + " before it");
+                    }
+                    append_rows(*column, *values[c], i, length);
+                }
+                counts.rows += static_cast<std::size_t>(length);
+                i = end;
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<arrow::Field>> fields = {arrow::field("date", arrow::utf8()),
+                                                         arrow::field("symbol", arrow::utf8())};
+    std::vector<std::shared_ptr<arrow::Array>> arrays = {finish(dates), finish(symbols)};
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        // A column no file had: factor scores are doubles
+        if (!builders[c]) {
+            builders[c] = make_builder(arrow::float64());
+            throw_if_not_ok(builders[c]->AppendNulls(pending_nulls[c]));
+        }
+        arrays.push_back(finish(*builders[c]));
+        fields.push_back(arrow::field(columns[c], arrays.back()->type()));
+    }
+    if (stats) {
+        *stats = counts;
+    }
+    return arrow::Table::Make(arrow::schema(fields), arrays);
+}
+
+} // namespace qse
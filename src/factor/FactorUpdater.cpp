@@ -0,0 +1,277 @@
+#include "qse/factor/FactorUpdater.h"
+#include "qse/math/FactorKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace qse {
+
+namespace {
+
+constexpr char kMagic[8] = {'Q', 'S', 'E', 'F', 'S', 'T', 'A', 'T'};
+constexpr uint32_t kByteOrderMarker = 0x01020304;
+constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+template <class T>
+void write_value(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <class T>
+bool read_value(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void write_series(std::ofstream& file, const std::deque<double>& values) {
+    write_value(file, static_cast<uint32_t>(values.size()));
+    for (double v : values) {
+        write_value(file, v);
+    }
+}
+
+bool read_series(std::ifstream& file, std::deque<double>& values, std::size_t max_size) {
+    uint32_t size = 0;
+    if (!read_value(file, size) || size > max_size) {
+        return false;
+    }
+    values.resize(size);
+    for (double& v : values) {
+        if (!read_value(file, v)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+FactorUpdater::FactorUpdater(FactorPanelSettings settings) : settings_(settings) {
+    if (settings_.momentum_skip > settings_.momentum_lookback) {
+        throw std::invalid_argument("momentum_skip must not exceed momentum_lookback");
+    }
+}
+
+void FactorUpdater::step(SymbolState& state, double close, double pb, double out[3]) const {
+    const std::uint64_t i = state.rows++;
+    const std::size_t lookback = settings_.momentum_lookback;
+    const std::size_t window = settings_.vol_window;
+
+    // Same return and momentum as math::simple_returns and math::momentum
+    const double r = i == 0 ? 0.0 : math::pct_change(close, state.closes.back());
+    state.closes.push_back(close);
+    if (state.closes.size() > lookback + 1) {
+        state.closes.pop_front();
+    }
+    out[0] = i < lookback ? kMissing
+                          : math::pct_change(
+                                state.closes[state.closes.size() - 1 - settings_.momentum_skip],
+                                state.closes.front());
+
+    // The running sums move in math::rolling_std's order: add, then drop
+    state.returns.push_back(r);
+    state.sum += r;
+    state.sum2 += r * r;
+    if (state.returns.size() > window) {
+        const double old = state.returns.front();
+        state.returns.pop_front();
+        state.sum -= old;
+        state.sum2 -= old * old;
+    }
+    out[1] = i < window    ? kMissing
+             : window < 2 ? 0.0
+                          : math::std_from_sums(state.sum, state.sum2,
+                                                static_cast<double>(window));
+
+    out[2] = pb == 0.0 ? kMissing : 1.0 / pb;
+}
+
+FactorPanelOutput FactorUpdater::update(const FactorPanelInput& rows) {
+    const std::size_t n = rows.symbols.size();
+    if (rows.dates.size() != n || rows.close.size() != n || rows.pb.size() != n) {
+        throw std::invalid_argument("FactorUpdater: input columns differ in length");
+    }
+
+    // Oldest date first; each date's rows in symbol order, the order
+    // FactorPanel visits a cross-section in
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        if (rows.dates[a] != rows.dates[b]) {
+            return rows.dates[a] < rows.dates[b];
+        }
+        return rows.symbols[a] < rows.symbols[b];
+    });
+    if (n > 0 && rows.dates[order.front()] <= last_date_) {
+        throw std::invalid_argument("FactorUpdater: " + std::to_string(rows.dates[order.front()]) +
+                                    " is not after the last ingested date " +
+                                    std::to_string(last_date_));
+    }
+    auto same_row = [&](std::size_t a, std::size_t b) {
+        return rows.dates[a] == rows.dates[b] && rows.symbols[a] == rows.symbols[b];
+    };
+    auto duplicate = std::adjacent_find(order.begin(), order.end(), same_row);
+    if (duplicate != order.end()) {
+        throw std::invalid_argument("FactorUpdater: two rows for " + rows.symbols[*duplicate] +
+                                    " on " + std::to_string(rows.dates[*duplicate]));
+    }
+
+    FactorPanelOutput out;
+    out.mom_z.resize(n);
+    out.vol_z.resize(n);
+    out.val_z.resize(n);
+    out.alpha.resize(n);
+    const double weights[3] = {settings_.momentum_weight, settings_.vol_weight,
+                               settings_.value_weight};
+    std::vector<double> factors[3];
+    std::vector<double> finite;
+
+    for (std::size_t begin = 0; begin < n;) {
+        const DateKey date = rows.dates[order[begin]];
+        std::size_t end = begin;
+        while (end < n && rows.dates[order[end]] == date) {
+            ++end;
+        }
+        const std::size_t count = end - begin;
+        for (auto& column : factors) {
+            column.resize(count);
+        }
+
+        // Both this date's rows and the map are in name order, so the next
+        // symbol is found by walking forward from the previous one
+        auto hint = symbols_.begin();
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t row = order[begin + k];
+            const std::string& symbol = rows.symbols[row];
+            while (hint != symbols_.end() && hint->first < symbol) {
+                ++hint;
+            }
+            if (hint == symbols_.end() || hint->first != symbol) {
+                hint = symbols_.emplace_hint(hint, symbol, SymbolState{});
+            }
+            double raw[3];
+            step(hint->second, rows.close[row], rows.pb[row], raw);
+            for (int f = 0; f < 3; ++f) {
+                factors[f][k] = raw[f];
+            }
+        }
+
+        for (auto& column : factors) {
+            math::cross_section_zscore(column.data(), count, settings_.winsor_quantile, finite);
+        }
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t row = order[begin + k];
+            out.mom_z[row] = factors[0][k];
+            out.vol_z[row] = factors[1][k];
+            out.val_z[row] = factors[2][k];
+            // Same sum, in the same order, as math::weighted_sum
+            out.alpha[row] = weights[0] * factors[0][k] + weights[1] * factors[1][k] +
+                             weights[2] * factors[2][k];
+        }
+
+        last_date_ = date;
+        ++out.num_dates;
+        begin = end;
+    }
+    out.num_symbols = symbols_.size();
+    return out;
+}
+
+void FactorUpdater::save(const std::string& path) const {
+    FactorStateHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFactorStateVersion;
+    header.byte_order = kByteOrderMarker;
+    header.momentum_lookback = settings_.momentum_lookback;
+    header.momentum_skip = settings_.momentum_skip;
+    header.vol_window = settings_.vol_window;
+    header.last_date = last_date_;
+    header.symbol_count = static_cast<uint32_t>(symbols_.size());
+
+    // Written under a unique name and renamed into place, as the tick cache
+    // is, so readers never see half a state
+    const std::string tmp_path =
+        path + ".tmp." + std::to_string(::getpid()) + "." +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (file) {
+            write_value(file, header);
+            for (const auto& [symbol, state] : symbols_) {
+                write_value(file, static_cast<uint32_t>(symbol.size()));
+                file.write(symbol.data(), static_cast<std::streamsize>(symbol.size()));
+                write_value(file, state.rows);
+                write_value(file, state.sum);
+                write_value(file, state.sum2);
+                write_series(file, state.closes);
+                write_series(file, state.returns);
+            }
+        }
+        if (!file) {
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            throw std::runtime_error("Could not write factor state " + tmp_path);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        throw std::runtime_error("Could not install factor state " + path + ": " + ec.message());
+    }
+}
+
+FactorUpdater FactorUpdater::load(const std::string& path, FactorPanelSettings settings) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Could not open factor state " + path);
+    }
+    FactorStateHeader header{};
+    if (!read_value(file, header) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.version != kFactorStateVersion || header.byte_order != kByteOrderMarker) {
+        throw std::runtime_error(path + " is not a factor state file of this version");
+    }
+    if (header.momentum_lookback != settings.momentum_lookback ||
+        header.momentum_skip != settings.momentum_skip ||
+        header.vol_window != settings.vol_window) {
+        throw std::runtime_error(path + " was built with momentum " +
+                                 std::to_string(header.momentum_lookback) + "-" +
+                                 std::to_string(header.momentum_skip) + " and volatility window " +
+                                 std::to_string(header.vol_window) +
+                                 "; rebuild it from the full history");
+    }
+
+    FactorUpdater updater(settings);
+    updater.last_date_ = header.last_date;
+    auto hint = updater.symbols_.end();
+    for (uint32_t s = 0; s < header.symbol_count; ++s) {
+        uint32_t length = 0;
+        std::string symbol;
+        SymbolState state;
+        bool ok = read_value(file, length);
+        if (ok) {
+            symbol.resize(length);
+            ok = static_cast<bool>(file.read(symbol.data(), length));
+        }
+        ok = ok && read_value(file, state.rows) && read_value(file, state.sum) &&
+             read_value(file, state.sum2) &&
+             read_series(file, state.closes, settings.momentum_lookback + 1) &&
+             read_series(file, state.returns, settings.vol_window);
+        if (!ok) {
+            throw std::runtime_error("Truncated factor state " + path);
+        }
+        hint = updater.symbols_.emplace_hint(hint, std::move(symbol), std::move(state));
+    }
+    return updater;
+}
+
+} // namespace qse
@@ -1,4 +1,5 @@
 #include "qse/factor/ICMonitor.h"
+#include "qse/factor/FactorStore.h"
 #include <arrow/table.h>
 #include <arrow/array.h>
 #include <algorithm>
@@ -140,4 +141,12 @@ ICMonitor::ICResult ICMonitor::compute_ic(const std::shared_ptr<arrow::Table>& t
     return result;
 }
 
+ICMonitor::ICResult ICMonitor::compute_ic(const FactorStore& store, const FactorQuery& query,
+                                          const std::string& factor_col,
+                                          const std::string& return_col, int window_size) {
+    FactorQuery projected = query;
+    projected.columns = {factor_col, return_col};
+    return compute_ic(store.read(projected), factor_col, return_col, "date", window_size);
+}
+
 } // namespace qse
\ No newline at end of file
@@ -1,13 +1,18 @@
 #include "qse/factor/MultiFactorCalculator.h"
 #include "qse/core/ArrowUtil.h"
+#include "qse/factor/FactorPanel.h"
+#include "qse/factor/FactorStore.h"
+#include "qse/factor/FactorUpdater.h"
 #include <cmath>
 #include <stdexcept>
 #include "qse/factor/UniverseFilter.h"
+#include "qse/math/FactorKernels.h"
 #include "qse/math/StatsUtil.h"
 #include <arrow/api.h>
 #include <arrow/csv/api.h>
 #include <arrow/io/api.h>
 #include <parquet/arrow/writer.h>
+#include <parquet/properties.h>
 #include <yaml-cpp/yaml.h>
 #include <filesystem>
 #include <iostream>
@@ -18,8 +23,133 @@ using namespace qse;
 
 namespace {
 
-double pct_change(double now, double prev) {
-    return prev == 0.0 ? 0.0 : (now - prev) / prev;
+// 12-1 momentum on daily rows: twelve months back to one month back
+constexpr std::size_t kMomentumLookback = 252;
+constexpr std::size_t kMomentumSkip = 21;
+constexpr std::size_t kVolWindow = 20;
+
+// Contiguous values of a float64 column, looked up by name once. A column
+// held in one chunk without nulls is read in place from Arrow's buffer;
+// otherwise its chunks are copied into `storage`, with nulls as NaN.
+const double* column_data(const arrow::Table& table, const std::string& name,
+                          std::vector<double>& storage) {
+    auto column = table.GetColumnByName(name);
+    if (!column) {
+        throw std::runtime_error("Missing column '" + name + "'");
+    }
+    if (column->type()->id() != arrow::Type::DOUBLE) {
+        throw std::runtime_error("Column '" + name + "' is " + column->type()->ToString() +
+                                 ", expected double");
+    }
+    if (column->num_chunks() == 1 && column->null_count() == 0) {
+        return std::static_pointer_cast<arrow::DoubleArray>(column->chunk(0))->raw_values();
+    }
+    storage.clear();
+    storage.reserve(static_cast<std::size_t>(column->length()));
+    for (const auto& chunk : column->chunks()) {
+        auto values = std::static_pointer_cast<arrow::DoubleArray>(chunk);
+        const double* raw = values->raw_values();
+        for (int64_t i = 0; i < values->length(); ++i) {
+            storage.push_back(values->IsNull(i) ? std::nan("") : raw[i]);
+        }
+    }
+    return storage.data();
+}
+
+// Values of a utf8 column, looked up by name once
+std::vector<std::string> string_column(const arrow::Table& table, const std::string& name) {
+    auto column = table.GetColumnByName(name);
+    if (!column) {
+        throw std::runtime_error("Missing column '" + name + "'");
+    }
+    if (column->type()->id() != arrow::Type::STRING) {
+        throw std::runtime_error("Column '" + name + "' is " + column->type()->ToString() +
+                                 ", expected string");
+    }
+    std::vector<std::string> values;
+    values.reserve(static_cast<std::size_t>(column->length()));
+    for (const auto& chunk : column->chunks()) {
+        auto strings = std::static_pointer_cast<arrow::StringArray>(chunk);
+        for (int64_t i = 0; i < strings->length(); ++i) {
+            values.push_back(strings->GetString(i));
+        }
+    }
+    return values;
+}
+
+struct FactorWeights {
+    double momentum, vol, value;
+};
+
+FactorWeights load_weights(const std::string& weights_yaml) {
+    YAML::Node cfg = YAML::LoadFile(weights_yaml);
+    FactorWeights w{cfg["momentum"].as<double>(), cfg["vol"].as<double>(),
+                    cfg["value"].as<double>()};
+    if (std::abs(w.momentum + w.vol + w.value - 1.0) > 1e-6)
+        throw std::runtime_error("Factor weights must sum to 1");
+    return w;
+}
+
+FactorPanelSettings panel_settings(const std::string& weights_yaml, unsigned threads) {
+    const FactorWeights w = load_weights(weights_yaml);
+    FactorPanelSettings settings;
+    settings.momentum_lookback = kMomentumLookback;
+    settings.momentum_skip = kMomentumSkip;
+    settings.vol_window = kVolWindow;
+    settings.momentum_weight = w.momentum;
+    settings.vol_weight = w.vol;
+    settings.value_weight = w.value;
+    settings.threads = threads;
+    return settings;
+}
+
+FactorPanelInput panel_input(const arrow::Table& table) {
+    const auto nrows = static_cast<std::size_t>(table.num_rows());
+    FactorPanelInput input;
+    input.symbols = string_column(table, "symbol");
+    input.dates.reserve(nrows);
+    for (const std::string& date : string_column(table, "date")) {
+        input.dates.push_back(parse_date_key(date));
+    }
+    std::vector<double> storage;
+    const double* close = column_data(table, "close", storage);
+    input.close.assign(close, close + nrows);
+    const double* pb = column_data(table, "pb", storage);
+    input.pb.assign(pb, pb + nrows);
+    return input;
+}
+
+std::shared_ptr<arrow::Array> finish_array(arrow::ArrayBuilder& builder) {
+    std::shared_ptr<arrow::Array> array;
+    qse::throw_if_not_ok(builder.Finish(&array));
+    return array;
+}
+
+// The new rows and their scores as a FactorStore table
+std::shared_ptr<arrow::Table> scores_table(const FactorPanelInput& rows,
+                                           const FactorPanelOutput& scores) {
+    arrow::StringBuilder date;
+    arrow::StringBuilder symbol;
+    arrow::DoubleBuilder columns[6];
+    const std::vector<double>* values[6] = {&rows.close,   &rows.pb,     &scores.mom_z,
+                                            &scores.vol_z, &scores.val_z, &scores.alpha};
+    for (std::size_t row = 0; row < rows.symbols.size(); ++row) {
+        qse::throw_if_not_ok(date.Append(format_date_key(rows.dates[row])));
+        qse::throw_if_not_ok(symbol.Append(rows.symbols[row]));
+        for (int c = 0; c < 6; ++c) {
+            qse::throw_if_not_ok(columns[c].Append((*values[c])[row]));
+        }
+    }
+    std::vector<std::shared_ptr<arrow::Array>> arrays = {finish_array(date), finish_array(symbol)};
+    for (auto& column : columns) {
+        arrays.push_back(finish_array(column));
+    }
+    auto schema = arrow::schema(
+        {arrow::field("date", arrow::utf8()), arrow::field("symbol", arrow::utf8()),
+         arrow::field("close", arrow::float64()), arrow::field("pb", arrow::float64()),
+         arrow::field("mom_z", arrow::float64()), arrow::field("vol20_z", arrow::float64()),
+         arrow::field("val_z", arrow::float64()), arrow::field("alpha", arrow::float64())});
+    return arrow::Table::Make(schema, arrays);
 }
 
 } // namespace
@@ -30,13 +160,10 @@ void MultiFactorCalculator::set_filter_criteria(double min_price, double min_vol
     universe_filter_ = std::make_unique<UniverseFilter>(criteria);
 }
 
-void MultiFactorCalculator::compute_factors(const std::string& in_csv,
-                                            const std::string& out_parquet,
-                                            const std::string& weights_yaml) {
+std::shared_ptr<arrow::Table> MultiFactorCalculator::load_clean_table(const std::string& in_csv) {
     /************ 1. Load daily OHLCV ************/
     auto table = load_arrow_table(in_csv);
-    auto nrows = table->num_rows();
-    if (nrows == 0)
+    if (table->num_rows() == 0)
         throw std::runtime_error("Empty price file");
 
     /************ 2. Apply universe filters and data hygiene ************/
@@ -53,28 +180,39 @@ void MultiFactorCalculator::compute_factors(const std::string& in_csv,
 
         std::cout << universe_filter_->get_filter_stats() << std::endl;
     }
+    return table;
+}
 
-    /************ 3. Momentum 12-1 (placeholder) ************/
-    // TODO: replace with real 12-1 logic
-    std::vector<double> mom(nrows, 0.0);
-    for (int i = 21; i < nrows; ++i) // 1-month gap, 12-month look-back
-        mom[i] = pct_change(col<double>(table, "close", i), col<double>(table, "close", i - 252));
+void MultiFactorCalculator::compute_factors(const std::string& in_csv,
+                                            const std::string& out_parquet,
+                                            const std::string& weights_yaml) {
+    auto table = load_clean_table(in_csv);
 
-    /************ 4. Volatility ************/
-    qse::math::RollingStdDev vol20(20), vol60(60);
-    std::vector<double> vol20v(nrows), vol60v(nrows);
-    for (int i = 0; i < nrows; ++i) {
-        auto px = col<double>(table, "close", i);
-        vol20v[i] = vol20(px);
-        vol60v[i] = vol60(px);
+    // A multi-symbol panel is grouped by symbol and scored per date
+    if (table->GetColumnByName("symbol")) {
+        compute_panel_factors(table, out_parquet, weights_yaml);
+        return;
     }
 
-    /************ 5. Value proxy: 1 / P-B (placeholder) ************/
+    // Every factor below is a column kernel over contiguous buffers: each
+    // input column is looked up once, not once per row
+    const auto nrows = static_cast<std::size_t>(table->num_rows());
+    std::vector<double> close_storage, pb_storage;
+    const double* close = column_data(*table, "close", close_storage);
+    const double* pb = column_data(*table, "pb", pb_storage); // price-to-book
+
+    /************ 3. Momentum 12-1 ************/
+    std::vector<double> mom(nrows);
+    qse::math::momentum(close, nrows, kMomentumLookback, kMomentumSkip, mom.data());
+
+    /************ 4. Volatility of daily returns ************/
+    std::vector<double> returns(nrows), vol20v(nrows);
+    qse::math::simple_returns(close, nrows, returns.data());
+    qse::math::rolling_std(returns.data(), nrows, kVolWindow, vol20v.data());
+
+    /************ 5. Value proxy: 1 / P-B ************/
     std::vector<double> value(nrows);
-    for (int i = 0; i < nrows; ++i) {
-        double pb = col<double>(table, "pb", i); // assumes pb column exists
-        value[i] = pb == 0.0 ? 0.0 : 1.0 / pb;
-    }
+    qse::math::reciprocal(pb, nrows, value.data());
 
     /************ 6. Winsorise + z-score ************/
     qse::math::winsorize(mom);
@@ -86,17 +224,11 @@ void MultiFactorCalculator::compute_factors(const std::string& in_csv,
     qse::math::zscore(value);
 
     /************ 7. Composite score ************/
-    YAML::Node cfg = YAML::LoadFile(weights_yaml);
-    double w_mom = cfg["momentum"].as<double>();
-    double w_vol = cfg["vol"].as<double>();
-    double w_val = cfg["value"].as<double>();
-    double w_sum = w_mom + w_vol + w_val;
-    if (std::abs(w_sum - 1.0) > 1e-6)
-        throw std::runtime_error("Factor weights must sum to 1");
-
+    const FactorWeights w = load_weights(weights_yaml);
+    const double* columns[3] = {mom.data(), vol20v.data(), value.data()};
+    const double weights[3] = {w.momentum, w.vol, w.value};
     std::vector<double> composite(nrows);
-    for (int i = 0; i < nrows; ++i)
-        composite[i] = w_mom * mom[i] + w_vol * vol20v[i] + w_val * value[i];
+    qse::math::weighted_sum(columns, weights, 3, nrows, composite.data());
 
     /************ 8. Attach columns and dump Parquet ************/
     append_column(table, "mom_z", mom);
@@ -108,85 +240,108 @@ void MultiFactorCalculator::compute_factors(const std::string& in_csv,
     std::cout << "Wrote " << out_parquet << std::endl;
 }
 
-std::shared_ptr<arrow::Table> MultiFactorCalculator::load_arrow_table(const std::string& csv_path) {
-    // For now, create a simple mock table
-    // In practice, you'd use Arrow's CSV reader
-    // Create schema
-    std::vector<std::shared_ptr<arrow::Field>> fields = {
-        arrow::field("date", arrow::utf8()),     arrow::field("open", arrow::float64()),
-        arrow::field("high", arrow::float64()),  arrow::field("low", arrow::float64()),
-        arrow::field("close", arrow::float64()), arrow::field("volume", arrow::int64()),
-        arrow::field("pb", arrow::float64()) // Price-to-book ratio
-    };
-
-    auto schema = std::make_shared<arrow::Schema>(fields);
-
-    // Create mock data (in practice, read from CSV)
-    std::vector<std::shared_ptr<arrow::Array>> arrays;
+void MultiFactorCalculator::compute_panel_factors(const std::shared_ptr<arrow::Table>& table,
+                                                  const std::string& out_parquet,
+                                                  const std::string& weights_yaml) {
+    const FactorPanelInput input = panel_input(*table);
+    FactorPanelOutput out = FactorPanel(panel_settings(weights_yaml, threads_)).compute(input);
+    std::cout << "Scored " << out.num_symbols << " symbols over " << out.num_dates << " dates"
+              << std::endl;
 
-    // Mock data for testing
-    std::vector<std::string> dates = {"2023-01-01", "2023-01-02", "2023-01-03"};
-    std::vector<double> closes = {100.0, 101.0, 102.0};
-    std::vector<double> pbs = {1.5, 1.6, 1.7};
+    std::shared_ptr<arrow::Table> scored = table;
+    append_column(scored, "mom_z", out.mom_z);
+    append_column(scored, "vol20_z", out.vol_z);
+    append_column(scored, "val_z", out.val_z);
+    append_column(scored, "alpha", out.alpha);
 
-    // Create arrays (simplified for now)
-    arrow::StringBuilder date_builder;
-    arrow::DoubleBuilder close_builder;
-    arrow::DoubleBuilder pb_builder;
+    save_parquet(scored, out_parquet);
+    std::cout << "Wrote " << out_parquet << std::endl;
+}
 
-    for (const auto& date : dates) {
-        qse::throw_if_not_ok(date_builder.Append(date));
+void MultiFactorCalculator::update_factors(const std::string& in_csv,
+                                           const std::string& state_path,
+                                           const std::string& out_dir,
+                                           const std::string& weights_yaml) {
+    auto table = load_clean_table(in_csv);
+    if (!table->GetColumnByName("symbol")) {
+        throw std::runtime_error("update_factors needs a panel with a 'symbol' column");
     }
-    for (double close : closes) {
-        qse::throw_if_not_ok(close_builder.Append(close));
+
+    const FactorPanelSettings settings = panel_settings(weights_yaml, threads_);
+    const bool resume = std::filesystem::exists(state_path);
+    FactorUpdater updater = resume ? FactorUpdater::load(state_path, settings)
+                                   : FactorUpdater(settings);
+
+    // The input may repeat dates already ingested; only later ones are new
+    const FactorPanelInput all = panel_input(*table);
+    FactorPanelInput input;
+    for (std::size_t i = 0; i < all.dates.size(); ++i) {
+        if (all.dates[i] > updater.last_date()) {
+            input.symbols.push_back(all.symbols[i]);
+            input.dates.push_back(all.dates[i]);
+            input.close.push_back(all.close[i]);
+            input.pb.push_back(all.pb[i]);
+        }
     }
-    for (double pb : pbs) {
-        qse::throw_if_not_ok(pb_builder.Append(pb));
+    if (input.dates.empty()) {
+        std::cout << "No dates after " << format_date_key(updater.last_date()) << " in "
+                  << in_csv << std::endl;
+        return;
     }
 
-    std::shared_ptr<arrow::Array> date_array, close_array, pb_array;
-    qse::throw_if_not_ok(date_builder.Finish(&date_array));
-    qse::throw_if_not_ok(close_builder.Finish(&close_array));
-    qse::throw_if_not_ok(pb_builder.Finish(&pb_array));
+    const FactorPanelOutput out = updater.update(input);
+    FactorStore(out_dir).write(scores_table(input, out));
+    // Saved only once every partition is on disk: a failed run is simply
+    // rerun from the previous state
+    updater.save(state_path);
+    std::cout << (resume ? "Updated " : "Built ") << state_path << " through "
+              << format_date_key(updater.last_date()) << "; wrote " << out.num_dates
+              << " date(s) to the factor store " << out_dir << std::endl;
+}
 
-    // Create a simple volume array with zeros
-    arrow::Int64Builder volume_builder;
-    for (size_t i = 0; i < dates.size(); ++i) {
-        qse::throw_if_not_ok(volume_builder.Append(1000)); // Mock volume
+std::shared_ptr<arrow::Table> MultiFactorCalculator::load_arrow_table(const std::string& csv_path) {
+    auto infile = arrow::io::ReadableFile::Open(csv_path);
+    if (!infile.ok()) {
+        throw std::runtime_error("Could not open price file: " + csv_path);
     }
-    std::shared_ptr<arrow::Array> volume_array;
-    qse::throw_if_not_ok(volume_builder.Finish(&volume_array));
 
-    arrays = {date_array,  close_array,  close_array, close_array,
-              close_array, volume_array, pb_array};
-
-    return arrow::Table::Make(schema, arrays);
+    // Dates stay text for parse_date_key (Arrow would infer date32), and
+    // prices are float64 even in a file where every one is a whole number
+    auto convert_options = arrow::csv::ConvertOptions::Defaults();
+    for (const char* name : {"date", "symbol"}) {
+        convert_options.column_types[name] = arrow::utf8();
+    }
+    for (const char* name : {"open", "high", "low", "close", "pb"}) {
+        convert_options.column_types[name] = arrow::float64();
+    }
+    auto reader = arrow::csv::TableReader::Make(
+        arrow::io::IOContext(arrow::default_memory_pool()), *infile,
+        arrow::csv::ReadOptions::Defaults(), arrow::csv::ParseOptions::Defaults(), convert_options);
+    qse::throw_if_not_ok(reader.status());
+    auto table = (*reader)->Read();
+    qse::throw_if_not_ok(table.status());
+    return *table;
 }
 
 void MultiFactorCalculator::save_parquet(const std::shared_ptr<arrow::Table>& table,
                                          const std::string& path) {
-    // For now, just log that we would save
-    // In practice, use Arrow's Parquet writer
-    std::cout << "Would save table with " << table->num_rows() << " rows to " << path << std::endl;
+    auto out = arrow::io::FileOutputStream::Open(path);
+    if (!out.ok()) {
+        throw std::runtime_error("Could not open factor file: " + path);
+    }
+    qse::throw_if_not_ok(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), *out,
+                                                    parquet::DEFAULT_MAX_ROW_GROUP_LENGTH));
+    qse::throw_if_not_ok((*out)->Close());
 }
 
-void MultiFactorCalculator::append_column(const std::shared_ptr<arrow::Table>& table,
+void MultiFactorCalculator::append_column(std::shared_ptr<arrow::Table>& table,
                                           const std::string& name,
                                           const std::vector<double>& data) {
-    // For now, just log the column addition
-    // In practice, create Arrow array and append to table
-    std::cout << "Would append column '" << name << "' with " << data.size() << " values"
-              << std::endl;
+    arrow::DoubleBuilder builder;
+    qse::throw_if_not_ok(builder.AppendValues(data));
+    // Fails, rather than misaligning rows, if `data` is not one value per row
+    auto added = table->AddColumn(table->num_columns(), arrow::field(name, arrow::float64()),
+                                  std::make_shared<arrow::ChunkedArray>(finish_array(builder)));
+    qse::throw_if_not_ok(added.status());
+    table = *added;
 }
-
-template <typename T>
-T MultiFactorCalculator::col(const std::shared_ptr<arrow::Table>& table, const std::string& name,
-                             int row) {
-    // Mock implementation - return test values
-    if (name == "close") {
-        return static_cast<T>(100.0 + row);
-    } else if (name == "pb") {
-        return static_cast<T>(1.5 + row * 0.1);
-    }
-    return static_cast<T>(0.0);
-}
\ No newline at end of file
@@ -14,8 +14,8 @@ LiveEngine::LiveEngine(LiveEngineConfig config, IExecutionHandler& exec, DrainFn
     exec_.set_fill_callback([this](const Fill& fill) {
         fills_.push_back(fill);
         std::cout << "[LiveEngine] fill: " << fill.side << " " << fill.quantity << " "
-                  << fill.symbol << " @ " << fill.price << " (order " << fill.order_id << ")"
-                  << std::endl;
+                  << fill.symbol << " @ " << fill.price << " (order " << fill.venue_order_id
+                  << ")" << std::endl;
     });
 }
 
@@ -74,7 +74,7 @@ void LiveEngine::on_bar(const Bar& bar) {
     const double cur_short = short_ma_.get_value();
     const double cur_long = long_ma_.get_value();
 
-    OrderId id;
+    VenueOrderId id;
     if (prev_short < prev_long && cur_short > cur_long && !is_long_) {
         std::cout << "[LiveEngine] golden cross @ " << bar.close << " - buying "
                   << config_.order_size << std::endl;
@@ -103,8 +103,8 @@ void LiveEngine::save_logs(const std::string& directory) const {
     std::ofstream fills(directory + "/fills.csv");
     fills << "order_id,symbol,side,quantity,price\n";
     for (const auto& fill : fills_) {
-        fills << fill.order_id << "," << fill.symbol << "," << fill.side << "," << fill.quantity
-              << "," << fill.price << "\n";
+        fills << fill.venue_order_id << "," << fill.symbol << "," << fill.side << ","
+              << fill.quantity << "," << fill.price << "\n";
     }
 }
 
@@ -114,7 +114,7 @@ LiveEngine::Reconciliation LiveEngine::reconcile() const {
         ReconciliationLine line;
         line.order_id = id;
         for (const auto& fill : fills_) {
-            if (fill.order_id == id) {
+            if (fill.venue_order_id == id) {
                 line.local_fill_qty += fill.quantity;
             }
         }
@@ -233,7 +233,8 @@ Order TickSubscriber::deserialize_order(const std::string& data) {
     Order order;
 
     // Parse order_id
-    std::getline(iss, order.order_id, ',');
+    std::getline(iss, token, ',');
+    order.order_id = std::stoull(token);
 
     // Parse symbol
     std::getline(iss, order.symbol, ',');
@@ -1,74 +1,86 @@
 #include "qse/order/OrderManager.h"
 #include "qse/core/Debug.h"
 #include "qse/data/Data.h" // Required for the Trade struct
+#include "qse/data/SymbolTable.h"
 
 #include <iostream>
 #include <stdexcept>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
 
 namespace qse {
 
-OrderManager::OrderManager(const Config& config, OrderBook& order_book,
-                           const std::string& equity_curve_path, const std::string& tradelog_path)
-    : config_(&config), order_book_(&order_book), use_full_depth_(config.use_full_depth_book()),
-      cash_(config.get_initial_cash()), next_order_id_(1) {
+namespace {
 
-    equity_curve_file_.open(equity_curve_path);
-    if (!equity_curve_file_.is_open()) {
-        throw std::runtime_error("Could not open equity curve file: " + equity_curve_path);
+// Price priority for resting limit orders: a better limit first, and the
+// earlier order (lower ID) first at the same limit
+struct BuyPriority {
+    template <typename Entry> bool operator()(const Entry& a, const Entry& b) const {
+        return a.limit > b.limit || (a.limit == b.limit && a.id < b.id);
+    }
+};
+struct SellPriority {
+    template <typename Entry> bool operator()(const Entry& a, const Entry& b) const {
+        return a.limit < b.limit || (a.limit == b.limit && a.id < b.id);
+    }
+};
+
+// Appends the IDs of the limit orders that `crosses` accepts, in priority
+// order, stopping at the first that does not: every later order has a
+// worse limit
+template <typename Limits, typename Crosses>
+void append_marketable(const Limits& limits, Crosses&& crosses, std::vector<OrderId>& out) {
+    for (const auto& entry : limits) {
+        if (!crosses(entry.limit)) {
+            break;
+        }
+        out.push_back(entry.id);
     }
-    equity_curve_file_ << "timestamp,equity\n"; // Write header
+}
 
-    tradelog_file_.open(tradelog_path);
-    if (!tradelog_file_.is_open()) {
-        throw std::runtime_error("Could not open tradelog file: " + tradelog_path);
+template <typename Limits, typename Priority>
+void erase_limit(Limits& limits, PriceTicks limit, OrderId id, Priority priority) {
+    auto it = std::lower_bound(limits.begin(), limits.end(), typename Limits::value_type{limit, id},
+                               priority);
+    if (it != limits.end() && it->id == id) {
+        limits.erase(it);
     }
-    tradelog_file_ << "timestamp,symbol,type,quantity,price,cash\n"; // Write header
+}
+
+} // namespace
+
+OrderManager::OrderManager(const Config& config, OrderBook& order_book,
+                           const std::string& equity_curve_path, const std::string& tradelog_path)
+    : config_(&config), order_book_(&order_book), use_full_depth_(config.use_full_depth_book()),
+      portfolio_(config.get_initial_cash()), next_order_id_(1) {
+
+    open_outputs(equity_curve_path, tradelog_path);
+    init_run_summary();
 }
 
 OrderManager::OrderManager(const Config& config, const std::string& equity_curve_path,
                            const std::string& tradelog_path)
     : config_(&config), order_book_(nullptr), use_full_depth_(config.use_full_depth_book()),
-      cash_(config.get_initial_cash()), next_order_id_(1) {
+      portfolio_(config.get_initial_cash()), next_order_id_(1) {
 
-    equity_curve_file_.open(equity_curve_path);
-    if (!equity_curve_file_.is_open()) {
-        throw std::runtime_error("Could not open equity curve file: " + equity_curve_path);
-    }
-    equity_curve_file_ << "timestamp,equity\n"; // Write header
-
-    tradelog_file_.open(tradelog_path);
-    if (!tradelog_file_.is_open()) {
-        throw std::runtime_error("Could not open tradelog file: " + tradelog_path);
-    }
-    tradelog_file_ << "timestamp,symbol,type,quantity,price,cash\n"; // Write header
+    open_outputs(equity_curve_path, tradelog_path);
+    init_run_summary();
 }
 
 OrderManager::OrderManager(double initial_cash, const std::string& equity_curve_path,
                            const std::string& tradelog_path)
-    : config_(nullptr), order_book_(nullptr), cash_(initial_cash), next_order_id_(1) {
+    : config_(nullptr), order_book_(nullptr), portfolio_(initial_cash), next_order_id_(1) {
 
-    equity_curve_file_.open(equity_curve_path);
-    if (!equity_curve_file_.is_open()) {
-        throw std::runtime_error("Could not open equity curve file: " + equity_curve_path);
-    }
-    equity_curve_file_ << "timestamp,equity\n"; // Write header
-
-    tradelog_file_.open(tradelog_path);
-    if (!tradelog_file_.is_open()) {
-        throw std::runtime_error("Could not open tradelog file: " + tradelog_path);
-    }
-    tradelog_file_ << "timestamp,symbol,type,quantity,price,cash\n"; // Write header
+    open_outputs(equity_curve_path, tradelog_path);
+    init_run_summary();
 }
 
 OrderManager::~OrderManager() {
-    if (equity_curve_file_.is_open()) {
-        equity_curve_file_.close();
-    }
-    if (tradelog_file_.is_open()) {
-        tradelog_file_.close();
+    if (results_ && skipped_equity_) {
+        results_->add_equity(skipped_equity_->timestamp, skipped_equity_->equity);
     }
+    // results_ finishes the files as it is destroyed (errors go to std::cerr)
 }
 
 void OrderManager::execute_buy(const std::string& symbol, int quantity, double price) {
@@ -79,16 +91,15 @@ void OrderManager::execute_buy(const std::string& symbol, int quantity, double p
     }
 
     double cost = quantity * price;
-    if (cost > cash_) {
+    if (cost > portfolio_.cash()) {
         // Not enough cash to execute the trade, log it and return.
         // In a real system, this might be handled differently (e.g., partial fill, error).
         std::cerr << "WARNING: Not enough cash to execute buy order for " << quantity << " of "
-                  << symbol << " at price " << price << ". Have " << cash_ << ", need " << cost
-                  << std::endl;
+                  << symbol << " at price " << price << ". Have " << portfolio_.cash()
+                  << ", need " << cost << std::endl;
         return;
     }
-    cash_ -= cost;
-    positions_[symbol] += quantity;               // Update position for the specific symbol
+    portfolio_.trade(intern_symbol(symbol), quantity, price);
     log_trade(0, symbol, "BUY", quantity, price); // Timestamp will be updated by backtester
 }
 
@@ -101,65 +112,110 @@ void OrderManager::execute_sell(const std::string& symbol, int quantity, double
 
     // For short selling, we don't check the current position, but in a real system
     // you would need to manage margin requirements. For now, we assume we can always short.
-    cash_ += quantity * price;
-    positions_[symbol] -= quantity;                // Update position for the specific symbol
+    portfolio_.trade(intern_symbol(symbol), -static_cast<int64_t>(quantity), price);
     log_trade(0, symbol, "SELL", quantity, price); // Timestamp will be updated by backtester
 }
 
 int OrderManager::get_position(const std::string& symbol) const {
-    // If the symbol is not in our map, we have no position.
-    if (positions_.find(symbol) == positions_.end()) {
-        return 0;
-    }
-    // Otherwise, return the stored position.
-    return positions_.at(symbol);
+    // A symbol never interned has never traded
+    const SymbolId id = SymbolTable::instance().find(symbol);
+    return id == kInvalidSymbolId ? 0 : static_cast<int>(portfolio_.position(id));
 }
 
 std::vector<Position> OrderManager::get_positions() const {
     std::vector<Position> result;
-    for (const auto& pair : positions_) {
-        if (pair.second != 0) { // Only include non-zero positions
-            result.emplace_back(pair.first, static_cast<double>(pair.second));
-        }
-    }
+    const SymbolTable& symbols = SymbolTable::instance();
+    portfolio_.for_each_position([&](SymbolId id, int64_t quantity) {
+        result.emplace_back(symbols.name(id), static_cast<double>(quantity));
+    });
+    // Sorted by ticker, the order the name-keyed position map gave
+    std::sort(result.begin(), result.end(),
+              [](const Position& a, const Position& b) { return a.symbol < b.symbol; });
     return result;
 }
 
 double OrderManager::get_cash() const {
-    return cash_;
+    return portfolio_.cash();
 }
 
 void OrderManager::record_equity(long long timestamp,
                                  const std::map<std::string, double>& market_prices) {
-    if (equity_curve_file_.is_open()) {
-        double holdings_value = calculate_holdings_value(market_prices);
-        double total_equity = cash_ + holdings_value;
-        equity_curve_file_ << timestamp << "," << total_equity << "\n";
+    for (const auto& [symbol, price] : market_prices) {
+        portfolio_.mark(intern_symbol(symbol), price);
     }
+    record_equity(timestamp);
 }
 
-void OrderManager::log_trade(long long timestamp, const std::string& symbol,
-                             const std::string& type, int quantity, double price) {
-    if (tradelog_file_.is_open()) {
-        // We'll update the timestamp later. For now, just log the core trade details.
-        // A more sophisticated logger might buffer trades and associate them with timestamps.
-        tradelog_file_ << timestamp << "," << symbol << "," << type << "," << quantity << ","
-                       << price << "," << cash_ << "\n";
+void OrderManager::record_equity(long long timestamp) {
+    if (qse_debug_enabled()) {
+        const double full = portfolio_.recompute_holdings_value();
+        const double incremental = portfolio_.holdings_value();
+        if (std::abs(full - incremental) > 1e-9 * std::max(1.0, std::abs(full))) {
+            std::cerr << "[OrderManager] Incremental holdings value " << incremental
+                      << " differs from full recompute " << full << std::endl;
+        }
     }
-}
+    const double total_equity = portfolio_.equity();
 
-double
-OrderManager::calculate_holdings_value(const std::map<std::string, double>& market_prices) const {
-    double total_value = 0.0;
-    for (const auto& pair : positions_) {
-        const std::string& symbol = pair.first;
-        int quantity = pair.second;
+    summary_.final_equity = total_equity;
+    summary_.peak_equity = std::max(summary_.peak_equity, total_equity);
+    if (summary_.peak_equity > 0.0) {
+        summary_.max_drawdown = std::max(
+            summary_.max_drawdown, (summary_.peak_equity - total_equity) / summary_.peak_equity);
+    }
+    ++summary_.equity_points;
 
-        if (market_prices.count(symbol)) {
-            total_value += quantity * market_prices.at(symbol);
+    if (results_) {
+        if ((summary_.equity_points - 1) % equity_sample_every_ == 0) {
+            results_->add_equity(timestamp, total_equity);
+            skipped_equity_.reset();
+        } else {
+            skipped_equity_ = EquityPoint{timestamp, total_equity};
         }
     }
-    return total_value;
+}
+
+void OrderManager::set_equity_sample_every(std::size_t every) {
+    if (every == 0) {
+        throw std::invalid_argument("equity_sample_every must be at least 1");
+    }
+    equity_sample_every_ = every;
+}
+
+void OrderManager::flush_results() {
+    if (results_) {
+        results_->flush();
+    }
+}
+
+void OrderManager::open_outputs(const std::string& equity_curve_path,
+                                const std::string& tradelog_path) {
+    ResultSink::Options options;
+    if (config_) {
+        options.format = parse_result_format(config_->get_result_format());
+        equity_sample_every_ = config_->get_equity_sample_every();
+    }
+    if (!equity_curve_path.empty() || !tradelog_path.empty()) {
+        // Creates both files and writes the CSV headers straight away
+        results_ = std::make_unique<ResultSink>(equity_curve_path, tradelog_path, options);
+    }
+}
+
+void OrderManager::init_run_summary() {
+    summary_ = RunSummary{};
+    summary_.initial_cash = portfolio_.cash();
+    summary_.final_equity = portfolio_.cash();
+    summary_.peak_equity = portfolio_.cash();
+}
+
+void OrderManager::log_trade(long long timestamp, const std::string& symbol,
+                             const std::string& type, int quantity, double price) {
+    ++summary_.trades;
+    summary_.traded_notional += std::abs(quantity * price);
+    if (results_) {
+        results_->add_trade(TradeRecord{timestamp, symbol, type == "BUY", quantity, price,
+                                        portfolio_.cash()});
+    }
 }
 
 // --- Tick-level order management stub implementations ---
@@ -171,6 +227,7 @@ OrderId OrderManager::submit_market_order(const std::string& symbol, Order::Side
     Order order;
     order.order_id = order_id;
     order.symbol = symbol;
+    order.symbol_id = intern_symbol(symbol);
     order.type = Order::Type::MARKET;
     order.side = side;
     order.time_in_force = Order::TimeInForce::DAY;
@@ -192,10 +249,15 @@ OrderId OrderManager::submit_limit_order(const std::string& symbol, Order::Side
     Order order;
     order.order_id = order_id;
     order.symbol = symbol;
+    order.symbol_id = intern_symbol(symbol);
     order.type = Order::Type::LIMIT;
     order.side = side;
     order.time_in_force = tif;
-    order.limit_price = limit_price;
+    // Off-grid limits round inward, so a buy never pays and a sell never
+    // receives worse than the price it was given
+    const TickScale& scale = tick_scale(order.symbol_id);
+    order.limit_price = scale.to_price(side == Order::Side::BUY ? scale.floor_ticks(limit_price)
+                                                                : scale.ceil_ticks(limit_price));
     order.quantity = quantity;
     order.filled_quantity = 0;
     order.avg_fill_price = 0.0;
@@ -217,7 +279,7 @@ OrderId OrderManager::submit_limit_order(const std::string& symbol, Order::Side
         submit_tick.symbol = symbol;
         submit_tick.timestamp = stored.timestamp;
 
-        auto& book = depth_books_[symbol];
+        auto& book = depth_book_for(symbol, stored.symbol_id);
         take_liquidity(stored, book, submit_tick);
 
         if (stored.is_filled()) {
@@ -227,8 +289,8 @@ OrderId OrderManager::submit_limit_order(const std::string& symbol, Order::Side
             stored.status = Order::Status::CANCELLED;
             remove_order_from_book(order_id);
         } else {
-            QueueId qid =
-                book.enqueue_order(side, limit_price, order_id, stored.remaining_quantity());
+            QueueId qid = book.enqueue_order(side, stored.limit_price, order_id,
+                                             stored.remaining_quantity());
             limit_queue_ids_[order_id] = qid;
         }
     }
@@ -296,6 +358,8 @@ void OrderManager::process_tick(const Tick& tick) {
         ofi_->update(tick);
     }
 
+    const SymbolId symbol = resolve_symbol_id(tick);
+
     // Update the order book first
     if (use_full_depth_) {
         // The tick's trade consumes the FIFO queue at its price (advancing
@@ -304,23 +368,26 @@ void OrderManager::process_tick(const Tick& tick) {
         if (tick.volume > 0 && tick.price > 0) {
             consume_trade_print(tick);
         }
-        depth_books_[tick.symbol].on_tick(tick);
+        depth_book_for(tick.symbol, symbol).on_tick(tick);
     } else if (order_book_ != nullptr) {
         order_book_->on_tick(tick);
     }
 
-    // Use the tick's symbol for order matching
-    std::string symbol = tick.symbol;
+    // Use the tick's symbol for order matching; its book changed, so the
+    // next attempt_fills() revisits it. Its position is marked at the trade
+    // price for record_equity().
+    mark_dirty(symbol);
+    portfolio_.mark(symbol, tick.price);
 
     if (qse_debug_enabled())
-        std::cout << "DEBUG: Processing tick for " << symbol << " bid=" << tick.bid
+        std::cout << "DEBUG: Processing tick for " << tick.symbol << " bid=" << tick.bid
                   << " ask=" << tick.ask << " mid=" << tick.mid_price() << std::endl;
 
     // Match orders for this symbol first
     match_orders_for_symbol(symbol, tick);
 
     // Cancel IOC orders that weren't filled immediately
-    cancel_ioc_orders(symbol, tick);
+    cancel_ioc_orders(symbol);
 }
 
 std::optional<Order> OrderManager::get_order(const OrderId& order_id) const {
@@ -334,12 +401,22 @@ std::optional<Order> OrderManager::get_order(const OrderId& order_id) const {
 std::vector<Order> OrderManager::get_active_orders(const std::string& symbol) const {
     std::vector<Order> active_orders;
 
-    auto symbol_it = symbol_orders_.find(symbol);
-    if (symbol_it == symbol_orders_.end()) {
+    const SymbolId id = SymbolTable::instance().find(symbol);
+    if (id >= symbol_orders_.size()) {
         return active_orders;
     }
 
-    for (const OrderId& order_id : symbol_it->second) {
+    // Report in submission order (IDs count up), whatever the index order
+    const SymbolOrders& index = symbol_orders_[id];
+    std::vector<OrderId> order_ids = index.market;
+    for (const auto* limits : {&index.buys, &index.sells}) {
+        for (const LimitEntry& entry : *limits) {
+            order_ids.push_back(entry.id);
+        }
+    }
+    std::sort(order_ids.begin(), order_ids.end());
+
+    for (const OrderId& order_id : order_ids) {
         auto order_it = orders_.find(order_id);
         if (order_it != orders_.end()) {
             const Order& order = order_it->second;
@@ -355,12 +432,76 @@ std::vector<Order> OrderManager::get_active_orders(const std::string& symbol) co
 // --- Helper method implementations ---
 
 OrderId OrderManager::generate_order_id() {
-    return "ORDER_" + std::to_string(next_order_id_++);
+    return next_order_id_++;
+}
+
+OrderBookFullDepth& OrderManager::depth_book(const std::string& symbol) {
+    const SymbolId id = intern_symbol(symbol);
+    mark_dirty(id);
+    return depth_book_for(symbol, id);
+}
+
+OrderBookFullDepth& OrderManager::depth_book_for(const std::string& symbol, SymbolId id) {
+    return depth_books_.try_emplace(symbol, tick_scale(id)).first->second;
+}
+
+const TickScale& OrderManager::tick_scale(SymbolId symbol) {
+    while (tick_scales_.size() <= symbol) {
+        const SymbolId id = static_cast<SymbolId>(tick_scales_.size());
+        tick_scales_.emplace_back(config_ != nullptr
+                                      ? config_->get_tick_size(SymbolTable::instance().name(id))
+                                      : kDefaultPriceResolution);
+    }
+    return tick_scales_[symbol];
+}
+
+bool OrderManager::limit_crosses(const Order& order, Price quote) const {
+    // Only called for orders that went through add_order_to_book, which
+    // sized tick_scales_ for their symbol
+    const TickScale& scale = tick_scales_[order.symbol_id];
+    const PriceTicks limit = scale.to_ticks(order.limit_price);
+    return order.side == Order::Side::BUY ? scale.to_ticks(quote) <= limit
+                                          : scale.to_ticks(quote) >= limit;
+}
+
+void OrderManager::mark_dirty(SymbolId symbol) {
+    if (symbol >= dirty_flags_.size()) {
+        dirty_flags_.resize(static_cast<std::size_t>(symbol) + 1, 0);
+    }
+    if (!dirty_flags_[symbol]) {
+        dirty_flags_[symbol] = 1;
+        dirty_symbols_.push_back(symbol);
+    }
 }
 
 void OrderManager::add_order_to_book(const Order& order) {
     orders_[order.order_id] = order;
-    symbol_orders_[order.symbol].push_back(order.order_id);
+
+    const SymbolId symbol = order.symbol_id;
+    const TickScale& scale = tick_scale(symbol);
+    if (symbol >= symbol_orders_.size()) {
+        symbol_orders_.resize(static_cast<std::size_t>(symbol) + 1);
+    }
+    SymbolOrders& index = symbol_orders_[symbol];
+    if (order.type == Order::Type::MARKET) {
+        index.market.push_back(order.order_id);
+    } else {
+        // IDs count up, so a new order goes after every order at its limit
+        const LimitEntry entry{scale.to_ticks(order.limit_price), order.order_id};
+        if (order.side == Order::Side::BUY) {
+            index.buys.insert(
+                std::upper_bound(index.buys.begin(), index.buys.end(), entry, BuyPriority{}),
+                entry);
+        } else {
+            index.sells.insert(
+                std::upper_bound(index.sells.begin(), index.sells.end(), entry, SellPriority{}),
+                entry);
+        }
+        if (order.time_in_force == Order::TimeInForce::IOC) {
+            ++index.ioc;
+        }
+    }
+    mark_dirty(symbol);
 }
 
 void OrderManager::remove_order_from_book(const OrderId& order_id) {
@@ -369,41 +510,41 @@ void OrderManager::remove_order_from_book(const OrderId& order_id) {
         return;
     }
 
-    const std::string& symbol = order_it->second.symbol;
-
-    // Remove from symbol_orders_
-    auto symbol_it = symbol_orders_.find(symbol);
-    if (symbol_it != symbol_orders_.end()) {
-        auto& order_ids = symbol_it->second;
-        order_ids.erase(std::remove(order_ids.begin(), order_ids.end(), order_id), order_ids.end());
-
-        // Remove empty symbol entries
-        if (order_ids.empty()) {
-            symbol_orders_.erase(symbol_it);
-        }
+    const Order& order = order_it->second;
+    if (order.symbol_id >= symbol_orders_.size()) {
+        return;
+    }
+    SymbolOrders& index = symbol_orders_[order.symbol_id];
+    if (order.type == Order::Type::MARKET) {
+        index.market.erase(std::remove(index.market.begin(), index.market.end(), order_id),
+                           index.market.end());
+        return;
+    }
+    const std::size_t before = index.buys.size() + index.sells.size();
+    const PriceTicks limit = tick_scales_[order.symbol_id].to_ticks(order.limit_price);
+    if (order.side == Order::Side::BUY) {
+        erase_limit(index.buys, limit, order_id, BuyPriority{});
+    } else {
+        erase_limit(index.sells, limit, order_id, SellPriority{});
+    }
+    if (order.time_in_force == Order::TimeInForce::IOC &&
+        index.buys.size() + index.sells.size() < before) {
+        --index.ioc;
     }
 }
 
-void OrderManager::match_orders_for_symbol(const std::string& symbol, const Tick& tick) {
-    auto symbol_it = symbol_orders_.find(symbol);
-    if (symbol_it == symbol_orders_.end()) {
+void OrderManager::match_orders_for_symbol(SymbolId symbol, const Tick& tick) {
+    if (symbol >= symbol_orders_.size() || symbol_orders_[symbol].empty()) {
         if (qse_debug_enabled())
-            std::cout << "DEBUG: No orders found for symbol " << symbol << std::endl;
+            std::cout << "DEBUG: No orders found for symbol " << tick.symbol << std::endl;
         return;
     }
-
-    // Iterate a copy: maker fills triggered inside the loop can remove
-    // entries from symbol_orders_ and invalidate references into it
-    std::vector<OrderId> order_ids = symbol_it->second;
-    if (qse_debug_enabled())
-        std::cout << "DEBUG: Found " << order_ids.size() << " orders for symbol " << symbol
-                  << std::endl;
-    std::vector<OrderId> to_remove;
+    const SymbolOrders& index = symbol_orders_[symbol];
 
     // Get current top of book from whichever book model is active
     TopOfBook tob;
     if (use_full_depth_) {
-        auto db_it = depth_books_.find(symbol);
+        auto db_it = depth_books_.find(tick.symbol);
         if (db_it != depth_books_.end()) {
             tob = db_it->second.top_of_book();
         }
@@ -411,6 +552,31 @@ void OrderManager::match_orders_for_symbol(const std::string& symbol, const Tick
         tob = order_book_->top_of_book(symbol);
     }
 
+    // Collect the orders that can trade into a scratch list: fills and
+    // callbacks inside the loop can change the index. Market orders always
+    // try; limit orders only up to the first that does not cross. In the
+    // depth model limits rest in the book and fill from trade prints.
+    std::vector<OrderId> order_ids;
+    order_ids.swap(match_ids_);
+    order_ids.assign(index.market.begin(), index.market.end());
+    if (!use_full_depth_) {
+        const bool has_ask = order_book_ == nullptr || tob.has_ask();
+        const bool has_bid = order_book_ == nullptr || tob.has_bid();
+        const TickScale& scale = tick_scales_[symbol];
+        const PriceTicks ask =
+            scale.to_ticks(order_book_ != nullptr ? tob.best_ask_price : tick.ask);
+        const PriceTicks bid =
+            scale.to_ticks(order_book_ != nullptr ? tob.best_bid_price : tick.bid);
+        append_marketable(
+            index.buys, [&](PriceTicks limit) { return has_ask && ask <= limit; }, order_ids);
+        append_marketable(
+            index.sells, [&](PriceTicks limit) { return has_bid && bid >= limit; }, order_ids);
+    }
+    if (qse_debug_enabled())
+        std::cout << "DEBUG: Found " << order_ids.size() << " matchable orders for symbol "
+                  << tick.symbol << std::endl;
+    std::vector<OrderId> to_remove;
+
     for (const OrderId& order_id : order_ids) {
         auto order_it = orders_.find(order_id);
         if (order_it == orders_.end()) {
@@ -441,7 +607,7 @@ void OrderManager::match_orders_for_symbol(const std::string& symbol, const Tick
                 // Walk the full-depth book: the taker pays the VWAP of the
                 // liquidity consumed, and any strategy maker orders that
                 // were consumed get credited with their fills
-                auto db_it = depth_books_.find(symbol);
+                auto db_it = depth_books_.find(tick.symbol);
                 if (db_it != depth_books_.end()) {
                     take_liquidity(order, db_it->second, tick);
                     if (order.is_filled()) {
@@ -457,8 +623,8 @@ void OrderManager::match_orders_for_symbol(const std::string& symbol, const Tick
         if (order.type == Order::Type::MARKET) {
             if (order_book_ != nullptr) {
                 // Use OrderBook to consume liquidity
-                fill_qty =
-                    order_book_->consume_liquidity(symbol, order.side, order.remaining_quantity());
+                fill_qty = order_book_->consume_liquidity(order.symbol_id, order.side,
+                                                          order.remaining_quantity());
                 if (fill_qty > 0) {
                     fill_price =
                         (order.side == Order::Side::BUY) ? tob.best_ask_price : tob.best_bid_price;
@@ -482,9 +648,8 @@ void OrderManager::match_orders_for_symbol(const std::string& symbol, const Tick
             } else {
                 // Fallback to old logic: the order crosses when the touch
                 // reaches its limit price on the relevant side
-                bool crosses = (order.side == Order::Side::BUY && tick.ask <= order.limit_price) ||
-                               (order.side == Order::Side::SELL && tick.bid >= order.limit_price);
-                if (crosses) {
+                const Price quote = (order.side == Order::Side::BUY) ? tick.ask : tick.bid;
+                if (limit_crosses(order, quote)) {
                     fill_qty = std::min(order.remaining_quantity(), tick.volume);
                     fill_price = order.limit_price;
                 }
@@ -510,6 +675,8 @@ void OrderManager::match_orders_for_symbol(const std::string& symbol, const Tick
     for (const OrderId& order_id : to_remove) {
         remove_order_from_book(order_id);
     }
+    order_ids.clear();
+    match_ids_.swap(order_ids);
 }
 
 void OrderManager::fill_order(Order& order, Volume fill_qty, Price fill_price, const Tick& tick,
@@ -550,40 +717,47 @@ void OrderManager::fill_order(Order& order, Volume fill_qty, Price fill_price, c
         order.status = Order::Status::PARTIALLY_FILLED;
     }
 
+    // Execution cost against the mid at fill time (spread, slippage
+    // coefficient and depth impact together); falls back to the trade price
+    // when the tick carries no two-sided quote
+    const double mid =
+        (tick.bid > 0.0 && tick.ask > 0.0) ? 0.5 * (tick.bid + tick.ask) : tick.price;
+
     // Update portfolio
     if (order.side == Order::Side::BUY) {
         double cost = fill_qty * base_fill_price;
-        if (cost <= cash_) {
-            cash_ -= cost;
-            positions_[order.symbol] += fill_qty;
+        if (cost <= portfolio_.cash()) {
+            portfolio_.trade(order.symbol_id, static_cast<int64_t>(fill_qty), base_fill_price);
+            summary_.slippage_cost += (base_fill_price - mid) * fill_qty;
             log_trade(to_unix_ms(tick.timestamp), order.symbol, "BUY", fill_qty, base_fill_price);
         }
     } else { // SELL
-        double proceeds = fill_qty * base_fill_price;
-        cash_ += proceeds;
-        positions_[order.symbol] -= fill_qty;
+        portfolio_.trade(order.symbol_id, -static_cast<int64_t>(fill_qty), base_fill_price);
+        summary_.slippage_cost += (mid - base_fill_price) * fill_qty;
         log_trade(to_unix_ms(tick.timestamp), order.symbol, "SELL", fill_qty, base_fill_price);
     }
 }
 
-void OrderManager::cancel_ioc_orders(const std::string& symbol, const Tick& tick) {
-    auto symbol_it = symbol_orders_.find(symbol);
-    if (symbol_it == symbol_orders_.end()) {
+void OrderManager::cancel_ioc_orders(SymbolId symbol) {
+    // Only limit orders carry IOC; most symbols have none to look for
+    if (symbol >= symbol_orders_.size() || symbol_orders_[symbol].ioc == 0) {
         return;
     }
 
-    std::vector<OrderId>& order_ids = symbol_it->second;
+    const SymbolOrders& index = symbol_orders_[symbol];
     std::vector<OrderId> to_cancel;
 
-    for (const OrderId& order_id : order_ids) {
-        auto order_it = orders_.find(order_id);
-        if (order_it == orders_.end()) {
-            continue;
-        }
+    for (const auto* limits : {&index.buys, &index.sells}) {
+        for (const LimitEntry& entry : *limits) {
+            auto order_it = orders_.find(entry.id);
+            if (order_it == orders_.end()) {
+                continue;
+            }
 
-        Order& order = order_it->second;
-        if (order.time_in_force == Order::TimeInForce::IOC && order.filled_quantity == 0) {
-            to_cancel.push_back(order_id);
+            const Order& order = order_it->second;
+            if (order.time_in_force == Order::TimeInForce::IOC && order.filled_quantity == 0) {
+                to_cancel.push_back(entry.id);
+            }
         }
     }
 
@@ -601,14 +775,14 @@ Volume OrderManager::process_limit_order_fill(Order& order, const TopOfBook& tob
 
     if (order.side == Order::Side::BUY) {
         // Buy limit order fills when ask price is at or below limit price
-        if (tob.has_ask() && tob.best_ask_price <= order.limit_price) {
-            fill_qty = order_book_->consume_liquidity(order.symbol, order.side,
+        if (tob.has_ask() && limit_crosses(order, tob.best_ask_price)) {
+            fill_qty = order_book_->consume_liquidity(order.symbol_id, order.side,
                                                       order.remaining_quantity());
         }
     } else { // SELL
         // Sell limit order fills when bid price is at or above limit price
-        if (tob.has_bid() && tob.best_bid_price >= order.limit_price) {
-            fill_qty = order_book_->consume_liquidity(order.symbol, order.side,
+        if (tob.has_bid() && limit_crosses(order, tob.best_bid_price)) {
+            fill_qty = order_book_->consume_liquidity(order.symbol_id, order.side,
                                                       order.remaining_quantity());
         }
     }
@@ -621,14 +795,14 @@ Volume OrderManager::process_ioc_order_fill(Order& order, const TopOfBook& tob)
 
     if (order.side == Order::Side::BUY) {
         // IOC buy order fills when ask price is at or below limit price
-        if (tob.has_ask() && tob.best_ask_price <= order.limit_price) {
-            fill_qty = order_book_->consume_liquidity(order.symbol, order.side,
+        if (tob.has_ask() && limit_crosses(order, tob.best_ask_price)) {
+            fill_qty = order_book_->consume_liquidity(order.symbol_id, order.side,
                                                       order.remaining_quantity());
         }
     } else { // SELL
         // IOC sell order fills when bid price is at or above limit price
-        if (tob.has_bid() && tob.best_bid_price >= order.limit_price) {
-            fill_qty = order_book_->consume_liquidity(order.symbol, order.side,
+        if (tob.has_bid() && limit_crosses(order, tob.best_bid_price)) {
+            fill_qty = order_book_->consume_liquidity(order.symbol_id, order.side,
                                                       order.remaining_quantity());
         }
     }
@@ -642,131 +816,158 @@ void OrderManager::attempt_fills() {
         return; // No book model available
     }
 
-    // Snapshot symbols first: removing filled orders can erase entries from
-    // symbol_orders_, which would invalidate an iterator over it
-    std::vector<std::string> symbols;
-    symbols.reserve(symbol_orders_.size());
-    for (const auto& symbol_pair : symbol_orders_) {
-        symbols.push_back(symbol_pair.first);
+    // Only symbols whose book or orders changed since the last pass can have
+    // anything new to match. Take the set first: fills can dirty symbols
+    // again, and those wait for the next pass.
+    std::vector<SymbolId> symbols;
+    symbols.swap(dirty_symbols_);
+    for (SymbolId symbol : symbols) {
+        dirty_flags_[symbol] = 0;
+    }
+    for (SymbolId symbol : symbols) {
+        attempt_fills_for_symbol(symbol);
     }
 
-    // Process fills for each symbol that has active orders
-    for (const std::string& symbol : symbols) {
-        auto symbol_it = symbol_orders_.find(symbol);
-        if (symbol_it == symbol_orders_.end() || symbol_it->second.empty()) {
-            continue;
-        }
+    // Hand the buffer back so steady-state passes do not allocate
+    if (dirty_symbols_.empty()) {
+        symbols.clear();
+        dirty_symbols_.swap(symbols);
+    }
+}
 
-        // Get current top of book from whichever book model is active
-        TopOfBook tob;
-        OrderBookFullDepth* depth = nullptr;
-        if (use_full_depth_) {
-            auto db_it = depth_books_.find(symbol);
-            if (db_it == depth_books_.end()) {
-                continue; // No liquidity known for this symbol
-            }
-            depth = &db_it->second;
-            tob = depth->top_of_book();
-        } else {
-            tob = order_book_->top_of_book(symbol);
-        }
-        if (!tob.has_bid() && !tob.has_ask()) {
-            continue; // No liquidity available
+void OrderManager::attempt_fills_for_symbol(SymbolId symbol_id) {
+    if (symbol_id >= symbol_orders_.size() || symbol_orders_[symbol_id].empty()) {
+        return;
+    }
+    const SymbolOrders& index = symbol_orders_[symbol_id];
+    const std::string& symbol = SymbolTable::instance().name(symbol_id);
+
+    // Get current top of book from whichever book model is active
+    TopOfBook tob;
+    OrderBookFullDepth* depth = nullptr;
+    if (use_full_depth_) {
+        auto db_it = depth_books_.find(symbol);
+        if (db_it == depth_books_.end()) {
+            return; // No liquidity known for this symbol
         }
+        depth = &db_it->second;
+        tob = depth->top_of_book();
+    } else {
+        tob = order_book_->top_of_book(symbol_id);
+    }
+    if (!tob.has_bid() && !tob.has_ask()) {
+        return; // No liquidity available
+    }
 
-        std::vector<OrderId> to_remove;
+    // Collect the orders that can trade into a scratch list: maker fills and
+    // fill callbacks inside the loop can change the index. Market orders
+    // always try; limit orders only up to the first that does not cross
+    // (in the depth model they rest in the book and fill from trade prints).
+    std::vector<OrderId> order_ids;
+    order_ids.swap(match_ids_);
+    order_ids.assign(index.market.begin(), index.market.end());
+    if (depth == nullptr) {
+        const TickScale& scale = tick_scales_[symbol_id];
+        const PriceTicks ask = scale.to_ticks(tob.best_ask_price);
+        const PriceTicks bid = scale.to_ticks(tob.best_bid_price);
+        append_marketable(
+            index.buys, [&](PriceTicks limit) { return tob.has_ask() && ask <= limit; },
+            order_ids);
+        append_marketable(
+            index.sells, [&](PriceTicks limit) { return tob.has_bid() && bid >= limit; },
+            order_ids);
+    }
 
-        // Iterate a copy: maker fills triggered inside the loop can remove
-        // entries from symbol_orders_ and invalidate references into it
-        std::vector<OrderId> order_ids = symbol_it->second;
-        for (const OrderId& order_id : order_ids) {
-            auto order_it = orders_.find(order_id);
-            if (order_it == orders_.end()) {
-                continue;
-            }
+    std::vector<OrderId> to_remove;
+    for (const OrderId& order_id : order_ids) {
+        auto order_it = orders_.find(order_id);
+        if (order_it == orders_.end()) {
+            continue;
+        }
 
-            Order& order = order_it->second;
-            if (!order.is_active()) {
-                continue;
-            }
+        Order& order = order_it->second;
+        if (!order.is_active()) {
+            continue;
+        }
 
-            if (depth != nullptr) {
-                if (order.type == Order::Type::MARKET) {
-                    // Walk the full-depth book: the taker pays the VWAP of
-                    // consumed liquidity, and any strategy maker orders that
-                    // were consumed get credited with their fills
-                    Tick book_tick{};
-                    book_tick.symbol = symbol;
-                    book_tick.timestamp = std::chrono::system_clock::now();
-                    book_tick.bid = tob.best_bid_price;
-                    book_tick.ask = tob.best_ask_price;
-                    book_tick.bid_size = tob.best_bid_size;
-                    book_tick.ask_size = tob.best_ask_size;
-                    book_tick.price = tob.mid_price();
-
-                    take_liquidity(order, *depth, book_tick);
-                    if (order.is_filled()) {
-                        to_remove.push_back(order_id);
-                    }
+        if (depth != nullptr) {
+            if (order.type == Order::Type::MARKET) {
+                // Walk the full-depth book: the taker pays the VWAP of
+                // consumed liquidity, and any strategy maker orders that
+                // were consumed get credited with their fills
+                Tick book_tick{};
+                book_tick.symbol = symbol;
+                book_tick.timestamp = std::chrono::system_clock::now();
+                book_tick.bid = tob.best_bid_price;
+                book_tick.ask = tob.best_ask_price;
+                book_tick.bid_size = tob.best_bid_size;
+                book_tick.ask_size = tob.best_ask_size;
+                book_tick.price = tob.mid_price();
+
+                take_liquidity(order, *depth, book_tick);
+                if (order.is_filled()) {
+                    to_remove.push_back(order_id);
                 }
-                // LIMIT orders rest in the depth book; their fills come from
-                // trade prints consuming the queue (consume_trade_print)
-                continue;
             }
+            // LIMIT orders rest in the depth book; their fills come from
+            // trade prints consuming the queue (consume_trade_print)
+            continue;
+        }
 
-            Volume fill_qty = 0;
-            Price fill_price = 0.0;
+        Volume fill_qty = 0;
+        Price fill_price = 0.0;
 
-            if (order.type == Order::Type::MARKET) {
-                // Market orders fill immediately at the touch
-                fill_qty =
-                    order_book_->consume_liquidity(symbol, order.side, order.remaining_quantity());
-                if (fill_qty > 0) {
-                    fill_price =
-                        (order.side == Order::Side::BUY) ? tob.best_ask_price : tob.best_bid_price;
-                }
-            } else if (order.type == Order::Type::LIMIT) {
-                // Limit orders fill when price crosses limit
-                fill_qty = process_limit_order_fill(order, tob);
-                if (fill_qty > 0) {
-                    fill_price =
-                        (order.side == Order::Side::BUY) ? tob.best_ask_price : tob.best_bid_price;
-                }
+        if (order.type == Order::Type::MARKET) {
+            // Market orders fill immediately at the touch
+            fill_qty = order_book_->consume_liquidity(order.symbol_id, order.side,
+                                                      order.remaining_quantity());
+            if (fill_qty > 0) {
+                fill_price =
+                    (order.side == Order::Side::BUY) ? tob.best_ask_price : tob.best_bid_price;
             }
-
+        } else if (order.type == Order::Type::LIMIT) {
+            // Limit orders fill when price crosses limit
+            fill_qty = process_limit_order_fill(order, tob);
             if (fill_qty > 0) {
-                // Create a dummy tick for the fill (since we don't have a real tick here)
-                Tick dummy_tick;
-                dummy_tick.symbol = symbol;
-                dummy_tick.timestamp = std::chrono::system_clock::now();
-                dummy_tick.bid = tob.best_bid_price;
-                dummy_tick.ask = tob.best_ask_price;
-                dummy_tick.bid_size = tob.best_bid_size;
-                dummy_tick.ask_size = tob.best_ask_size;
-                dummy_tick.price = (tob.best_bid_price + tob.best_ask_price) / 2.0;
-                dummy_tick.volume = fill_qty;
-
-                fill_order(order, fill_qty, fill_price, dummy_tick);
-
-                // Emit fill callback if registered
-                if (fill_callback_) {
-                    std::string side_str = (order.side == Order::Side::BUY) ? "BUY" : "SELL";
-                    Fill fill(order.order_id, order.symbol, fill_qty, fill_price,
-                              dummy_tick.timestamp, side_str);
-                    fill_callback_(fill);
-                }
-
-                if (order.is_filled()) {
-                    to_remove.push_back(order_id);
-                }
+                fill_price =
+                    (order.side == Order::Side::BUY) ? tob.best_ask_price : tob.best_bid_price;
             }
         }
 
-        // Remove filled orders from symbol_orders_
-        for (const OrderId& order_id : to_remove) {
-            remove_order_from_book(order_id);
+        if (fill_qty > 0) {
+            // Create a dummy tick for the fill (since we don't have a real tick here)
+            Tick dummy_tick;
+            dummy_tick.symbol = symbol;
+            dummy_tick.timestamp = std::chrono::system_clock::now();
+            dummy_tick.bid = tob.best_bid_price;
+            dummy_tick.ask = tob.best_ask_price;
+            dummy_tick.bid_size = tob.best_bid_size;
+            dummy_tick.ask_size = tob.best_ask_size;
+            dummy_tick.price = (tob.best_bid_price + tob.best_ask_price) / 2.0;
+            dummy_tick.volume = fill_qty;
+
+            fill_order(order, fill_qty, fill_price, dummy_tick);
+
+            // Emit fill callback if registered
+            if (fill_callback_) {
+                std::string side_str = (order.side == Order::Side::BUY) ? "BUY" : "SELL";
+                Fill fill(order.order_id, order.symbol, fill_qty, fill_price,
+                          dummy_tick.timestamp, side_str);
+                fill_callback_(fill);
+            }
+
+            if (order.is_filled()) {
+                to_remove.push_back(order_id);
+            }
         }
     }
+
+    // Remove filled orders from symbol_orders_
+    for (const OrderId& order_id : to_remove) {
+        remove_order_from_book(order_id);
+    }
+    order_ids.clear();
+    match_ids_.swap(order_ids);
 }
 
 // --- NEW: Set fill callback for strategy notifications ---
@@ -789,11 +990,11 @@ Volume OrderManager::take_liquidity(Order& taker, OrderBookFullDepth& book, cons
         bool crossable = false;
         if (taker.side == Order::Side::BUY) {
             crossable = tob.has_ask() && (taker.type == Order::Type::MARKET ||
-                                          tob.best_ask_price <= taker.limit_price);
+                                          limit_crosses(taker, tob.best_ask_price));
             level_price = tob.best_ask_price;
         } else {
             crossable = tob.has_bid() && (taker.type == Order::Type::MARKET ||
-                                          tob.best_bid_price >= taker.limit_price);
+                                          limit_crosses(taker, tob.best_bid_price));
             level_price = tob.best_bid_price;
         }
         if (!crossable) {
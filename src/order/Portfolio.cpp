@@ -0,0 +1,13 @@
+#include "qse/order/Portfolio.h"
+
+namespace qse {
+
+double Portfolio::recompute_holdings_value() const {
+    double total = 0.0;
+    for (const Holding& h : holdings_) {
+        total += static_cast<double>(h.position) * h.last_price;
+    }
+    return total;
+}
+
+} // namespace qse
@@ -145,9 +145,11 @@ void run_one(bool depth_mode, qse::Volume order_size, const std::vector<Row>& ro
                 qse::Price ask_px = tick.ask + static_cast<double>(lvl) * kTickSize;
                 qse::Price bid_px = tick.bid - static_cast<double>(lvl) * kTickSize;
                 qse::QueueId aq = book.enqueue_order(qse::Order::Side::SELL, ask_px,
-                                                     "seed_a" + std::to_string(lvl), tick.ask_size);
+                                                     qse::kExternalOrderIdBase + 2 * lvl,
+                                                     tick.ask_size);
                 qse::QueueId bq = book.enqueue_order(qse::Order::Side::BUY, bid_px,
-                                                     "seed_b" + std::to_string(lvl), tick.bid_size);
+                                                     qse::kExternalOrderIdBase + 2 * lvl + 1,
+                                                     tick.bid_size);
                 seeds.push_back({qse::Order::Side::SELL, ask_px, aq});
                 seeds.push_back({qse::Order::Side::BUY, bid_px, bq});
             }
@@ -28,8 +28,8 @@ int main(int argc, char** argv) {
 
         // 1-share buy limit at $1.00: cannot fill, sits visibly on the book
         std::cout << "Submitting 1-share AAPL buy limit @ $1.00 (day)...\n";
-        qse::OrderId id = handler.submit_limit_order("AAPL", qse::Order::Side::BUY, 1, 1.0,
-                                                     qse::Order::TimeInForce::DAY);
+        qse::VenueOrderId id = handler.submit_limit_order("AAPL", qse::Order::Side::BUY, 1, 1.0,
+                                                          qse::Order::TimeInForce::DAY);
         if (id.empty()) {
             std::cerr << "Order rejected - check credentials/market status\n";
             return 1;
@@ -1,4 +1,4 @@
-// Arena allocator microbenchmark (roadmap G1). Two experiments:
+// Arena allocator microbenchmark (roadmap G1). Four experiments:
 //
 //   1. Raw allocation path: N small allocations through the arena bump
 //      pointer vs paired ::operator new/delete calls.
@@ -6,15 +6,23 @@
 //      walk it with fill_market, destroy it - heap-backed vs arena-backed
 //      with an O(1) reset between iterations. This mirrors the inner loop of
 //      impact_sweep/ab_audit, where thousands of books are built per run.
+//   3. The same workload on PriceLadderBook (flat integer-tick ladder,
+//      pooled order nodes), reused through clear().
+//   4. Steady-state queue workload near the touch: a replayed stream of
+//      enqueue / consume_at_price / cancel / queue_position operations on a
+//      live book, OrderBookFullDepth vs PriceLadderBook.
 //
 // Results are recorded in docs/benchmarks/04_arena_allocator.md.
 
 #include "qse/core/Arena.h"
 #include "qse/data/OrderBookFullDepth.h"
+#include "qse/data/PriceLadderBook.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -65,7 +73,7 @@ void bench_raw_allocations(std::size_t n) {
 std::int64_t build_and_fill_book(qse::OrderBookFullDepth& book, std::size_t levels) {
     for (std::size_t lvl = 0; lvl < levels; ++lvl) {
         book.enqueue_order(qse::Order::Side::SELL, 100.0 + static_cast<double>(lvl) * 0.01,
-                           "lvl_" + std::to_string(lvl), 100);
+                           lvl + 1, 100);
     }
     auto result = book.fill_market(qse::Order::Side::BUY, static_cast<std::int64_t>(levels) * 50);
     return result.first;
@@ -103,12 +111,166 @@ void bench_book_workload(std::size_t iterations, std::size_t levels) {
               << "  arena high-water mark: " << arena.high_water_mark() / 1024 << " KiB\n";
 }
 
+void bench_ladder_workload(std::size_t iterations, std::size_t levels) {
+    std::int64_t filled_total = 0;
+    qse::PriceLadderBook book(0.01, levels, levels);
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        for (std::size_t lvl = 0; lvl < levels; ++lvl) {
+            book.enqueue_order(qse::Order::Side::SELL, 100.0 + static_cast<double>(lvl) * 0.01,
+                               lvl, 100);
+        }
+        auto result =
+            book.fill_market(qse::Order::Side::BUY, static_cast<std::int64_t>(levels) * 50);
+        filled_total += result.first;
+        book.clear();
+    }
+    double ladder_ms = ms_since(start);
+
+    g_sink += static_cast<std::uintptr_t>(filled_total);
+    std::cout << "price-ladder workload (" << iterations << " books x " << levels
+              << " levels, build + VWAP walk + clear):\n"
+              << "  PriceLadderBook: " << ladder_ms << " ms  (" << ladder_ms * 1e3 / iterations
+              << " us/book)\n";
+}
+
+struct QueueOp {
+    enum Kind { Enqueue, Consume, Cancel, Position } kind;
+    qse::Order::Side side;
+    double price;
+    std::uint64_t id; // order to enqueue / cancel / locate
+    qse::Volume size;
+};
+
+// Replayable op stream: prices within `depth` ticks of a fixed touch, cancels
+// and position queries against recently placed orders
+std::vector<QueueOp> make_queue_ops(std::size_t n, int depth, std::uint64_t first_id) {
+    std::mt19937_64 rng(7);
+    std::vector<QueueOp> ops;
+    ops.reserve(n);
+    std::uint64_t next_id = first_id;
+    for (std::size_t i = 0; i < n; ++i) {
+        QueueOp op{};
+        op.side = (rng() % 2) ? qse::Order::Side::BUY : qse::Order::Side::SELL;
+        const int offset = static_cast<int>(rng() % static_cast<std::uint64_t>(depth));
+        op.price = (op.side == qse::Order::Side::BUY ? 10000 - offset : 10001 + offset) / 100.0;
+        const auto roll = rng() % 10;
+        const std::uint64_t recent = next_id - 1 - rng() % std::min<std::uint64_t>(next_id, 2000);
+        if (roll < 4) {
+            op.kind = QueueOp::Enqueue;
+            op.id = next_id++;
+            op.size = 1 + rng() % 200;
+        } else if (roll < 6) {
+            op.kind = QueueOp::Consume;
+            op.size = 1 + rng() % 300;
+        } else if (roll < 8) {
+            op.kind = QueueOp::Cancel;
+            op.id = recent;
+        } else {
+            op.kind = QueueOp::Position;
+            op.id = recent;
+        }
+        ops.push_back(op);
+    }
+    return ops;
+}
+
+void bench_queue_workload(std::size_t n_ops, std::size_t resting, int depth) {
+    // Seed both books with the same resting orders, then replay the stream
+    std::vector<QueueOp> seed;
+    {
+        std::mt19937_64 rng(11);
+        for (std::uint64_t id = 1; id <= resting; ++id) {
+            const auto side = (id % 2) ? qse::Order::Side::BUY : qse::Order::Side::SELL;
+            const int offset = static_cast<int>(rng() % static_cast<std::uint64_t>(depth));
+            const double price = (side == qse::Order::Side::BUY ? 10000 - offset : 10001 + offset) /
+                                 100.0;
+            seed.push_back({QueueOp::Enqueue, side, price, id, 100});
+        }
+    }
+    const std::vector<QueueOp> ops = make_queue_ops(n_ops, depth, resting + 1);
+    const std::uint64_t max_id = resting + n_ops + 1;
+
+    // OrderBookFullDepth cancels and locates orders by QueueId
+    std::vector<qse::QueueId> qids(max_id, 0);
+    std::vector<std::pair<qse::Order::Side, double>> where(max_id);
+    std::size_t checksum_depth = 0;
+    std::size_t checksum_ladder = 0;
+
+    qse::OrderBookFullDepth depth_book;
+    for (const QueueOp& op : seed) {
+        qids[op.id] = depth_book.enqueue_order(op.side, op.price, op.id, op.size);
+        where[op.id] = {op.side, op.price};
+    }
+    auto depth_start = Clock::now();
+    for (const QueueOp& op : ops) {
+        switch (op.kind) {
+        case QueueOp::Enqueue:
+            qids[op.id] = depth_book.enqueue_order(op.side, op.price, op.id, op.size);
+            where[op.id] = {op.side, op.price};
+            break;
+        case QueueOp::Consume:
+            checksum_depth += depth_book.consume_at_price(op.side, op.price, op.size).size();
+            break;
+        case QueueOp::Cancel:
+            if (depth_book.cancel_order(qids[op.id])) {
+                depth_book.remove_level_if_empty(where[op.id].first, where[op.id].second);
+            }
+            break;
+        case QueueOp::Position:
+            checksum_depth += depth_book.queue_position(qids[op.id]);
+            break;
+        }
+    }
+    double depth_ms = ms_since(depth_start);
+
+    qse::PriceLadderBook ladder(0.01, static_cast<std::size_t>(depth) * 2, resting * 2);
+    for (const QueueOp& op : seed) {
+        ladder.enqueue_order(op.side, op.price, op.id, op.size);
+    }
+    std::vector<std::pair<qse::LadderOrderId, qse::Volume>> consumed;
+    auto ladder_start = Clock::now();
+    for (const QueueOp& op : ops) {
+        switch (op.kind) {
+        case QueueOp::Enqueue:
+            ladder.enqueue_order(op.side, op.price, op.id, op.size);
+            break;
+        case QueueOp::Consume:
+            consumed.clear();
+            ladder.consume_at_price(op.side, op.price, op.size, consumed);
+            checksum_ladder += consumed.size();
+            break;
+        case QueueOp::Cancel:
+            ladder.cancel_order(op.id);
+            break;
+        case QueueOp::Position:
+            checksum_ladder += ladder.queue_position(op.id);
+            break;
+        }
+    }
+    double ladder_ms = ms_since(ladder_start);
+
+    g_sink += checksum_depth + checksum_ladder;
+    std::cout << "queue workload near the touch (" << n_ops << " ops, " << resting
+              << " resting orders over " << depth << " ticks/side):\n"
+              << "  OrderBookFullDepth: " << depth_ms << " ms  (" << depth_ms * 1e6 / n_ops
+              << " ns/op)\n"
+              << "  PriceLadderBook:    " << ladder_ms << " ms  (" << ladder_ms * 1e6 / n_ops
+              << " ns/op)\n"
+              << "  speedup:            " << depth_ms / ladder_ms << "x\n"
+              << "  results match:      " << (checksum_depth == checksum_ladder ? "yes" : "NO")
+              << "\n";
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
     std::size_t raw_n = 1'000'000;
     std::size_t iterations = 2000;
     std::size_t levels = 200;
+    std::size_t queue_ops = 200'000;
+    std::size_t resting = 2000;
+    int depth = 20;
     for (int i = 1; i + 1 < argc; i += 2) {
         std::string flag = argv[i];
         if (flag == "--raw-n")
@@ -117,6 +279,12 @@ int main(int argc, char** argv) {
             iterations = std::stoul(argv[i + 1]);
         else if (flag == "--levels")
             levels = std::stoul(argv[i + 1]);
+        else if (flag == "--queue-ops")
+            queue_ops = std::stoul(argv[i + 1]);
+        else if (flag == "--resting")
+            resting = std::stoul(argv[i + 1]);
+        else if (flag == "--depth")
+            depth = std::stoi(argv[i + 1]);
         else {
             std::cerr << "Unknown flag: " << flag << "\n";
             return 1;
@@ -126,5 +294,9 @@ int main(int argc, char** argv) {
     bench_raw_allocations(raw_n);
     std::cout << "\n";
     bench_book_workload(iterations, levels);
+    std::cout << "\n";
+    bench_ladder_workload(iterations, levels);
+    std::cout << "\n";
+    bench_queue_workload(queue_ops, resting, depth);
     return 0;
 }
@@ -0,0 +1,256 @@
+// BarBuilder throughput benchmark: ticks/sec through the in-place fast path
+// and the bounded reorder window, against the previous buffer-and-sort
+// builder (copied below as LegacyBarBuilder so the comparison survives the
+// rewrite). Two workloads:
+//
+//   1. data/raw_ticks_*.csv, one builder per symbol, 5-minute bars.
+//   2. A synthetic dense stream (2M ticks, ~37 ms apart, 1-second bars),
+//      in order and with arrival jitter: ticks shuffled within blocks of 8
+//      (up to ~260 ms late). The legacy builder and the fast path split a bar whenever a
+//      tick arrives behind its interval; the reorder window (500 ms) does not.
+//
+// Results are recorded in docs/benchmarks/11_bar_builder.md.
+
+#include "qse/data/BarBuilder.h"
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/SymbolTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Prevents the optimizer from deleting the measured loops
+volatile double g_sink = 0.0;
+
+const char* kSymbols[] = {"AAPL", "GOOG", "MSFT", "SPY"};
+
+// The builder as it was before the fast path: every tick is copied into a
+// buffer that is sorted and drained front-first (debug output removed)
+class LegacyBarBuilder {
+public:
+    explicit LegacyBarBuilder(std::chrono::seconds bar_interval) : bar_interval_(bar_interval) {}
+
+    std::optional<qse::Bar> add_tick(const qse::Tick& tick) {
+        tick_buffer_.push_back(tick);
+        std::sort(tick_buffer_.begin(), tick_buffer_.end(),
+                  [](auto& a, auto& b) { return a.timestamp < b.timestamp; });
+        process_buffered_ticks();
+        if (!ready_bars_.empty()) {
+            qse::Bar b = ready_bars_.front();
+            ready_bars_.pop_front();
+            return b;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<qse::Bar> flush() {
+        process_buffered_ticks();
+        if (!ready_bars_.empty()) {
+            qse::Bar b = ready_bars_.front();
+            ready_bars_.pop_front();
+            return b;
+        }
+        if (current_bar_) {
+            qse::Bar b = *current_bar_;
+            current_bar_.reset();
+            return b;
+        }
+        return std::nullopt;
+    }
+
+private:
+    void process_buffered_ticks() {
+        while (!tick_buffer_.empty()) {
+            const auto tick = tick_buffer_.front();
+            tick_buffer_.erase(tick_buffer_.begin());
+            if (!current_bar_) {
+                start_new_bar(tick);
+                continue;
+            }
+            auto bucket_end = current_bar_start_time_ + bar_interval_;
+            if (tick.timestamp >= bucket_end) {
+                ready_bars_.push_back(*current_bar_);
+                do {
+                    current_bar_start_time_ += bar_interval_;
+                } while (tick.timestamp >= current_bar_start_time_ + bar_interval_);
+                start_new_bar(tick);
+            } else if (tick.timestamp < current_bar_start_time_) {
+                ready_bars_.push_back(*current_bar_);
+                start_new_bar(tick);
+            } else {
+                current_bar_->high = std::max(current_bar_->high, tick.price);
+                current_bar_->low = std::min(current_bar_->low, tick.price);
+                current_bar_->close = tick.price;
+                current_bar_->volume += tick.volume;
+            }
+        }
+    }
+
+    void start_new_bar(const qse::Tick& tick) {
+        auto secs =
+            std::chrono::duration_cast<std::chrono::seconds>(tick.timestamp.time_since_epoch());
+        auto interval = bar_interval_.count();
+        current_bar_start_time_ = qse::Timestamp(std::chrono::seconds((secs.count() / interval) *
+                                                                      interval));
+        qse::Bar bar;
+        bar.symbol = tick.symbol;
+        bar.symbol_id = qse::resolve_symbol_id(tick);
+        bar.timestamp = current_bar_start_time_;
+        bar.open = bar.high = bar.low = bar.close = tick.price;
+        bar.volume = tick.volume;
+        current_bar_.emplace(std::move(bar));
+    }
+
+    std::chrono::seconds bar_interval_;
+    qse::Timestamp current_bar_start_time_;
+    std::optional<qse::Bar> current_bar_;
+    std::vector<qse::Tick> tick_buffer_;
+    std::deque<qse::Bar> ready_bars_;
+};
+
+struct RunResult {
+    double best_ms = 0.0;
+    std::size_t bars = 0;
+    std::size_t dropped = 0;
+};
+
+// One builder per stream; every completed bar is consumed (as the backtest
+// loop would) so returning it is part of the cost
+template <typename MakeBuilder>
+RunResult run(const std::vector<std::vector<qse::Tick>>& streams, MakeBuilder make,
+              std::size_t reps) {
+    RunResult result;
+    for (std::size_t r = 0; r < reps; ++r) {
+        std::size_t bars = 0;
+        std::size_t dropped = 0;
+        double sum = 0.0;
+        const auto start = Clock::now();
+        for (const auto& stream : streams) {
+            auto builder = make();
+            for (const qse::Tick& tick : stream) {
+                if (auto bar = builder.add_tick(tick)) {
+                    sum += bar->close;
+                    ++bars;
+                }
+            }
+            while (auto bar = builder.flush()) {
+                sum += bar->close;
+                ++bars;
+            }
+            if constexpr (std::is_same_v<decltype(builder), qse::BarBuilder>) {
+                dropped += builder.late_ticks_dropped();
+            }
+        }
+        const double ms = ms_since(start);
+        g_sink = g_sink + sum;
+        if (r == 0 || ms < result.best_ms) {
+            result.best_ms = ms;
+        }
+        result.bars = bars;
+        result.dropped = dropped;
+    }
+    return result;
+}
+
+void report(const char* label, std::size_t ticks, const RunResult& r, double baseline_ms) {
+    std::cout << "  " << label << (ticks / r.best_ms / 1e3) << " M ticks/s  (" << r.best_ms
+              << " ms, " << r.bars << " bars";
+    if (r.dropped > 0) {
+        std::cout << ", " << r.dropped << " dropped";
+    }
+    std::cout << ")";
+    if (baseline_ms > 0.0) {
+        std::cout << "  " << baseline_ms / r.best_ms << "x";
+    }
+    std::cout << "\n";
+}
+
+void bench(const char* title, const std::vector<std::vector<qse::Tick>>& streams,
+           std::chrono::seconds interval, std::chrono::milliseconds lateness, std::size_t reps) {
+    std::size_t ticks = 0;
+    for (const auto& s : streams) {
+        ticks += s.size();
+    }
+    std::cout << title << " (" << ticks << " ticks, " << interval.count() << " s bars):\n";
+    const auto legacy = run(streams, [&] { return LegacyBarBuilder(interval); }, reps);
+    report("legacy buffer+sort:   ", ticks, legacy, 0.0);
+    const auto fast = run(streams, [&] { return qse::BarBuilder(interval); }, reps);
+    report("fast path:            ", ticks, fast, legacy.best_ms);
+    const auto window = run(streams, [&] { return qse::BarBuilder(interval, lateness); }, reps);
+    report("reorder window:       ", ticks, window, legacy.best_ms);
+}
+
+// Dense single-symbol stream: ~27 ticks per 1-second bar
+std::vector<qse::Tick> synthetic_stream(std::size_t n) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 0.01);
+    std::vector<qse::Tick> ticks(n);
+    double price = 100.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        price += step(rng);
+        ticks[i].symbol = "SYN";
+        ticks[i].timestamp = qse::from_unix_ms(1700000000000LL + 37LL * static_cast<long long>(i));
+        ticks[i].price = price;
+        ticks[i].volume = 100;
+    }
+    return ticks;
+}
+
+// Arrival jitter: ticks shuffled within consecutive blocks of `block`, so
+// none arrives more than block - 1 places (here ~260 ms) out of order
+std::vector<qse::Tick> jittered(std::vector<qse::Tick> ticks, std::size_t block) {
+    std::mt19937_64 rng(7);
+    for (std::size_t i = 0; i + block <= ticks.size(); i += block) {
+        std::shuffle(ticks.begin() + static_cast<std::ptrdiff_t>(i),
+                     ticks.begin() + static_cast<std::ptrdiff_t>(i + block), rng);
+    }
+    return ticks;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string data_dir = "data";
+    std::size_t reps = 5;
+    std::size_t synthetic_ticks = 2'000'000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--data-dir") {
+            data_dir = argv[i + 1];
+        } else if (flag == "--reps") {
+            reps = std::stoul(argv[i + 1]);
+        } else if (flag == "--ticks") {
+            synthetic_ticks = std::stoul(argv[i + 1]);
+        }
+    }
+
+    std::vector<std::vector<qse::Tick>> files;
+    for (const char* symbol : kSymbols) {
+        qse::CSVDataReader reader(data_dir + "/raw_ticks_" + symbol + ".csv", symbol);
+        files.push_back(reader.read_all_ticks());
+    }
+    bench("raw_ticks_*.csv, per symbol", files, std::chrono::seconds(300),
+          std::chrono::milliseconds(60000), reps);
+
+    const auto dense = synthetic_stream(synthetic_ticks);
+    bench("synthetic, in order", {dense}, std::chrono::seconds(1),
+          std::chrono::milliseconds(500), reps);
+    bench("synthetic, shuffled in blocks of 8", {jittered(dense, 8)}, std::chrono::seconds(1),
+          std::chrono::milliseconds(500), reps);
+    return 0;
+}
@@ -3,21 +3,34 @@
 #include <string>
 
 int main(int argc, char* argv[]) {
-    if (argc != 4) {
+    const bool update = argc == 6 && std::string(argv[1]) == "--update";
+    if (argc != 4 && !update) {
         std::cout << "Usage: " << argv[0] << " <input_csv> <output_parquet> <weights_yaml>"
                   << std::endl;
+        std::cout << "       " << argv[0]
+                  << " --update <input_csv> <state_file> <output_dir> <weights_yaml>" << std::endl;
         std::cout << "Example: " << argv[0]
                   << " data/daily_prices_AAPL.csv factors_AAPL.parquet config/factor_weights.yaml"
                   << std::endl;
+        std::cout << "Example: " << argv[0]
+                  << " --update data/prices_today.csv factors.state factors/"
+                     " config/factor_weights.yaml"
+                  << std::endl;
         return 1;
     }
 
-    std::string input_csv = argv[1];
-    std::string output_parquet = argv[2];
-    std::string weights_yaml = argv[3];
-
     try {
         qse::MultiFactorCalculator calculator;
+        if (update) {
+            // Scores only the dates the state has not seen, one partition each
+            calculator.update_factors(argv[2], argv[3], argv[4], argv[5]);
+            std::cout << "Successfully updated factors under: " << argv[4] << std::endl;
+            return 0;
+        }
+
+        std::string input_csv = argv[1];
+        std::string output_parquet = argv[2];
+        std::string weights_yaml = argv[3];
         calculator.compute_factors(input_csv, output_parquet, weights_yaml);
         std::cout << "Successfully computed factors and saved to: " << output_parquet << std::endl;
     } catch (const std::exception& e) {
@@ -26,4 +39,4 @@ int main(int argc, char* argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,228 @@
+// Daily Fama-MacBeth pass benchmark on a synthetic panel (default 3,000
+// symbols x 252 dates x 5 factors, rows date-major): one no-intercept
+// cross-sectional regression per date.
+//
+//   row-of-columns   the previous CrossSectionalRegression core, reproduced
+//                    here: each date as std::vector columns, full-sort
+//                    winsorization, Gaussian elimination on X'X, and one
+//                    more solve per factor for its R²
+//   batched          run_cross_sections: contiguous Eigen matrices, one
+//                    Cholesky factorization per date, dates in parallel
+//
+// The factor returns of both paths are compared.
+//
+// Usage: cross_section_bench [--symbols N] [--dates N] [--factors N]
+//
+// Results are recorded in docs/benchmarks/19_cross_section_regression.md.
+
+#include "qse/factor/CrossSectionalRegression.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Columns = std::vector<std::vector<double>>;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void sort_winsorize(std::vector<double>& v, double q) {
+    std::vector<double> sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    const double lo = sorted[static_cast<std::size_t>(q * v.size())];
+    const double hi = sorted[static_cast<std::size_t>((1.0 - q) * v.size())];
+    for (double& x : v) {
+        x = std::clamp(x, lo, hi);
+    }
+}
+
+// Solves (X'X) b = X'y by Gaussian elimination with partial pivoting
+std::vector<double> solve_normal_equations(const Columns& X, const std::vector<double>& y) {
+    const std::size_t p = X.size();
+    const std::size_t n = y.size();
+    Columns A(p, std::vector<double>(p, 0.0));
+    std::vector<double> b(p, 0.0);
+    for (std::size_t i = 0; i < p; ++i) {
+        for (std::size_t j = 0; j < p; ++j) {
+            for (std::size_t r = 0; r < n; ++r) {
+                A[i][j] += X[i][r] * X[j][r];
+            }
+        }
+        for (std::size_t r = 0; r < n; ++r) {
+            b[i] += X[i][r] * y[r];
+        }
+    }
+    for (std::size_t i = 0; i < p; ++i) {
+        std::size_t pivot = i;
+        for (std::size_t r = i + 1; r < p; ++r) {
+            if (std::abs(A[r][i]) > std::abs(A[pivot][i])) {
+                pivot = r;
+            }
+        }
+        std::swap(A[i], A[pivot]);
+        std::swap(b[i], b[pivot]);
+        for (std::size_t r = i + 1; r < p; ++r) {
+            const double f = A[r][i] / A[i][i];
+            b[r] -= f * b[i];
+            for (std::size_t c = i; c < p; ++c) {
+                A[r][c] -= f * A[i][c];
+            }
+        }
+    }
+    for (std::size_t i = p; i-- > 0;) {
+        for (std::size_t j = i + 1; j < p; ++j) {
+            b[i] -= A[i][j] * b[j];
+        }
+        b[i] /= A[i][i];
+    }
+    return b;
+}
+
+double r_squared(const std::vector<double>& y, const std::vector<double>& fitted) {
+    double mean = 0.0;
+    for (double v : y) {
+        mean += v;
+    }
+    mean /= static_cast<double>(y.size());
+    double ss_res = 0.0, ss_tot = 0.0;
+    for (std::size_t r = 0; r < y.size(); ++r) {
+        ss_res += (y[r] - fitted[r]) * (y[r] - fitted[r]);
+        ss_tot += (y[r] - mean) * (y[r] - mean);
+    }
+    return ss_tot == 0.0 ? 0.0 : 1.0 - ss_res / ss_tot;
+}
+
+// One date the old way; returns the factor returns and fills the statistics
+// the old run_regression produced so none of the work is optimized away
+std::vector<double> row_of_columns_fit(Columns X, std::vector<double> y, double& checksum) {
+    const std::size_t p = X.size();
+    const std::size_t n = y.size();
+    sort_winsorize(y, 0.01);
+    for (auto& column : X) {
+        sort_winsorize(column, 0.01);
+    }
+    const std::vector<double> beta = solve_normal_equations(X, y);
+    std::vector<double> fitted(n, 0.0);
+    for (std::size_t j = 0; j < p; ++j) {
+        for (std::size_t r = 0; r < n; ++r) {
+            fitted[r] += X[j][r] * beta[j];
+        }
+    }
+    double ssr = 0.0;
+    for (std::size_t r = 0; r < n; ++r) {
+        ssr += (y[r] - fitted[r]) * (y[r] - fitted[r]);
+    }
+    checksum += r_squared(y, fitted) + ssr;
+    for (std::size_t j = 0; j < p; ++j) {
+        const std::vector<double> single = solve_normal_equations(Columns{X[j]}, y);
+        std::vector<double> single_fitted(n);
+        for (std::size_t r = 0; r < n; ++r) {
+            single_fitted[r] = X[j][r] * single[0];
+        }
+        checksum += r_squared(y, single_fitted);
+    }
+    return beta;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t symbols = 3000;
+    std::size_t dates = 252;
+    std::size_t factors = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (flag == "--symbols") {
+            symbols = std::stoul(argv[i + 1]);
+        } else if (flag == "--dates") {
+            dates = std::stoul(argv[i + 1]);
+        } else if (flag == "--factors") {
+            factors = std::stoul(argv[i + 1]);
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    if (symbols <= factors || dates == 0 || factors == 0) {
+        std::cerr << "need --symbols > --factors > 0 and --dates > 0\n";
+        return 1;
+    }
+
+    // Correlated exposures and fat-tailed returns, date-major
+    qse::CrossSectionInput input;
+    input.exposures.resize(factors);
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::student_t_distribution<double> noise(4.0);
+    for (std::size_t d = 0; d < dates; ++d) {
+        for (std::size_t s = 0; s < symbols; ++s) {
+            const double market = normal(rng);
+            double ret = 0.01 * noise(rng);
+            for (std::size_t j = 0; j < factors; ++j) {
+                const double x = 0.4 * market + normal(rng);
+                input.exposures[j].push_back(x);
+                ret += 0.001 * (static_cast<double>(j) - 2.0) * x;
+            }
+            input.dates.push_back(static_cast<qse::DateKey>(20000000 + d));
+            input.returns.push_back(ret);
+        }
+    }
+    std::cout << symbols << " symbols x " << dates << " dates x " << factors
+              << " factors = " << input.returns.size() << " rows\n";
+
+    auto start = Clock::now();
+    double checksum = 0.0;
+    Columns old_returns(dates);
+    for (std::size_t d = 0; d < dates; ++d) {
+        Columns X(factors);
+        for (std::size_t j = 0; j < factors; ++j) {
+            X[j].assign(input.exposures[j].begin() + d * symbols,
+                        input.exposures[j].begin() + (d + 1) * symbols);
+        }
+        std::vector<double> y(input.returns.begin() + d * symbols,
+                              input.returns.begin() + (d + 1) * symbols);
+        old_returns[d] = row_of_columns_fit(std::move(X), std::move(y), checksum);
+    }
+    const double old_ms = ms_since(start);
+    std::cout << "  row-of-columns, 1 thread:  " << old_ms << " ms  (checksum " << checksum
+              << ")\n";
+
+    qse::CrossSectionalRegression regression;
+    regression.set_num_threads(1);
+    start = Clock::now();
+    const auto serial = regression.run_cross_sections(input);
+    const double serial_ms = ms_since(start);
+    std::cout << "  batched, 1 thread:         " << serial_ms << " ms  (" << old_ms / serial_ms
+              << "x)\n";
+
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    regression.set_num_threads(0);
+    start = Clock::now();
+    const auto parallel = regression.run_cross_sections(input);
+    const double parallel_ms = ms_since(start);
+    std::cout << "  batched, " << hw << (hw == 1 ? " thread:  " : " threads: ") << "       "
+              << parallel_ms << " ms  (" << old_ms / parallel_ms << "x)\n";
+
+    double max_diff = 0.0;
+    bool same = serial.size() == dates && parallel.size() == dates;
+    for (std::size_t d = 0; same && d < dates; ++d) {
+        same = serial[d].factor_returns == parallel[d].factor_returns;
+        for (std::size_t j = 0; j < factors; ++j) {
+            max_diff =
+                std::max(max_diff, std::abs(serial[d].factor_returns[j] - old_returns[d][j]));
+        }
+    }
+    std::cout << "max |factor return difference| vs row-of-columns: " << max_diff << "\n";
+    std::cout << "parallel identical to serial: " << (same ? "yes" : "NO") << "\n";
+    return same && max_diff < 1e-9 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// CSV tick loading benchmark: the line reader (std::getline + stringstream
+// tokenizing + std::stod) vs the memory-mapped SIMD/from_chars parser
+// (CSVDataReader::LoadMode::Mapped), serial and split across threads, vs a
+// warm binary tick cache (LoadMode::Cached, which copies it into columns),
+// vs the same cache mapped as a zero-copy TickDataset.
+//
+//   1. The four data/raw_ticks_*.csv files (legacy timestamp,price,volume).
+//   2. A synthetic full-format file (timestamp,symbol,price,volume,bid,ask,
+//      bid_size,ask_size) large enough for the threaded path to engage.
+//
+// Timings include opening the file, parsing, sorting and the gap scan, i.e.
+// everything the constructor does. Results are recorded in
+// docs/benchmarks/07_mapped_csv_parser.md and 08_binary_tick_cache.md.
+// The dataset row also reports the heap bytes the series costs.
+
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/TickCache.h"
+#include "qse/data/TickDataset.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Mode = qse::CSVDataReader::LoadMode;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Best-of-`reps` load time; also returns the row count for the throughput line
+double best_load_ms(const std::string& path, Mode mode, unsigned threads, std::size_t reps,
+                    std::size_t& rows) {
+    double best = 0.0;
+    for (std::size_t r = 0; r < reps; ++r) {
+        auto start = Clock::now();
+        qse::CSVDataReader reader(path, "BENCH", mode, threads);
+        double ms = ms_since(start);
+        rows = reader.read_tick_columns().size();
+        if (r == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+volatile double g_sink = 0.0;
+
+// Best-of-`reps` TickDataset::load over a warm cache, plus one pass over
+// every column: the mapping faults pages in lazily, so load alone would
+// understate what a first replay pays
+double best_dataset_ms(const std::string& path, std::size_t reps, std::size_t& rows,
+                       std::size_t& heap_bytes) {
+    double best = 0.0;
+    for (std::size_t r = 0; r < reps; ++r) {
+        auto start = Clock::now();
+        const auto dataset = qse::TickDataset::load(path, "BENCH");
+        const qse::TickColumnsView& v = dataset->view();
+        double sum = 0.0;
+        for (std::size_t i = 0; i < v.size; ++i) {
+            sum += static_cast<double>(v.timestamps[i] + v.symbol_ids[i] + v.volumes[i] +
+                                       v.bid_sizes[i] + v.ask_sizes[i]) +
+                   v.prices[i] + v.bids[i] + v.asks[i];
+        }
+        g_sink = g_sink + sum;
+        double ms = ms_since(start);
+        rows = dataset->size();
+        heap_bytes = dataset->heap_bytes();
+        if (r == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+void report(const std::string& label, double ms, std::size_t rows, double baseline_ms) {
+    std::cout << "  " << label << ms << " ms  (" << rows / (ms / 1e3) / 1e6 << " M rows/s, "
+              << baseline_ms / ms << "x)\n";
+}
+
+void bench_file(const std::string& path, std::size_t reps, unsigned threads) {
+    std::size_t rows = 0;
+    const double line_ms = best_load_ms(path, Mode::Eager, 1, reps, rows);
+    const double mapped_ms = best_load_ms(path, Mode::Mapped, 1, reps, rows);
+    std::cout << path << " (" << rows << " rows, best of " << reps << "):\n";
+    report("line reader:       ", line_ms, rows, line_ms);
+    report("mapped, 1 thread:  ", mapped_ms, rows, line_ms);
+    if (threads > 1) {
+        const double par_ms = best_load_ms(path, Mode::Mapped, threads, reps, rows);
+        report("mapped, " + std::to_string(threads) + " threads: ", par_ms, rows, line_ms);
+    }
+
+    // First Cached load parses and writes the cache; the rest map it
+    const std::string cache = qse::tick_cache_path(path);
+    std::remove(cache.c_str());
+    const double build_ms = best_load_ms(path, Mode::Cached, 1, 1, rows);
+    const double cached_ms = best_load_ms(path, Mode::Cached, 1, reps, rows);
+    report("cache build:       ", build_ms, rows, line_ms);
+    report("cache hit:         ", cached_ms, rows, line_ms);
+    std::size_t heap_bytes = 0;
+    const double dataset_ms = best_dataset_ms(path, reps, rows, heap_bytes);
+    report("dataset + scan:    ", dataset_ms, rows, line_ms);
+    std::cout << "    heap: " << rows * 60 / 1024 << " KiB copied vs " << heap_bytes / 1024
+              << " KiB mapped\n";
+    std::remove(cache.c_str());
+}
+
+std::string write_synthetic(std::size_t rows) {
+    const std::string path = "csv_parse_bench_synthetic.csv";
+    std::ofstream out(path);
+    out << "timestamp,symbol,price,volume,bid,ask,bid_size,ask_size\n";
+    const char* symbols[] = {"AAPL", "GOOG", "MSFT", "SPY"};
+    for (std::size_t i = 0; i < rows; ++i) {
+        const double px = 100.0 + static_cast<double>(i % 1000) * 0.01;
+        out << (1700000000000LL + static_cast<long long>(i)) << "," << symbols[i % 4] << ","
+            << px << "," << 100 + i % 50 << "," << px - 0.01 << "," << px + 0.01 << ","
+            << 200 + i % 30 << "," << 300 + i % 20 << "\n";
+    }
+    return path;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string data_dir = "data";
+    std::size_t reps = 5;
+    std::size_t synthetic_rows = 2'000'000;
+    unsigned threads = std::thread::hardware_concurrency();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--data-dir")
+            data_dir = argv[i + 1];
+        else if (flag == "--reps")
+            reps = std::stoul(argv[i + 1]);
+        else if (flag == "--rows")
+            synthetic_rows = std::stoul(argv[i + 1]);
+        else if (flag == "--threads")
+            threads = static_cast<unsigned>(std::stoul(argv[i + 1]));
+        else {
+            std::cerr << "Unknown flag: " << flag << "\n";
+            return 1;
+        }
+    }
+
+    for (const char* symbol : {"AAPL", "GOOG", "MSFT", "SPY"}) {
+        bench_file(data_dir + "/raw_ticks_" + symbol + ".csv", reps, 1);
+    }
+    std::cout << "\n";
+
+    const std::string synthetic = write_synthetic(synthetic_rows);
+    bench_file(synthetic, reps, threads);
+    std::remove(synthetic.c_str());
+    return 0;
+}
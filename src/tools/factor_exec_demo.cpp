@@ -16,11 +16,11 @@ public:
                                 Volume quantity) override {
         std::cerr << "[ORDER] " << symbol << " " << (side == Order::Side::BUY ? "BUY" : "SELL")
                   << " " << quantity << " (MARKET)\n";
-        return symbol + "_order";
+        return ++last_id_;
     }
     OrderId submit_limit_order(const std::string&, Order::Side, Volume, Price,
                                Order::TimeInForce) override {
-        return "";
+        return kInvalidOrderId;
     }
     bool cancel_order(const OrderId&) override { return false; }
     void process_tick(const Tick&) override {}
@@ -34,6 +34,10 @@ public:
     std::vector<Position> get_positions() const override { return {}; }
     double get_cash() const override { return 1000000.0; }
     void record_equity(long long, const std::map<std::string, double>&) override {}
+    void record_equity(long long) override {}
+
+private:
+    OrderId last_id_ = kInvalidOrderId;
 };
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,231 @@
+// Factor computation benchmark on a synthetic daily panel (default 3,000
+// symbols x 10 years of 252 trading days), symbol-major like the rows the
+// factor pipeline reads.
+//
+// Compares the two ways MultiFactorCalculator::compute_factors has read and
+// computed its factors (12-1 momentum, 20-day volatility of daily returns,
+// 1 / P-B value, weighted composite):
+//
+//   per-row   every value fetched through a by-name column accessor (a hash
+//             lookup and a shared column handle per call, as
+//             arrow::Table::GetColumnByName does), volatility through the
+//             deque-based RollingStdDev
+//   kernels   the column kernels in qse/math/FactorKernels.h, run once per
+//             symbol over contiguous slices of each column
+//
+// Both produce the same values bit for bit; the tool checks it. Stages are
+// timed as the pipeline runs them: per-symbol time-series factors, then the
+// shared winsorize + z-score, then the composite over whole columns.
+//
+// Results are recorded in docs/benchmarks/16_factor_kernels.md.
+
+#include "qse/math/FactorKernels.h"
+#include "qse/math/StatsUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+constexpr std::size_t kLookback = 252;
+constexpr std::size_t kSkip = 21;
+constexpr std::size_t kVolWindow = 20;
+constexpr double kWeights[3] = {0.5, 0.3, 0.2}; // momentum, vol, value
+
+struct Panel {
+    std::size_t symbols = 0;
+    std::size_t days = 0;
+    std::vector<double> close; // symbol-major: symbol s owns [s * days, (s + 1) * days)
+    std::vector<double> pb;
+};
+
+Panel make_panel(std::size_t symbols, std::size_t days) {
+    Panel panel;
+    panel.symbols = symbols;
+    panel.days = days;
+    panel.close.resize(symbols * days);
+    panel.pb.resize(symbols * days);
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> ret(0.0003, 0.02);
+    std::uniform_real_distribution<double> start(10.0, 500.0);
+    std::uniform_real_distribution<double> book(0.5, 8.0);
+    for (std::size_t s = 0; s < symbols; ++s) {
+        double px = start(rng);
+        const double pb0 = book(rng);
+        const double price0 = px;
+        for (std::size_t d = 0; d < days; ++d) {
+            px *= 1.0 + ret(rng);
+            panel.close[s * days + d] = px;
+            panel.pb[s * days + d] = pb0 * px / price0;
+        }
+    }
+    return panel;
+}
+
+struct Factors {
+    std::vector<double> mom, vol, value, alpha;
+    explicit Factors(std::size_t n) : mom(n), vol(n), value(n), alpha(n) {}
+};
+
+// --- per-row: the accessor pattern the calculator was written against ---
+
+// Columns looked up by name on every access, handed out as shared handles
+class RowTable {
+public:
+    explicit RowTable(const Panel& panel) {
+        columns_["close"] = std::make_shared<std::vector<double>>(panel.close);
+        columns_["pb"] = std::make_shared<std::vector<double>>(panel.pb);
+    }
+    template <typename T> T col(const std::string& name, std::size_t row) const {
+        std::shared_ptr<std::vector<double>> column = columns_.at(name);
+        return static_cast<T>((*column)[row]);
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<std::vector<double>>> columns_;
+};
+
+void per_row(const RowTable& table, std::size_t symbols, std::size_t days, Factors& f) {
+    for (std::size_t s = 0; s < symbols; ++s) {
+        const std::size_t base = s * days;
+        for (std::size_t d = 0; d < days; ++d) {
+            const std::size_t i = base + d;
+            f.mom[i] = d < kLookback ? 0.0
+                                     : qse::math::pct_change(table.col<double>("close", i - kSkip),
+                                                             table.col<double>("close",
+                                                                               i - kLookback));
+        }
+        qse::math::RollingStdDev vol(kVolWindow);
+        for (std::size_t d = 0; d < days; ++d) {
+            const std::size_t i = base + d;
+            const double r = d == 0 ? 0.0
+                                    : qse::math::pct_change(table.col<double>("close", i),
+                                                            table.col<double>("close", i - 1));
+            f.vol[i] = vol(r);
+        }
+        for (std::size_t d = 0; d < days; ++d) {
+            const std::size_t i = base + d;
+            const double pb = table.col<double>("pb", i);
+            f.value[i] = pb == 0.0 ? 0.0 : 1.0 / pb;
+        }
+    }
+}
+
+void per_row_composite(Factors& f) {
+    for (std::size_t i = 0; i < f.alpha.size(); ++i)
+        f.alpha[i] = kWeights[0] * f.mom[i] + kWeights[1] * f.vol[i] + kWeights[2] * f.value[i];
+}
+
+// --- kernels: contiguous slices, one kernel call per column ---
+
+void kernels(const Panel& panel, Factors& f) {
+    const std::size_t days = panel.days;
+    std::vector<double> returns(days);
+    for (std::size_t s = 0; s < panel.symbols; ++s) {
+        const std::size_t base = s * days;
+        const double* close = panel.close.data() + base;
+        qse::math::momentum(close, days, kLookback, kSkip, f.mom.data() + base);
+        qse::math::simple_returns(close, days, returns.data());
+        qse::math::rolling_std(returns.data(), days, kVolWindow, f.vol.data() + base);
+        qse::math::reciprocal(panel.pb.data() + base, days, f.value.data() + base);
+    }
+}
+
+void kernel_composite(Factors& f) {
+    const double* columns[3] = {f.mom.data(), f.vol.data(), f.value.data()};
+    qse::math::weighted_sum(columns, kWeights, 3, f.alpha.size(), f.alpha.data());
+}
+
+void normalize(Factors& f) {
+    for (auto* column : {&f.mom, &f.vol, &f.value}) {
+        qse::math::winsorize(*column);
+        qse::math::zscore(*column);
+    }
+}
+
+bool identical(const Factors& a, const Factors& b) {
+    return a.mom == b.mom && a.vol == b.vol && a.value == b.value && a.alpha == b.alpha;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t symbols = 3000;
+    std::size_t years = 10;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::size_t value = std::stoul(argv[i + 1]);
+        if (flag == "--symbols") {
+            symbols = value;
+        } else if (flag == "--years") {
+            years = value;
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    if (symbols == 0 || years == 0) {
+        std::cerr << "--symbols and --years must be positive\n";
+        return 1;
+    }
+
+    const std::size_t days = years * 252;
+    const Panel panel = make_panel(symbols, days);
+    const std::size_t rows = symbols * days;
+    std::cout << symbols << " symbols x " << days << " days = " << rows << " rows\n";
+
+    auto report = [&](const char* label, double ms) {
+        std::cout << "  " << label << ms << " ms  (" << ms * 1e6 / static_cast<double>(rows)
+                  << " ns/row)\n";
+    };
+
+    Factors row_factors(rows);
+    const RowTable table(panel);
+    auto start = Clock::now();
+    per_row(table, symbols, days, row_factors);
+    const double row_factors_ms = ms_since(start);
+
+    Factors kernel_factors(rows);
+    start = Clock::now();
+    kernels(panel, kernel_factors);
+    const double kernel_factors_ms = ms_since(start);
+
+    // Shared by both paths; timed once
+    start = Clock::now();
+    normalize(row_factors);
+    const double normalize_ms = ms_since(start);
+    normalize(kernel_factors);
+
+    start = Clock::now();
+    per_row_composite(row_factors);
+    const double row_composite_ms = ms_since(start);
+    start = Clock::now();
+    kernel_composite(kernel_factors);
+    const double kernel_composite_ms = ms_since(start);
+
+    std::cout << "momentum, volatility, value:\n";
+    report("per-row accessor + RollingStdDev: ", row_factors_ms);
+    report("column kernels:                   ", kernel_factors_ms);
+    std::cout << "composite:\n";
+    report("scalar loop:                      ", row_composite_ms);
+    report("weighted_sum kernel:              ", kernel_composite_ms);
+    std::cout << "winsorize + z-score (3 columns, shared):\n";
+    report("", normalize_ms);
+    std::cout << "results identical: " << (identical(row_factors, kernel_factors) ? "yes" : "NO")
+              << "\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+// Panel factor benchmark on a synthetic daily panel (default 3,000 symbols
+// x 10 years of 252 trading days). Rows come date-major, as a file of daily
+// cross-sections lists them, or with --order symbol, symbol-major, as
+// per-symbol history files concatenate.
+//
+//   single series  what compute_factors did with a panel: the column kernels
+//                  over the whole table as one series, then winsorize and
+//                  z-score over the whole column. Look-backs run across
+//                  symbols, so most of its values are wrong; it is the cost
+//                  floor, not an alternative.
+//   FactorPanel    group by symbol, per-symbol kernels, per-date winsorize
+//                  and z-score; once on the calling thread and once on a
+//                  WorkStealingPool
+//
+// Usage: factor_panel_bench [--symbols N] [--years N] [--threads N]
+//                           [--order date|symbol]
+// (--threads 0, the default, means one per hardware thread)
+//
+// Results are recorded in docs/benchmarks/17_factor_panel.md.
+
+#include "qse/factor/FactorPanel.h"
+#include "qse/math/FactorKernels.h"
+#include "qse/math/StatsUtil.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+qse::FactorPanelInput make_panel(std::size_t symbols, std::size_t days, bool symbol_major) {
+    // Prices generated symbol by symbol, then listed in the requested order
+    std::vector<double> close(symbols * days), pb(symbols * days);
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> ret(0.0003, 0.02);
+    std::uniform_real_distribution<double> start(10.0, 500.0);
+    std::uniform_real_distribution<double> book(0.5, 8.0);
+    std::vector<std::string> names(symbols);
+    for (std::size_t s = 0; s < symbols; ++s) {
+        names[s] = "SYM" + std::to_string(s);
+        double px = start(rng);
+        const double pb_per_px = book(rng) / px;
+        for (std::size_t d = 0; d < days; ++d) {
+            px *= 1.0 + ret(rng);
+            close[s * days + d] = px;
+            pb[s * days + d] = pb_per_px * px;
+        }
+    }
+
+    qse::FactorPanelInput input;
+    const std::size_t rows = symbols * days;
+    input.symbols.reserve(rows);
+    input.dates.reserve(rows);
+    input.close.reserve(rows);
+    input.pb.reserve(rows);
+    auto add = [&](std::size_t s, std::size_t d) {
+        // Consecutive integers stand in for trading dates
+        input.symbols.push_back(names[s]);
+        input.dates.push_back(static_cast<qse::DateKey>(20000000 + d));
+        input.close.push_back(close[s * days + d]);
+        input.pb.push_back(pb[s * days + d]);
+    };
+    for (std::size_t outer = 0; outer < (symbol_major ? symbols : days); ++outer) {
+        for (std::size_t inner = 0; inner < (symbol_major ? days : symbols); ++inner) {
+            if (symbol_major) {
+                add(outer, inner);
+            } else {
+                add(inner, outer);
+            }
+        }
+    }
+    return input;
+}
+
+// The single-series pipeline over the whole table
+void single_series(const qse::FactorPanelInput& input) {
+    const std::size_t n = input.close.size();
+    std::vector<double> mom(n), returns(n), vol(n), value(n), alpha(n);
+    qse::math::momentum(input.close.data(), n, 252, 21, mom.data());
+    qse::math::simple_returns(input.close.data(), n, returns.data());
+    qse::math::rolling_std(returns.data(), n, 20, vol.data());
+    qse::math::reciprocal(input.pb.data(), n, value.data());
+    for (auto* column : {&mom, &vol, &value}) {
+        qse::math::winsorize(*column);
+        qse::math::zscore(*column);
+    }
+    const double* columns[3] = {mom.data(), vol.data(), value.data()};
+    const double weights[3] = {0.5, 0.3, 0.2};
+    qse::math::weighted_sum(columns, weights, 3, n, alpha.data());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t symbols = 3000;
+    std::size_t years = 10;
+    unsigned threads = 0;
+    bool symbol_major = false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (flag == "--order") {
+            symbol_major = std::string(argv[i + 1]) == "symbol";
+            continue;
+        }
+        const std::size_t value = std::stoul(argv[i + 1]);
+        if (flag == "--symbols") {
+            symbols = value;
+        } else if (flag == "--years") {
+            years = value;
+        } else if (flag == "--threads") {
+            threads = static_cast<unsigned>(value);
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    if (symbols == 0 || years == 0) {
+        std::cerr << "--symbols and --years must be positive\n";
+        return 1;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::size_t days = years * 252;
+    const qse::FactorPanelInput input = make_panel(symbols, days, symbol_major);
+    const std::size_t rows = input.close.size();
+    std::cout << symbols << " symbols x " << days << " days = " << rows << " rows, "
+              << (symbol_major ? "symbol" : "date") << "-major\n";
+
+    auto report = [&](const std::string& label, double ms) {
+        std::cout << "  " << label << ms << " ms  (" << ms * 1e6 / static_cast<double>(rows)
+                  << " ns/row)\n";
+    };
+
+    auto start = Clock::now();
+    single_series(input);
+    report("single series (look-backs cross symbols): ", ms_since(start));
+
+    qse::FactorPanelSettings settings;
+    settings.threads = 1;
+    start = Clock::now();
+    const qse::FactorPanelOutput serial = qse::FactorPanel(settings).compute(input);
+    report("FactorPanel, 1 thread:                    ", ms_since(start));
+
+    settings.threads = threads;
+    start = Clock::now();
+    const qse::FactorPanelOutput parallel = qse::FactorPanel(settings).compute(input);
+    const double parallel_ms = ms_since(start);
+    report("FactorPanel, " + std::to_string(threads) + " threads: ", parallel_ms);
+
+    const bool same = serial.mom_z == parallel.mom_z && serial.vol_z == parallel.vol_z &&
+                      serial.val_z == parallel.val_z && serial.alpha == parallel.alpha;
+    std::cout << serial.num_symbols << " symbols, " << serial.num_dates << " dates; "
+              << "1-thread and " << threads << "-thread results identical: "
+              << (same ? "yes" : "NO") << "\n";
+    return same ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+// Daily factor job benchmark on a synthetic panel (default 3,000 symbols x
+// 10 years of 252 trading days, rows date-major).
+//
+//   full recompute   FactorPanel over the whole history, which is what a
+//                    daily compute_factors run does to add one date
+//   daily update     FactorUpdater: load the saved state, score the newest
+//                    date only, save the state again
+//
+// The state is built once, untimed, from every date but the last. The last
+// date's scores from both paths are compared bit for bit.
+//
+// Usage: factor_update_bench [--symbols N] [--years N] [--state PATH]
+//
+// Results are recorded in docs/benchmarks/18_incremental_factors.md.
+
+#include "qse/factor/FactorPanel.h"
+#include "qse/factor/FactorUpdater.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Rows for dates [first, last) of the panel, date-major
+qse::FactorPanelInput make_rows(std::size_t symbols, std::size_t first, std::size_t last,
+                                const std::vector<std::vector<double>>& close) {
+    qse::FactorPanelInput input;
+    for (std::size_t d = first; d < last; ++d) {
+        for (std::size_t s = 0; s < symbols; ++s) {
+            // Consecutive integers stand in for trading dates
+            input.symbols.push_back("SYM" + std::to_string(s));
+            input.dates.push_back(static_cast<qse::DateKey>(20000000 + d));
+            input.close.push_back(close[s][d]);
+            input.pb.push_back(close[s][d] / (40.0 + static_cast<double>(s % 50)));
+        }
+    }
+    return input;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t symbols = 3000;
+    std::size_t years = 10;
+    std::string state_path = "factor_update_bench.state";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (flag == "--symbols") {
+            symbols = std::stoul(argv[i + 1]);
+        } else if (flag == "--years") {
+            years = std::stoul(argv[i + 1]);
+        } else if (flag == "--state") {
+            state_path = argv[i + 1];
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    if (symbols == 0 || years == 0) {
+        std::cerr << "--symbols and --years must be positive\n";
+        return 1;
+    }
+
+    const std::size_t days = years * 252;
+    std::vector<std::vector<double>> close(symbols, std::vector<double>(days));
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> ret(0.0003, 0.02);
+    for (auto& series : close) {
+        double px = 100.0;
+        for (double& c : series) {
+            px *= 1.0 + ret(rng);
+            c = px;
+        }
+    }
+    const qse::FactorPanelInput history = make_rows(symbols, 0, days, close);
+    const qse::FactorPanelInput today = make_rows(symbols, days - 1, days, close);
+    std::cout << symbols << " symbols x " << days << " days = " << history.close.size()
+              << " rows\n";
+
+    qse::FactorPanelSettings settings;
+    settings.threads = 1;
+    {
+        qse::FactorUpdater bootstrap(settings);
+        bootstrap.update(make_rows(symbols, 0, days - 1, close));
+        bootstrap.save(state_path);
+    }
+    std::cout << "  state file: " << std::filesystem::file_size(state_path) / 1024 << " KiB\n";
+
+    auto start = Clock::now();
+    const qse::FactorPanelOutput full = qse::FactorPanel(settings).compute(history);
+    const double full_ms = ms_since(start);
+    std::cout << "  full recompute, 1 thread:      " << full_ms << " ms\n";
+
+    start = Clock::now();
+    qse::FactorUpdater updater = qse::FactorUpdater::load(state_path, settings);
+    const double load_ms = ms_since(start);
+    start = Clock::now();
+    const qse::FactorPanelOutput day = updater.update(today);
+    const double update_ms = ms_since(start);
+    start = Clock::now();
+    updater.save(state_path);
+    const double save_ms = ms_since(start);
+    const double daily_ms = load_ms + update_ms + save_ms;
+    std::cout << "  daily update (load + score + save): " << daily_ms << " ms  (load "
+              << load_ms << ", score " << update_ms << ", save " << save_ms << ")\n";
+    std::cout << "  speed-up: " << full_ms / daily_ms << "x\n";
+
+    // The last date's rows are the final `symbols` rows of the history
+    bool same = true;
+    const std::size_t offset = history.close.size() - symbols;
+    for (std::size_t k = 0; k < symbols; ++k) {
+        same = same && day.alpha[k] == full.alpha[offset + k] &&
+               day.mom_z[k] == full.mom_z[offset + k] && day.vol_z[k] == full.vol_z[offset + k] &&
+               day.val_z[k] == full.val_z[offset + k];
+    }
+    std::cout << "last date identical to the full recompute: " << (same ? "yes" : "NO") << "\n";
+    std::remove(state_path.c_str());
+    return same ? 0 : 1;
+}
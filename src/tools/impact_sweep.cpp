@@ -126,8 +126,8 @@ int main(int argc, char** argv) {
                                            ? base_size * static_cast<qse::Volume>(lvl + 1)
                                            : base_size;
                     book.enqueue_order(qse::Order::Side::SELL,
-                                       best_ask + static_cast<double>(lvl) * tick_size,
-                                       "lvl_" + std::to_string(lvl), size);
+                                       best_ask + static_cast<double>(lvl) * tick_size, lvl + 1,
+                                       size);
                 }
 
                 auto result = book.fill_market(qse::Order::Side::BUY, static_cast<std::int64_t>(q));
@@ -0,0 +1,124 @@
+// OrderManager matching benchmark: a multi-asset tick loop with many resting
+// limit orders that never cross, plus a stream of small market orders.
+//
+// Every tick goes through process_tick + attempt_fills, the Backtester's
+// per-tick pair. The cost being measured is how much of the resting order
+// population each tick revisits: all symbols' orders on every call before
+// the per-symbol index, only the ticked symbol's marketable prefix after.
+// Runs the top-of-book model (shared OrderBook) and the full-depth model.
+//
+// Results are recorded in docs/benchmarks/12_order_matching.md.
+
+#include "qse/core/Config.h"
+#include "qse/data/OrderBook.h"
+#include "qse/order/OrderManager.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::size_t symbols = 50;
+    std::size_t resting = 100; // limit orders per symbol, half each side
+    std::size_t ticks = 20000;
+    std::size_t market_every = 50; // one market order per this many ticks
+};
+
+void run(const Options& opt, bool full_depth) {
+    qse::Config config;
+    qse::OrderBook book;
+    qse::OrderManager om(config, book, "", "");
+    om.set_use_full_depth(full_depth);
+
+    std::vector<std::string> symbols;
+    for (std::size_t s = 0; s < opt.symbols; ++s) {
+        symbols.push_back("SYM" + std::to_string(s));
+    }
+
+    // Resting orders well away from a touch that wanders around 100
+    for (const auto& symbol : symbols) {
+        for (std::size_t i = 0; i < opt.resting / 2; ++i) {
+            const double offset = 2.0 + 0.01 * static_cast<double>(i);
+            om.submit_limit_order(symbol, qse::Order::Side::BUY, 10, 100.0 - offset,
+                                  qse::Order::TimeInForce::GTC);
+            om.submit_limit_order(symbol, qse::Order::Side::SELL, 10, 100.0 + offset,
+                                  qse::Order::TimeInForce::GTC);
+        }
+    }
+
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    std::size_t market_orders = 0;
+
+    auto start = Clock::now();
+    for (std::size_t t = 0; t < opt.ticks; ++t) {
+        const std::string& symbol = symbols[t % symbols.size()];
+        const double mid = 100.0 + noise(rng);
+
+        qse::Tick tick{};
+        tick.symbol = symbol;
+        tick.timestamp = qse::from_unix_ms(1748318400000LL + static_cast<long long>(t));
+        tick.bid = mid - 0.01;
+        tick.ask = mid + 0.01;
+        tick.bid_size = 500;
+        tick.ask_size = 500;
+        tick.price = mid;
+
+        if (t % opt.market_every == 0) {
+            const auto side = (market_orders++ % 2 == 0) ? qse::Order::Side::BUY
+                                                         : qse::Order::Side::SELL;
+            om.submit_market_order(symbol, side, 10);
+        }
+        om.process_tick(tick);
+        om.attempt_fills();
+    }
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::size_t active = 0;
+    for (const auto& symbol : symbols) {
+        active += om.get_active_orders(symbol).size();
+    }
+    std::cout << (full_depth ? "full-depth model: " : "top-of-book model:") << " " << ms
+              << " ms  (" << ms * 1e6 / static_cast<double>(opt.ticks) << " ns/tick)\n"
+              << "  trades " << om.run_summary().trades << ", active orders " << active
+              << ", cash " << std::fixed << om.get_cash() << std::defaultfloat << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::size_t value = std::stoul(argv[i + 1]);
+        if (flag == "--symbols") {
+            opt.symbols = value;
+        } else if (flag == "--resting") {
+            opt.resting = value;
+        } else if (flag == "--ticks") {
+            opt.ticks = value;
+        } else if (flag == "--market-every") {
+            opt.market_every = value;
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    if (opt.symbols == 0 || opt.market_every == 0) {
+        std::cerr << "--symbols and --market-every must be positive\n";
+        return 1;
+    }
+
+    std::cout << opt.symbols << " symbols x " << opt.resting << " resting limit orders, "
+              << opt.ticks << " ticks, a market order every " << opt.market_every << "\n";
+    run(opt, /*full_depth=*/false);
+    run(opt, /*full_depth=*/true);
+    return 0;
+}
@@ -0,0 +1,222 @@
+// Parameter sweep over the sample tick data: an SMA-crossover window grid
+// on one symbol and a pairs-trading threshold grid on two, each evaluated
+// by ParameterSweep in a single pass over the ticks.
+//
+// For comparison the same grids are also run the way the older tools do
+// it, one full pipeline per point (fresh BacktestBatchRunner: load, merge,
+// replay), and as one BacktestBatchRunner batch (data loaded once, but
+// every job walks it separately). The final equity of every cell is checked
+// against the batch run. Results are recorded in
+// docs/benchmarks/10_parameter_sweep.md.
+//
+// Slippage comes from --config (default config.yaml) when it loads.
+//
+// Output CSVs: results/sweep_sma_<SYM>.csv, results/sweep_pairs_<A>_<B>.csv
+// (parameters, total_return, sharpe, max_drawdown, trades, turnover,
+// slippage_bps, ok)
+
+#include "qse/core/BacktestBatchRunner.h"
+#include "qse/core/ParameterSweep.h"
+#include "qse/strategy/PairsTradingStrategy.h"
+#include "qse/strategy/SMACrossoverStrategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Grid {
+    std::string name;
+    std::string symbol; // Backtester symbol
+    std::vector<qse::TickSource> sources;
+    std::shared_ptr<const qse::Config> config; // slippage; may be null
+    qse::ParameterGrid grid;
+    qse::ParameterSweep::StrategyFactory make_strategy;
+};
+
+qse::BacktestJob make_job(const Grid& g, const qse::ParameterPoint& point) {
+    qse::BacktestJob job;
+    job.name = g.name + " " + qse::format_parameters(point);
+    job.symbol = g.symbol;
+    job.sources = g.sources;
+    job.config = g.config;
+    job.make_strategy = [make = g.make_strategy,
+                         point](const std::shared_ptr<qse::OrderManager>& om) {
+        return make(point, om);
+    };
+    return job;
+}
+
+// Returns false if a sweep cell disagrees with the batch run of its point
+bool run_grid(const Grid& g, unsigned threads, const std::string& out_path) {
+    const auto points = g.grid.points();
+    std::cout << g.name << ": " << points.size() << " configurations\n";
+
+    // 1. One pipeline per point
+    auto start = Clock::now();
+    for (const auto& point : points) {
+        qse::BacktestBatchRunner runner(1);
+        runner.add_job(make_job(g, point));
+        runner.run();
+    }
+    const double rerun_s = seconds_since(start);
+
+    // 2. One batch: data loaded once, each job replays it
+    start = Clock::now();
+    qse::BacktestBatchRunner batch(threads);
+    for (const auto& point : points) {
+        batch.add_job(make_job(g, point));
+    }
+    const auto batch_results = batch.run();
+    const double batch_s = seconds_since(start);
+
+    // 3. One pass feeding every cell
+    start = Clock::now();
+    qse::SweepSettings settings;
+    settings.symbol = g.symbol;
+    settings.threads = threads;
+    settings.config = g.config;
+    qse::ParameterSweep sweep(settings, g.make_strategy);
+    for (const auto& source : g.sources) {
+        sweep.add_source(source.data_file, source.symbol);
+    }
+    const auto results = sweep.run(points);
+    const double sweep_s = seconds_since(start);
+
+    bool consistent = true;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const double expected = batch_results[i].summary.final_equity;
+        if (!results[i].ok || std::abs(results[i].summary.final_equity - expected) > 1e-6) {
+            std::cerr << "[param_sweep] Mismatch at " << qse::format_parameters(points[i]) << ": "
+                      << results[i].summary.final_equity << " vs " << expected << "\n";
+            consistent = false;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(1) << "  per-point reruns  " << std::setw(8)
+              << rerun_s * 1e3 << " ms\n"
+              << "  batch runner      " << std::setw(8) << batch_s * 1e3 << " ms ("
+              << rerun_s / batch_s << "x)\n"
+              << "  one-pass sweep    " << std::setw(8) << sweep_s * 1e3 << " ms ("
+              << rerun_s / sweep_s << "x), " << sweep.ticks_processed() << " ticks\n";
+
+    std::ofstream out(out_path);
+    if (!out.is_open()) {
+        std::cerr << "Could not open " << out_path << "\n";
+        return false;
+    }
+    qse::ParameterSweep::write_csv(results, out);
+
+    std::vector<const qse::SweepResult*> ranked;
+    for (const auto& r : results) {
+        ranked.push_back(&r);
+    }
+    std::sort(ranked.begin(), ranked.end(),
+              [](const auto* a, const auto* b) { return a->sharpe > b->sharpe; });
+    std::cout << "  best by Sharpe:\n" << std::setprecision(3);
+    for (std::size_t i = 0; i < std::min<std::size_t>(3, ranked.size()); ++i) {
+        const auto& r = *ranked[i];
+        std::cout << "    " << std::left << std::setw(36) << qse::format_parameters(r.params)
+                  << std::right << " sharpe " << std::setw(7) << r.sharpe << "  return "
+                  << std::setw(7) << r.summary.total_return() * 100.0 << "%  turnover "
+                  << std::setw(6) << r.turnover << "  slippage " << r.slippage_bps << " bp\n";
+    }
+    std::cout << "  -> " << out_path << "\n\n";
+    return consistent;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string symbol = "SPY";
+    std::string leg1 = "AAPL";
+    std::string leg2 = "GOOG";
+    std::string out_dir = "results";
+    std::string config_path = "config.yaml";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--threads")
+            threads = static_cast<unsigned>(std::stoul(argv[i + 1]));
+        else if (flag == "--symbol")
+            symbol = argv[i + 1];
+        else if (flag == "--pair") {
+            const std::string pair = argv[i + 1];
+            const auto comma = pair.find(',');
+            if (comma == std::string::npos) {
+                std::cerr << "--pair expects A,B\n";
+                return 1;
+            }
+            leg1 = pair.substr(0, comma);
+            leg2 = pair.substr(comma + 1);
+        } else if (flag == "--out-dir")
+            out_dir = argv[i + 1];
+        else if (flag == "--config")
+            config_path = argv[i + 1];
+        else {
+            std::cerr << "Unknown flag: " << flag << "\n";
+            return 1;
+        }
+    }
+
+    try {
+        std::cout << threads << " worker thread(s)\n\n";
+
+        auto config = std::make_shared<qse::Config>();
+        if (!config->load_config(config_path)) {
+            std::cerr << "[param_sweep] No config at " << config_path
+                      << "; running without slippage\n";
+            config.reset();
+        }
+
+        Grid sma;
+        sma.name = "SMA " + symbol;
+        sma.symbol = symbol;
+        sma.sources = {{"data/raw_ticks_" + symbol + ".csv", symbol}};
+        sma.config = config;
+        sma.grid.add_axis("short", {5, 10, 20, 30}).add_axis("long", {50, 100, 200, 400});
+        sma.make_strategy = [symbol](const qse::ParameterPoint& p,
+                                     const std::shared_ptr<qse::OrderManager>& om) {
+            return std::make_unique<qse::SMACrossoverStrategy>(
+                om.get(), static_cast<std::size_t>(p.at("short")),
+                static_cast<std::size_t>(p.at("long")), symbol);
+        };
+
+        Grid pairs;
+        pairs.name = "Pairs " + leg1 + "/" + leg2;
+        pairs.symbol = leg1 + "_" + leg2;
+        pairs.sources = {{"data/raw_ticks_" + leg1 + ".csv", leg1},
+                         {"data/raw_ticks_" + leg2 + ".csv", leg2}};
+        pairs.config = config;
+        pairs.grid.add_axis("window", {20, 60})
+            .add_axis("entry", {1.5, 2.0, 2.5, 3.0})
+            .add_axis("exit", {0.25, 0.5, 0.75});
+        pairs.make_strategy = [leg1, leg2](const qse::ParameterPoint& p,
+                                           const std::shared_ptr<qse::OrderManager>& om) {
+            return std::make_unique<qse::PairsTradingStrategy>(
+                leg1, leg2, 1.0, static_cast<int>(p.at("window")), p.at("entry"), p.at("exit"),
+                om);
+        };
+
+        const bool sma_ok = run_grid(sma, threads, out_dir + "/sweep_sma_" + symbol + ".csv");
+        const bool pairs_ok = run_grid(pairs, threads,
+                                       out_dir + "/sweep_pairs_" + leg1 + "_" + leg2 + ".csv");
+        return sma_ok && pairs_ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,84 @@
+// Mark-to-market benchmark: Backtester::step over a round-robin tick stream
+// while the account holds a position in every symbol.
+//
+// Each tick ends with the order manager recording an equity point. Before
+// the flat-array Portfolio that meant updating a name-keyed price map and
+// revaluing every position through it, O(symbols held) per tick; now it is
+// one position x price replacement. Sweeping --symbols shows the scaling.
+// Equity files are disabled, so only the valuation is measured.
+//
+// Results are recorded in docs/benchmarks/14_portfolio_valuation.md.
+
+#include "qse/core/Backtester.h"
+#include "qse/order/OrderManager.h"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+class NullStrategy : public qse::IStrategy {};
+
+void run(std::size_t symbols, std::size_t ticks) {
+    auto om = std::make_shared<qse::OrderManager>(1e9, "", "");
+    qse::Backtester backtester("PORTFOLIO", nullptr, std::make_unique<NullStrategy>(), om,
+                               std::chrono::seconds(60));
+
+    std::vector<std::string> names;
+    for (std::size_t s = 0; s < symbols; ++s) {
+        names.push_back("PB" + std::to_string(s));
+        om->execute_buy(names.back(), 100, 100.0);
+    }
+
+    std::vector<qse::Tick> stream(symbols);
+    for (std::size_t s = 0; s < symbols; ++s) {
+        stream[s].symbol = names[s];
+        stream[s].volume = 1;
+    }
+
+    auto start = Clock::now();
+    for (std::size_t t = 0; t < ticks; ++t) {
+        qse::Tick& tick = stream[t % symbols];
+        tick.timestamp = qse::from_unix_ms(1748318400000LL + static_cast<long long>(t));
+        tick.price = 100.0 + 0.01 * static_cast<double>(t % 97);
+        backtester.step(tick);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << symbols << " symbols held: " << ms * 1e6 / static_cast<double>(ticks)
+              << " ns/tick, final equity " << std::fixed << om->run_summary().final_equity
+              << std::defaultfloat << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t ticks = 200000;
+    std::vector<std::size_t> symbol_counts = {1, 10, 100, 1000};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::size_t value = std::stoul(argv[i + 1]);
+        if (flag == "--ticks") {
+            ticks = value;
+        } else if (flag == "--symbols") {
+            symbol_counts = {value};
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    for (std::size_t n : symbol_counts) {
+        if (n == 0) {
+            std::cerr << "--symbols must be positive\n";
+            return 1;
+        }
+        run(n, ticks);
+    }
+    return 0;
+}
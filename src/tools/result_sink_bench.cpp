@@ -0,0 +1,110 @@
+// Equity curve output benchmark: the cost a tick loop pays to record one
+// equity point per tick.
+//
+// "ofstream per tick" is what OrderManager did before ResultSink: format
+// the double through std::ostream on every call. The ResultSink runs
+// append a 16-byte record to the current block and leave formatting and
+// I/O to the writer thread (or, with --sync, to the caller once per block).
+// "loop" is the time spent inside the producer loop, "total" adds close(),
+// i.e. draining whatever the writer still has queued.
+//
+// Results are recorded in docs/benchmarks/13_result_sink.md.
+
+#include "qse/core/ResultSink.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// A plausible equity path: no two consecutive values format the same
+double equity_at(std::size_t i) {
+    return 1e6 + 0.37 * static_cast<double>(i % 100003) - 0.013 * static_cast<double>(i % 7919);
+}
+
+void report(const char* name, double loop_ms, double total_ms, std::size_t points,
+            const std::string& path) {
+    std::cout << name << " loop " << loop_ms << " ms (" << loop_ms * 1e6 / points
+              << " ns/point), total " << total_ms << " ms, "
+              << std::filesystem::file_size(path) / 1024 << " KiB\n";
+}
+
+void run_ofstream(std::size_t points, const std::string& path) {
+    auto start = Clock::now();
+    {
+        std::ofstream out(path);
+        out << "timestamp,equity\n";
+        for (std::size_t i = 0; i < points; ++i) {
+            out << static_cast<long long>(1748318400000LL + i) << "," << equity_at(i) << "\n";
+        }
+        const double loop_ms = ms_since(start);
+        out.close();
+        report("ofstream per tick:      ", loop_ms, ms_since(start), points, path);
+    }
+}
+
+void run_sink(const char* name, std::size_t points, const std::string& path,
+              const qse::ResultSink::Options& options) {
+    auto start = Clock::now();
+    qse::ResultSink sink(path, "", options);
+    for (std::size_t i = 0; i < points; ++i) {
+        sink.add_equity(1748318400000LL + static_cast<int64_t>(i), equity_at(i));
+    }
+    const double loop_ms = ms_since(start);
+    sink.close();
+    report(name, loop_ms, ms_since(start), points, path);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t points = 5000000;
+    std::size_t block = 8192;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::size_t value = std::stoul(argv[i + 1]);
+        if (flag == "--points") {
+            points = value;
+        } else if (flag == "--block") {
+            block = value;
+        } else {
+            std::cerr << "unknown flag " << flag << "\n";
+            return 1;
+        }
+    }
+    if (points == 0 || block == 0) {
+        std::cerr << "--points and --block must be positive\n";
+        return 1;
+    }
+
+    const std::string path = "result_sink_bench.out";
+    std::cout << points << " equity points, " << block << " records per block\n";
+    run_ofstream(points, path);
+
+    qse::ResultSink::Options options;
+    options.block_records = block;
+    options.async = false;
+    run_sink("ResultSink csv, sync:   ", points, path, options);
+    options.async = true;
+    run_sink("ResultSink csv, async:  ", points, path, options);
+    options.format = qse::ResultFormat::Binary;
+    options.async = false;
+    run_sink("ResultSink binary, sync:", points, path, options);
+    options.async = true;
+    run_sink("ResultSink binary,async:", points, path, options);
+
+    std::remove(path.c_str());
+    return 0;
+}
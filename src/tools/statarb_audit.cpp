@@ -181,10 +181,12 @@ void run_one(const std::string& name, bool depth_mode, double size_mult, const P
                 for (std::size_t lvl = 1; lvl <= p.levels; ++lvl) {
                     const qse::Price ask_px = tick.ask + static_cast<double>(lvl) * grid;
                     const qse::Price bid_px = tick.bid - static_cast<double>(lvl) * grid;
-                    const qse::QueueId aq = book.enqueue_order(
-                        qse::Order::Side::SELL, ask_px, "seed_a" + std::to_string(lvl), per_level);
-                    const qse::QueueId bq = book.enqueue_order(
-                        qse::Order::Side::BUY, bid_px, "seed_b" + std::to_string(lvl), per_level);
+                    const qse::QueueId aq =
+                        book.enqueue_order(qse::Order::Side::SELL, ask_px,
+                                           qse::kExternalOrderIdBase + 2 * lvl, per_level);
+                    const qse::QueueId bq =
+                        book.enqueue_order(qse::Order::Side::BUY, bid_px,
+                                           qse::kExternalOrderIdBase + 2 * lvl + 1, per_level);
                     seeds[sym].push_back({qse::Order::Side::SELL, ask_px, aq});
                     seeds[sym].push_back({qse::Order::Side::BUY, bid_px, bq});
                 }
@@ -0,0 +1,231 @@
+// Thread pool benchmark: the single-queue ThreadPool vs WorkStealingPool on
+// the workloads the research tools generate, i.e. many small tasks.
+//
+//   1. Flat batch: N tiny tasks submitted from the main thread, joined via
+//      futures (ThreadPool::enqueue, WorkStealingPool::enqueue) or a
+//      TaskGroup (no future).
+//   2. Nested fan-out: D "dates" x S "symbols". ThreadPool cannot block a
+//      worker on inner futures without risking deadlock, so it gets all
+//      D*S tasks flattened from the main thread; the work-stealing pool runs
+//      an outer parallel_for whose bodies fork the inner loop.
+//   3. parallel_for over a large index range vs the same range split into
+//      one ThreadPool task per chunk.
+//
+// Each row reports ns per task and heap allocations per task (global
+// operator new is counted). Results are recorded in
+// docs/benchmarks/09_work_stealing_pool.md.
+
+#include "qse/core/ThreadPool.h"
+#include "qse/core/WorkStealingPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> g_allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// ~20 ns of arithmetic standing in for a tiny factor or sweep cell
+inline double tiny_work(std::size_t i) {
+    double x = static_cast<double>(i) * 1e-6;
+    for (int k = 0; k < 8; ++k) {
+        x = x * 0.999 + std::sqrt(x + 1.0);
+    }
+    return x;
+}
+
+std::atomic<double> g_sink{0.0};
+
+void consume(double v) {
+    double cur = g_sink.load(std::memory_order_relaxed);
+    g_sink.store(cur + v, std::memory_order_relaxed);
+}
+
+struct Measurement {
+    double ns_per_task;
+    double allocs_per_task;
+};
+
+template <class Fn>
+Measurement measure(std::size_t tasks, std::size_t reps, Fn&& fn) {
+    Measurement best{0.0, 0.0};
+    for (std::size_t r = 0; r < reps; ++r) {
+        const std::size_t allocs_before = g_allocations.load();
+        const auto start = Clock::now();
+        fn();
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        const double allocs = static_cast<double>(g_allocations.load() - allocs_before);
+        if (r == 0 || ns / tasks < best.ns_per_task) {
+            best = {ns / tasks, allocs / tasks};
+        }
+    }
+    return best;
+}
+
+void report(const std::string& label, const Measurement& m, double baseline_ns) {
+    std::cout << "  " << std::left << std::setw(32) << label << std::right << std::setw(8)
+              << m.ns_per_task << " ns/task, " << m.allocs_per_task
+              << " allocs/task (" << baseline_ns / m.ns_per_task << "x)\n";
+}
+
+void bench_flat(std::size_t threads, std::size_t tasks, std::size_t reps) {
+    std::cout << "Flat batch: " << tasks << " tiny tasks from the main thread\n";
+    qse::ThreadPool classic(threads);
+    qse::WorkStealingPool stealing(threads);
+
+    const Measurement base = measure(tasks, reps, [&] {
+        std::vector<std::future<double>> futures;
+        futures.reserve(tasks);
+        for (std::size_t i = 0; i < tasks; ++i) {
+            futures.push_back(classic.enqueue([i] { return tiny_work(i); }));
+        }
+        for (auto& f : futures) {
+            consume(f.get());
+        }
+    });
+    const Measurement ws_future = measure(tasks, reps, [&] {
+        std::vector<std::future<double>> futures;
+        futures.reserve(tasks);
+        for (std::size_t i = 0; i < tasks; ++i) {
+            futures.push_back(stealing.enqueue([i] { return tiny_work(i); }));
+        }
+        for (auto& f : futures) {
+            consume(f.get());
+        }
+    });
+    std::vector<double> out(tasks);
+    const Measurement ws_group = measure(tasks, reps, [&] {
+        qse::TaskGroup group(stealing);
+        double* dst = out.data();
+        for (std::size_t i = 0; i < tasks; ++i) {
+            group.run([dst, i] { dst[i] = tiny_work(i); });
+        }
+        group.wait();
+    });
+    report("ThreadPool::enqueue", base, base.ns_per_task);
+    report("WorkStealingPool::enqueue", ws_future, base.ns_per_task);
+    report("WorkStealingPool TaskGroup", ws_group, base.ns_per_task);
+}
+
+void bench_nested(std::size_t threads, std::size_t dates, std::size_t symbols, std::size_t reps) {
+    const std::size_t tasks = dates * symbols;
+    std::cout << "Nested fan-out: " << dates << " dates x " << symbols << " symbols\n";
+    qse::ThreadPool classic(threads);
+    qse::WorkStealingPool stealing(threads);
+    std::vector<double> out(tasks);
+    double* dst = out.data();
+
+    const Measurement base = measure(tasks, reps, [&] {
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasks);
+        for (std::size_t d = 0; d < dates; ++d) {
+            for (std::size_t s = 0; s < symbols; ++s) {
+                futures.push_back(classic.enqueue(
+                    [dst, d, s, symbols] { dst[d * symbols + s] = tiny_work(d * symbols + s); }));
+            }
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+    });
+    const Measurement ws = measure(tasks, reps, [&] {
+        stealing.parallel_for(0, dates, [&](std::size_t d) {
+            stealing.parallel_for(0, symbols, [&](std::size_t s) {
+                dst[d * symbols + s] = tiny_work(d * symbols + s);
+            });
+        });
+    });
+    report("ThreadPool (flattened)", base, base.ns_per_task);
+    report("WorkStealingPool nested pfor", ws, base.ns_per_task);
+}
+
+void bench_parallel_for(std::size_t threads, std::size_t n, std::size_t grain, std::size_t reps) {
+    std::cout << "parallel_for: " << n << " indices, grain " << grain << "\n";
+    qse::ThreadPool classic(threads);
+    qse::WorkStealingPool stealing(threads);
+    std::vector<double> out(n);
+    double* dst = out.data();
+
+    const Measurement base = measure(n, reps, [&] {
+        std::vector<std::future<void>> futures;
+        for (std::size_t lo = 0; lo < n; lo += grain) {
+            const std::size_t hi = std::min(n, lo + grain);
+            futures.push_back(classic.enqueue([dst, lo, hi] {
+                for (std::size_t i = lo; i < hi; ++i) {
+                    dst[i] = tiny_work(i);
+                }
+            }));
+        }
+        for (auto& f : futures) {
+            f.get();
+        }
+    });
+    const Measurement ws = measure(n, reps, [&] {
+        stealing.parallel_for(0, n, [dst](std::size_t i) { dst[i] = tiny_work(i); }, grain);
+    });
+    report("ThreadPool, task per chunk", base, base.ns_per_task);
+    report("WorkStealingPool parallel_for", ws, base.ns_per_task);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t tasks = 200'000;
+    std::size_t reps = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--threads")
+            threads = std::stoul(argv[i + 1]);
+        else if (flag == "--tasks")
+            tasks = std::stoul(argv[i + 1]);
+        else if (flag == "--reps")
+            reps = std::stoul(argv[i + 1]);
+        else {
+            std::cerr << "Unknown flag: " << flag << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << threads << " worker thread(s), best of " << reps << "\n\n";
+    bench_flat(threads, tasks, reps);
+    std::cout << "\n";
+    bench_nested(threads, 2520, tasks / 2520, reps);
+    std::cout << "\n";
+    bench_parallel_for(threads, tasks * 10, 1024, reps);
+    std::cout << "\n(checksum " << g_sink.load() << ")\n";
+    return 0;
+}
@@ -0,0 +1,329 @@
+// Columnar tick store / symbol interning benchmark. Three experiments on the
+// data/raw_ticks_*.csv workloads:
+//
+//   1. Footprint: bytes per tick as an array of Tick structs vs TickColumns.
+//   2. Scan: a VWAP pass over the loaded series, Tick array vs price/volume
+//      columns (the access pattern of factor and bar passes).
+//   3. Per-symbol hot-path state: the string-keyed containers the backtest
+//      loop used to touch on every tick (unordered_set registration check,
+//      unordered_map<string> bar-builder lookup, map<string> last price) vs
+//      one vector indexed by SymbolId.
+//   4. Bar routing: the string-keyed BarRouter (copied below) vs the
+//      SymbolId-indexed one, plus its per-tick dispatch.
+//
+// Plus an end-to-end ticks/sec figure for Backtester::run over all four files
+// merged, with a top-of-book OrderManager attached (equity/trade logs go to
+// /dev/null so file I/O does not dominate).
+//
+// Results are recorded in docs/benchmarks/06_columnar_tick_store.md.
+
+#include "qse/core/Backtester.h"
+#include "qse/core/BarRouter.h"
+#include "qse/core/Config.h"
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/OrderBook.h"
+#include "qse/data/SymbolTable.h"
+#include "qse/data/TickColumns.h"
+#include "qse/order/OrderManager.h"
+#include "qse/strategy/IStrategy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Prevents the optimizer from deleting the measured loops
+volatile double g_sink = 0.0;
+
+const char* kSymbols[] = {"AAPL", "GOOG", "MSFT", "SPY"};
+
+std::string tick_file(const std::string& data_dir, const std::string& symbol) {
+    return data_dir + "/raw_ticks_" + symbol + ".csv";
+}
+
+// All four files interleaved in timestamp order, as the backtest loop sees them
+std::vector<qse::Tick> load_merged(const std::string& data_dir) {
+    std::vector<qse::Tick> merged;
+    for (const char* symbol : kSymbols) {
+        qse::CSVDataReader reader(tick_file(data_dir, symbol), symbol);
+        const auto& ticks = reader.read_all_ticks();
+        merged.insert(merged.end(), ticks.begin(), ticks.end());
+    }
+    std::stable_sort(merged.begin(), merged.end(), [](const qse::Tick& a, const qse::Tick& b) {
+        return a.timestamp < b.timestamp;
+    });
+    return merged;
+}
+
+void bench_footprint(const std::vector<qse::Tick>& ticks, const qse::TickColumns& columns) {
+    const double aos = static_cast<double>(sizeof(qse::Tick));
+    const double soa = static_cast<double>(sizeof(qse::Timestamp::rep) + sizeof(qse::SymbolId) +
+                                           3 * sizeof(qse::Price) + 3 * sizeof(qse::Volume));
+    std::cout << "footprint (" << ticks.size() << " ticks):\n"
+              << "  Tick array:  " << aos << " B/tick  (" << aos * ticks.size() / 1024 << " KiB)\n"
+              << "  TickColumns: " << soa << " B/tick  (" << soa * columns.size() / 1024
+              << " KiB)\n"
+              << "  price+volume scan touches " << sizeof(qse::Price) + sizeof(qse::Volume)
+              << " B/tick from columns vs " << aos << " B/tick from Tick\n";
+}
+
+void bench_scan(const std::vector<qse::Tick>& ticks, const qse::TickColumns& columns,
+                std::size_t reps) {
+    auto aos_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        double pv = 0.0;
+        double v = 0.0;
+        for (const qse::Tick& t : ticks) {
+            pv += t.price * static_cast<double>(t.volume);
+            v += static_cast<double>(t.volume);
+        }
+        g_sink = g_sink + pv / v;
+    }
+    double aos_ms = ms_since(aos_start);
+
+    const qse::TickColumnsView view = columns.view();
+    auto soa_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        double pv = 0.0;
+        double v = 0.0;
+        for (std::size_t i = 0; i < view.size; ++i) {
+            pv += view.prices[i] * static_cast<double>(view.volumes[i]);
+            v += static_cast<double>(view.volumes[i]);
+        }
+        g_sink = g_sink + pv / v;
+    }
+    double soa_ms = ms_since(soa_start);
+
+    const double n = static_cast<double>(ticks.size() * reps);
+    std::cout << "VWAP scan (" << reps << " passes):\n"
+              << "  Tick array:  " << aos_ms * 1e6 / n << " ns/tick\n"
+              << "  TickColumns: " << soa_ms * 1e6 / n << " ns/tick\n"
+              << "  speedup:     " << aos_ms / soa_ms << "x\n";
+}
+
+void bench_symbol_state(const std::vector<qse::Tick>& ticks, std::size_t reps) {
+    // String-keyed: the per-tick container work the loop used to do
+    struct Builder {
+        double close = 0.0;
+    };
+    auto str_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        std::unordered_set<std::string> registered;
+        std::unordered_map<std::string, Builder> builders;
+        std::map<std::string, double> last_prices;
+        for (const qse::Tick& t : ticks) {
+            registered.insert(t.symbol);
+            builders.try_emplace(t.symbol).first->second.close = t.price;
+            last_prices[t.symbol] = t.price;
+        }
+        g_sink = g_sink + last_prices.begin()->second + builders.size();
+    }
+    double str_ms = ms_since(str_start);
+
+    // ID-keyed: one flat vector of per-symbol state
+    struct State {
+        bool registered = false;
+        Builder builder;
+        double* last_price = nullptr;
+    };
+    auto id_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        std::vector<State> states;
+        std::map<std::string, double> last_prices;
+        for (const qse::Tick& t : ticks) {
+            const qse::SymbolId id = t.symbol_id;
+            if (id >= states.size()) {
+                states.resize(id + 1);
+            }
+            State& s = states[id];
+            if (!s.registered) {
+                s.registered = true;
+                s.last_price = &last_prices[t.symbol];
+            }
+            s.builder.close = t.price;
+            *s.last_price = t.price;
+        }
+        g_sink = g_sink + last_prices.begin()->second + states.size();
+    }
+    double id_ms = ms_since(id_start);
+
+    const double n = static_cast<double>(ticks.size() * reps);
+    std::cout << "per-symbol state lookups (" << reps << " passes, 4 symbols):\n"
+              << "  string-keyed: " << str_ms * 1e6 / n << " ns/tick\n"
+              << "  SymbolId:     " << id_ms * 1e6 / n << " ns/tick\n"
+              << "  speedup:      " << str_ms / id_ms << "x\n";
+}
+
+class CountingStrategy : public qse::IStrategy {
+public:
+    void on_tick(const qse::Tick& tick) override { sum_ += tick.price; }
+    void on_bar(const qse::Bar& bar) override { sum_ += bar.close; }
+    double sum_ = 0.0;
+};
+
+// The string-keyed BarRouter as it was: one unordered_map<string> lookup per bar
+class StringBarRouter {
+public:
+    void register_strategy(const std::string& symbol, qse::IStrategy* strategy) {
+        routes_[symbol].push_back(strategy);
+    }
+    void route_bar(const qse::Bar& bar) const {
+        auto it = routes_.find(bar.symbol);
+        if (it == routes_.end())
+            return;
+        for (auto* strat : it->second) {
+            strat->on_bar(bar);
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::vector<qse::IStrategy*>> routes_;
+};
+
+// One bar per tick routed to two strategies per symbol, plus (ID router
+// only) the per-tick dispatch the string router never offered
+void bench_routing(const std::vector<qse::Tick>& ticks, std::size_t reps) {
+    std::vector<qse::Bar> bars;
+    bars.reserve(ticks.size());
+    for (const qse::Tick& t : ticks) {
+        qse::Bar b{t.symbol, t.timestamp, t.price, t.price, t.price, t.price, t.volume};
+        b.symbol_id = t.symbol_id;
+        bars.push_back(std::move(b));
+    }
+    CountingStrategy a, b;
+
+    StringBarRouter by_name;
+    qse::BarRouter by_id;
+    for (const char* symbol : kSymbols) {
+        by_name.register_strategy(symbol, &a);
+        by_name.register_strategy(symbol, &b);
+        by_id.register_strategy(symbol, &a);
+        by_id.register_strategy(symbol, &b);
+        by_id.subscribe_ticks(symbol, &a);
+    }
+
+    auto str_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        for (const qse::Bar& bar : bars) {
+            by_name.route_bar(bar);
+        }
+    }
+    double str_ms = ms_since(str_start);
+
+    auto id_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        for (const qse::Bar& bar : bars) {
+            by_id.route_bar(bar);
+        }
+    }
+    double id_ms = ms_since(id_start);
+
+    auto tick_start = Clock::now();
+    for (std::size_t r = 0; r < reps; ++r) {
+        for (const qse::Tick& tick : ticks) {
+            by_id.route_tick(tick);
+        }
+    }
+    double tick_ms = ms_since(tick_start);
+    g_sink = g_sink + a.sum_ + b.sum_;
+
+    const double n = static_cast<double>(bars.size() * reps);
+    std::cout << "bar routing (" << reps << " passes, 2 strategies per symbol):\n"
+              << "  string-keyed: " << str_ms * 1e6 / n << " ns/bar\n"
+              << "  SymbolId:     " << id_ms * 1e6 / n << " ns/bar\n"
+              << "  speedup:      " << str_ms / id_ms << "x\n"
+              << "  tick routing (1 subscriber): " << tick_ms * 1e6 / n << " ns/tick\n";
+}
+
+// Trades a little so the order manager's fill path is exercised too
+class PulseStrategy : public qse::IStrategy {
+public:
+    explicit PulseStrategy(std::shared_ptr<qse::OrderManager> om) : om_(std::move(om)) {}
+    void on_tick(const qse::Tick& tick) override {
+        if (++ticks_ % 500 == 0) {
+            om_->submit_market_order(tick.symbol, (ticks_ / 500) % 2 ? qse::Order::Side::BUY
+                                                                     : qse::Order::Side::SELL,
+                                     10);
+        }
+    }
+
+private:
+    std::shared_ptr<qse::OrderManager> om_;
+    std::size_t ticks_ = 0;
+};
+
+void bench_backtest(const std::string& data_dir, std::size_t ticks, std::size_t reps) {
+    double best_ms = 0.0;
+    for (std::size_t r = 0; r < reps; ++r) {
+        qse::Config config;
+        qse::OrderBook book;
+        auto om = std::make_shared<qse::OrderManager>(config, book, "/dev/null", "/dev/null");
+        qse::Backtester backtester(
+            "PORTFOLIO", std::make_unique<qse::CSVDataReader>(tick_file(data_dir, kSymbols[0]),
+                                                              kSymbols[0]),
+            std::make_unique<PulseStrategy>(om), om, std::chrono::seconds(60));
+        for (std::size_t s = 1; s < 4; ++s) {
+            backtester.add_data_source(std::make_unique<qse::CSVDataReader>(
+                tick_file(data_dir, kSymbols[s]), kSymbols[s]));
+        }
+
+        // Files are loaded above; only the replay loop is timed
+        std::streambuf* saved = std::cout.rdbuf(nullptr);
+        auto start = Clock::now();
+        backtester.run();
+        double ms = ms_since(start);
+        std::cout.rdbuf(saved);
+        if (r == 0 || ms < best_ms) {
+            best_ms = ms;
+        }
+    }
+    std::cout << "Backtester::run, 4 symbols merged (" << ticks << " ticks, best of " << reps
+              << "):\n"
+              << "  " << best_ms << " ms  (" << ticks / (best_ms / 1e3) / 1e6 << " M ticks/s)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string data_dir = "data";
+    std::size_t reps = 50;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--data-dir")
+            data_dir = argv[i + 1];
+        else if (flag == "--reps")
+            reps = std::stoul(argv[i + 1]);
+        else {
+            std::cerr << "Unknown flag: " << flag << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<qse::Tick> ticks = load_merged(data_dir);
+    qse::TickColumns columns = qse::TickColumns::from_ticks(ticks);
+
+    bench_footprint(ticks, columns);
+    std::cout << "\n";
+    bench_scan(ticks, columns, reps);
+    std::cout << "\n";
+    bench_symbol_state(ticks, reps);
+    std::cout << "\n";
+    bench_routing(ticks, reps);
+    std::cout << "\n";
+    bench_backtest(data_dir, ticks.size(), 5);
+    return 0;
+}
@@ -66,7 +66,7 @@ TEST_F(AlpacaHandlerTest, MarketOrderPostsCorrectPayloadWithAuth) {
                                    HasSubstr("\"time_in_force\":\"day\""))))
         .WillOnce(Return(json_response(200, R"({"id":"alpaca-1","status":"accepted"})")));
 
-    qse::OrderId id = handler_->submit_market_order("AAPL", qse::Order::Side::BUY, 100);
+    qse::VenueOrderId id = handler_->submit_market_order("AAPL", qse::Order::Side::BUY, 100);
     EXPECT_EQ(id, "alpaca-1");
 }
 
@@ -77,8 +77,8 @@ TEST_F(AlpacaHandlerTest, LimitOrderCarriesPriceAndTimeInForce) {
                            HasSubstr("\"side\":\"sell\""), HasSubstr("\"time_in_force\":\"gtc\""))))
         .WillOnce(Return(json_response(200, R"({"id":"alpaca-2","status":"new"})")));
 
-    qse::OrderId id = handler_->submit_limit_order("AAPL", qse::Order::Side::SELL, 50, 150.0,
-                                                   qse::Order::TimeInForce::GTC);
+    qse::VenueOrderId id = handler_->submit_limit_order("AAPL", qse::Order::Side::SELL, 50, 150.0,
+                                                        qse::Order::TimeInForce::GTC);
     EXPECT_EQ(id, "alpaca-2");
 }
 
@@ -91,7 +91,7 @@ TEST(ArenaTest, OrderBookOnArenaMatchesDefaultBook) {
     auto run = [](qse::OrderBookFullDepth& book) {
         for (int lvl = 0; lvl < 10; ++lvl) {
             book.enqueue_order(qse::Order::Side::SELL, 100.0 + lvl * 0.01,
-                               "a" + std::to_string(lvl), 100);
+                               static_cast<qse::OrderId>(lvl) + 1, 100);
         }
         return book.fill_market(qse::Order::Side::BUY, 550);
     };
@@ -0,0 +1,175 @@
+// Batch runner: jobs run in parallel over shared per-source datasets, each
+// with its own OrderManager; results come back in job order and a failing
+// job is reported without taking the batch down.
+
+#include <gtest/gtest.h>
+#include "qse/core/BacktestBatchRunner.h"
+#include "qse/data/SharedTickDataReader.h"
+#include "qse/data/TickCache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Buys on the first tick and sells everything on the `exit_tick`-th
+class RoundTripStrategy : public qse::IStrategy {
+public:
+    RoundTripStrategy(std::shared_ptr<qse::OrderManager> om, int exit_tick)
+        : om_(std::move(om)), exit_tick_(exit_tick) {}
+
+    void on_tick(const qse::Tick& tick) override {
+        ++seen_;
+        if (seen_ == 1) {
+            om_->submit_market_order(tick.symbol, qse::Order::Side::BUY, 10);
+        } else if (seen_ == exit_tick_) {
+            om_->submit_market_order(tick.symbol, qse::Order::Side::SELL, 10);
+        }
+    }
+
+private:
+    std::shared_ptr<qse::OrderManager> om_;
+    int exit_tick_;
+    int seen_ = 0;
+};
+
+class BacktestBatchRunnerTest : public ::testing::Test {
+protected:
+    const std::string path_ = "batch_runner_test.csv";
+    static constexpr int kTicks = 50;
+
+    void SetUp() override {
+        std::ofstream file(path_);
+        file << "timestamp,symbol,price,volume,bid,ask,bid_size,ask_size\n";
+        for (int i = 0; i < kTicks; ++i) {
+            const double price = 100.0 + i * 0.1;
+            file << 1700000000 + i << ",BATCH," << price << ",10," << price - 0.01 << ","
+                 << price + 0.01 << ",500,500\n";
+        }
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+        std::remove(qse::tick_cache_path(path_).c_str());
+    }
+
+    qse::BacktestJob round_trip_job(const std::string& name, int exit_tick) const {
+        qse::BacktestJob job;
+        job.name = name;
+        job.symbol = "BATCH";
+        job.sources = {{path_, ""}};
+        job.make_strategy = [exit_tick](const std::shared_ptr<qse::OrderManager>& om) {
+            return std::make_unique<RoundTripStrategy>(om, exit_tick);
+        };
+        return job;
+    }
+};
+
+} // namespace
+
+TEST_F(BacktestBatchRunnerTest, ResultsComeBackInJobOrderWithSummaries) {
+    qse::BacktestBatchRunner runner(3);
+    for (int exit_tick : {10, 20, 30, 40}) {
+        runner.add_job(round_trip_job("exit_" + std::to_string(exit_tick), exit_tick));
+    }
+    const auto results = runner.run();
+    ASSERT_EQ(results.size(), 4u);
+
+    double previous_return = -1.0;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        ASSERT_TRUE(r.ok) << r.error;
+        EXPECT_EQ(r.name, "exit_" + std::to_string(10 * (i + 1)));
+        EXPECT_EQ(r.summary.trades, 2u);
+        EXPECT_EQ(r.summary.equity_points, static_cast<std::size_t>(kTicks));
+        EXPECT_DOUBLE_EQ(r.summary.initial_cash, 100000.0);
+        EXPECT_GT(r.summary.traded_notional, 2000.0);
+        // Rising prices: holding longer earns more
+        EXPECT_GT(r.summary.total_return(), previous_return);
+        previous_return = r.summary.total_return();
+    }
+}
+
+TEST_F(BacktestBatchRunnerTest, IdenticalJobsOnSharedDataAgree) {
+    qse::BacktestBatchRunner runner(4);
+    for (int i = 0; i < 8; ++i) {
+        runner.add_job(round_trip_job("copy_" + std::to_string(i), 25));
+    }
+    const auto results = runner.run();
+    ASSERT_EQ(results.size(), 8u);
+    for (const auto& r : results) {
+        ASSERT_TRUE(r.ok) << r.error;
+        EXPECT_DOUBLE_EQ(r.summary.final_equity, results.front().summary.final_equity);
+        EXPECT_DOUBLE_EQ(r.summary.max_drawdown, results.front().summary.max_drawdown);
+    }
+}
+
+TEST_F(BacktestBatchRunnerTest, FailingJobsAreReportedNotThrown) {
+    qse::BacktestBatchRunner runner(2);
+    runner.add_job(round_trip_job("good", 10));
+
+    auto missing = round_trip_job("missing_file", 10);
+    missing.sources = {{"batch_runner_no_such_file.csv", ""}};
+    runner.add_job(missing);
+
+    auto broken = round_trip_job("broken_strategy", 10);
+    broken.make_strategy =
+        [](const std::shared_ptr<qse::OrderManager>&) -> std::unique_ptr<qse::IStrategy> {
+        throw std::runtime_error("bad parameters");
+    };
+    runner.add_job(broken);
+
+    const auto results = runner.run();
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_FALSE(results[1].ok);
+    EXPECT_FALSE(results[1].error.empty());
+    EXPECT_FALSE(results[2].ok);
+    EXPECT_EQ(results[2].error, "bad parameters");
+
+    std::ostringstream table;
+    qse::BacktestBatchRunner::print_results(results, table);
+    EXPECT_NE(table.str().find("FAILED: bad parameters"), std::string::npos);
+}
+
+TEST_F(BacktestBatchRunnerTest, JobWithoutSourceIsRejected) {
+    qse::BacktestBatchRunner runner(1);
+    auto job = round_trip_job("no_source", 10);
+    job.sources.clear();
+    EXPECT_THROW(runner.add_job(job), std::invalid_argument);
+}
+
+TEST(SharedTickDataReaderTest, ReadersShareOneSeries) {
+    auto columns = std::make_shared<qse::TickColumns>();
+    for (int i = 0; i < 3; ++i) {
+        qse::Tick t{};
+        t.symbol = "SHARED";
+        t.timestamp = qse::from_unix_ms(1000 * (i + 1));
+        t.price = 10.0 + i;
+        columns->push_back(t);
+    }
+    std::shared_ptr<const qse::TickColumns> shared = columns;
+    qse::SharedTickDataReader a(shared);
+    qse::SharedTickDataReader b(shared);
+    EXPECT_EQ(a.dataset().view().prices, shared->prices().data()); // not copied
+    EXPECT_EQ(b.dataset().view().prices, shared->prices().data());
+
+    auto cursor = a.open_tick_cursor();
+    std::vector<qse::Tick> replayed;
+    for (auto batch = cursor->next_batch(); !batch.empty(); batch = cursor->next_batch()) {
+        replayed.insert(replayed.end(), batch.begin(), batch.end());
+    }
+    ASSERT_EQ(replayed.size(), 3u);
+    EXPECT_DOUBLE_EQ(replayed.back().price, 12.0);
+    EXPECT_EQ(b.read_all_ticks().size(), 3u);
+
+    EXPECT_THROW(qse::SharedTickDataReader(std::shared_ptr<const qse::TickColumns>()),
+                 std::invalid_argument);
+    EXPECT_THROW(qse::SharedTickDataReader(std::shared_ptr<const qse::TickDataset>()),
+                 std::invalid_argument);
+}
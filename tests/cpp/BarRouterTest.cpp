@@ -0,0 +1,71 @@
+// BarRouter: flat per-SymbolId dispatch of bars and ticks.
+
+#include <gtest/gtest.h>
+#include "qse/core/BarRouter.h"
+#include "qse/data/SymbolTable.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+class RecordingStrategy : public qse::IStrategy {
+public:
+    void on_tick(const qse::Tick& tick) override { ticks.push_back(tick.symbol); }
+    void on_bar(const qse::Bar& bar) override { bars.push_back(bar.symbol); }
+    std::vector<std::string> ticks;
+    std::vector<std::string> bars;
+};
+
+qse::Bar make_bar(const std::string& symbol, qse::SymbolId id) {
+    qse::Bar bar{symbol, qse::from_unix_ms(0), 1.0, 1.0, 1.0, 1.0, 1};
+    bar.symbol_id = id;
+    return bar;
+}
+
+} // namespace
+
+TEST(BarRouterTest, RoutesByIdAndByTickerAlike) {
+    const qse::SymbolId a = qse::intern_symbol("ROUTER_A");
+    const qse::SymbolId b = qse::intern_symbol("ROUTER_B");
+    RecordingStrategy first, second;
+    qse::BarRouter router;
+    router.register_strategy(a, &first);
+    router.register_strategy("ROUTER_A", &first); // same route, ignored
+    router.register_strategy("ROUTER_B", &second);
+
+    router.route_bar(make_bar("ROUTER_A", a));
+    router.route_bar(make_bar("ROUTER_B", b));
+    router.route_bar(make_bar("ROUTER_B", qse::kInvalidSymbolId)); // looked up by name
+    router.route_bar(make_bar("ROUTER_NEVER_SEEN", qse::kInvalidSymbolId));
+
+    EXPECT_EQ(first.bars, std::vector<std::string>{"ROUTER_A"});
+    EXPECT_EQ(second.bars, (std::vector<std::string>{"ROUTER_B", "ROUTER_B"}));
+    // Routing never interns
+    EXPECT_EQ(qse::SymbolTable::instance().find("ROUTER_NEVER_SEEN"), qse::kInvalidSymbolId);
+}
+
+TEST(BarRouterTest, SeveralStrategiesSubscribeToOneSymbolsTicks) {
+    const qse::SymbolId a = qse::intern_symbol("ROUTER_TICK_A");
+    RecordingStrategy first, second, bars_only;
+    qse::BarRouter router;
+    router.subscribe_ticks(a, &first);
+    router.subscribe_ticks("ROUTER_TICK_A", &second);
+    router.subscribe_ticks("ROUTER_TICK_A", &second); // ignored
+    router.register_strategy(a, &bars_only);
+
+    qse::Tick tick{};
+    tick.symbol = "ROUTER_TICK_A";
+    tick.symbol_id = a;
+    router.route_tick(tick);
+    tick.symbol_id = qse::kInvalidSymbolId;
+    router.route_tick(tick);
+    router.route_tick(a, tick);
+    tick.symbol = "ROUTER_TICK_OTHER";
+    router.route_tick(tick);
+
+    EXPECT_EQ(first.ticks.size(), 3u);
+    EXPECT_EQ(second.ticks.size(), 3u);
+    EXPECT_TRUE(bars_only.ticks.empty());
+    EXPECT_TRUE(first.bars.empty());
+}
@@ -0,0 +1,157 @@
+// Memory-mapped fast CSV path: LoadMode::Mapped must load exactly what the
+// line reader loads, with the same skipped-row and gap reporting, serially
+// or split across threads.
+
+#include <gtest/gtest.h>
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/CSVTickParser.h"
+#include "qse/data/SymbolTable.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+class CSVTickParserTest : public ::testing::Test {
+protected:
+    std::string path_;
+
+    void write_file(const std::string& name, const std::string& content) {
+        path_ = name;
+        std::ofstream file(path_, std::ios::binary);
+        file << content;
+    }
+
+    void TearDown() override {
+        if (!path_.empty()) {
+            std::remove(path_.c_str());
+        }
+    }
+};
+
+void expect_same_ticks(const qse::CSVDataReader& a, const qse::CSVDataReader& b) {
+    const auto& ta = a.read_all_ticks();
+    const auto& tb = b.read_all_ticks();
+    ASSERT_EQ(ta.size(), tb.size());
+    for (std::size_t i = 0; i < ta.size(); ++i) {
+        EXPECT_EQ(ta[i].symbol, tb[i].symbol) << "row " << i;
+        EXPECT_EQ(ta[i].symbol_id, tb[i].symbol_id) << "row " << i;
+        EXPECT_EQ(ta[i].timestamp, tb[i].timestamp) << "row " << i;
+        EXPECT_DOUBLE_EQ(ta[i].price, tb[i].price) << "row " << i;
+        EXPECT_DOUBLE_EQ(ta[i].bid, tb[i].bid) << "row " << i;
+        EXPECT_DOUBLE_EQ(ta[i].ask, tb[i].ask) << "row " << i;
+        EXPECT_EQ(ta[i].volume, tb[i].volume) << "row " << i;
+        EXPECT_EQ(ta[i].bid_size, tb[i].bid_size) << "row " << i;
+        EXPECT_EQ(ta[i].ask_size, tb[i].ask_size) << "row " << i;
+    }
+}
+
+std::string legacy_rows(std::size_t rows, std::size_t skip_every = 0) {
+    std::string text;
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (skip_every != 0 && i % skip_every == 0) {
+            continue; // leave a hole in the 1s grid
+        }
+        text += std::to_string(1700000000 + i) + "," + std::to_string(100 + i % 7) + ".25," +
+                std::to_string(10 + i % 3) + "\n";
+    }
+    return text;
+}
+
+} // namespace
+
+TEST_F(CSVTickParserTest, MappedMatchesLineReaderOnFullFormat) {
+    // Rows longer than one 16-byte SIMD block, two symbols, out of order
+    write_file("fast_full.csv", "timestamp,symbol,price,volume,bid,ask,bid_size,ask_size\n"
+                                "1700000002,FAST_B,20.5,7,20.4,20.6,100,110\n"
+                                "1700000001,FAST_A,10.25,5,10.2,10.3,50,60\n"
+                                "1700000003,FAST_A,10.5,9,10.4,10.6,70,80\n");
+    qse::CSVDataReader line(path_, "", qse::CSVDataReader::LoadMode::Eager);
+    qse::CSVDataReader mapped(path_, "", qse::CSVDataReader::LoadMode::Mapped);
+
+    expect_same_ticks(line, mapped);
+    EXPECT_EQ(mapped.read_all_ticks().front().symbol, "FAST_A");
+    EXPECT_EQ(mapped.read_all_ticks().front().bid_size, 50u);
+}
+
+TEST_F(CSVTickParserTest, MalformedRowsAreSkippedLikeTheLineReader) {
+    write_file("fast_malformed.csv", "timestamp,price,volume\n"
+                                     "1700000000,100.5,10\n"
+                                     "1700000001,not_a_price,10\n" // non-numeric
+                                     "1700000002,100.7\n"          // too few columns
+                                     "1700000003,,10\n"            // empty field
+                                     "\n"                          // blank: not counted
+                                     "1700000004, +100.9,12\r\n"   // whitespace, sign, CRLF
+                                     "1700000005,101.0,13,\n"      // trailing comma
+                                     "1700000006,101.1,14");       // no final newline
+    qse::CSVDataReader line(path_, "TEST", qse::CSVDataReader::LoadMode::Eager);
+    qse::CSVDataReader mapped(path_, "TEST", qse::CSVDataReader::LoadMode::Mapped);
+
+    expect_same_ticks(line, mapped);
+    EXPECT_EQ(mapped.read_all_ticks().size(), 4u);
+    EXPECT_EQ(mapped.skipped_row_count(), 3u);
+    EXPECT_EQ(mapped.skipped_row_count(), line.skipped_row_count());
+}
+
+TEST_F(CSVTickParserTest, GapCountMatchesLineReader) {
+    write_file("fast_gaps.csv", "timestamp,price,volume\n" + legacy_rows(200, 50));
+    qse::CSVDataReader line(path_, "TEST", qse::CSVDataReader::LoadMode::Eager);
+    qse::CSVDataReader mapped(path_, "TEST", qse::CSVDataReader::LoadMode::Mapped);
+
+    // Rows 50, 100 and 150 are missing (row 0 is too, but that is not a gap)
+    EXPECT_EQ(mapped.gap_count(), 3u);
+    EXPECT_EQ(mapped.gap_count(), line.gap_count());
+    expect_same_ticks(line, mapped);
+}
+
+TEST_F(CSVTickParserTest, ParallelRangesMatchSerialParse) {
+    // Large enough for several newline-aligned ranges
+    const std::string text = legacy_rows(120000);
+    ASSERT_GT(text.size(), 1024u * 1024u);
+
+    qse::TickColumns serial;
+    qse::TickColumns parallel;
+    EXPECT_EQ(qse::parse_csv_ticks(text, "PAR", serial), 0u);
+    EXPECT_EQ(qse::parse_csv_ticks_parallel(text, "PAR", 4, parallel), 0u);
+
+    ASSERT_EQ(parallel.size(), serial.size());
+    EXPECT_EQ(serial.size(), 120000u);
+    EXPECT_EQ(parallel.timestamps(), serial.timestamps());
+    EXPECT_EQ(parallel.prices(), serial.prices());
+    EXPECT_EQ(parallel.symbol_ids(), serial.symbol_ids());
+}
+
+TEST_F(CSVTickParserTest, ParallelMappedReaderCountsSkippedRowsAcrossRanges) {
+    std::string text = "timestamp,price,volume\n";
+    for (int block = 0; block < 4; ++block) {
+        text += legacy_rows(30000);
+        text += "1700000000,bad,1\n";
+    }
+    write_file("fast_parallel.csv", text);
+
+    qse::CSVDataReader line(path_, "TEST", qse::CSVDataReader::LoadMode::Eager);
+    qse::CSVDataReader mapped(path_, "TEST", qse::CSVDataReader::LoadMode::Mapped, 4);
+
+    EXPECT_EQ(mapped.skipped_row_count(), 4u);
+    EXPECT_EQ(mapped.read_tick_columns().size(), 120000u);
+    EXPECT_EQ(mapped.read_tick_columns().timestamps(), line.read_tick_columns().timestamps());
+}
+
+TEST_F(CSVTickParserTest, MappedModeStillReadsBarFiles) {
+    write_file("fast_bars.csv", "timestamp,open,high,low,close,volume\n"
+                                "1000,10,11,9,10.5,100\n"
+                                "1060,10.5,11,10,10.8,120\n");
+    qse::CSVDataReader mapped(path_, "TEST", qse::CSVDataReader::LoadMode::Mapped);
+    EXPECT_EQ(mapped.read_all_bars().size(), 2u);
+    EXPECT_TRUE(mapped.read_all_ticks().empty());
+}
+
+TEST_F(CSVTickParserTest, MappedModeRejectsMissingAndEmptyFiles) {
+    EXPECT_THROW(qse::CSVDataReader("no/such/fast.csv", "TEST",
+                                    qse::CSVDataReader::LoadMode::Mapped),
+                 std::runtime_error);
+    write_file("fast_empty.csv", "");
+    EXPECT_THROW(qse::CSVDataReader(path_, "TEST", qse::CSVDataReader::LoadMode::Mapped),
+                 std::runtime_error);
+}
@@ -0,0 +1,218 @@
+// The per-date regression pass: coefficients, standard errors and per-factor
+// R² against direct formulas, one result per usable date, and the same
+// results on any number of threads.
+
+#include <gtest/gtest.h>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "qse/factor/CrossSectionalRegression.h"
+
+using namespace qse;
+
+namespace {
+
+// `symbols` rows on each of `dates` dates, date-major, with three correlated
+// exposures and returns = exposures * (0.01 * (d + 1), -0.02, 0.005) plus
+// noise of scale `noise`
+CrossSectionInput make_panel(int dates, int symbols, double noise, unsigned seed = 7) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    CrossSectionInput input;
+    input.exposures.resize(3);
+    for (int d = 0; d < dates; ++d) {
+        for (int s = 0; s < symbols; ++s) {
+            const double a = normal(gen);
+            const double b = 0.6 * a + normal(gen);
+            const double c = 1.0 + 0.3 * normal(gen);
+            input.dates.push_back(20230102 + d);
+            input.exposures[0].push_back(a);
+            input.exposures[1].push_back(b);
+            input.exposures[2].push_back(c);
+            input.returns.push_back(0.01 * (d + 1) * a - 0.02 * b + 0.005 * c +
+                                    noise * normal(gen));
+        }
+    }
+    return input;
+}
+
+// One date's rows as X and y
+void date_rows(const CrossSectionInput& input, DateKey date, Eigen::MatrixXd& X,
+               Eigen::VectorXd& y) {
+    std::vector<std::size_t> rows;
+    for (std::size_t i = 0; i < input.dates.size(); ++i) {
+        if (input.dates[i] == date) {
+            rows.push_back(i);
+        }
+    }
+    const auto n = static_cast<Eigen::Index>(rows.size());
+    const auto k = static_cast<Eigen::Index>(input.exposures.size());
+    X.resize(n, k);
+    y.resize(n);
+    for (Eigen::Index i = 0; i < n; ++i) {
+        y(i) = input.returns[rows[i]];
+        for (Eigen::Index j = 0; j < k; ++j) {
+            X(i, j) = input.exposures[j][rows[i]];
+        }
+    }
+}
+
+} // namespace
+
+TEST(CrossSectionFitTest, RecoversExactFactorReturnsPerDate) {
+    const CrossSectionInput input = make_panel(5, 40, 0.0);
+    CrossSectionalRegression regression;
+    regression.set_num_threads(1);
+    regression.set_winsor_quantile(0.0);
+    const auto results = regression.run_cross_sections(input);
+
+    ASSERT_EQ(results.size(), 5u);
+    for (int d = 0; d < 5; ++d) {
+        const auto& r = results[d];
+        EXPECT_EQ(r.date, 20230102 + d);
+        EXPECT_EQ(r.num_observations, 40);
+        EXPECT_EQ(r.num_factors, 3);
+        ASSERT_EQ(r.factor_returns.size(), 3u);
+        EXPECT_NEAR(r.factor_returns[0], 0.01 * (d + 1), 1e-12);
+        EXPECT_NEAR(r.factor_returns[1], -0.02, 1e-12);
+        EXPECT_NEAR(r.factor_returns[2], 0.005, 1e-12);
+        EXPECT_NEAR(r.total_r_squared, 1.0, 1e-12);
+        ASSERT_EQ(r.residuals.size(), 40u);
+    }
+}
+
+TEST(CrossSectionFitTest, StatisticsMatchTheTextbookFormulas) {
+    const CrossSectionInput input = make_panel(3, 60, 0.01);
+    CrossSectionalRegression regression;
+    regression.set_num_threads(1);
+    regression.set_winsor_quantile(0.0);
+    const auto results = regression.run_cross_sections(input);
+    ASSERT_EQ(results.size(), 3u);
+
+    for (const auto& r : results) {
+        Eigen::MatrixXd X;
+        Eigen::VectorXd y;
+        date_rows(input, r.date, X, y);
+        const Eigen::Index n = X.rows();
+        const Eigen::Index k = X.cols();
+
+        const Eigen::VectorXd beta = X.colPivHouseholderQr().solve(y);
+        const Eigen::VectorXd residuals = y - X * beta;
+        const double s2 = residuals.squaredNorm() / static_cast<double>(n - k);
+        const Eigen::MatrixXd inverse = (X.transpose() * X).inverse();
+        const double sst = (y.array() - y.mean()).square().sum();
+
+        EXPECT_NEAR(r.total_r_squared, 1.0 - residuals.squaredNorm() / sst, 1e-10);
+        for (Eigen::Index j = 0; j < k; ++j) {
+            EXPECT_NEAR(r.factor_returns[j], beta(j), 1e-10);
+            // Standard errors use the full (X'X)^-1, not just its diagonal
+            const double se = std::sqrt(s2 * inverse(j, j));
+            EXPECT_NEAR(r.factor_std_errors[j], se, 1e-10);
+            EXPECT_NEAR(r.factor_t_stats[j], beta(j) / se, 1e-6 * std::abs(beta(j) / se));
+
+            // Per-factor R² is the factor's own no-intercept regression
+            const Eigen::VectorXd x = X.col(j);
+            const double single = x.dot(y) / x.dot(x);
+            const double single_ssr = (y - single * x).squaredNorm();
+            EXPECT_NEAR(r.factor_r_squared[j], 1.0 - single_ssr / sst, 1e-10);
+        }
+    }
+}
+
+TEST(CrossSectionFitTest, ResultsDoNotDependOnThreadsOrDateOrder) {
+    const CrossSectionInput input = make_panel(24, 50, 0.02);
+    CrossSectionalRegression serial;
+    serial.set_num_threads(1);
+    const auto expected = serial.run_cross_sections(input);
+    ASSERT_EQ(expected.size(), 24u);
+
+    CrossSectionalRegression parallel;
+    parallel.set_num_threads(4);
+    const auto actual = parallel.run_cross_sections(input);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t d = 0; d < expected.size(); ++d) {
+        EXPECT_EQ(actual[d].date, expected[d].date);
+        EXPECT_EQ(actual[d].factor_returns, expected[d].factor_returns);
+        EXPECT_EQ(actual[d].factor_std_errors, expected[d].factor_std_errors);
+        EXPECT_EQ(actual[d].factor_r_squared, expected[d].factor_r_squared);
+        EXPECT_EQ(actual[d].residuals, expected[d].residuals);
+    }
+
+    // Dates listed newest first: each date's rows keep their order, so the
+    // fits are identical and come back oldest first
+    CrossSectionInput reversed;
+    reversed.exposures.resize(3);
+    for (int d = 23; d >= 0; --d) {
+        for (std::size_t i = d * 50; i < (d + 1) * 50u; ++i) {
+            reversed.dates.push_back(input.dates[i]);
+            reversed.returns.push_back(input.returns[i]);
+            for (int j = 0; j < 3; ++j) {
+                reversed.exposures[j].push_back(input.exposures[j][i]);
+            }
+        }
+    }
+    const auto sorted = parallel.run_cross_sections(reversed);
+    ASSERT_EQ(sorted.size(), expected.size());
+    for (std::size_t d = 0; d < expected.size(); ++d) {
+        EXPECT_EQ(sorted[d].date, expected[d].date);
+        EXPECT_EQ(sorted[d].factor_returns, expected[d].factor_returns);
+    }
+}
+
+TEST(CrossSectionFitTest, DropsMissingRowsAndThinDates) {
+    CrossSectionInput input = make_panel(3, 20, 0.01);
+    const double nan = std::nan("");
+    // Date 0: two rows lose a value. Date 1: all but three rows do, which
+    // leaves no more rows than factors.
+    input.returns[0] = nan;
+    input.exposures[1][5] = nan;
+    for (std::size_t i = 20; i < 37; ++i) {
+        input.exposures[2][i] = nan;
+    }
+    CrossSectionalRegression regression;
+    regression.set_num_threads(1);
+    const auto results = regression.run_cross_sections(input);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].date, 20230102);
+    EXPECT_EQ(results[0].num_observations, 18);
+    EXPECT_EQ(results[0].residuals.size(), 18u);
+    EXPECT_EQ(results[1].date, 20230104);
+    EXPECT_EQ(results[1].num_observations, 20);
+}
+
+TEST(CrossSectionFitTest, CollinearExposuresFallBackToQR) {
+    CrossSectionInput input = make_panel(1, 30, 0.01);
+    // The third exposure duplicates the first
+    input.exposures[2] = input.exposures[0];
+    CrossSectionalRegression regression;
+    regression.set_winsor_quantile(0.0);
+    const auto results = regression.run_cross_sections(input);
+
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    for (double beta : r.factor_returns) {
+        EXPECT_TRUE(std::isfinite(beta));
+    }
+    // The two copies share the first factor's return between them
+    EXPECT_NEAR(r.factor_returns[0] + r.factor_returns[2], 0.01, 0.01);
+    EXPECT_TRUE(std::isnan(r.factor_std_errors[0]));
+    EXPECT_GT(r.total_r_squared, 0.5);
+}
+
+TEST(CrossSectionFitTest, RejectsRaggedColumns) {
+    CrossSectionInput input = make_panel(2, 10, 0.0);
+    input.returns.pop_back();
+    CrossSectionalRegression regression;
+    EXPECT_THROW(regression.run_cross_sections(input), std::invalid_argument);
+
+    input = make_panel(2, 10, 0.0);
+    input.exposures[1].push_back(0.0);
+    EXPECT_THROW(regression.run_cross_sections(input), std::invalid_argument);
+
+    EXPECT_TRUE(regression.run_cross_sections(CrossSectionInput{}).empty());
+}
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <arrow/api.h>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 using namespace qse;
@@ -40,4 +42,71 @@ TEST(CrossSectionalRegressionTest, OLSRegressionSimple) {
     EXPECT_EQ(result.num_observations, 5);
     EXPECT_EQ(result.factor_returns.size(), 2);
     EXPECT_NEAR(result.total_r_squared, 0.9, 0.2); // Should fit decently
-}
\ No newline at end of file
+}
+
+TEST(CrossSectionalRegressionTest, CrossSectionsFromATable) {
+    // Two exactly fitted dates, given out of date order: 2023-01-03 has
+    // returns 2*f1 - f2, 2023-01-02 has 0.5*f1 + f2 with one null return.
+    // 2023-01-04 has no more rows than factors and is skipped.
+    arrow::StringBuilder date_builder;
+    arrow::DoubleBuilder factor1_builder, factor2_builder, return_builder;
+    arrow::Int64Builder count_builder;
+    const std::vector<double> factor1 = {1, 2, 3, 4, 5};
+    const std::vector<double> factor2 = {2, 1, 0, 1, 2};
+    auto add_row = [&](const std::string& date, double f1, double f2, double ret, bool valid) {
+        date_builder.Append(date);
+        factor1_builder.Append(f1);
+        factor2_builder.Append(f2);
+        if (valid) {
+            return_builder.Append(ret);
+        } else {
+            return_builder.AppendNull();
+        }
+        count_builder.Append(1);
+    };
+    for (std::size_t i = 0; i < factor1.size(); ++i) {
+        add_row("2023-01-03", factor1[i], factor2[i], 2 * factor1[i] - factor2[i], true);
+    }
+    for (std::size_t i = 0; i < factor1.size(); ++i) {
+        add_row("2023-01-02", factor1[i], factor2[i], 0.5 * factor1[i] + factor2[i], i != 4);
+    }
+    add_row("2023-01-04", 1, 2, 3, true);
+    add_row("2023-01-04", 2, 1, 3, true);
+    std::shared_ptr<arrow::Array> date_array, factor1_array, factor2_array, return_array,
+        count_array;
+    date_builder.Finish(&date_array);
+    factor1_builder.Finish(&factor1_array);
+    factor2_builder.Finish(&factor2_array);
+    return_builder.Finish(&return_array);
+    count_builder.Finish(&count_array);
+    auto schema = arrow::schema(
+        {arrow::field("date", arrow::utf8()), arrow::field("factor1", arrow::float64()),
+         arrow::field("factor2", arrow::float64()), arrow::field("returns", arrow::float64()),
+         arrow::field("count", arrow::int64())});
+    auto table = arrow::Table::Make(
+        schema, {date_array, factor1_array, factor2_array, return_array, count_array});
+
+    CrossSectionalRegression reg;
+    reg.set_winsor_quantile(0.0); // keep the fits exact
+    reg.set_num_threads(2);
+    auto results = reg.run_cross_sections(table, "date", "returns", {"factor1", "factor2"});
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].date, 20230102);
+    EXPECT_EQ(results[0].num_observations, 4); // the null return's row is dropped
+    ASSERT_EQ(results[0].factor_returns.size(), 2u);
+    EXPECT_NEAR(results[0].factor_returns[0], 0.5, 1e-12);
+    EXPECT_NEAR(results[0].factor_returns[1], 1.0, 1e-12);
+    EXPECT_EQ(results[1].date, 20230103);
+    EXPECT_EQ(results[1].num_observations, 5);
+    ASSERT_EQ(results[1].factor_returns.size(), 2u);
+    EXPECT_NEAR(results[1].factor_returns[0], 2.0, 1e-12);
+    EXPECT_NEAR(results[1].factor_returns[1], -1.0, 1e-12);
+    EXPECT_NEAR(results[1].total_r_squared, 1.0, 1e-12);
+
+    // Factor columns must be float64
+    EXPECT_THROW(reg.run_cross_sections(table, "date", "returns", {"factor1", "count"}),
+                 std::runtime_error);
+    EXPECT_THROW(reg.run_cross_sections(table, "no_such_date", "returns", {"factor1"}),
+                 std::runtime_error);
+}
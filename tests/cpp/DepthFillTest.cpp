@@ -14,9 +14,9 @@ namespace {
 
 // Seed three ask levels: 100@10.0, 200@10.5, 300@11.0 (600 shares total)
 void seed_asks(OrderBookFullDepth& book) {
-    book.enqueue_order(Order::Side::SELL, 10.0, "mm_a", 100);
-    book.enqueue_order(Order::Side::SELL, 10.5, "mm_b", 200);
-    book.enqueue_order(Order::Side::SELL, 11.0, "mm_c", 300);
+    book.enqueue_order(Order::Side::SELL, 10.0, kExternalOrderIdBase + 1, 100);
+    book.enqueue_order(Order::Side::SELL, 10.5, kExternalOrderIdBase + 2, 200);
+    book.enqueue_order(Order::Side::SELL, 11.0, kExternalOrderIdBase + 3, 300);
 }
 
 } // namespace
@@ -103,8 +103,8 @@ TEST_F(DepthFillTest, PartialFillWhenBookExhausted) {
 TEST_F(DepthFillTest, SellOrderWalksBids) {
     auto om = make_om("sell");
     auto& book = om->depth_book("AAPL");
-    book.enqueue_order(Order::Side::BUY, 10.0, "mm_x", 100);
-    book.enqueue_order(Order::Side::BUY, 9.5, "mm_y", 200);
+    book.enqueue_order(Order::Side::BUY, 10.0, kExternalOrderIdBase + 4, 100);
+    book.enqueue_order(Order::Side::BUY, 9.5, kExternalOrderIdBase + 5, 200);
 
     OrderId id = om->submit_market_order("AAPL", Order::Side::SELL, 300);
     om->attempt_fills();
@@ -22,7 +22,7 @@ namespace {
 // A caller written purely against the interface: brings a flat book to the
 // target position with one market order. This is the shape strategies and
 // the live runner (E3) use - no dependency on any concrete venue.
-qse::OrderId route_to_target(qse::IExecutionHandler& exec, const std::string& symbol,
+qse::VenueOrderId route_to_target(qse::IExecutionHandler& exec, const std::string& symbol,
                              qse::Volume current, qse::Volume target) {
     if (target == current) {
         return {};
@@ -76,7 +76,7 @@ TEST(ExecutionHandlerContractTest, CallersNeedOnlyTheInterface) {
     EXPECT_CALL(mock, submit_market_order("TEST", qse::Order::Side::BUY, 500))
         .WillOnce(Return("venue-1"));
 
-    qse::OrderId id = route_to_target(mock, "TEST", 0, 500);
+    qse::VenueOrderId id = route_to_target(mock, "TEST", 0, 500);
     EXPECT_EQ(id, "venue-1");
 }
 
@@ -84,9 +84,9 @@ TEST(ExecutionHandlerContractTest, FlatteningRoutesASell) {
     StrictMock<qse::MockExecutionHandler> mock;
     EXPECT_CALL(mock, submit_market_order("TEST", qse::Order::Side::SELL, 300))
         .WillOnce(Return("venue-2"));
-    EXPECT_CALL(mock, cancel_order(qse::OrderId("venue-2"))).WillOnce(Return(true));
+    EXPECT_CALL(mock, cancel_order(qse::VenueOrderId("venue-2"))).WillOnce(Return(true));
 
-    qse::OrderId id = route_to_target(mock, "TEST", 300, 0);
+    qse::VenueOrderId id = route_to_target(mock, "TEST", 300, 0);
     EXPECT_EQ(id, "venue-2");
     EXPECT_TRUE(mock.cancel_order(id)); // e.g. a timeout guard cancelling
 }
@@ -99,7 +99,7 @@ TEST(ExecutionHandlerContractTest, NoOrderWhenAlreadyAtTarget) {
 // --- Integration: the simulated venue is the real backtest engine ---
 
 TEST_F(SimulatedExecutionHandlerTest, MarketOrderFillsThroughRealEngine) {
-    qse::OrderId id = exec_->submit_market_order("TEST", qse::Order::Side::BUY, 100);
+    qse::VenueOrderId id = exec_->submit_market_order("TEST", qse::Order::Side::BUY, 100);
     ASSERT_FALSE(id.empty());
 
     om_->process_tick(make_tick(99.9, 100.1));
@@ -120,7 +120,7 @@ TEST_F(SimulatedExecutionHandlerTest, RestingLimitOrderCancelsCleanly) {
     om_->process_tick(make_tick(99.9, 100.1));
 
     // Buy limit below the bid: rests in the book, never marketable here
-    qse::OrderId id = exec_->submit_limit_order("TEST", qse::Order::Side::BUY, 100, 99.5,
+    qse::VenueOrderId id = exec_->submit_limit_order("TEST", qse::Order::Side::BUY, 100, 99.5,
                                                 qse::Order::TimeInForce::DAY);
     ASSERT_FALSE(id.empty());
     EXPECT_EQ(exec_->get_order(id)->status, qse::Order::Status::PENDING);
@@ -136,10 +136,10 @@ TEST_F(SimulatedExecutionHandlerTest, RestingLimitOrderCancelsCleanly) {
 
 TEST_F(SimulatedExecutionHandlerTest, ReplacePreservesSymbolAndSide) {
     om_->process_tick(make_tick(99.9, 100.1));
-    qse::OrderId id = exec_->submit_limit_order("TEST", qse::Order::Side::BUY, 100, 99.5,
+    qse::VenueOrderId id = exec_->submit_limit_order("TEST", qse::Order::Side::BUY, 100, 99.5,
                                                 qse::Order::TimeInForce::DAY);
 
-    qse::OrderId new_id = exec_->replace_order(id, 200, 99.8);
+    qse::VenueOrderId new_id = exec_->replace_order(id, 200, 99.8);
     ASSERT_FALSE(new_id.empty());
     EXPECT_NE(new_id, id);
 
@@ -154,7 +154,7 @@ TEST_F(SimulatedExecutionHandlerTest, ReplacePreservesSymbolAndSide) {
 }
 
 TEST_F(SimulatedExecutionHandlerTest, ReplaceRejectsMarketOrdersAndUnknownIds) {
-    qse::OrderId market_id = exec_->submit_market_order("TEST", qse::Order::Side::BUY, 100);
+    qse::VenueOrderId market_id = exec_->submit_market_order("TEST", qse::Order::Side::BUY, 100);
     EXPECT_TRUE(exec_->replace_order(market_id, 200, 100.0).empty());
     EXPECT_TRUE(exec_->replace_order("no-such-order", 200, 100.0).empty());
 }
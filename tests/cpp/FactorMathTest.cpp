@@ -1,6 +1,11 @@
 #include "gtest/gtest.h"
+#include "qse/math/FactorKernels.h"
 #include "qse/math/StatsUtil.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 TEST(FactorMathTest, RollingStd) {
     qse::math::RollingStdDev r(4);
     std::vector<double> v = {1, 2, 3, 4};
@@ -9,4 +14,96 @@ TEST(FactorMathTest, RollingStd) {
         last = r(x);
     // σ of {1,2,3,4} = √1.25 ≈ 1.118
     EXPECT_NEAR(last, 1.1180, 1e-3);
-}
\ No newline at end of file
+}
+
+TEST(FactorMathTest, RollingStdKernelMatchesRollingStdDev) {
+    std::vector<double> x;
+    for (int i = 0; i < 100; ++i)
+        x.push_back(std::sin(i * 0.37) * 0.02 + (i % 7) * 1e-3);
+
+    for (std::size_t window : {1u, 2u, 5u, 20u, 150u}) {
+        for (std::size_t n : {0u, 1u, 3u, 100u}) {
+            std::vector<double> out(n, -1.0);
+            qse::math::rolling_std(x.data(), n, window, out.data());
+            qse::math::RollingStdDev r(window);
+            for (std::size_t i = 0; i < n; ++i)
+                EXPECT_EQ(out[i], r(x[i])) << "window " << window << " row " << i;
+        }
+    }
+}
+
+TEST(FactorMathTest, ReturnAndMomentumKernels) {
+    const std::vector<double> x = {10, 11, 0, 5, 10, 12, 15};
+    std::vector<double> r(x.size());
+    qse::math::simple_returns(x.data(), x.size(), r.data());
+    EXPECT_EQ(r, (std::vector<double>{0.0, 0.1, -1.0, 0.0, 1.0, 0.2, 0.25})); // 0 after x == 0
+
+    // lookback 4, skip 1: out[i] = x[i - 1] / x[i - 4] - 1 from row 4
+    std::vector<double> m(x.size(), -1.0);
+    qse::math::momentum(x.data(), x.size(), 4, 1, m.data());
+    EXPECT_EQ(m[0], 0.0);
+    EXPECT_EQ(m[3], 0.0);
+    EXPECT_DOUBLE_EQ(m[4], 5.0 / 10.0 - 1.0);
+    EXPECT_DOUBLE_EQ(m[5], 10.0 / 11.0 - 1.0);
+    EXPECT_EQ(m[6], 0.0); // x[2] == 0: no return rather than inf
+    // Shorter than the lookback: all zeros
+    std::vector<double> short_m(3, -1.0);
+    qse::math::momentum(x.data(), 3, 4, 1, short_m.data());
+    EXPECT_EQ(short_m, std::vector<double>(3, 0.0));
+}
+
+TEST(FactorMathTest, ReciprocalAndWeightedSumKernels) {
+    const std::vector<double> pb = {2.0, 0.0, 0.5, -4.0};
+    std::vector<double> value(pb.size());
+    qse::math::reciprocal(pb.data(), pb.size(), value.data());
+    EXPECT_EQ(value, (std::vector<double>{0.5, 0.0, 2.0, -0.25}));
+
+    const std::vector<double> a = {1, 2, 3, 4};
+    const std::vector<double> b = {10, 20, 30, 40};
+    const double* columns[2] = {a.data(), b.data()};
+    const double weights[2] = {0.5, 0.25};
+    std::vector<double> out(a.size());
+    qse::math::weighted_sum(columns, weights, 2, a.size(), out.data());
+    EXPECT_EQ(out, (std::vector<double>{3.0, 6.0, 9.0, 12.0}));
+
+    qse::math::axpy(2.0, a.data(), a.size(), out.data());
+    EXPECT_EQ(out, (std::vector<double>{5.0, 10.0, 15.0, 20.0}));
+
+    qse::math::weighted_sum(columns, weights, 0, a.size(), out.data());
+    EXPECT_EQ(out, std::vector<double>(4, 0.0));
+}
+
+TEST(FactorMathTest, CrossSectionZscoreSkipsNonFiniteValues) {
+    std::vector<double> x = {1.0, NAN, 2.0, INFINITY, 3.0};
+    std::vector<double> finite;
+    qse::math::cross_section_zscore(x.data(), x.size(), 0.0, finite);
+
+    std::vector<double> expected = {1.0, 2.0, 3.0};
+    qse::math::zscore(expected);
+    EXPECT_EQ(x, (std::vector<double>{expected[0], 0.0, expected[1], 0.0, expected[2]}));
+}
+
+TEST(FactorMathTest, WinsorizeClampsToTheSortedOrderStatistics) {
+    // Thin tails take the heap path, wide ones nth_element; both must clamp
+    // to the values a full sort puts at positions n*q and n*(1-q)
+    for (std::size_t n : {1u, 7u, 40u, 1000u}) {
+        for (double q : {0.0, 0.01, 0.05, 0.25}) {
+            std::vector<double> x(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                x[i] = std::sin(static_cast<double>(i) * 12.9898) * 100.0;
+            }
+            std::vector<double> sorted = x;
+            std::sort(sorted.begin(), sorted.end());
+            const double lo = sorted[static_cast<std::size_t>(n * q)];
+            const double hi = sorted[std::min(static_cast<std::size_t>(n * (1 - q)), n - 1)];
+
+            std::vector<double> expected = x;
+            for (double& v : expected) {
+                v = std::clamp(v, lo, hi);
+            }
+            std::vector<double> scratch;
+            qse::math::winsorize(x.data(), x.size(), q, scratch);
+            EXPECT_EQ(x, expected) << "n=" << n << " q=" << q;
+        }
+    }
+}
@@ -0,0 +1,189 @@
+// Panel factor engine: per-symbol look-backs, per-date z-scores, warm-up
+// rows left out of the cross-section, and results independent of row order
+// and thread count.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "qse/factor/FactorPanel.h"
+
+using namespace qse;
+
+namespace {
+
+FactorPanelSettings short_windows(unsigned threads = 1) {
+    FactorPanelSettings settings;
+    settings.momentum_lookback = 3;
+    settings.momentum_skip = 1;
+    settings.vol_window = 2;
+    settings.threads = threads;
+    return settings;
+}
+
+void add_row(FactorPanelInput& input, const std::string& symbol, DateKey date, double close,
+             double pb = 1.0) {
+    input.symbols.push_back(symbol);
+    input.dates.push_back(date);
+    input.close.push_back(close);
+    input.pb.push_back(pb);
+}
+
+// Row index of (symbol, date)
+std::size_t row_of(const FactorPanelInput& input, const std::string& symbol, DateKey date) {
+    for (std::size_t i = 0; i < input.symbols.size(); ++i) {
+        if (input.symbols[i] == symbol && input.dates[i] == date) {
+            return i;
+        }
+    }
+    throw std::out_of_range(symbol);
+}
+
+} // namespace
+
+TEST(FactorPanelTest, ParsesDateKeys) {
+    EXPECT_EQ(parse_date_key("2023-01-03"), 20230103);
+    EXPECT_EQ(parse_date_key("20231231"), 20231231);
+    EXPECT_THROW(parse_date_key("2023-13-01"), std::invalid_argument);
+    EXPECT_THROW(parse_date_key("2023/01/03"), std::invalid_argument);
+    EXPECT_THROW(parse_date_key("2023-1-3"), std::invalid_argument);
+    EXPECT_THROW(parse_date_key(""), std::invalid_argument);
+    EXPECT_EQ(format_date_key(20230103), "2023-01-03");
+    EXPECT_EQ(parse_date_key(format_date_key(19991231)), 19991231);
+}
+
+TEST(FactorPanelTest, LookbacksStayWithinEachSymbol) {
+    // Rows arrive date by date, interleaving the two symbols. UP rises 10%
+    // a day, DOWN falls 10% a day.
+    FactorPanelInput input;
+    double up = 100.0, down = 50.0;
+    for (DateKey date = 20230102; date <= 20230107; ++date) {
+        add_row(input, "UP", date, up);
+        add_row(input, "DOWN", date, down);
+        up *= 1.1;
+        down *= 0.9;
+    }
+    FactorPanelOutput out = FactorPanel(short_windows()).compute(input);
+    EXPECT_EQ(out.num_symbols, 2u);
+    EXPECT_EQ(out.num_dates, 6u);
+
+    for (DateKey date = 20230102; date <= 20230107; ++date) {
+        const std::size_t up_row = row_of(input, "UP", date);
+        const std::size_t down_row = row_of(input, "DOWN", date);
+        if (date < 20230105) {
+            // Fewer than 3 earlier rows: no momentum yet for either symbol
+            EXPECT_EQ(out.mom_z[up_row], 0.0) << date;
+            EXPECT_EQ(out.mom_z[down_row], 0.0) << date;
+        } else {
+            // Two names: one standard deviation either side of the mean
+            EXPECT_DOUBLE_EQ(out.mom_z[up_row], 1.0) << date;
+            EXPECT_DOUBLE_EQ(out.mom_z[down_row], -1.0) << date;
+        }
+    }
+}
+
+TEST(FactorPanelTest, ScoresEachDateOnItsOwn) {
+    // On every date the three names' P/B are 1:2:4, at a scale that grows
+    // a hundredfold from one date to the next
+    FactorPanelInput input;
+    double scale = 1.0;
+    for (DateKey date = 20230102; date <= 20230104; ++date) {
+        add_row(input, "A", date, 10.0, 1.0 * scale);
+        add_row(input, "B", date, 10.0, 2.0 * scale);
+        add_row(input, "C", date, 10.0, 4.0 * scale);
+        scale *= 100.0;
+    }
+    FactorPanelOutput out = FactorPanel(short_windows()).compute(input);
+
+    // Value is 1 / P/B: {1, 0.5, 0.25} up to scale
+    const double mean = 1.75 / 3.0;
+    const double sd = std::sqrt(((1 - mean) * (1 - mean) + (0.5 - mean) * (0.5 - mean) +
+                                 (0.25 - mean) * (0.25 - mean)) /
+                                3.0);
+    for (DateKey date = 20230102; date <= 20230104; ++date) {
+        EXPECT_NEAR(out.val_z[row_of(input, "A", date)], (1.0 - mean) / sd, 1e-12);
+        EXPECT_NEAR(out.val_z[row_of(input, "B", date)], (0.5 - mean) / sd, 1e-12);
+        EXPECT_NEAR(out.val_z[row_of(input, "C", date)], (0.25 - mean) / sd, 1e-12);
+    }
+}
+
+TEST(FactorPanelTest, WarmUpAndMissingValuesLeaveTheCrossSection) {
+    FactorPanelInput input;
+    for (DateKey date = 20230102; date <= 20230106; ++date) {
+        const double day = static_cast<double>(date - 20230101);
+        add_row(input, "A", date, 100.0 + day, 1.0);
+        add_row(input, "B", date, 100.0 - day, 2.0);
+    }
+    // LATE lists on the last date; its P/B of 0 has no value either
+    add_row(input, "LATE", 20230106, 1000.0, 0.0);
+    FactorPanelOutput out = FactorPanel(short_windows()).compute(input);
+
+    const std::size_t late = row_of(input, "LATE", 20230106);
+    EXPECT_EQ(out.mom_z[late], 0.0);
+    EXPECT_EQ(out.vol_z[late], 0.0);
+    EXPECT_EQ(out.val_z[late], 0.0);
+    EXPECT_EQ(out.alpha[late], 0.0);
+    // A and B are still scored against each other alone
+    EXPECT_DOUBLE_EQ(out.mom_z[row_of(input, "A", 20230106)], 1.0);
+    EXPECT_DOUBLE_EQ(out.mom_z[row_of(input, "B", 20230106)], -1.0);
+    EXPECT_DOUBLE_EQ(out.val_z[row_of(input, "A", 20230106)], 1.0);
+}
+
+TEST(FactorPanelTest, SameResultForAnyRowOrderAndThreadCount) {
+    FactorPanelSettings settings; // full-size windows
+    FactorPanelInput input;
+    std::mt19937 rng(7);
+    std::normal_distribution<double> ret(0.0, 0.02);
+    for (int s = 0; s < 40; ++s) {
+        double px = 20.0 + s;
+        // Staggered listings: symbol s starts s * 5 days in
+        for (int d = s * 5; d < 400; ++d) {
+            px *= 1.0 + ret(rng);
+            add_row(input, "S" + std::to_string(s), 20000000 + d, px, 0.5 + px / 100.0);
+        }
+    }
+    const FactorPanelOutput serial = FactorPanel(settings).compute(input);
+
+    std::vector<std::size_t> perm(input.symbols.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::shuffle(perm.begin(), perm.end(), rng);
+    FactorPanelInput shuffled;
+    for (std::size_t i : perm) {
+        add_row(shuffled, input.symbols[i], input.dates[i], input.close[i], input.pb[i]);
+    }
+    settings.threads = 4;
+    const FactorPanelOutput parallel = FactorPanel(settings).compute(shuffled);
+
+    for (std::size_t k = 0; k < perm.size(); ++k) {
+        const std::size_t i = perm[k];
+        ASSERT_EQ(parallel.mom_z[k], serial.mom_z[i]) << k;
+        ASSERT_EQ(parallel.vol_z[k], serial.vol_z[i]) << k;
+        ASSERT_EQ(parallel.val_z[k], serial.val_z[i]) << k;
+        ASSERT_EQ(parallel.alpha[k], serial.alpha[i]) << k;
+    }
+    const std::size_t row = row_of(input, "S0", 20000300);
+    EXPECT_DOUBLE_EQ(serial.alpha[row], 0.5 * serial.mom_z[row] + 0.3 * serial.vol_z[row] +
+                                            0.2 * serial.val_z[row]);
+}
+
+TEST(FactorPanelTest, RejectsDuplicateRowsAndRaggedColumns) {
+    FactorPanelInput input;
+    add_row(input, "A", 20230102, 10.0);
+    add_row(input, "B", 20230102, 10.0);
+    add_row(input, "A", 20230102, 11.0);
+    EXPECT_THROW(FactorPanel(short_windows()).compute(input), std::invalid_argument);
+    EXPECT_THROW(FactorPanel(short_windows(4)).compute(input), std::invalid_argument);
+
+    input.dates[2] = 20230103;
+    input.pb.pop_back();
+    EXPECT_THROW(FactorPanel(short_windows()).compute(input), std::invalid_argument);
+
+    FactorPanelSettings bad;
+    bad.momentum_skip = bad.momentum_lookback + 1;
+    EXPECT_THROW(FactorPanel{bad}, std::invalid_argument);
+}
@@ -0,0 +1,185 @@
+// FactorStore Parquet round trips: partitioned writes, pruned and projected
+// reads, date replacement, and the ICMonitor reader on top of a store.
+
+#include <gtest/gtest.h>
+#include "qse/factor/FactorStore.h"
+#include "qse/factor/ICMonitor.h"
+
+#include <arrow/api.h>
+
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace qse;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+template <class Builder, class T>
+std::shared_ptr<arrow::Array> build(const std::vector<T>& values) {
+    Builder builder;
+    EXPECT_TRUE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+    return array;
+}
+
+// `symbols` x `dates` rows, date-major: close = date index * 100 + symbol
+// index, volume = symbol index, ret = a return that tracks the factor
+std::shared_ptr<arrow::Table> panel(const std::vector<std::string>& dates, int symbols) {
+    std::vector<std::string> date, symbol;
+    std::vector<double> close, ret;
+    std::vector<int64_t> volume;
+    for (std::size_t d = 0; d < dates.size(); ++d) {
+        for (int s = 0; s < symbols; ++s) {
+            date.push_back(dates[d]);
+            symbol.push_back("S" + std::to_string(100 + s));
+            close.push_back(static_cast<double>(d * 100 + s));
+            volume.push_back(s);
+            ret.push_back(0.001 * s);
+        }
+    }
+    auto schema = arrow::schema(
+        {arrow::field("date", arrow::utf8()), arrow::field("symbol", arrow::utf8()),
+         arrow::field("close", arrow::float64()), arrow::field("volume", arrow::int64()),
+         arrow::field("ret", arrow::float64())});
+    return arrow::Table::Make(schema, {build<arrow::StringBuilder>(date),
+                                       build<arrow::StringBuilder>(symbol),
+                                       build<arrow::DoubleBuilder>(close),
+                                       build<arrow::Int64Builder>(volume),
+                                       build<arrow::DoubleBuilder>(ret)});
+}
+
+// (date, symbol) -> close of a table read from the store
+std::map<std::pair<std::string, std::string>, double> closes(const arrow::Table& table) {
+    auto date =
+        std::static_pointer_cast<arrow::StringArray>(table.GetColumnByName("date")->chunk(0));
+    auto symbol =
+        std::static_pointer_cast<arrow::StringArray>(table.GetColumnByName("symbol")->chunk(0));
+    auto close =
+        std::static_pointer_cast<arrow::DoubleArray>(table.GetColumnByName("close")->chunk(0));
+    std::map<std::pair<std::string, std::string>, double> out;
+    for (int64_t i = 0; i < table.num_rows(); ++i) {
+        out[{date->GetString(i), symbol->GetString(i)}] = close->Value(i);
+    }
+    return out;
+}
+
+fs::path fresh_root(const std::string& name) {
+    const fs::path root = fs::temp_directory_path() / name;
+    fs::remove_all(root);
+    return root;
+}
+
+} // namespace
+
+TEST(FactorStoreParquetTest, RoundTripsEveryRowAndColumn) {
+    const fs::path root = fresh_root("qse_factor_store_roundtrip");
+    FactorStore store(root.string(), FactorStoreSettings{4, 8});
+    store.write(panel({"2023-01-03", "2023-01-04", "2023-01-05"}, 40));
+
+    FactorReadStats stats;
+    auto table = store.read(FactorQuery{}, &stats);
+    ASSERT_EQ(table->num_rows(), 120);
+    EXPECT_EQ(stats.files, 12u);
+    EXPECT_EQ(stats.row_groups_skipped, 0u);
+    EXPECT_EQ(stats.rows, 120u);
+    // date, symbol, then the stored columns in file order
+    ASSERT_EQ(table->num_columns(), 5);
+    EXPECT_EQ(table->field(0)->name(), "date");
+    EXPECT_EQ(table->field(1)->name(), "symbol");
+    EXPECT_EQ(table->field(3)->type()->id(), arrow::Type::INT64);
+    for (const auto& column : table->columns()) {
+        EXPECT_EQ(column->num_chunks(), 1);
+    }
+
+    const auto values = closes(*table);
+    EXPECT_EQ(values.size(), 120u);
+    EXPECT_EQ(values.at({"2023-01-04", "S107"}), 107.0);
+    EXPECT_EQ(values.at({"2023-01-05", "S139"}), 239.0);
+    fs::remove_all(root);
+}
+
+TEST(FactorStoreParquetTest, ReadsOnlyTheQueriedDatesSymbolsAndColumns) {
+    const fs::path root = fresh_root("qse_factor_store_pruned");
+    FactorStore store(root.string(), FactorStoreSettings{4, 4});
+    store.write(panel({"2023-01-03", "2023-01-04", "2023-01-05", "2023-02-01"}, 200));
+
+    FactorQuery query;
+    query.first_date = 20230104;
+    query.last_date = 20230131;
+    query.symbols = {"S150", "S151"};
+    query.columns = {"close"};
+    FactorReadStats stats;
+    auto table = store.read(query, &stats);
+
+    ASSERT_EQ(table->num_columns(), 3);
+    EXPECT_EQ(table->field(2)->name(), "close");
+    const auto values = closes(*table);
+    ASSERT_EQ(values.size(), 4u);
+    EXPECT_EQ(values.at({"2023-01-04", "S150"}), 150.0);
+    EXPECT_EQ(values.at({"2023-01-05", "S151"}), 251.0);
+
+    // Two dates, at most two buckets each; about 50 symbols per file in row
+    // groups of 4, so nearly every row group is skipped
+    EXPECT_LE(stats.files, 4u);
+    EXPECT_LE(stats.row_groups_read, stats.files * 2);
+    EXPECT_GT(stats.row_groups_skipped, 40u);
+    EXPECT_EQ(stats.rows, 4u);
+
+    // A column no file has reads as nulls
+    query.columns = {"close", "beta"};
+    table = store.read(query);
+    EXPECT_EQ(table->GetColumnByName("beta")->null_count(), 4);
+    fs::remove_all(root);
+}
+
+TEST(FactorStoreParquetTest, RewritingADateReplacesOnlyThatDate) {
+    const fs::path root = fresh_root("qse_factor_store_rewrite");
+    FactorStore(root.string(), FactorStoreSettings{4, 8})
+        .write(panel({"2023-01-03", "2023-01-04"}, 40));
+
+    // Reopened: the bucket count comes from the store, not the settings
+    FactorStore store(root.string(), FactorStoreSettings{16, 8});
+    EXPECT_EQ(store.symbol_buckets(), 4u);
+    // 2023-01-04 again with one symbol: the other buckets of that date go
+    store.write(panel({"2023-01-04"}, 1));
+
+    const auto values = closes(*store.read(FactorQuery{}));
+    EXPECT_EQ(values.size(), 41u);
+    EXPECT_EQ(values.count({"2023-01-04", "S100"}), 1u);
+    EXPECT_EQ(values.count({"2023-01-04", "S101"}), 0u);
+    EXPECT_EQ(values.count({"2023-01-03", "S139"}), 1u);
+    fs::remove_all(root);
+}
+
+TEST(FactorStoreParquetTest, RejectsTablesWithoutDateOrSymbol) {
+    const fs::path root = fresh_root("qse_factor_store_invalid");
+    FactorStore store(root.string());
+    auto table = panel({"2023-01-03"}, 3);
+    EXPECT_THROW(store.write(*table->RemoveColumn(1)), std::invalid_argument);
+    EXPECT_THROW(store.write(panel({"03/01/2023"}, 3)), std::invalid_argument);
+    fs::remove_all(root);
+}
+
+TEST(FactorStoreParquetTest, ICMonitorReadsAWindowFromTheStore) {
+    const fs::path root = fresh_root("qse_factor_store_ic");
+    FactorStore store(root.string());
+    store.write(panel({"2023-01-03", "2023-01-04", "2023-01-05", "2023-01-06"}, 30));
+
+    FactorQuery query;
+    query.first_date = 20230104;
+    query.last_date = 20230105;
+    ICMonitor monitor;
+    auto result = monitor.compute_ic(store, query, "close", "ret", 2);
+    ASSERT_EQ(result.daily_ic.size(), 2u);
+    // Within a date close and ret rank the symbols the same way
+    EXPECT_NEAR(result.daily_ic[0], 1.0, 1e-12);
+    EXPECT_NEAR(result.daily_ic[1], 1.0, 1e-12);
+    fs::remove_all(root);
+}
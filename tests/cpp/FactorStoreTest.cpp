@@ -0,0 +1,131 @@
+// FactorStore layout and partition pruning: which files a query opens.
+// Reading and writing the Parquet files is covered by
+// FactorStoreParquetTest.
+
+#include <gtest/gtest.h>
+#include "qse/factor/FactorStore.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace qse;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// A store directory with empty part files for `dates` x all buckets, plus
+// entries the planner must ignore
+fs::path make_layout(const std::string& name, const std::vector<DateKey>& dates,
+                     std::uint32_t buckets) {
+    const fs::path root = fs::temp_directory_path() / name;
+    fs::remove_all(root);
+    fs::create_directories(root);
+    std::ofstream(root / "_factor_store") << "qse_factor_store 1\nsymbol_buckets " << buckets
+                                          << "\n";
+    for (DateKey date : dates) {
+        for (std::uint32_t b = 0; b < buckets; ++b) {
+            const fs::path dir = root / partition_directory(date, b);
+            fs::create_directories(dir);
+            std::ofstream(dir / kFactorPartFile).put('x');
+            // An interrupted write's leftover is not a partition
+            std::ofstream(dir / "part-0.parquet.tmp").put('x');
+        }
+    }
+    fs::create_directories(root / "date=not-a-date" / "symbol_bucket=0");
+    std::ofstream(root / "date=not-a-date" / "symbol_bucket=0" / kFactorPartFile).put('x');
+    fs::create_directories(root / "notes");
+    return root;
+}
+
+} // namespace
+
+TEST(FactorStoreTest, SymbolBucketsAreStableAndInRange) {
+    // FNV-1a, so the value is fixed across platforms and runs
+    EXPECT_EQ(symbol_bucket("", 1000), 2166136261u % 1000);
+    EXPECT_EQ(symbol_bucket("AAPL", 7), symbol_bucket(std::string("AAPL"), 7));
+    std::vector<int> counts(4, 0);
+    for (int s = 0; s < 400; ++s) {
+        const std::uint32_t b = symbol_bucket("SYM" + std::to_string(s), 4);
+        ASSERT_LT(b, 4u);
+        ++counts[b];
+    }
+    for (int count : counts) {
+        EXPECT_GT(count, 60); // roughly balanced
+    }
+    EXPECT_EQ(partition_directory(20230103, 2), "date=2023-01-03/symbol_bucket=2");
+}
+
+TEST(FactorStoreTest, PlanPrunesByDateRangeAndSymbolBucket) {
+    const std::vector<DateKey> dates = {20230102, 20230103, 20230104, 20230201, 20230301};
+    const fs::path root = make_layout("qse_factor_store_plan", dates, 4);
+    const FactorStore store(root.string(), FactorStoreSettings{16, 128});
+    EXPECT_EQ(store.symbol_buckets(), 4u); // the layout file wins
+
+    // Everything
+    std::vector<FactorPartition> all = store.plan(FactorQuery{});
+    ASSERT_EQ(all.size(), dates.size() * 4);
+    EXPECT_EQ(all.front().date, 20230102);
+    EXPECT_EQ(all.front().bucket, 0u);
+    EXPECT_EQ(all.back().date, 20230301);
+    EXPECT_EQ(all.back().bucket, 3u);
+    EXPECT_EQ(fs::path(all[5].path), root / partition_directory(20230103, 1) / kFactorPartFile);
+
+    // January's first week, every symbol
+    FactorQuery week;
+    week.first_date = 20230102;
+    week.last_date = 20230108;
+    std::vector<FactorPartition> parts = store.plan(week);
+    ASSERT_EQ(parts.size(), 3u * 4);
+    for (const FactorPartition& part : parts) {
+        EXPECT_TRUE(week.wants_date(part.date));
+    }
+
+    // Two symbols: only their buckets, in every date of the range
+    week.symbols = {"AAPL", "MSFT"};
+    parts = store.plan(week);
+    const std::uint32_t a = symbol_bucket("AAPL", 4);
+    const std::uint32_t m = symbol_bucket("MSFT", 4);
+    ASSERT_EQ(parts.size(), 3u * (a == m ? 1 : 2));
+    for (const FactorPartition& part : parts) {
+        EXPECT_TRUE(part.bucket == a || part.bucket == m);
+    }
+
+    // A range with no dates, and a store that does not exist
+    week.first_date = 20240101;
+    week.last_date = 20241231;
+    EXPECT_TRUE(store.plan(week).empty());
+    EXPECT_TRUE(FactorStore((root / "missing").string()).plan(FactorQuery{}).empty());
+    fs::remove_all(root);
+}
+
+TEST(FactorStoreTest, RowGroupRangesPruneBySymbol) {
+    FactorQuery query;
+    EXPECT_TRUE(query.may_contain_symbols("A", "B"));
+
+    query.symbols = {"IBM", "MSFT"};
+    EXPECT_TRUE(query.may_contain_symbols("IBM", "IBM"));
+    EXPECT_TRUE(query.may_contain_symbols("GOOG", "INTC"));
+    EXPECT_TRUE(query.may_contain_symbols("META", "NVDA"));
+    EXPECT_FALSE(query.may_contain_symbols("AAPL", "AMZN"));
+    EXPECT_FALSE(query.may_contain_symbols("INTC", "META"));
+    EXPECT_FALSE(query.may_contain_symbols("NVDA", "TSLA"));
+}
+
+TEST(FactorStoreTest, RejectsBadSettingsAndForeignLayoutFiles) {
+    EXPECT_THROW(FactorStore("unused", FactorStoreSettings{0, 128}), std::invalid_argument);
+    EXPECT_THROW(FactorStore("unused", FactorStoreSettings{4, 0}), std::invalid_argument);
+
+    const fs::path root = fs::temp_directory_path() / "qse_factor_store_layout";
+    fs::remove_all(root);
+    fs::create_directories(root);
+    std::ofstream(root / "_factor_store") << "symbol_buckets 4\n";
+    EXPECT_THROW(FactorStore(root.string()), std::runtime_error);
+    std::ofstream(root / "_factor_store", std::ios::trunc)
+        << "qse_factor_store 1\nsymbol_buckets 0\n";
+    EXPECT_THROW(FactorStore(root.string()), std::invalid_argument);
+    fs::remove_all(root);
+}
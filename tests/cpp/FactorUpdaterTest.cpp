@@ -0,0 +1,151 @@
+// Incremental factor updates: daily updates (with the state saved and
+// reloaded between them) match a full FactorPanel recomputation bit for bit;
+// stale dates, duplicates and mismatched state files are rejected.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "qse/factor/FactorPanel.h"
+#include "qse/factor/FactorUpdater.h"
+
+using namespace qse;
+
+namespace {
+
+FactorPanelSettings small_windows() {
+    FactorPanelSettings settings;
+    settings.momentum_lookback = 30;
+    settings.momentum_skip = 5;
+    settings.vol_window = 10;
+    settings.threads = 1;
+    return settings;
+}
+
+// 25 symbols over 80 dates. Symbol s lists on date 2 * s and symbols
+// divisible by 7 skip every fifth date; one P/B is zero.
+FactorPanelInput make_history() {
+    FactorPanelInput panel;
+    std::mt19937 rng(11);
+    std::normal_distribution<double> ret(0.0, 0.02);
+    std::vector<double> px(25, 50.0);
+    for (int d = 0; d < 80; ++d) {
+        for (int s = 0; s < 25; ++s) {
+            px[s] *= 1.0 + ret(rng);
+            if (d < 2 * s || (s % 7 == 0 && d % 5 == 4)) {
+                continue;
+            }
+            panel.symbols.push_back("S" + std::to_string(s));
+            panel.dates.push_back(20230000 + d);
+            panel.close.push_back(px[s]);
+            panel.pb.push_back(s == 3 && d == 40 ? 0.0 : 0.8 + px[s] / 40.0);
+        }
+    }
+    return panel;
+}
+
+// Rows of `panel` dated in [from, to)
+FactorPanelInput slice(const FactorPanelInput& panel, DateKey from, DateKey to,
+                       std::vector<std::size_t>& rows) {
+    FactorPanelInput out;
+    rows.clear();
+    // Reversed, so the updater cannot rely on input order
+    for (std::size_t i = panel.symbols.size(); i-- > 0;) {
+        if (panel.dates[i] >= from && panel.dates[i] < to) {
+            out.symbols.push_back(panel.symbols[i]);
+            out.dates.push_back(panel.dates[i]);
+            out.close.push_back(panel.close[i]);
+            out.pb.push_back(panel.pb[i]);
+            rows.push_back(i);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(FactorUpdaterTest, DailyUpdatesMatchFullRecomputation) {
+    const FactorPanelInput history = make_history();
+    const FactorPanelOutput full = FactorPanel(small_windows()).compute(history);
+
+    const std::string path = "factor_updater_test.state";
+    std::vector<std::size_t> rows;
+    {
+        // Build the state from the first 60 dates in one call
+        FactorUpdater updater(small_windows());
+        FactorPanelOutput first = updater.update(slice(history, 20230000, 20230060, rows));
+        EXPECT_EQ(first.num_dates, 60u);
+        for (std::size_t k = 0; k < rows.size(); ++k) {
+            ASSERT_EQ(first.alpha[k], full.alpha[rows[k]]) << k;
+        }
+        updater.save(path);
+    }
+
+    // Then one date per run, reloading the state every time
+    for (DateKey date = 20230060; date < 20230080; ++date) {
+        FactorUpdater updater = FactorUpdater::load(path, small_windows());
+        EXPECT_EQ(updater.last_date(), date - 1);
+        FactorPanelOutput day = updater.update(slice(history, date, date + 1, rows));
+        ASSERT_FALSE(rows.empty());
+        for (std::size_t k = 0; k < rows.size(); ++k) {
+            ASSERT_EQ(day.mom_z[k], full.mom_z[rows[k]]) << date;
+            ASSERT_EQ(day.vol_z[k], full.vol_z[rows[k]]) << date;
+            ASSERT_EQ(day.val_z[k], full.val_z[rows[k]]) << date;
+            ASSERT_EQ(day.alpha[k], full.alpha[rows[k]]) << date;
+        }
+        updater.save(path);
+    }
+    EXPECT_EQ(FactorUpdater::load(path, small_windows()).num_symbols(), 25u);
+    std::remove(path.c_str());
+}
+
+TEST(FactorUpdaterTest, RejectsStaleDatesAndDuplicatesWithoutChangingState) {
+    FactorUpdater updater(small_windows());
+    FactorPanelInput day;
+    day.symbols = {"A", "B"};
+    day.dates = {20230102, 20230102};
+    day.close = {10.0, 20.0};
+    day.pb = {1.0, 2.0};
+    updater.update(day);
+    EXPECT_EQ(updater.last_date(), 20230102);
+
+    // The same date again
+    EXPECT_THROW(updater.update(day), std::invalid_argument);
+
+    FactorPanelInput twice = day;
+    twice.dates = {20230103, 20230103};
+    twice.symbols = {"A", "A"};
+    EXPECT_THROW(updater.update(twice), std::invalid_argument);
+    EXPECT_EQ(updater.last_date(), 20230102);
+    EXPECT_EQ(updater.num_symbols(), 2u);
+
+    twice.pb.pop_back();
+    EXPECT_THROW(updater.update(twice), std::invalid_argument);
+}
+
+TEST(FactorUpdaterTest, LoadRejectsOtherWindowsAndForeignFiles) {
+    const std::string path = "factor_updater_windows.state";
+    FactorUpdater(small_windows()).save(path);
+
+    FactorPanelSettings other = small_windows();
+    other.vol_window = 20;
+    EXPECT_THROW(FactorUpdater::load(path, other), std::runtime_error);
+
+    // Weights and threads may change between runs
+    FactorPanelSettings reweighted = small_windows();
+    reweighted.momentum_weight = 1.0;
+    reweighted.threads = 4;
+    EXPECT_NO_THROW(FactorUpdater::load(path, reweighted));
+
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "date,symbol,close\n";
+    }
+    EXPECT_THROW(FactorUpdater::load(path, small_windows()), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(FactorUpdater::load(path, small_windows()), std::runtime_error);
+}
@@ -15,10 +15,12 @@ public:
     void execute_sell(const std::string&, int, double) override {}
 
     // Additional interface methods
-    OrderId submit_market_order(const std::string&, Order::Side, Volume) override { return ""; }
+    OrderId submit_market_order(const std::string&, Order::Side, Volume) override {
+        return kInvalidOrderId;
+    }
     OrderId submit_limit_order(const std::string&, Order::Side, Volume, Price,
                                Order::TimeInForce) override {
-        return "";
+        return kInvalidOrderId;
     }
     bool cancel_order(const OrderId&) override { return false; }
     void process_tick(const Tick&) override {}
@@ -29,6 +31,7 @@ public:
     int get_position(const std::string&) const override { return 0; }
     double get_cash() const override { return 0.0; }
     void record_equity(long long, const std::map<std::string, double>&) override {}
+    void record_equity(long long) override {}
 };
 
 TEST(HoldingsSnapshotTest, EmptyOK) {
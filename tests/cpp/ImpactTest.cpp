@@ -13,7 +13,7 @@ protected:
 // 6-C.1: Simple Fill Test
 TEST_F(ImpactTest, SimpleFill) {
     // Add one level with 500 shares at $10
-    book.enqueue_order(Order::Side::SELL, 10.0, "order1", 500);
+    book.enqueue_order(Order::Side::SELL, 10.0, 1, 500);
 
     // Fill market order for 300 shares
     auto result = book.fill_market(Order::Side::BUY, 300);
@@ -31,8 +31,8 @@ TEST_F(ImpactTest, SimpleFill) {
 // 6-C.2: Walk Depth Test
 TEST_F(ImpactTest, WalkDepth) {
     // Add two levels: 500@10, 300@9
-    book.enqueue_order(Order::Side::BUY, 10.0, "bid1", 500);
-    book.enqueue_order(Order::Side::BUY, 9.0, "bid2", 300);
+    book.enqueue_order(Order::Side::BUY, 10.0, 101, 500);
+    book.enqueue_order(Order::Side::BUY, 9.0, 102, 300);
 
     // Fill market SELL order for 600 shares
     auto result = book.fill_market(Order::Side::SELL, 600);
@@ -51,9 +51,9 @@ TEST_F(ImpactTest, WalkDepth) {
 // 6-C.3: VWAP Slippage Test
 TEST_F(ImpactTest, VWAPSlippage) {
     // Add multiple levels with different prices
-    book.enqueue_order(Order::Side::SELL, 10.0, "ask1", 100);
-    book.enqueue_order(Order::Side::SELL, 10.5, "ask2", 200);
-    book.enqueue_order(Order::Side::SELL, 11.0, "ask3", 300);
+    book.enqueue_order(Order::Side::SELL, 10.0, 201, 100);
+    book.enqueue_order(Order::Side::SELL, 10.5, 202, 200);
+    book.enqueue_order(Order::Side::SELL, 11.0, 203, 300);
 
     // Fill market BUY order for 400 shares
     auto result = book.fill_market(Order::Side::BUY, 400);
@@ -71,8 +71,8 @@ TEST_F(ImpactTest, VWAPSlippage) {
 // 6-C.4: Partial Fill Test
 TEST_F(ImpactTest, PartialFill) {
     // Add limited liquidity: 300@10, 200@11
-    book.enqueue_order(Order::Side::SELL, 10.0, "ask1", 300);
-    book.enqueue_order(Order::Side::SELL, 11.0, "ask2", 200);
+    book.enqueue_order(Order::Side::SELL, 10.0, 201, 300);
+    book.enqueue_order(Order::Side::SELL, 11.0, 202, 200);
 
     // Request 1000 shares but only 500 available
     auto result = book.fill_market(Order::Side::BUY, 1000);
@@ -97,7 +97,7 @@ TEST_F(ImpactTest, EmptyBook) {
 
 TEST_F(ImpactTest, ZeroQuantity) {
     // Add some liquidity
-    book.enqueue_order(Order::Side::SELL, 10.0, "ask1", 100);
+    book.enqueue_order(Order::Side::SELL, 10.0, 201, 100);
 
     // Try to fill zero quantity
     auto result = book.fill_market(Order::Side::BUY, 0);
@@ -107,7 +107,7 @@ TEST_F(ImpactTest, ZeroQuantity) {
 
 TEST_F(ImpactTest, NegativeQuantity) {
     // Add some liquidity
-    book.enqueue_order(Order::Side::SELL, 10.0, "ask1", 100);
+    book.enqueue_order(Order::Side::SELL, 10.0, 201, 100);
 
     // Try to fill negative quantity
     auto result = book.fill_market(Order::Side::BUY, -50);
@@ -117,7 +117,7 @@ TEST_F(ImpactTest, NegativeQuantity) {
 
 TEST_F(ImpactTest, ExactFill) {
     // Add exactly 500 shares
-    book.enqueue_order(Order::Side::SELL, 10.0, "ask1", 500);
+    book.enqueue_order(Order::Side::SELL, 10.0, 201, 500);
 
     // Fill exactly 500 shares
     auto result = book.fill_market(Order::Side::BUY, 500);
@@ -130,9 +130,9 @@ TEST_F(ImpactTest, ExactFill) {
 
 TEST_F(ImpactTest, MultipleLevelsExactFill) {
     // Add multiple levels
-    book.enqueue_order(Order::Side::BUY, 10.0, "bid1", 100);
-    book.enqueue_order(Order::Side::BUY, 9.5, "bid2", 200);
-    book.enqueue_order(Order::Side::BUY, 9.0, "bid3", 300);
+    book.enqueue_order(Order::Side::BUY, 10.0, 101, 100);
+    book.enqueue_order(Order::Side::BUY, 9.5, 102, 200);
+    book.enqueue_order(Order::Side::BUY, 9.0, 103, 300);
 
     // Fill exactly 600 shares (consumes all levels)
     auto result = book.fill_market(Order::Side::SELL, 600);
@@ -146,7 +146,7 @@ TEST_F(ImpactTest, MultipleLevelsExactFill) {
 
 TEST_F(ImpactTest, SingleOrderFill) {
     // Add a single order
-    book.enqueue_order(Order::Side::SELL, 10.0, "ask1", 100);
+    book.enqueue_order(Order::Side::SELL, 10.0, 201, 100);
 
     // Fill less than the order size
     auto result = book.fill_market(Order::Side::BUY, 50);
@@ -0,0 +1,153 @@
+// Tick, volume and dollar bars: built in the tick pass, routed by Bar::type.
+
+#include <gtest/gtest.h>
+#include "qse/core/Backtester.h"
+#include "qse/core/BarRouter.h"
+#include "qse/data/InformationBarBuilder.h"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+qse::Tick make_tick(long long ms, double price, qse::Volume volume) {
+    qse::Tick t{};
+    t.symbol = "INFO";
+    t.timestamp = qse::from_unix_ms(ms);
+    t.price = price;
+    t.volume = volume;
+    return t;
+}
+
+std::vector<qse::Bar> build(qse::BarType type, double threshold,
+                            const std::vector<qse::Tick>& ticks) {
+    qse::InformationBarBuilder builder(type, threshold);
+    std::vector<qse::Bar> bars;
+    for (const auto& t : ticks) {
+        if (auto b = builder.add_tick(t)) {
+            bars.push_back(*b);
+        }
+    }
+    if (auto b = builder.flush()) {
+        bars.push_back(*b);
+    }
+    return bars;
+}
+
+class RecordingStrategy : public qse::IStrategy {
+public:
+    explicit RecordingStrategy(std::vector<qse::Bar>* bars) : bars_(bars) {}
+    void on_bar(const qse::Bar& bar) override { bars_->push_back(bar); }
+
+private:
+    std::vector<qse::Bar>* bars_;
+};
+
+} // namespace
+
+TEST(InformationBarBuilderTest, TickBarsCloseEveryNTicks) {
+    std::vector<qse::Tick> ticks;
+    for (int i = 0; i < 10; ++i) {
+        ticks.push_back(make_tick(1000 * i, 10.0 + (i % 4), 5));
+    }
+    const auto bars = build(qse::BarType::Tick, 4, ticks);
+    ASSERT_EQ(bars.size(), 3u); // 4 + 4 + a flushed 2
+    EXPECT_EQ(bars[0].type, qse::BarType::Tick);
+    EXPECT_EQ(qse::to_unix_ms(bars[0].timestamp), 0LL); // first tick, not aligned
+    EXPECT_DOUBLE_EQ(bars[0].open, 10.0);
+    EXPECT_DOUBLE_EQ(bars[0].high, 13.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 13.0);
+    EXPECT_EQ(bars[0].volume, 20u);
+    EXPECT_EQ(qse::to_unix_ms(bars[1].timestamp), 4000LL);
+    EXPECT_EQ(bars[2].volume, 10u);
+}
+
+TEST(InformationBarBuilderTest, VolumeBarsCloseOnTheTickThatReachesTheThreshold) {
+    const std::vector<qse::Tick> ticks = {
+        make_tick(0, 10.0, 40), make_tick(1, 11.0, 50), make_tick(2, 9.0, 30), // 120: closes
+        make_tick(3, 12.0, 100),                                             // exactly 100
+        make_tick(4, 13.0, 10)};
+    const auto bars = build(qse::BarType::Volume, 100, ticks);
+    ASSERT_EQ(bars.size(), 3u);
+    EXPECT_EQ(bars[0].volume, 120u); // a large trade is not split
+    EXPECT_DOUBLE_EQ(bars[0].low, 9.0);
+    EXPECT_DOUBLE_EQ(bars[0].close, 9.0);
+    EXPECT_EQ(bars[1].volume, 100u);
+    EXPECT_DOUBLE_EQ(bars[1].open, 12.0);
+    EXPECT_EQ(bars[2].volume, 10u);
+}
+
+TEST(InformationBarBuilderTest, DollarBarsCountPriceTimesVolume) {
+    // $1,000 per tick at price 10 x 100, then $4,000 per tick at 40 x 100
+    std::vector<qse::Tick> ticks;
+    for (int i = 0; i < 6; ++i) {
+        ticks.push_back(make_tick(i, 10.0, 100));
+    }
+    for (int i = 6; i < 9; ++i) {
+        ticks.push_back(make_tick(i, 40.0, 100));
+    }
+    const auto bars = build(qse::BarType::Dollar, 3000.0, ticks);
+    // 3 cheap ticks, 3 cheap ticks, then one bar per expensive tick
+    ASSERT_EQ(bars.size(), 5u);
+    EXPECT_EQ(bars[0].volume, 300u);
+    EXPECT_EQ(bars[1].volume, 300u);
+    EXPECT_EQ(bars[2].volume, 100u);
+    EXPECT_EQ(bars[4].type, qse::BarType::Dollar);
+}
+
+TEST(InformationBarBuilderTest, RejectsTimeBarsAndNonPositiveThresholds) {
+    EXPECT_THROW(qse::InformationBarBuilder(qse::BarType::Time, 60), std::invalid_argument);
+    EXPECT_THROW(qse::InformationBarBuilder(qse::BarType::Volume, 0), std::invalid_argument);
+    EXPECT_THROW(qse::InformationBarBuilder(qse::BarType::Dollar, -5), std::invalid_argument);
+}
+
+TEST(InformationBarBuilderTest, RouterSeparatesBarTypes) {
+    std::vector<qse::Bar> volume, time, any;
+    RecordingStrategy volume_strategy(&volume), time_strategy(&time), any_strategy(&any);
+    qse::BarRouter router;
+    router.register_strategy("INFO", qse::BarType::Volume, &volume_strategy);
+    router.register_strategy("INFO", 60s, &time_strategy);
+    router.register_strategy("INFO", &any_strategy);
+
+    qse::Bar bar{"INFO", qse::from_unix_ms(0), 1.0, 1.0, 1.0, 1.0, 1};
+    bar.interval = 60s;
+    router.route_bar(bar);
+    bar.interval = 0s;
+    bar.type = qse::BarType::Volume;
+    router.route_bar(bar);
+    bar.type = qse::BarType::Tick;
+    router.route_bar(bar);
+
+    ASSERT_EQ(volume.size(), 1u);
+    EXPECT_EQ(volume[0].type, qse::BarType::Volume);
+    ASSERT_EQ(time.size(), 1u);
+    EXPECT_EQ(time[0].type, qse::BarType::Time);
+    EXPECT_EQ(any.size(), 3u);
+}
+
+TEST(InformationBarBuilderTest, BacktesterEmitsInformationBarsInTheSamePass) {
+    std::vector<qse::Bar> bars;
+    qse::Backtester backtester("INFO", nullptr, std::make_unique<RecordingStrategy>(&bars),
+                               nullptr, 10s);
+    backtester.add_information_bars(qse::BarType::Tick, 5);
+    backtester.add_information_bars(qse::BarType::Volume, 250);
+    EXPECT_THROW(backtester.add_information_bars(qse::BarType::Tick, 0), std::invalid_argument);
+
+    for (int i = 0; i < 40; ++i) {
+        backtester.step(make_tick(500LL * i, 1.0 + i, 50));
+    }
+    backtester.finish();
+
+    std::size_t time_bars = 0, tick_bars = 0, volume_bars = 0;
+    for (const auto& b : bars) {
+        time_bars += b.type == qse::BarType::Time;
+        tick_bars += b.type == qse::BarType::Tick;
+        volume_bars += b.type == qse::BarType::Volume;
+    }
+    EXPECT_EQ(time_bars, 2u);   // 20 s of ticks in 10 s bars
+    EXPECT_EQ(tick_bars, 8u);   // 40 ticks / 5
+    EXPECT_EQ(volume_bars, 8u); // 2,000 shares / 250
+}
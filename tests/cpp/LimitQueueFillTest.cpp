@@ -60,7 +60,7 @@ protected:
 // trade prints at its price
 TEST_F(LimitQueueFillTest, NoFillWhileQueueAhead) {
     auto om = make_om("queue_ahead");
-    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, "mm_1", 300);
+    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, kExternalOrderIdBase + 1, 300);
 
     OrderId id =
         om->submit_limit_order("AAPL", Order::Side::SELL, 100, 10.0, Order::TimeInForce::GTC);
@@ -80,7 +80,7 @@ TEST_F(LimitQueueFillTest, NoFillWhileQueueAhead) {
 // A3 done-when (b): fills once the queue ahead is exhausted
 TEST_F(LimitQueueFillTest, FillsAfterQueueAheadExhausted) {
     auto om = make_om("queue_fill");
-    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, "mm_1", 300);
+    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, kExternalOrderIdBase + 1, 300);
 
     OrderId id =
         om->submit_limit_order("AAPL", Order::Side::SELL, 100, 10.0, Order::TimeInForce::GTC);
@@ -108,7 +108,7 @@ TEST_F(LimitQueueFillTest, FillsAfterQueueAheadExhausted) {
 // A3 done-when (c): cancel removes the order from the queue
 TEST_F(LimitQueueFillTest, CancelRemovesFromQueue) {
     auto om = make_om("cancel");
-    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, "mm_1", 100);
+    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, kExternalOrderIdBase + 1, 100);
 
     OrderId id =
         om->submit_limit_order("AAPL", Order::Side::SELL, 50, 10.0, Order::TimeInForce::GTC);
@@ -153,8 +153,8 @@ TEST_F(LimitQueueFillTest, FifoAmongStrategyOrders) {
 TEST_F(LimitQueueFillTest, MarketableLimitTakesThenRests) {
     auto om = make_om("marketable");
     auto& book = om->depth_book("AAPL");
-    book.enqueue_order(Order::Side::SELL, 10.0, "mm_a", 100);
-    book.enqueue_order(Order::Side::SELL, 10.5, "mm_b", 200);
+    book.enqueue_order(Order::Side::SELL, 10.0, kExternalOrderIdBase + 1, 100);
+    book.enqueue_order(Order::Side::SELL, 10.5, kExternalOrderIdBase + 2, 200);
 
     // Buy 150 limit 10.2: takes the 100 @ 10.0, will not lift 10.5,
     // rests the remaining 50 on the bid side at 10.2
@@ -172,7 +172,7 @@ TEST_F(LimitQueueFillTest, MarketableLimitTakesThenRests) {
 // An IOC limit takes what it can and never rests
 TEST_F(LimitQueueFillTest, IocTakesAndCancelsRemainder) {
     auto om = make_om("ioc");
-    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, "mm_a", 100);
+    om->depth_book("AAPL").enqueue_order(Order::Side::SELL, 10.0, kExternalOrderIdBase + 1, 100);
 
     OrderId id =
         om->submit_limit_order("AAPL", Order::Side::BUY, 150, 10.2, Order::TimeInForce::IOC);
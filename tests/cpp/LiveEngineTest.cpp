@@ -38,6 +38,14 @@ qse::Tick tick_at(double price, int second) {
     return tick;
 }
 
+// A fill as the venue reports it: keyed by the venue's order ID
+qse::Fill venue_fill(const qse::VenueOrderId& id, qse::Volume quantity, qse::Price price) {
+    qse::Fill fill(qse::kInvalidOrderId, "TEST", quantity, price, std::chrono::system_clock::now(),
+                   "BUY");
+    fill.venue_order_id = id;
+    return fill;
+}
+
 class LiveEngineTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -91,7 +99,7 @@ TEST_F(LiveEngineTest, FillsAreRecordedLocally) {
     engine_->step();
 
     ASSERT_TRUE(fill_callback_); // engine registered its callback
-    fill_callback_(qse::Fill("live-1", "TEST", 5, 101.0, std::chrono::system_clock::now(), "BUY"));
+    fill_callback_(venue_fill("live-1", 5, 101.0));
 
     ASSERT_EQ(engine_->local_fills().size(), 1u);
     EXPECT_EQ(engine_->local_fills()[0].quantity, 5);
@@ -102,12 +110,12 @@ TEST_F(LiveEngineTest, ReconciliationMatchesWhenVenueAgrees) {
     EXPECT_CALL(exec_, submit_market_order(_, _, _)).WillOnce(Return("live-1"));
     push_path(kCrossPath);
     engine_->step();
-    fill_callback_(qse::Fill("live-1", "TEST", 5, 101.0, std::chrono::system_clock::now(), "BUY"));
+    fill_callback_(venue_fill("live-1", 5, 101.0));
 
     qse::Order venue_view;
-    venue_view.order_id = "live-1";
+    venue_view.venue_order_id = "live-1";
     venue_view.filled_quantity = 5;
-    EXPECT_CALL(exec_, get_order(qse::OrderId("live-1")))
+    EXPECT_CALL(exec_, get_order(qse::VenueOrderId("live-1")))
         .WillOnce(Return(std::optional<qse::Order>(venue_view)));
 
     auto report = engine_->reconcile();
@@ -123,9 +131,9 @@ TEST_F(LiveEngineTest, ReconciliationFlagsMissingLocalFills) {
     // Venue filled 5 but the local log never saw the fill
 
     qse::Order venue_view;
-    venue_view.order_id = "live-1";
+    venue_view.venue_order_id = "live-1";
     venue_view.filled_quantity = 5;
-    EXPECT_CALL(exec_, get_order(qse::OrderId("live-1")))
+    EXPECT_CALL(exec_, get_order(qse::VenueOrderId("live-1")))
         .WillOnce(Return(std::optional<qse::Order>(venue_view)));
 
     auto report = engine_->reconcile();
@@ -0,0 +1,214 @@
+// MultiFactorCalculator end to end: a two-symbol price CSV read with Arrow's
+// CSV reader, scored by compute_factors into a Parquet file and through
+// update_factors into a FactorStore, against FactorPanel over the same rows.
+
+#include <gtest/gtest.h>
+#include "qse/factor/FactorPanel.h"
+#include "qse/factor/FactorStore.h"
+#include "qse/factor/MultiFactorCalculator.h"
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace qse;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr int kDates = 40;
+
+// Trading day d as yyyy-mm-dd: January, then February
+std::string date_text(int d) {
+    return format_date_key(d < 31 ? 20230101 + d : 20230201 + (d - 31));
+}
+
+// AAA closes on whole numbers, which Arrow would infer as int64 if the
+// loader did not ask for float64; BBB does not
+double close_of(int symbol, int d) {
+    return symbol == 0 ? 100.0 + d % 7 : 50.0 * (1.0 + 0.01 * std::sin(d));
+}
+double pb_of(int symbol, int d) { return symbol == 0 ? 1.5 + 0.01 * d : 2.5 - 0.02 * d; }
+
+// Rows for dates [from, to), symbols interleaved within each date
+void write_prices(const std::string& path, int from, int to) {
+    std::ofstream out(path);
+    out.precision(17);
+    out << "date,symbol,close,volume,pb\n";
+    for (int d = from; d < to; ++d) {
+        for (int s = 0; s < 2; ++s) {
+            out << date_text(d) << ',' << (s == 0 ? "AAA" : "BBB") << ',' << close_of(s, d)
+                << ",1000," << pb_of(s, d) << '\n';
+        }
+    }
+}
+
+// The rows write_prices(path, 0, kDates) writes, in the same order
+FactorPanelInput all_rows() {
+    FactorPanelInput rows;
+    for (int d = 0; d < kDates; ++d) {
+        for (int s = 0; s < 2; ++s) {
+            rows.symbols.push_back(s == 0 ? "AAA" : "BBB");
+            rows.dates.push_back(parse_date_key(date_text(d)));
+            rows.close.push_back(close_of(s, d));
+            rows.pb.push_back(pb_of(s, d));
+        }
+    }
+    return rows;
+}
+
+// The calculator's windows (12-1 momentum, 20-day volatility) and the
+// weights the fixture writes
+FactorPanelSettings calculator_settings() {
+    FactorPanelSettings settings;
+    settings.momentum_lookback = 252;
+    settings.momentum_skip = 21;
+    settings.vol_window = 20;
+    settings.momentum_weight = 0.5;
+    settings.vol_weight = 0.3;
+    settings.value_weight = 0.2;
+    settings.threads = 1;
+    return settings;
+}
+
+std::shared_ptr<arrow::Table> read_parquet(const std::string& path) {
+    std::shared_ptr<arrow::io::ReadableFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(path));
+    auto reader = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
+    PARQUET_THROW_NOT_OK(reader.status());
+    std::shared_ptr<arrow::Table> table;
+    PARQUET_THROW_NOT_OK((*reader)->ReadTable(&table));
+    return table;
+}
+
+// A float64 column of a table read back, whatever its chunking
+std::vector<double> doubles(const arrow::Table& table, const std::string& name) {
+    auto column = table.GetColumnByName(name);
+    EXPECT_TRUE(column && column->type()->id() == arrow::Type::DOUBLE) << name;
+    std::vector<double> values;
+    if (!column) {
+        return values;
+    }
+    for (const auto& chunk : column->chunks()) {
+        auto array = std::static_pointer_cast<arrow::DoubleArray>(chunk);
+        values.insert(values.end(), array->raw_values(), array->raw_values() + array->length());
+    }
+    return values;
+}
+
+class MultiFactorCalculatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / "multi_factor_calculator_test";
+        fs::remove_all(dir_);
+        fs::create_directories(dir_);
+        weights_ = (dir_ / "weights.yaml").string();
+        std::ofstream(weights_) << "momentum: 0.5\nvol: 0.3\nvalue: 0.2\n";
+    }
+    void TearDown() override { fs::remove_all(dir_); }
+
+    std::string path(const std::string& name) const { return (dir_ / name).string(); }
+
+    fs::path dir_;
+    std::string weights_;
+};
+
+} // namespace
+
+TEST_F(MultiFactorCalculatorTest, ComputeFactorsWritesThePanelScores) {
+    write_prices(path("prices.csv"), 0, kDates);
+    MultiFactorCalculator calculator;
+    calculator.set_num_threads(1);
+    calculator.compute_factors(path("prices.csv"), path("factors.parquet"), weights_);
+
+    const FactorPanelInput rows = all_rows();
+    const FactorPanelOutput expected = FactorPanel(calculator_settings()).compute(rows);
+    auto table = read_parquet(path("factors.parquet"));
+    ASSERT_EQ(table->num_rows(), 2 * kDates);
+    // The input columns, then the four scores in the input's row order
+    const std::vector<std::string> names = {"date", "symbol", "close", "volume", "pb",
+                                            "mom_z", "vol20_z", "val_z", "alpha"};
+    EXPECT_EQ(table->schema()->field_names(), names);
+    EXPECT_EQ(doubles(*table, "close"), rows.close);
+    EXPECT_EQ(doubles(*table, "mom_z"), expected.mom_z);
+    EXPECT_EQ(doubles(*table, "vol20_z"), expected.vol_z);
+    EXPECT_EQ(doubles(*table, "val_z"), expected.val_z);
+    EXPECT_EQ(doubles(*table, "alpha"), expected.alpha);
+}
+
+TEST_F(MultiFactorCalculatorTest, ComputeFactorsScoresASingleSeries) {
+    {
+        std::ofstream out(path("single.csv"));
+        out << "date,close,pb\n";
+        for (int d = 0; d < kDates; ++d) {
+            out << date_text(d) << ',' << 100 + d % 5 << ",1.5\n";
+        }
+    }
+    MultiFactorCalculator calculator;
+    calculator.compute_factors(path("single.csv"), path("single.parquet"), weights_);
+
+    auto table = read_parquet(path("single.parquet"));
+    EXPECT_EQ(table->num_rows(), kDates);
+    EXPECT_EQ(table->num_columns(), 7);
+    EXPECT_EQ(doubles(*table, "alpha").size(), static_cast<std::size_t>(kDates));
+}
+
+TEST_F(MultiFactorCalculatorTest, UpdateFactorsScoresATwoSymbolCsv) {
+    MultiFactorCalculator calculator;
+    calculator.set_num_threads(1);
+
+    // The full history builds the state; the second file repeats two dates
+    // already ingested, which are skipped
+    write_prices(path("history.csv"), 0, 35);
+    calculator.update_factors(path("history.csv"), path("factors.state"), path("store"), weights_);
+    ASSERT_TRUE(fs::exists(path("factors.state")));
+    write_prices(path("today.csv"), 33, kDates);
+    calculator.update_factors(path("today.csv"), path("factors.state"), path("store"), weights_);
+
+    const FactorPanelInput history = all_rows();
+    const FactorPanelOutput expected = FactorPanel(calculator_settings()).compute(history);
+
+    auto table = FactorStore(path("store")).read(FactorQuery{});
+    ASSERT_EQ(table->num_rows(), 2 * kDates);
+    auto date =
+        std::static_pointer_cast<arrow::StringArray>(table->GetColumnByName("date")->chunk(0));
+    auto symbol =
+        std::static_pointer_cast<arrow::StringArray>(table->GetColumnByName("symbol")->chunk(0));
+    auto close =
+        std::static_pointer_cast<arrow::DoubleArray>(table->GetColumnByName("close")->chunk(0));
+    auto alpha =
+        std::static_pointer_cast<arrow::DoubleArray>(table->GetColumnByName("alpha")->chunk(0));
+    std::map<std::pair<std::string, std::string>, std::pair<double, double>> stored;
+    for (int64_t i = 0; i < table->num_rows(); ++i) {
+        stored[{date->GetString(i), symbol->GetString(i)}] = {close->Value(i), alpha->Value(i)};
+    }
+    ASSERT_EQ(stored.size(), history.symbols.size());
+    for (std::size_t i = 0; i < history.symbols.size(); ++i) {
+        const auto it = stored.find({format_date_key(history.dates[i]), history.symbols[i]});
+        ASSERT_NE(it, stored.end());
+        EXPECT_EQ(it->second.first, history.close[i]);
+        EXPECT_DOUBLE_EQ(it->second.second, expected.alpha[i]);
+    }
+}
+
+TEST_F(MultiFactorCalculatorTest, UpdateFactorsRejectsASingleSymbolCsv) {
+    std::ofstream(path("single.csv")) << "date,close,pb\n2023-01-02,100,1.5\n";
+    MultiFactorCalculator calculator;
+    EXPECT_THROW(calculator.update_factors(path("single.csv"), path("factors.state"),
+                                           path("store"), weights_),
+                 std::runtime_error);
+    EXPECT_THROW(calculator.update_factors(path("missing.csv"), path("factors.state"),
+                                           path("store"), weights_),
+                 std::runtime_error);
+}
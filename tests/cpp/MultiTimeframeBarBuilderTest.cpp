@@ -0,0 +1,174 @@
+// MultiTimeframeBarBuilder: every interval from one tick pass, coarse bars
+// rolled up from fine ones; BarRouter routing by (symbol, interval).
+
+#include <gtest/gtest.h>
+#include "qse/core/Backtester.h"
+#include "qse/core/BarRouter.h"
+#include "qse/data/BarBuilder.h"
+#include "qse/data/MultiTimeframeBarBuilder.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+qse::Tick make_tick(long long ms, double price, qse::Volume volume = 10) {
+    qse::Tick t{};
+    t.symbol = "MTF";
+    t.timestamp = qse::from_unix_ms(ms);
+    t.price = price;
+    t.volume = volume;
+    return t;
+}
+
+// Bars a single-interval BarBuilder produces from the same ticks
+std::vector<qse::Bar> single_interval(const std::vector<qse::Tick>& ticks,
+                                      std::chrono::seconds interval) {
+    qse::BarBuilder builder(interval);
+    std::vector<qse::Bar> bars;
+    for (const auto& t : ticks) {
+        if (auto b = builder.add_tick(t)) {
+            bars.push_back(*b);
+        }
+    }
+    while (auto b = builder.flush()) {
+        bars.push_back(*b);
+    }
+    return bars;
+}
+
+std::vector<qse::Bar> with_interval(const std::vector<qse::Bar>& bars,
+                                    std::chrono::seconds interval) {
+    std::vector<qse::Bar> out;
+    for (const auto& b : bars) {
+        if (b.interval == interval) {
+            out.push_back(b);
+        }
+    }
+    return out;
+}
+
+class RecordingStrategy : public qse::IStrategy {
+public:
+    explicit RecordingStrategy(std::vector<qse::Bar>* bars) : bars_(bars) {}
+    void on_bar(const qse::Bar& bar) override { bars_->push_back(bar); }
+
+private:
+    std::vector<qse::Bar>* bars_;
+};
+
+} // namespace
+
+TEST(MultiTimeframeBarBuilderTest, RollUpsMatchBuildingEachIntervalFromTicks) {
+    // ~25 minutes of ticks every 700 ms with a 3-minute hole in the middle
+    std::vector<qse::Tick> ticks;
+    for (int i = 0; i < 2200; ++i) {
+        if (i >= 900 && i < 1160) {
+            continue;
+        }
+        ticks.push_back(make_tick(700LL * i, 100.0 + (i * 37 % 101) * 0.01, 1 + i % 7));
+    }
+
+    const std::vector<std::chrono::seconds> intervals = {1s, 60s, 300s, 900s};
+    qse::MultiTimeframeBarBuilder builder(intervals);
+    std::vector<qse::Bar> out;
+    for (const auto& t : ticks) {
+        builder.add_tick(t, out);
+    }
+    builder.flush(out);
+
+    for (auto interval : intervals) {
+        const auto expected = single_interval(ticks, interval);
+        const auto got = with_interval(out, interval);
+        ASSERT_EQ(got.size(), expected.size()) << interval.count() << "s";
+        for (std::size_t i = 0; i < got.size(); ++i) {
+            EXPECT_EQ(got[i].timestamp, expected[i].timestamp);
+            EXPECT_DOUBLE_EQ(got[i].open, expected[i].open);
+            EXPECT_DOUBLE_EQ(got[i].high, expected[i].high);
+            EXPECT_DOUBLE_EQ(got[i].low, expected[i].low);
+            EXPECT_DOUBLE_EQ(got[i].close, expected[i].close);
+            EXPECT_EQ(got[i].volume, expected[i].volume);
+            EXPECT_EQ(got[i].symbol, "MTF");
+        }
+    }
+}
+
+TEST(MultiTimeframeBarBuilderTest, CoarseBarCompletesWithItsLastFineBar) {
+    qse::MultiTimeframeBarBuilder builder({1s, 2s, 4s});
+    std::vector<qse::Bar> out;
+    for (int s = 0; s < 4; ++s) {
+        builder.add_tick(make_tick(1000LL * s + 500, 1.0 + s), out);
+    }
+    // 1 s bars [0,1), [1,2), [2,3); the 2 s bar [0,2) ends with [1,2)
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(out[0].interval, 1s);
+    EXPECT_EQ(out[1].interval, 1s);
+    EXPECT_EQ(out[2].interval, 2s); // right after the 1 s bar that ends it
+    EXPECT_EQ(out[3].interval, 1s);
+
+    out.clear();
+    builder.add_tick(make_tick(4500, 9.0), out);
+    // [3,4) completes [2,4), which completes [0,4): finest first
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[0].interval, 1s);
+    EXPECT_EQ(out[1].interval, 2s);
+    EXPECT_EQ(out[2].interval, 4s);
+    EXPECT_DOUBLE_EQ(out[2].open, 1.0);
+    EXPECT_DOUBLE_EQ(out[2].high, 4.0);
+    EXPECT_DOUBLE_EQ(out[2].close, 4.0);
+    EXPECT_EQ(out[2].volume, 40u);
+
+    out.clear();
+    EXPECT_EQ(builder.flush(out), 3u); // the partial [4,5), [4,6), [4,8)
+    EXPECT_EQ(builder.flush(out), 0u);
+}
+
+TEST(MultiTimeframeBarBuilderTest, RejectsIntervalsThatDoNotNest) {
+    using Intervals = std::vector<std::chrono::seconds>;
+    EXPECT_THROW(qse::MultiTimeframeBarBuilder(Intervals{}), std::invalid_argument);
+    EXPECT_THROW(qse::MultiTimeframeBarBuilder(Intervals{60s, 90s}), std::invalid_argument);
+    EXPECT_THROW(qse::MultiTimeframeBarBuilder(Intervals{60s, 60s}), std::invalid_argument);
+    EXPECT_THROW(qse::MultiTimeframeBarBuilder(Intervals{300s, 60s}), std::invalid_argument);
+    EXPECT_NO_THROW(qse::MultiTimeframeBarBuilder(Intervals{1s, 60s, 300s, 86400s}));
+}
+
+TEST(BarRouterTest, RoutesBySymbolAndInterval) {
+    std::vector<qse::Bar> minute, any;
+    RecordingStrategy minute_strategy(&minute), any_strategy(&any);
+    qse::BarRouter router;
+    router.register_strategy("MTF", 60s, &minute_strategy);
+    router.register_strategy("MTF", 60s, &minute_strategy); // ignored
+    router.register_strategy("MTF", &any_strategy);
+
+    qse::Bar bar{"MTF", qse::from_unix_ms(0), 1.0, 1.0, 1.0, 1.0, 1};
+    for (auto interval : {1s, 60s, 300s}) {
+        bar.interval = interval;
+        router.route_bar(bar);
+    }
+    bar.symbol = "OTHER";
+    router.route_bar(bar);
+
+    ASSERT_EQ(minute.size(), 1u);
+    EXPECT_EQ(minute[0].interval, 60s);
+    EXPECT_EQ(any.size(), 3u);
+}
+
+TEST(MultiTimeframeBarBuilderTest, BacktesterDeliversEveryInterval) {
+    std::vector<qse::Bar> bars;
+    qse::Backtester backtester("MTF", nullptr, std::make_unique<RecordingStrategy>(&bars),
+                               nullptr);
+    backtester.set_bar_intervals({1s, 10s});
+    EXPECT_THROW(backtester.set_bar_intervals({10s, 15s}), std::invalid_argument);
+
+    for (int i = 0; i < 40; ++i) {
+        backtester.step(make_tick(500LL * i, 1.0 + i));
+    }
+    backtester.finish();
+    EXPECT_EQ(with_interval(bars, 1s).size(), 20u);
+    EXPECT_EQ(with_interval(bars, 10s).size(), 2u);
+    EXPECT_EQ(bars.size(), 22u);
+}
@@ -0,0 +1,117 @@
+// OrderManager's per-symbol order index: limit orders match in price
+// priority, and attempt_fills() only revisits symbols that changed.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "qse/core/Config.h"
+#include "qse/data/OrderBook.h"
+#include "qse/order/OrderManager.h"
+
+using namespace qse;
+
+namespace {
+
+Tick quote(const std::string& symbol, Price bid, Volume bid_size, Price ask, Volume ask_size) {
+    Tick tick{};
+    tick.symbol = symbol;
+    tick.timestamp = from_unix_ms(1000);
+    tick.bid = bid;
+    tick.bid_size = bid_size;
+    tick.ask = ask;
+    tick.ask_size = ask_size;
+    tick.price = 0.5 * (bid + ask);
+    return tick;
+}
+
+} // namespace
+
+class OrderIndexTest : public ::testing::Test {
+protected:
+    // Empty paths: no output files
+    Config config_;
+    OrderBook book_;
+    OrderManager om_{config_, book_, "", ""};
+};
+
+TEST_F(OrderIndexTest, BetterLimitTakesScarceLiquidityFirst) {
+    OrderId low = om_.submit_limit_order("AAPL", Order::Side::BUY, 100, 100.5,
+                                         Order::TimeInForce::GTC);
+    OrderId high = om_.submit_limit_order("AAPL", Order::Side::BUY, 100, 101.0,
+                                          Order::TimeInForce::GTC);
+
+    // Only 100 shares offered: the higher bid is first in line, even though
+    // it arrived later
+    om_.process_tick(quote("AAPL", 99.0, 100, 100.0, 100));
+    EXPECT_EQ(om_.get_order(high)->status, Order::Status::FILLED);
+    EXPECT_EQ(om_.get_order(low)->filled_quantity, 0);
+    EXPECT_EQ(om_.get_position("AAPL"), 100);
+}
+
+TEST_F(OrderIndexTest, EqualLimitsFillInArrivalOrder) {
+    OrderId first = om_.submit_limit_order("AAPL", Order::Side::SELL, 50, 99.0,
+                                           Order::TimeInForce::GTC);
+    OrderId second = om_.submit_limit_order("AAPL", Order::Side::SELL, 50, 99.0,
+                                            Order::TimeInForce::GTC);
+
+    om_.process_tick(quote("AAPL", 99.5, 50, 100.0, 100));
+    EXPECT_EQ(om_.get_order(first)->status, Order::Status::FILLED);
+    EXPECT_EQ(om_.get_order(second)->filled_quantity, 0);
+}
+
+TEST_F(OrderIndexTest, MarketOrdersAreNotBlockedByRestingLimits) {
+    om_.submit_limit_order("AAPL", Order::Side::BUY, 100, 90.0, Order::TimeInForce::GTC);
+    om_.process_tick(quote("AAPL", 99.0, 500, 100.0, 500));
+
+    OrderId market = om_.submit_market_order("AAPL", Order::Side::BUY, 200);
+    om_.attempt_fills();
+    EXPECT_EQ(om_.get_order(market)->status, Order::Status::FILLED);
+    EXPECT_EQ(om_.get_active_orders("AAPL").size(), 1u);
+}
+
+TEST_F(OrderIndexTest, OnlyChangedSymbolsAreRematched) {
+    OrderId id = om_.submit_limit_order("AAPL", Order::Side::BUY, 100, 100.0,
+                                        Order::TimeInForce::GTC);
+    om_.process_tick(quote("AAPL", 100.5, 100, 101.0, 100));
+    om_.attempt_fills();
+    EXPECT_EQ(om_.get_order(id)->filled_quantity, 0);
+
+    // A quote written straight into the shared book is not a tick the
+    // manager saw: the symbol stays clean until something touches it
+    book_.on_tick(quote("AAPL", 99.0, 100, 99.5, 100));
+    om_.attempt_fills();
+    EXPECT_EQ(om_.get_order(id)->filled_quantity, 0);
+
+    // A new order on the symbol marks it for the next pass
+    om_.submit_limit_order("AAPL", Order::Side::SELL, 10, 120.0, Order::TimeInForce::GTC);
+    om_.attempt_fills();
+    EXPECT_EQ(om_.get_order(id)->status, Order::Status::FILLED);
+}
+
+TEST_F(OrderIndexTest, ActiveOrdersKeepSubmissionOrderAndDropCancels) {
+    OrderId a = om_.submit_limit_order("AAPL", Order::Side::BUY, 10, 98.0,
+                                       Order::TimeInForce::GTC);
+    OrderId b = om_.submit_market_order("AAPL", Order::Side::SELL, 10);
+    OrderId c = om_.submit_limit_order("AAPL", Order::Side::BUY, 10, 99.0,
+                                       Order::TimeInForce::GTC);
+    OrderId d = om_.submit_limit_order("AAPL", Order::Side::SELL, 10, 105.0,
+                                       Order::TimeInForce::GTC);
+
+    auto active = om_.get_active_orders("AAPL");
+    ASSERT_EQ(active.size(), 4u);
+    EXPECT_EQ(active[0].order_id, a);
+    EXPECT_EQ(active[1].order_id, b);
+    EXPECT_EQ(active[2].order_id, c);
+    EXPECT_EQ(active[3].order_id, d);
+
+    EXPECT_TRUE(om_.cancel_order(c));
+    om_.process_tick(quote("AAPL", 97.0, 100, 98.5, 100));
+    // The cancelled 99.0 bid is gone; the 98.0 bid does not cross 98.5
+    EXPECT_EQ(om_.get_order(c)->filled_quantity, 0);
+    EXPECT_EQ(om_.get_order(a)->filled_quantity, 0);
+    active = om_.get_active_orders("AAPL");
+    ASSERT_EQ(active.size(), 2u);
+    EXPECT_EQ(active[0].order_id, a);
+    EXPECT_EQ(active[1].order_id, d);
+}
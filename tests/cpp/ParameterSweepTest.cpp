@@ -0,0 +1,185 @@
+// Parameter sweep: one pass over the ticks drives every configuration, and
+// each cell ends exactly where a standalone Backtester run of the same
+// configuration would.
+
+#include <gtest/gtest.h>
+#include "qse/core/Backtester.h"
+#include "qse/core/ParameterSweep.h"
+#include "qse/data/SharedTickDataReader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Buys `qty` on the first tick and sells it on the `exit_tick`-th
+class RoundTripStrategy : public qse::IStrategy {
+public:
+    RoundTripStrategy(std::shared_ptr<qse::OrderManager> om, int exit_tick, int qty)
+        : om_(std::move(om)), exit_tick_(exit_tick), qty_(qty) {}
+
+    void on_tick(const qse::Tick& tick) override {
+        ++seen_;
+        if (qty_ == 0) {
+            return;
+        }
+        if (seen_ == 1) {
+            om_->submit_market_order(tick.symbol, qse::Order::Side::BUY, qty_);
+        } else if (seen_ == exit_tick_) {
+            om_->submit_market_order(tick.symbol, qse::Order::Side::SELL, qty_);
+        }
+    }
+
+private:
+    std::shared_ptr<qse::OrderManager> om_;
+    int exit_tick_;
+    int qty_;
+    int seen_ = 0;
+};
+
+std::unique_ptr<qse::IStrategy> make_round_trip(const qse::ParameterPoint& p,
+                                                const std::shared_ptr<qse::OrderManager>& om) {
+    return std::make_unique<RoundTripStrategy>(om, static_cast<int>(p.at("exit")),
+                                               static_cast<int>(p.at("qty")));
+}
+
+// One tick a second for `n` seconds on a gently rising, wiggling price
+std::shared_ptr<const qse::TickColumns> make_series(const std::string& symbol, int n,
+                                                    long long start_ms = 1699999980000LL) {
+    auto columns = std::make_shared<qse::TickColumns>();
+    for (int i = 0; i < n; ++i) {
+        qse::Tick t{};
+        t.symbol = symbol;
+        t.timestamp = qse::from_unix_ms(start_ms + 1000LL * i);
+        t.price = 100.0 + 0.05 * i + ((i % 7) - 3) * 0.02;
+        t.bid = t.price - 0.01;
+        t.ask = t.price + 0.01;
+        t.bid_size = 1000;
+        t.ask_size = 1000;
+        t.volume = 10;
+        columns->push_back(t);
+    }
+    return columns;
+}
+
+qse::SweepSettings settings(unsigned threads) {
+    qse::SweepSettings s;
+    s.symbol = "SWEEP";
+    s.threads = threads;
+    s.block_ticks = 64; // many blocks even for a short series
+    return s;
+}
+
+} // namespace
+
+TEST(ParameterGridTest, EnumeratesCartesianProductFirstAxisSlowest) {
+    qse::ParameterGrid grid;
+    grid.add_axis("fast", {5, 10}).add_axis("slow", {20, 50, 100});
+    ASSERT_EQ(grid.size(), 6u);
+    const auto points = grid.points();
+    ASSERT_EQ(points.size(), 6u);
+    EXPECT_EQ(points[0], (qse::ParameterPoint{{"fast", 5}, {"slow", 20}}));
+    EXPECT_EQ(points[2], (qse::ParameterPoint{{"fast", 5}, {"slow", 100}}));
+    EXPECT_EQ(points[3], (qse::ParameterPoint{{"fast", 10}, {"slow", 20}}));
+    EXPECT_EQ(qse::format_parameters(points[5]), "fast=10 slow=100");
+
+    EXPECT_THROW(grid.add_axis("fast", {1}), std::invalid_argument);
+    EXPECT_THROW(grid.add_axis("empty", {}), std::invalid_argument);
+}
+
+TEST(ParameterSweepTest, CellsMatchStandaloneBacktests) {
+    const auto series = make_series("SWEEP", 900);
+    qse::ParameterGrid grid;
+    grid.add_axis("exit", {50, 300, 800}).add_axis("qty", {0, 10, 40});
+
+    for (unsigned threads : {1u, 3u}) {
+        qse::ParameterSweep sweep(settings(threads), make_round_trip);
+        sweep.add_source(series);
+        const auto results = sweep.run(grid);
+        EXPECT_EQ(sweep.ticks_processed(), 900u);
+        ASSERT_EQ(results.size(), grid.size());
+
+        const auto points = grid.points();
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            auto om = std::make_shared<qse::OrderManager>(100000.0, "", "");
+            qse::Backtester reference("SWEEP", std::make_unique<qse::SharedTickDataReader>(series),
+                                      make_round_trip(points[i], om), om);
+            reference.run();
+            const auto& expected = om->run_summary();
+
+            const auto& r = results[i];
+            ASSERT_TRUE(r.ok) << r.error;
+            EXPECT_EQ(r.params, points[i]);
+            EXPECT_DOUBLE_EQ(r.summary.final_equity, expected.final_equity);
+            EXPECT_DOUBLE_EQ(r.summary.max_drawdown, expected.max_drawdown);
+            EXPECT_EQ(r.summary.trades, expected.trades);
+            EXPECT_EQ(r.summary.equity_points, 900u);
+        }
+    }
+}
+
+TEST(ParameterSweepTest, ReportsSharpeTurnoverAndSlippage) {
+    // Linear slippage of k * qty per share: 1e-5 * 10 = 1 bp of every fill
+    const std::string config_path = "parameter_sweep_test_config.yaml";
+    {
+        std::ofstream file(config_path);
+        file << "symbols:\n  SWEEP:\n    slippage:\n      linear_coeff: 0.00001\n"
+             << "backtester:\n  initial_cash: 100000.0\n";
+    }
+    auto config = std::make_shared<qse::Config>();
+    ASSERT_TRUE(config->load_config(config_path));
+    std::remove(config_path.c_str());
+
+    qse::SweepSettings s = settings(2);
+    s.config = config;
+    qse::ParameterSweep sweep(s, make_round_trip);
+    sweep.add_source(make_series("SWEEP", 1800)); // 30 one-minute periods
+    const auto results = sweep.run({{{"exit", 1800}, {"qty", 0}}, {{"exit", 1800}, {"qty", 10}}});
+    ASSERT_EQ(results.size(), 2u);
+
+    const auto& flat = results[0];
+    EXPECT_EQ(flat.summary.trades, 0u);
+    EXPECT_DOUBLE_EQ(flat.sharpe, 0.0);
+    EXPECT_DOUBLE_EQ(flat.turnover, 0.0);
+    EXPECT_DOUBLE_EQ(flat.slippage_bps, 0.0);
+
+    const auto& held = results[1];
+    EXPECT_EQ(held.summary.trades, 2u);
+    EXPECT_EQ(held.return_samples, 30u);
+    EXPECT_GT(held.sharpe, 0.0); // long a rising price
+    // 10 shares bought near 100 and sold near 190, on 100k
+    EXPECT_DOUBLE_EQ(held.turnover, held.summary.traded_notional / 100000.0);
+    EXPECT_GT(held.turnover, 0.02);
+    EXPECT_NEAR(held.slippage_bps, 1.0, 1e-3); // notional includes the slippage itself
+
+    std::ostringstream csv;
+    qse::ParameterSweep::write_csv(results, csv);
+    EXPECT_EQ(csv.str().substr(0, csv.str().find('\n')),
+              "exit,qty,total_return,sharpe,max_drawdown,trades,turnover,slippage_bps,ok");
+}
+
+TEST(ParameterSweepTest, MergesSourcesAndIsolatesFailingCells) {
+    auto factory = [](const qse::ParameterPoint& p, const std::shared_ptr<qse::OrderManager>& om)
+        -> std::unique_ptr<qse::IStrategy> {
+        if (p.at("qty") < 0) {
+            throw std::invalid_argument("negative size");
+        }
+        return make_round_trip(p, om);
+    };
+    qse::ParameterSweep sweep(settings(2), factory);
+    sweep.add_source(make_series("LEG_A", 200));
+    sweep.add_source(make_series("LEG_B", 200, 1699999980500LL));
+    const auto results = sweep.run({{{"exit", 10}, {"qty", 5}}, {{"exit", 10}, {"qty", -1}}});
+
+    EXPECT_EQ(sweep.ticks_processed(), 400u);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_TRUE(results[0].ok);
+    EXPECT_EQ(results[0].summary.equity_points, 400u);
+    EXPECT_FALSE(results[1].ok);
+    EXPECT_EQ(results[1].error, "negative size");
+}
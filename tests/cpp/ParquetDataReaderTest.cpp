@@ -0,0 +1,246 @@
+// Parquet tick/bar reading: row group by row group, multi-chunk columns,
+// column projection and the streaming cursor.
+
+#include <gtest/gtest.h>
+#include "qse/data/ParquetDataReader.h"
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int64_t kBaseMs = 1'700'000'000'000LL;
+
+std::shared_ptr<arrow::Array> doubles(const std::vector<double>& values,
+                                      const std::vector<bool>& valid = {}) {
+    arrow::DoubleBuilder builder;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!valid.empty() && !valid[i]) {
+            EXPECT_TRUE(builder.AppendNull().ok());
+        } else {
+            EXPECT_TRUE(builder.Append(values[i]).ok());
+        }
+    }
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+    return array;
+}
+
+std::shared_ptr<arrow::Array> int64s(const std::vector<int64_t>& values) {
+    arrow::Int64Builder builder;
+    EXPECT_TRUE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+    return array;
+}
+
+std::shared_ptr<arrow::Array> strings(const std::vector<std::string>& values) {
+    arrow::StringBuilder builder;
+    EXPECT_TRUE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    EXPECT_TRUE(builder.Finish(&array).ok());
+    return array;
+}
+
+// Splits `array` into two chunks so readers cannot assume chunk(0) is the
+// whole column
+std::shared_ptr<arrow::ChunkedArray> two_chunks(const std::shared_ptr<arrow::Array>& array) {
+    const int64_t half = array->length() / 2;
+    return std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+        array->Slice(0, half), array->Slice(half)});
+}
+
+void write_parquet(const std::string& path, const std::shared_ptr<arrow::Table>& table,
+                   int64_t row_group_size) {
+    auto sink = arrow::io::FileOutputStream::Open(path);
+    ASSERT_TRUE(sink.ok());
+    ASSERT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), *sink,
+                                           row_group_size)
+                    .ok());
+    ASSERT_TRUE((*sink)->Close().ok());
+}
+
+// Full tick schema, `n` rows 1 ms apart alternating between two symbols
+std::shared_ptr<arrow::Table> tick_table(std::size_t n) {
+    std::vector<int64_t> ts, volume, bid_size, ask_size;
+    std::vector<double> price, bid, ask;
+    std::vector<std::string> symbol;
+    for (std::size_t i = 0; i < n; ++i) {
+        ts.push_back(kBaseMs + static_cast<int64_t>(i));
+        symbol.push_back(i % 2 == 0 ? "PQ_A" : "PQ_B");
+        price.push_back(100.0 + static_cast<double>(i % 10));
+        bid.push_back(price.back() - 0.5);
+        ask.push_back(price.back() + 0.5);
+        volume.push_back(static_cast<int64_t>(10 + i % 5));
+        bid_size.push_back(static_cast<int64_t>(100 + i % 7));
+        ask_size.push_back(static_cast<int64_t>(200 + i % 3));
+    }
+    auto schema = arrow::schema({arrow::field("timestamp", arrow::int64()),
+                                 arrow::field("symbol", arrow::utf8()),
+                                 arrow::field("price", arrow::float64()),
+                                 arrow::field("volume", arrow::int64()),
+                                 arrow::field("bid", arrow::float64()),
+                                 arrow::field("ask", arrow::float64()),
+                                 arrow::field("bid_size", arrow::int64()),
+                                 arrow::field("ask_size", arrow::int64())});
+    return arrow::Table::Make(
+        schema, {two_chunks(int64s(ts)), two_chunks(strings(symbol)), two_chunks(doubles(price)),
+                 two_chunks(int64s(volume)), two_chunks(doubles(bid)), two_chunks(doubles(ask)),
+                 two_chunks(int64s(bid_size)), two_chunks(int64s(ask_size))});
+}
+
+class ParquetDataReaderTest : public ::testing::Test {
+protected:
+    std::string path_;
+
+    void TearDown() override {
+        if (!path_.empty()) {
+            std::remove(path_.c_str());
+        }
+    }
+};
+
+} // namespace
+
+TEST_F(ParquetDataReaderTest, ReadsTicksAcrossRowGroupsAndChunks) {
+    path_ = "pq_ticks.parquet";
+    write_parquet(path_, tick_table(10), 3);
+    qse::ParquetDataReader reader(path_);
+
+    EXPECT_EQ(reader.row_group_count(), 4);
+    EXPECT_TRUE(reader.read_all_bars().empty());
+    const auto& ticks = reader.read_all_ticks();
+    ASSERT_EQ(ticks.size(), 10u);
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_EQ(ticks[i].timestamp,
+                  qse::Timestamp(std::chrono::milliseconds(kBaseMs + static_cast<int64_t>(i))));
+        EXPECT_EQ(ticks[i].symbol, i % 2 == 0 ? "PQ_A" : "PQ_B");
+        EXPECT_DOUBLE_EQ(ticks[i].price, 100.0 + static_cast<double>(i % 10));
+        EXPECT_DOUBLE_EQ(ticks[i].bid, ticks[i].price - 0.5);
+        EXPECT_DOUBLE_EQ(ticks[i].ask, ticks[i].price + 0.5);
+        EXPECT_EQ(ticks[i].volume, 10 + i % 5);
+        EXPECT_EQ(ticks[i].bid_size, 100 + i % 7);
+        EXPECT_EQ(ticks[i].ask_size, 200 + i % 3);
+    }
+    EXPECT_NE(ticks[0].symbol_id, ticks[1].symbol_id);
+    EXPECT_EQ(reader.skipped_row_count(), 0u);
+}
+
+TEST_F(ParquetDataReaderTest, ProjectionFillsUnreadColumnsLikeLegacyCsv) {
+    path_ = "pq_projected.parquet";
+    write_parquet(path_, tick_table(6), 4);
+    qse::ParquetDataReader reader(path_, "PROJ", qse::ParquetDataReader::LoadMode::Eager,
+                                  qse::ParquetDataReader::kVolumeColumn);
+
+    const auto& ticks = reader.read_all_ticks();
+    ASSERT_EQ(ticks.size(), 6u);
+    for (const auto& t : ticks) {
+        EXPECT_EQ(t.symbol, "PROJ");
+        EXPECT_DOUBLE_EQ(t.bid, t.price);
+        EXPECT_DOUBLE_EQ(t.ask, t.price);
+        EXPECT_EQ(t.bid_size, t.volume);
+        EXPECT_EQ(t.ask_size, t.volume);
+    }
+}
+
+TEST_F(ParquetDataReaderTest, StreamingCursorMatchesEagerLoad) {
+    // Several cursor batches, and row groups that do not line up with them
+    path_ = "pq_stream.parquet";
+    write_parquet(path_, tick_table(3 * qse::kTickBatchSize + 17), 5000);
+    qse::ParquetDataReader eager(path_);
+    qse::ParquetDataReader streaming(path_, "", qse::ParquetDataReader::LoadMode::Streaming);
+
+    const auto& expected = eager.read_all_ticks();
+    auto cursor = streaming.open_tick_cursor();
+    std::size_t row = 0;
+    for (auto batch = cursor->next_batch(); !batch.empty(); batch = cursor->next_batch()) {
+        EXPECT_LE(batch.size, qse::kTickBatchSize);
+        for (const qse::Tick& t : batch) {
+            ASSERT_LT(row, expected.size());
+            EXPECT_EQ(t.timestamp, expected[row].timestamp);
+            EXPECT_EQ(t.symbol, expected[row].symbol);
+            EXPECT_EQ(t.symbol_id, expected[row].symbol_id);
+            EXPECT_DOUBLE_EQ(t.price, expected[row].price);
+            EXPECT_EQ(t.ask_size, expected[row].ask_size);
+            ++row;
+        }
+    }
+    EXPECT_EQ(row, expected.size());
+}
+
+TEST_F(ParquetDataReaderTest, NullRowsAreSkippedAndCounted) {
+    path_ = "pq_nulls.parquet";
+    auto schema = arrow::schema({arrow::field("timestamp", arrow::int64()),
+                                 arrow::field("price", arrow::float64())});
+    auto table = arrow::Table::Make(
+        schema, {int64s({kBaseMs, kBaseMs + 1, kBaseMs + 2}),
+                 doubles({1.0, 2.0, 3.0}, {true, false, true})});
+    write_parquet(path_, table, 2);
+    qse::ParquetDataReader reader(path_, "NULLS");
+
+    ASSERT_EQ(reader.read_all_ticks().size(), 2u);
+    EXPECT_DOUBLE_EQ(reader.read_all_ticks()[1].price, 3.0);
+    EXPECT_EQ(reader.read_all_ticks()[1].volume, 0u);
+    EXPECT_EQ(reader.skipped_row_count(), 1u);
+}
+
+TEST_F(ParquetDataReaderTest, ArrowTimestampUnitsAreHonoured) {
+    path_ = "pq_units.parquet";
+    arrow::TimestampBuilder builder(arrow::timestamp(arrow::TimeUnit::MICRO),
+                                    arrow::default_memory_pool());
+    ASSERT_TRUE(builder.Append(kBaseMs * 1000 + 250).ok());
+    std::shared_ptr<arrow::Array> ts;
+    ASSERT_TRUE(builder.Finish(&ts).ok());
+    auto schema = arrow::schema({arrow::field("timestamp", ts->type()),
+                                 arrow::field("price", arrow::float64())});
+    write_parquet(path_, arrow::Table::Make(schema, {ts, doubles({1.0})}), 16);
+    qse::ParquetDataReader reader(path_, "UNITS");
+
+    ASSERT_EQ(reader.read_all_ticks().size(), 1u);
+    EXPECT_EQ(reader.read_all_ticks()[0].timestamp,
+              qse::Timestamp(std::chrono::duration_cast<qse::Timestamp::duration>(
+                  std::chrono::microseconds(kBaseMs * 1000 + 250))));
+}
+
+TEST_F(ParquetDataReaderTest, ReadsMultiChunkBarFiles) {
+    path_ = "pq_bars.parquet";
+    auto schema = arrow::schema(
+        {arrow::field("timestamp", arrow::int64()), arrow::field("open", arrow::float64()),
+         arrow::field("high", arrow::float64()), arrow::field("low", arrow::float64()),
+         arrow::field("close", arrow::float64()), arrow::field("volume", arrow::int64()),
+         arrow::field("symbol", arrow::utf8())});
+    auto table = arrow::Table::Make(
+        schema, {two_chunks(int64s({1000, 1060, 1120, 1180})),
+                 two_chunks(doubles({10, 11, 12, 13})), two_chunks(doubles({11, 12, 13, 14})),
+                 two_chunks(doubles({9, 10, 11, 12})),
+                 two_chunks(doubles({10.5, 11.5, 12.5, 13.5})),
+                 two_chunks(int64s({100, 110, 120, 130})),
+                 two_chunks(strings({"BAR_X", "BAR_X", "BAR_X", "BAR_X"}))});
+    write_parquet(path_, table, 3);
+    qse::ParquetDataReader reader(path_);
+
+    const auto& bars = reader.read_all_bars();
+    ASSERT_EQ(bars.size(), 4u);
+    EXPECT_EQ(bars[3].timestamp, qse::Timestamp(std::chrono::seconds(1180)));
+    EXPECT_DOUBLE_EQ(bars[3].close, 13.5);
+    EXPECT_EQ(bars[3].volume, 130u);
+    EXPECT_EQ(bars[3].symbol, "BAR_X");
+    EXPECT_NE(bars[3].symbol_id, qse::kInvalidSymbolId);
+    EXPECT_TRUE(reader.read_all_ticks().empty());
+}
+
+TEST_F(ParquetDataReaderTest, RejectsFilesWithoutTickOrBarColumns) {
+    path_ = "pq_neither.parquet";
+    auto schema = arrow::schema({arrow::field("timestamp", arrow::int64())});
+    write_parquet(path_, arrow::Table::Make(schema, {int64s({1, 2})}), 16);
+    EXPECT_THROW(qse::ParquetDataReader reader(path_), std::runtime_error);
+    EXPECT_THROW(qse::ParquetDataReader reader("no/such/file.parquet"), std::runtime_error);
+}
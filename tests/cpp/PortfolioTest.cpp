@@ -0,0 +1,109 @@
+// Portfolio: O(1) mark-to-market by replacing one symbol's contribution,
+// checked against the full recompute, and OrderManager's use of it.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "qse/data/SymbolTable.h"
+#include "qse/order/OrderManager.h"
+#include "qse/order/Portfolio.h"
+
+using namespace qse;
+
+TEST(PortfolioTest, MarksAndTradesMoveCashAndHoldings) {
+    Portfolio p(10000.0);
+    p.trade(0, 100, 50.0); // unmarked symbol: valued at zero
+    EXPECT_DOUBLE_EQ(p.cash(), 5000.0);
+    EXPECT_DOUBLE_EQ(p.holdings_value(), 0.0);
+
+    p.mark(0, 52.0);
+    EXPECT_DOUBLE_EQ(p.holdings_value(), 5200.0);
+    EXPECT_DOUBLE_EQ(p.equity(), 10200.0);
+
+    p.trade(3, -20, 10.0); // short another symbol
+    p.mark(3, 11.0);
+    EXPECT_EQ(p.position(3), -20);
+    EXPECT_EQ(p.position(1), 0);
+    EXPECT_DOUBLE_EQ(p.cash(), 5200.0);
+    EXPECT_DOUBLE_EQ(p.equity(), 5200.0 + 5200.0 - 220.0);
+
+    p.trade(0, -100, 53.0); // flat again: that symbol contributes nothing
+    EXPECT_DOUBLE_EQ(p.holdings_value(), -220.0);
+    EXPECT_DOUBLE_EQ(p.recompute_holdings_value(), -220.0);
+
+    std::vector<SymbolId> held;
+    p.for_each_position([&](SymbolId id, int64_t) { held.push_back(id); });
+    EXPECT_EQ(held, std::vector<SymbolId>{3});
+}
+
+TEST(PortfolioTest, SingleSymbolStaysBitIdenticalToPositionTimesPrice) {
+    Portfolio p(0.0);
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> price(90.0, 110.0);
+    std::uniform_int_distribution<int> qty(-500, 500);
+    int64_t position = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const double px = price(rng);
+        p.mark(0, px);
+        if (i % 7 == 0) {
+            const int q = qty(rng);
+            p.trade(0, q, px);
+            position += q;
+        }
+        ASSERT_EQ(p.holdings_value(), static_cast<double>(position) * px);
+    }
+}
+
+TEST(PortfolioTest, ManySymbolsTrackTheFullRecompute) {
+    Portfolio p(1e6);
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<SymbolId> symbol(0, 499);
+    std::uniform_real_distribution<double> price(1.0, 1000.0);
+    std::uniform_int_distribution<int> qty(-100, 100);
+    for (int i = 0; i < 200000; ++i) {
+        const SymbolId id = symbol(rng);
+        p.mark(id, price(rng));
+        if (i % 5 == 0) {
+            p.trade(id, qty(rng), p.last_price(id));
+        }
+    }
+    const double full = p.recompute_holdings_value();
+    EXPECT_NEAR(p.holdings_value(), full, 1e-9 * std::abs(full));
+    p.resync();
+    EXPECT_EQ(p.holdings_value(), full);
+}
+
+TEST(PortfolioTest, OrderManagerMarksPositionsFromItsTicks) {
+    OrderManager om(100000.0, "", "");
+    om.execute_buy("PFT_A", 100, 50.0);
+    om.execute_sell("PFT_B", 10, 200.0);
+
+    Tick tick{};
+    tick.symbol = "PFT_A";
+    tick.timestamp = from_unix_ms(1000);
+    tick.price = 55.0;
+    om.process_tick(tick);
+    tick.symbol = "PFT_B";
+    tick.price = 190.0;
+    om.process_tick(tick);
+
+    om.record_equity(1000);
+    // 100000 - 5000 + 2000 in cash, +5500 long, -1900 short
+    EXPECT_DOUBLE_EQ(om.run_summary().final_equity, 100600.0);
+
+    // The map overload marks the given prices first
+    om.record_equity(2000, std::map<std::string, double>{{"PFT_A", 60.0}});
+    EXPECT_DOUBLE_EQ(om.run_summary().final_equity, 101100.0);
+
+    EXPECT_EQ(om.get_position("PFT_A"), 100);
+    EXPECT_EQ(om.get_position("PFT_B"), -10);
+    EXPECT_EQ(om.get_position("PFT_NEVER_SEEN"), 0);
+    auto positions = om.get_positions();
+    ASSERT_EQ(positions.size(), 2u);
+    EXPECT_EQ(positions[0].symbol, "PFT_A");
+    EXPECT_EQ(positions[1].symbol, "PFT_B");
+}
@@ -0,0 +1,257 @@
+// PriceLadderBook: the flat-array, integer-tick full-depth book must behave
+// exactly like OrderBookFullDepth for the operations they share.
+
+#include <gtest/gtest.h>
+#include "qse/data/OrderBookFullDepth.h"
+#include "qse/data/PriceLadderBook.h"
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using qse::LadderOrderId;
+using qse::Order;
+using qse::PriceLadderBook;
+
+TEST(PriceLadderBookTest, RejectsNonPositiveTickSize) {
+    EXPECT_THROW(PriceLadderBook(0.0), std::invalid_argument);
+    EXPECT_THROW(PriceLadderBook(-0.01), std::invalid_argument);
+}
+
+TEST(PriceLadderBookTest, ConsumesLevelInFifoOrderWithPartialHead) {
+    PriceLadderBook book;
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 100.00, 1, 100));
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 100.00, 2, 50));
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 100.00, 3, 75));
+    EXPECT_EQ(book.level_size(Order::Side::BUY, 100.00), 225u);
+    EXPECT_EQ(book.queue_position(3), 3u);
+
+    auto consumed = book.consume_at_price(Order::Side::BUY, 100.00, 120);
+    ASSERT_EQ(consumed.size(), 2u);
+    EXPECT_EQ(consumed[0], (std::pair<LadderOrderId, qse::Volume>{1, 100}));
+    EXPECT_EQ(consumed[1], (std::pair<LadderOrderId, qse::Volume>{2, 20}));
+    // The partially consumed order keeps the head
+    EXPECT_EQ(book.queue_position(2), 1u);
+    EXPECT_EQ(book.queue_position(3), 2u);
+    EXPECT_EQ(book.queue_position(1), 0u);
+    EXPECT_EQ(book.level_size(Order::Side::BUY, 100.00), 105u);
+
+    book.consume_at_price(Order::Side::BUY, 100.00, 1000);
+    EXPECT_FALSE(book.has_level(Order::Side::BUY, 100.00));
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+TEST(PriceLadderBookTest, FrontEnqueueDuplicatesAndCancel) {
+    PriceLadderBook book;
+    book.enqueue_order(Order::Side::SELL, 10.05, 7, 10);
+    EXPECT_TRUE(book.enqueue_order_front(Order::Side::SELL, 10.05, 8, 20));
+    EXPECT_FALSE(book.enqueue_order(Order::Side::SELL, 10.10, 7, 5)); // 7 is live
+    EXPECT_FALSE(book.enqueue_order_front(Order::Side::SELL, 10.05, 8, 5));
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 10.05, 8), 1u);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 10.05, 7), 2u);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.05, 7), 0u);
+    EXPECT_FALSE(book.has_level(Order::Side::SELL, 10.10));
+
+    EXPECT_TRUE(book.cancel_order(8));
+    EXPECT_FALSE(book.cancel_order(8));
+    EXPECT_EQ(book.queue_position(7), 1u);
+    // A cancelled ID can be reused
+    EXPECT_TRUE(book.enqueue_order(Order::Side::SELL, 10.05, 8, 1));
+}
+
+TEST(PriceLadderBookTest, TopOfBookFollowsTheTouchAsLevelsEmpty) {
+    PriceLadderBook book;
+    book.enqueue_order(Order::Side::BUY, 99.98, 1, 100);
+    book.enqueue_order(Order::Side::BUY, 99.99, 2, 200);
+    book.enqueue_order(Order::Side::SELL, 100.01, 3, 300);
+    book.enqueue_order(Order::Side::SELL, 100.04, 4, 400);
+
+    auto tob = book.top_of_book();
+    EXPECT_DOUBLE_EQ(tob.best_bid_price, 99.99);
+    EXPECT_EQ(tob.best_bid_size, 200u);
+    EXPECT_DOUBLE_EQ(tob.best_ask_price, 100.01);
+    EXPECT_EQ(tob.best_ask_size, 300u);
+
+    book.cancel_order(2);
+    book.cancel_order(3);
+    tob = book.top_of_book();
+    EXPECT_DOUBLE_EQ(tob.best_bid_price, 99.98);
+    EXPECT_DOUBLE_EQ(tob.best_ask_price, 100.04);
+    EXPECT_EQ(book.top_n_prices(Order::Side::SELL, 5), std::vector<qse::Price>{100.04});
+}
+
+TEST(PriceLadderBookTest, FillMarketWalksLevelsAndReportsVwap) {
+    PriceLadderBook book;
+    book.enqueue_order(Order::Side::SELL, 10.0, 1, 100);
+    book.enqueue_order(Order::Side::SELL, 10.5, 2, 200);
+    book.enqueue_order(Order::Side::SELL, 11.0, 3, 300);
+
+    auto [filled, avg] = book.fill_market(Order::Side::BUY, 250);
+    EXPECT_EQ(filled, 250u);
+    EXPECT_NEAR(avg, (100 * 10.0 + 150 * 10.5) / 250.0, 1e-9);
+    EXPECT_EQ(book.level_size(Order::Side::SELL, 10.5), 50u);
+
+    auto rest = book.fill_market(Order::Side::BUY, 10000);
+    EXPECT_EQ(rest.first, 350u);
+    EXPECT_FALSE(book.top_of_book().best_ask_price > 0.0);
+    EXPECT_EQ(book.fill_market(Order::Side::SELL, 10).first, 0u);
+    EXPECT_EQ(book.fill_market(Order::Side::BUY, -5).first, 0u);
+}
+
+TEST(PriceLadderBookTest, LadderGrowsForFarPricesAndClearKeepsWorking) {
+    PriceLadderBook book(0.01, /*levels_hint=*/4);
+    book.enqueue_order(Order::Side::BUY, 50.00, 1, 10);
+    book.enqueue_order(Order::Side::BUY, 49.00, 2, 20); // 100 ticks away
+    book.enqueue_order(Order::Side::BUY, 51.37, 3, 30);
+    EXPECT_EQ(book.level_size(Order::Side::BUY, 50.00), 10u);
+    EXPECT_EQ(book.level_size(Order::Side::BUY, 49.00), 20u);
+    EXPECT_EQ(book.top_n_prices(Order::Side::BUY, 3),
+              (std::vector<qse::Price>{51.37, 50.00, 49.00}));
+
+    book.clear();
+    EXPECT_EQ(book.order_count(), 0u);
+    EXPECT_FALSE(book.has_level(Order::Side::BUY, 50.00));
+    EXPECT_TRUE(book.enqueue_order(Order::Side::BUY, 50.00, 1, 5));
+    EXPECT_EQ(book.top_of_book().best_bid_size, 5u);
+}
+
+namespace {
+
+// Random enqueue / front-enqueue / consume / cancel / market workload with
+// prices up to `spread` ticks from the touch: every observable result must
+// match OrderBookFullDepth
+void expect_matches_full_depth(PriceLadderBook& ladder, int spread) {
+    qse::OrderBookFullDepth reference;
+    std::map<LadderOrderId, qse::QueueId> queue_ids;
+    std::map<LadderOrderId, std::pair<Order::Side, qse::Price>> placed;
+    std::vector<LadderOrderId> live;
+
+    std::mt19937_64 rng(42);
+    LadderOrderId next_id = 1;
+    auto price_of = [&](Order::Side side) {
+        const int offset = static_cast<int>(rng() % static_cast<unsigned>(spread));
+        return side == Order::Side::BUY ? (10000 - offset) / 100.0 : (10001 + offset) / 100.0;
+    };
+
+    for (int step = 0; step < 5000; ++step) {
+        const auto side = (rng() % 2) ? Order::Side::BUY : Order::Side::SELL;
+        const int op = static_cast<int>(rng() % 10);
+        if (op < 5) {
+            const LadderOrderId id = next_id++;
+            const qse::Price price = price_of(side);
+            const qse::Volume size = 1 + rng() % 100;
+            const bool front = op == 0;
+            const qse::QueueId qid =
+                front ? reference.enqueue_order_front(side, price, id, size)
+                      : reference.enqueue_order(side, price, id, size);
+            ASSERT_TRUE(front ? ladder.enqueue_order_front(side, price, id, size)
+                              : ladder.enqueue_order(side, price, id, size));
+            queue_ids[id] = qid;
+            placed[id] = {side, price};
+            live.push_back(id);
+        } else if (op < 7) {
+            const qse::Price price = price_of(side);
+            const qse::Volume quantity = 1 + rng() % 150;
+            auto expected = reference.consume_at_price(side, price, quantity);
+            auto actual = ladder.consume_at_price(side, price, quantity);
+            ASSERT_EQ(actual.size(), expected.size());
+            for (std::size_t i = 0; i < actual.size(); ++i) {
+                EXPECT_EQ(actual[i].first, expected[i].first);
+                EXPECT_EQ(actual[i].second, expected[i].second);
+            }
+        } else if (op < 9 && !live.empty()) {
+            const std::size_t pick = rng() % live.size();
+            const LadderOrderId id = live[pick];
+            live[pick] = live.back();
+            live.pop_back();
+            const bool cancelled = reference.cancel_order(queue_ids[id]);
+            // OrderBookFullDepth leaves an emptied level for the caller to drop
+            reference.remove_level_if_empty(placed[id].first, placed[id].second);
+            EXPECT_EQ(ladder.cancel_order(id), cancelled);
+        } else if (op == 9) {
+            const std::int64_t quantity = static_cast<std::int64_t>(rng() % 80);
+            auto expected = reference.fill_market(side, quantity);
+            auto actual = ladder.fill_market(side, quantity);
+            EXPECT_EQ(actual.first, expected.first);
+            EXPECT_NEAR(actual.second, expected.second, 1e-9);
+        }
+
+        const auto a = ladder.top_of_book();
+        const auto b = reference.top_of_book();
+        ASSERT_NEAR(a.best_bid_price, b.best_bid_price, 1e-9) << "step " << step;
+        ASSERT_EQ(a.best_bid_size, b.best_bid_size) << "step " << step;
+        ASSERT_NEAR(a.best_ask_price, b.best_ask_price, 1e-9) << "step " << step;
+        ASSERT_EQ(a.best_ask_size, b.best_ask_size) << "step " << step;
+        if (step % 50 == 0) {
+            for (const auto s : {Order::Side::BUY, Order::Side::SELL}) {
+                const auto expected = reference.top_n_prices(s, 8);
+                const auto actual = ladder.top_n_prices(s, 8);
+                ASSERT_EQ(actual.size(), expected.size()) << "step " << step;
+                for (std::size_t i = 0; i < actual.size(); ++i) {
+                    EXPECT_NEAR(actual[i], expected[i], 1e-9) << "step " << step;
+                }
+            }
+            for (const auto& [id, qid] : queue_ids) {
+                EXPECT_EQ(ladder.queue_position(id), reference.queue_position(qid)) << id;
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(PriceLadderBookTest, MatchesOrderBookFullDepthOnRandomWorkload) {
+    PriceLadderBook ladder(0.01, 8);
+    expect_matches_full_depth(ladder, 12);
+}
+
+TEST(PriceLadderBookTest, MatchesOrderBookFullDepthWithSparseLevels) {
+    // A 16-slot cap on prices up to 60 ticks apart: levels keep moving
+    // between the ring and the sparse map
+    PriceLadderBook ladder(0.01, 4, 1024, /*max_levels=*/16);
+    expect_matches_full_depth(ladder, 60);
+}
+
+TEST(PriceLadderBookTest, FatFingerPriceDoesNotGrowTheLadder) {
+    // On a 1e-8 grid these orders are 1e14 ticks apart; a dense ladder over
+    // that range would need petabytes
+    PriceLadderBook book(1e-8);
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 100.00, 1, 10));
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 99.99, 2, 20));
+    ASSERT_TRUE(book.enqueue_order(Order::Side::SELL, 100.01, 3, 30));
+    ASSERT_TRUE(book.enqueue_order(Order::Side::SELL, 1000000.0, 4, 5)); // fat finger
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 0.01, 5, 7));       // and a stub bid
+
+    auto tob = book.top_of_book();
+    EXPECT_DOUBLE_EQ(tob.best_bid_price, 100.00);
+    EXPECT_DOUBLE_EQ(tob.best_ask_price, 100.01);
+    EXPECT_EQ(book.level_size(Order::Side::SELL, 1000000.0), 5u);
+    EXPECT_EQ(book.top_n_prices(Order::Side::BUY, 5),
+              (std::vector<qse::Price>{100.00, 99.99, 0.01}));
+    EXPECT_EQ(book.top_n_prices(Order::Side::SELL, 5),
+              (std::vector<qse::Price>{100.01, 1000000.0}));
+
+    // A market buy walks from the touch into the outlier level
+    auto [filled, avg] = book.fill_market(Order::Side::BUY, 32);
+    EXPECT_EQ(filled, 32u);
+    EXPECT_NEAR(avg, (30 * 100.01 + 2 * 1000000.0) / 32, 1e-6);
+    EXPECT_EQ(book.top_of_book().best_ask_size, 3u);
+
+    // With the touch gone, the outlier is the best price on its side
+    EXPECT_TRUE(book.cancel_order(1));
+    EXPECT_TRUE(book.cancel_order(2));
+    EXPECT_DOUBLE_EQ(book.top_of_book().best_bid_price, 0.01);
+    auto consumed = book.consume_at_price(Order::Side::BUY, 0.01, 100);
+    ASSERT_EQ(consumed.size(), 1u);
+    EXPECT_EQ(consumed[0], (std::pair<LadderOrderId, qse::Volume>{5, 7}));
+    EXPECT_FALSE(book.has_level(Order::Side::BUY, 0.01));
+
+    // Orders placed back near the touch use the ring again
+    ASSERT_TRUE(book.enqueue_order(Order::Side::BUY, 100.00, 6, 1));
+    EXPECT_DOUBLE_EQ(book.top_of_book().best_bid_price, 100.00);
+    book.clear();
+    EXPECT_EQ(book.order_count(), 0u);
+    EXPECT_FALSE(book.has_level(Order::Side::SELL, 1000000.0));
+}
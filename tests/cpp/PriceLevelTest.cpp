@@ -93,39 +93,39 @@ TEST_F(PriceLevelTest, EnqueueDequeue) {
     book.add_level(Order::Side::BUY, 100.0);
 
     // Enqueue orders
-    book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    book.enqueue_order(Order::Side::BUY, 100.0, "order2", 200);
-    book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
+    book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    book.enqueue_order(Order::Side::BUY, 100.0, 2, 200);
+    book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
 
     // Check queue positions
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 1); // Head
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order2"), 2);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 3); // Tail
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 1); // Head
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 2), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 3); // Tail
 
     // Dequeue head
     OrderId dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "order1");
+    EXPECT_EQ(dequeued, 1);
 
     // Check new queue positions
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 0); // Not found
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order2"), 1); // New head
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 0); // Not found
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 2), 1); // New head
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 2);
 
     // Dequeue more
-    EXPECT_EQ(book.dequeue_head(Order::Side::BUY, 100.0), "order2");
-    EXPECT_EQ(book.dequeue_head(Order::Side::BUY, 100.0), "order3");
+    EXPECT_EQ(book.dequeue_head(Order::Side::BUY, 100.0), 2);
+    EXPECT_EQ(book.dequeue_head(Order::Side::BUY, 100.0), 3);
 
     // Queue should be empty now
-    EXPECT_EQ(book.dequeue_head(Order::Side::BUY, 100.0), "");
+    EXPECT_EQ(book.dequeue_head(Order::Side::BUY, 100.0), kInvalidOrderId);
 }
 
 // Additional test for top_of_book functionality
 TEST_F(PriceLevelTest, TopOfBook) {
     // Add levels with orders
-    book.enqueue_order(Order::Side::BUY, 100.0, "bid1", 100);
-    book.enqueue_order(Order::Side::BUY, 99.0, "bid2", 200);
-    book.enqueue_order(Order::Side::SELL, 101.0, "ask1", 150);
-    book.enqueue_order(Order::Side::SELL, 102.0, "ask2", 250);
+    book.enqueue_order(Order::Side::BUY, 100.0, 101, 100);
+    book.enqueue_order(Order::Side::BUY, 99.0, 102, 200);
+    book.enqueue_order(Order::Side::SELL, 101.0, 201, 150);
+    book.enqueue_order(Order::Side::SELL, 102.0, 202, 250);
 
     TopOfBook tob = book.top_of_book();
     EXPECT_EQ(tob.best_bid_price, 100.0);
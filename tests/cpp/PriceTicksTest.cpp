@@ -0,0 +1,155 @@
+// Fixed-point prices: TickScale conversion, tick-keyed levels in
+// OrderBookFullDepth, per-symbol tick sizes from Config, and OrderManager's
+// limit checks in ticks.
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "qse/core/Config.h"
+#include "qse/data/OrderBookFullDepth.h"
+#include "qse/data/PriceTicks.h"
+#include "qse/order/OrderManager.h"
+
+using namespace qse;
+
+TEST(PriceTicksTest, ScaleRoundTripsDecimalPrices) {
+    TickScale cents(0.01);
+    EXPECT_EQ(cents.to_ticks(51.37), 5137);
+    EXPECT_EQ(cents.to_price(5137), 51.37);
+    EXPECT_EQ(cents.to_ticks(51.374), 5137); // nearest tick
+    EXPECT_EQ(cents.to_ticks(51.376), 5138);
+    EXPECT_EQ(cents.round(-0.004), 0.0);
+
+    // The default grid leaves 8-decimal prices unchanged
+    TickScale fine;
+    for (double price : {100.1, 0.00000001, 51.37, 4123.12345678, 99999.99}) {
+        EXPECT_EQ(fine.round(price), price);
+    }
+    EXPECT_EQ(fine.to_ticks(100.1), fine.to_ticks(100.10000000001));
+
+    EXPECT_THROW(TickScale(0.0), std::invalid_argument);
+    EXPECT_THROW(TickScale(-0.01), std::invalid_argument);
+    EXPECT_THROW(TickScale(std::numeric_limits<double>::infinity()), std::invalid_argument);
+}
+
+TEST(PriceTicksTest, FloorAndCeilKeepOnGridPrices) {
+    TickScale cents(0.01);
+    EXPECT_EQ(cents.floor_ticks(10.005), 1000);
+    EXPECT_EQ(cents.ceil_ticks(10.005), 1001);
+    EXPECT_EQ(cents.floor_ticks(-0.005), -1);
+    EXPECT_EQ(cents.ceil_ticks(-0.005), 0);
+
+    // 10.03 * 100 is 1002.9999999999999 and 0.07 * 100 is 7.000000000000001:
+    // both are still their own tick either way
+    ASSERT_LT(10.03 * 100.0, 1003.0);
+    ASSERT_GT(0.07 * 100.0, 7.0);
+    EXPECT_EQ(cents.floor_ticks(10.03), 1003);
+    EXPECT_EQ(cents.ceil_ticks(10.03), 1003);
+    EXPECT_EQ(cents.floor_ticks(0.07), 7);
+    EXPECT_EQ(cents.ceil_ticks(0.07), 7);
+    const double computed = 100.0 + 0.7 - 0.6;
+    EXPECT_EQ(cents.floor_ticks(computed), 10010);
+    EXPECT_EQ(cents.ceil_ticks(computed), 10010);
+
+    TickScale fine;
+    for (double price : {100.1, 51.37, 4123.12345678, 99999.99}) {
+        EXPECT_EQ(fine.floor_ticks(price), fine.to_ticks(price));
+        EXPECT_EQ(fine.ceil_ticks(price), fine.to_ticks(price));
+    }
+}
+
+TEST(PriceTicksTest, NoisyPricesShareOneLevel) {
+    OrderBookFullDepth book;
+    const double computed = 100.0 + 0.7 - 0.6; // 100.10000000000001
+    ASSERT_NE(computed, 100.1);
+
+    book.enqueue_order(Order::Side::BUY, 100.1, 1, 10);
+    book.enqueue_order(Order::Side::BUY, computed, 2, 20);
+    book.enqueue_order(Order::Side::BUY, 100.10000000001, 3, 30);
+
+    EXPECT_EQ(book.top_n_prices(Order::Side::BUY, 10), std::vector<Price>{100.1});
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, computed, 3), 3u);
+    TopOfBook tob = book.top_of_book();
+    EXPECT_EQ(tob.best_bid_price, 100.1);
+    EXPECT_EQ(tob.best_bid_size, 60);
+
+    auto consumed = book.consume_at_price(Order::Side::BUY, 100.1, 60);
+    ASSERT_EQ(consumed.size(), 3u);
+    EXPECT_FALSE(book.has_level(Order::Side::BUY, computed));
+}
+
+TEST(PriceTicksTest, BookSnapsPricesToItsTickSize) {
+    OrderBookFullDepth book(TickScale(0.05));
+    EXPECT_EQ(book.tick_scale().tick_size(), 0.05);
+
+    book.enqueue_order(Order::Side::SELL, 10.02, 1, 100); // -> 10.00
+    book.enqueue_order(Order::Side::SELL, 10.03, 2, 100); // -> 10.05
+    book.enqueue_order(Order::Side::SELL, 10.04, 3, 100); // -> 10.05
+
+    EXPECT_EQ(book.top_n_prices(Order::Side::SELL, 10), (std::vector<Price>{10.0, 10.05}));
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 10.05, 3), 2u);
+
+    // 100 at 10.00 and 50 at 10.05
+    auto [filled, vwap] = book.fill_market(Order::Side::BUY, 150);
+    EXPECT_EQ(filled, 150);
+    EXPECT_DOUBLE_EQ(vwap, (100 * 10.0 + 50 * 10.05) / 150.0);
+}
+
+TEST(PriceTicksTest, ConfigTickSizesPerSymbolWithDefault) {
+    const std::string path = "price_ticks_test_config.yaml";
+    {
+        std::ofstream out(path);
+        out << "symbols:\n"
+               "  PTK_A:\n"
+               "    tick_size: 0.05\n"
+               "  PTK_B:\n"
+               "    tick_size: -1\n"
+               "backtester:\n"
+               "  tick_size: 0.01\n";
+    }
+    Config config;
+    ASSERT_TRUE(config.load_config(path));
+    std::remove(path.c_str());
+
+    EXPECT_EQ(config.get_tick_size("PTK_A"), 0.05);
+    EXPECT_EQ(config.get_tick_size("PTK_B"), 0.01); // invalid: falls back
+    EXPECT_EQ(config.get_tick_size("PTK_OTHER"), 0.01);
+    EXPECT_EQ(Config().get_tick_size("PTK_A"), kDefaultPriceResolution);
+}
+
+TEST(PriceTicksTest, OrderManagerRoundsLimitsAndComparesTicks) {
+    const std::string path = "price_ticks_om_config.yaml";
+    {
+        std::ofstream out(path);
+        out << "symbols:\n"
+               "  PTK_C:\n"
+               "    tick_size: 0.01\n";
+    }
+    Config config;
+    ASSERT_TRUE(config.load_config(path));
+    std::remove(path.c_str());
+
+    OrderManager om(config, "", "");
+    OrderId rounded =
+        om.submit_limit_order("PTK_C", Order::Side::BUY, 10, 100.004, Order::TimeInForce::GTC);
+    EXPECT_EQ(om.get_order(rounded)->limit_price, 100.0);
+
+    // An ask a rounding error above the limit still reaches it
+    OrderId noisy =
+        om.submit_limit_order("PTK_D", Order::Side::BUY, 10, 100.1, Order::TimeInForce::GTC);
+    Tick tick{};
+    tick.symbol = "PTK_D";
+    tick.timestamp = from_unix_ms(1000);
+    tick.bid = 100.0;
+    tick.ask = 100.0 + 0.7 - 0.6;
+    tick.price = 100.05;
+    tick.volume = 10;
+    om.process_tick(tick);
+    EXPECT_TRUE(om.get_order(noisy)->is_filled());
+    EXPECT_EQ(om.get_order(noisy)->avg_fill_price, 100.1);
+}
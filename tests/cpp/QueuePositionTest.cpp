@@ -49,9 +49,9 @@ TEST_F(QueuePositionTest, QueueIdUniqueness) {
 
 // 6-B.2: Enqueue Order Tests
 TEST_F(QueuePositionTest, EnqueueOrder) {
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order2", 200);
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 2, 200);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
 
     EXPECT_GT(id1, 0);
     EXPECT_GT(id2, 0);
@@ -61,9 +61,9 @@ TEST_F(QueuePositionTest, EnqueueOrder) {
     EXPECT_NE(id1, id3);
 
     // Check positions are correct
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order2"), 2);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 3);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 2), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 3);
 
     // Check QueueId-based position lookup
     EXPECT_EQ(book.queue_position(id1), 1);
@@ -72,43 +72,43 @@ TEST_F(QueuePositionTest, EnqueueOrder) {
 }
 
 TEST_F(QueuePositionTest, EnqueueOrderBothSides) {
-    QueueId bid_id1 = book.enqueue_order(Order::Side::BUY, 100.0, "bid1", 100);
-    QueueId bid_id2 = book.enqueue_order(Order::Side::BUY, 100.0, "bid2", 200);
-    QueueId ask_id1 = book.enqueue_order(Order::Side::SELL, 101.0, "ask1", 150);
-    QueueId ask_id2 = book.enqueue_order(Order::Side::SELL, 101.0, "ask2", 250);
+    QueueId bid_id1 = book.enqueue_order(Order::Side::BUY, 100.0, 101, 100);
+    QueueId bid_id2 = book.enqueue_order(Order::Side::BUY, 100.0, 102, 200);
+    QueueId ask_id1 = book.enqueue_order(Order::Side::SELL, 101.0, 201, 150);
+    QueueId ask_id2 = book.enqueue_order(Order::Side::SELL, 101.0, 202, 250);
 
     // Check bid positions
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "bid1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "bid2"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 101), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 102), 2);
     EXPECT_EQ(book.queue_position(bid_id1), 1);
     EXPECT_EQ(book.queue_position(bid_id2), 2);
 
     // Check ask positions
-    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, "ask1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, "ask2"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, 201), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, 202), 2);
     EXPECT_EQ(book.queue_position(ask_id1), 1);
     EXPECT_EQ(book.queue_position(ask_id2), 2);
 
     // Cross-check: bids don't affect asks and vice versa
-    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, "bid1"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "ask1"), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, 101), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 201), 0);
 }
 
 TEST_F(QueuePositionTest, EnqueueOrderMultiplePrices) {
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 99.0, "order2", 200);
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
-    QueueId id4 = book.enqueue_order(Order::Side::BUY, 99.0, "order4", 400);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 99.0, 2, 200);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
+    QueueId id4 = book.enqueue_order(Order::Side::BUY, 99.0, 4, 400);
 
     // Check positions at 100.0
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 2);
     EXPECT_EQ(book.queue_position(id1), 1);
     EXPECT_EQ(book.queue_position(id3), 2);
 
     // Check positions at 99.0
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 99.0, "order2"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 99.0, "order4"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 99.0, 2), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 99.0, 4), 2);
     EXPECT_EQ(book.queue_position(id2), 1);
     EXPECT_EQ(book.queue_position(id4), 2);
 }
@@ -119,35 +119,35 @@ TEST_F(QueuePositionTest, LookupUnknown) {
     EXPECT_EQ(book.queue_position(999999), 0);
 
     // Test with non-existent OrderId
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "nonexistent"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::SELL, 100.0, "nonexistent"), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 999), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 100.0, 999), 0);
 
     // Test with non-existent price level
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 999.0, "any"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::SELL, 999.0, "any"), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 999.0, 999), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 999.0, 999), 0);
 }
 
 TEST_F(QueuePositionTest, PositionLookupPerformance) {
     // Add many orders to test O(1) lookup performance
     std::vector<QueueId> ids;
     for (int i = 0; i < 1000; ++i) {
-        std::string order_id = "order" + std::to_string(i);
+        const OrderId order_id = i + 1;
         ids.push_back(book.enqueue_order(Order::Side::BUY, 100.0, order_id, 100));
     }
 
     // Test position lookups
     for (size_t i = 0; i < ids.size(); ++i) {
         EXPECT_EQ(book.queue_position(ids[i]), i + 1);
-        std::string order_id = "order" + std::to_string(i);
+        const OrderId order_id = i + 1;
         EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, order_id), i + 1);
     }
 }
 
 // 6-B.4: Position Updates on Dequeue/Cancel Tests
 TEST_F(QueuePositionTest, AfterDequeue) {
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order2", 200);
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 2, 200);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
 
     // Verify initial positions
     EXPECT_EQ(book.queue_position(id1), 1);
@@ -156,7 +156,7 @@ TEST_F(QueuePositionTest, AfterDequeue) {
 
     // Dequeue head
     OrderId dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "order1");
+    EXPECT_EQ(dequeued, 1);
 
     // Check updated positions
     EXPECT_EQ(book.queue_position(id1), 0); // Removed
@@ -164,15 +164,15 @@ TEST_F(QueuePositionTest, AfterDequeue) {
     EXPECT_EQ(book.queue_position(id3), 2); // Moved up
 
     // Check OrderId-based lookup
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order2"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 2), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 2);
 }
 
 TEST_F(QueuePositionTest, AfterCancel) {
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order2", 200);
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 2, 200);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
 
     // Cancel middle order
     bool cancelled = book.cancel_order(id2);
@@ -184,9 +184,9 @@ TEST_F(QueuePositionTest, AfterCancel) {
     EXPECT_EQ(book.queue_position(id3), 2); // Moved up
 
     // Check OrderId-based lookup
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order2"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 2), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 2);
 }
 
 TEST_F(QueuePositionTest, CancelNonExistent) {
@@ -195,7 +195,7 @@ TEST_F(QueuePositionTest, CancelNonExistent) {
     EXPECT_FALSE(cancelled);
 
     // Add an order and then cancel it
-    QueueId id = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
+    QueueId id = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
     EXPECT_EQ(book.queue_position(id), 1);
 
     cancelled = book.cancel_order(id);
@@ -210,40 +210,40 @@ TEST_F(QueuePositionTest, CancelNonExistent) {
 TEST_F(QueuePositionTest, DequeueEmptyQueue) {
     // Try to dequeue from empty queue
     OrderId dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "");
+    EXPECT_EQ(dequeued, kInvalidOrderId);
 
     // Add and remove all orders
-    QueueId id = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
+    QueueId id = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
     EXPECT_EQ(book.queue_position(id), 1);
 
     dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "order1");
+    EXPECT_EQ(dequeued, 1);
     EXPECT_EQ(book.queue_position(id), 0);
 
     // Try to dequeue again
     dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "");
+    EXPECT_EQ(dequeued, kInvalidOrderId);
 }
 
 // 6-B.5: Cross-price isolation
 TEST_F(QueuePositionTest, MultiplePrices) {
     // Enqueue at $10
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 10.0, "orderA1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 10.0, "orderA2", 200);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 10.0, 11, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 10.0, 12, 200);
     // Enqueue at $11
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 11.0, "orderB1", 150);
-    QueueId id4 = book.enqueue_order(Order::Side::BUY, 11.0, "orderB2", 250);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 11.0, 21, 150);
+    QueueId id4 = book.enqueue_order(Order::Side::BUY, 11.0, 22, 250);
 
     // Check positions at $10
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.0, "orderA1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.0, "orderA2"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.0, 11), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.0, 12), 2);
     // Check positions at $11
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 11.0, "orderB1"), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 11.0, "orderB2"), 2);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 11.0, 21), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 11.0, 22), 2);
 
     // Cross-check: orders at $10 do not appear at $11 and vice versa
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 11.0, "orderA1"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.0, "orderB1"), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 11.0, 11), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 10.0, 21), 0);
 
     // Check that queue_position(QueueId) works and is isolated
     EXPECT_EQ(book.queue_position(id1), 1);
@@ -254,23 +254,23 @@ TEST_F(QueuePositionTest, MultiplePrices) {
 
 TEST_F(QueuePositionTest, CrossPriceOperations) {
     // Add orders at different prices
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 99.0, "order2", 200);
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 99.0, 2, 200);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
 
     // Dequeue from one price level
     OrderId dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "order1");
+    EXPECT_EQ(dequeued, 1);
 
     // Check that other price level is unaffected
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 99.0, "order2"), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 99.0, 2), 1);
 
     // Cancel from other price level
     bool cancelled = book.cancel_order(id2);
     EXPECT_TRUE(cancelled);
 
     // Check that first price level is unaffected
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order3"), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 3), 1);
 }
 
 // Edge Cases and Stress Tests
@@ -280,7 +280,7 @@ TEST_F(QueuePositionTest, LargeNumberOfOrders) {
 
     // Add many orders
     for (int i = 0; i < NUM_ORDERS; ++i) {
-        std::string order_id = "order" + std::to_string(i);
+        const OrderId order_id = i + 1;
         ids.push_back(book.enqueue_order(Order::Side::BUY, 100.0, order_id, 100));
     }
 
@@ -334,8 +334,8 @@ TEST_F(QueuePositionTest, ConcurrentQueueIdGeneration) {
 }
 
 TEST_F(QueuePositionTest, ZeroSizeOrders) {
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 0);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order2", 0);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 0);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 2, 0);
 
     EXPECT_GT(id1, 0);
     EXPECT_GT(id2, 0);
@@ -344,15 +344,15 @@ TEST_F(QueuePositionTest, ZeroSizeOrders) {
 }
 
 TEST_F(QueuePositionTest, PriceLevelRemoval) {
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order2", 200);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 2, 200);
 
     // Remove all orders from the level
     OrderId dequeued1 = book.dequeue_head(Order::Side::BUY, 100.0);
     OrderId dequeued2 = book.dequeue_head(Order::Side::BUY, 100.0);
 
-    EXPECT_EQ(dequeued1, "order1");
-    EXPECT_EQ(dequeued2, "order2");
+    EXPECT_EQ(dequeued1, 1);
+    EXPECT_EQ(dequeued2, 2);
 
     // Check positions are 0
     EXPECT_EQ(book.queue_position(id1), 0);
@@ -360,26 +360,26 @@ TEST_F(QueuePositionTest, PriceLevelRemoval) {
 
     // Try to dequeue from empty level
     OrderId dequeued3 = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued3, "");
+    EXPECT_EQ(dequeued3, kInvalidOrderId);
 }
 
 TEST_F(QueuePositionTest, MixedOperations) {
     // Add orders
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order2", 200);
-    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, "order3", 300);
-    QueueId id4 = book.enqueue_order(Order::Side::BUY, 100.0, "order4", 400);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 2, 200);
+    QueueId id3 = book.enqueue_order(Order::Side::BUY, 100.0, 3, 300);
+    QueueId id4 = book.enqueue_order(Order::Side::BUY, 100.0, 4, 400);
 
     // Dequeue head
     OrderId dequeued = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued, "order1");
+    EXPECT_EQ(dequeued, 1);
 
     // Cancel middle order
     bool cancelled = book.cancel_order(id3);
     EXPECT_TRUE(cancelled);
 
     // Add new order
-    QueueId id5 = book.enqueue_order(Order::Side::BUY, 100.0, "order5", 500);
+    QueueId id5 = book.enqueue_order(Order::Side::BUY, 100.0, 5, 500);
 
     // Check final positions
     EXPECT_EQ(book.queue_position(id1), 0); // Removed
@@ -391,14 +391,14 @@ TEST_F(QueuePositionTest, MixedOperations) {
 
 TEST_F(QueuePositionTest, BothSidesMixedOperations) {
     // Add orders to both sides
-    QueueId bid1 = book.enqueue_order(Order::Side::BUY, 100.0, "bid1", 100);
-    QueueId bid2 = book.enqueue_order(Order::Side::BUY, 100.0, "bid2", 200);
-    QueueId ask1 = book.enqueue_order(Order::Side::SELL, 101.0, "ask1", 150);
-    QueueId ask2 = book.enqueue_order(Order::Side::SELL, 101.0, "ask2", 250);
+    QueueId bid1 = book.enqueue_order(Order::Side::BUY, 100.0, 101, 100);
+    QueueId bid2 = book.enqueue_order(Order::Side::BUY, 100.0, 102, 200);
+    QueueId ask1 = book.enqueue_order(Order::Side::SELL, 101.0, 201, 150);
+    QueueId ask2 = book.enqueue_order(Order::Side::SELL, 101.0, 202, 250);
 
     // Dequeue from bids
     OrderId dequeued_bid = book.dequeue_head(Order::Side::BUY, 100.0);
-    EXPECT_EQ(dequeued_bid, "bid1");
+    EXPECT_EQ(dequeued_bid, 101);
 
     // Cancel from asks
     bool cancelled_ask = book.cancel_order(ask2);
@@ -413,19 +413,19 @@ TEST_F(QueuePositionTest, BothSidesMixedOperations) {
     EXPECT_EQ(book.queue_position(ask2), 0); // Cancelled
 
     // Cross-check: operations on one side don't affect the other
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "ask1"), 0);
-    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, "bid2"), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 201), 0);
+    EXPECT_EQ(book.queue_position(Order::Side::SELL, 101.0, 102), 0);
 }
 
 TEST_F(QueuePositionTest, DuplicateOrderIds) {
     // Attempt to enqueue duplicate OrderId at the same price level – should be rejected
-    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 100);
-    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, "order1", 200);
+    QueueId id1 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 100);
+    QueueId id2 = book.enqueue_order(Order::Side::BUY, 100.0, 1, 200);
 
     EXPECT_NE(id1, 0u);
     EXPECT_EQ(id2, 0u); // Duplicate insertion returns 0 (failure)
 
     // Position of first order remains intact
     EXPECT_EQ(book.queue_position(id1), 1);
-    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, "order1"), 1);
+    EXPECT_EQ(book.queue_position(Order::Side::BUY, 100.0, 1), 1);
 }
\ No newline at end of file
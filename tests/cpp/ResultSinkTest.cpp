@@ -0,0 +1,288 @@
+// ResultSink: block-buffered equity curve / trade log output in CSV, binary
+// and Parquet form, and OrderManager's equity downsampling on top of it.
+
+#include <gtest/gtest.h>
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "qse/core/Backtester.h"
+#include "qse/core/ResultSink.h"
+#include "qse/order/OrderManager.h"
+#include "qse/strategy/DoNothingStrategy.h"
+
+using namespace qse;
+
+namespace {
+
+std::vector<std::string> read_lines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+TradeRecord trade(int64_t ts, const std::string& symbol, bool buy, int qty, double price,
+                  double cash) {
+    return TradeRecord{ts, symbol, buy, qty, price, cash};
+}
+
+std::shared_ptr<arrow::Table> read_parquet(const std::string& path) {
+    std::shared_ptr<arrow::io::ReadableFile> infile;
+    PARQUET_ASSIGN_OR_THROW(infile, arrow::io::ReadableFile::Open(path));
+    auto reader = parquet::arrow::OpenFile(infile, arrow::default_memory_pool());
+    PARQUET_THROW_NOT_OK(reader.status());
+    std::shared_ptr<arrow::Table> table;
+#if ARROW_VERSION_MAJOR >= 24
+    PARQUET_ASSIGN_OR_THROW(table, (*reader)->ReadTable());
+#else
+    PARQUET_THROW_NOT_OK((*reader)->ReadTable(&table));
+#endif
+    return table;
+}
+
+// A column of a table read back, across its row groups. ArrayType is the
+// Arrow array the column must decode to.
+template <typename ArrayType, typename T>
+std::vector<T> column_values(const arrow::Table& table, const std::string& name) {
+    std::vector<T> values;
+    auto column = table.GetColumnByName(name);
+    EXPECT_TRUE(column && column->type()->id() == ArrayType::TypeClass::type_id) << name;
+    if (!column) {
+        return values;
+    }
+    for (const auto& chunk : column->chunks()) {
+        const auto& array = static_cast<const ArrayType&>(*chunk);
+        for (int64_t i = 0; i < array.length(); ++i) {
+            values.push_back(T(array.GetView(i)));
+        }
+    }
+    return values;
+}
+
+} // namespace
+
+class ResultSinkTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::filesystem::remove(equity_path_);
+        std::filesystem::remove(trades_path_);
+    }
+
+    const std::string equity_path_ = "result_sink_equity.out";
+    const std::string trades_path_ = "result_sink_trades.out";
+};
+
+TEST_F(ResultSinkTest, CsvMatchesLegacyStreamFormatting) {
+    {
+        ResultSink sink(equity_path_, trades_path_);
+        sink.add_equity(1000, 100000.0);
+        sink.add_equity(2000, 100012.345678);
+        sink.add_trade(trade(1500, "AAPL", true, 100, 150.25, 84975.0));
+        sink.add_trade(trade(1600, "GOOG", false, 5, 2500.5, 97477.5));
+    }
+
+    EXPECT_EQ(read_lines(equity_path_),
+              (std::vector<std::string>{"timestamp,equity", "1000,100000", "2000,100012"}));
+    EXPECT_EQ(read_lines(trades_path_),
+              (std::vector<std::string>{"timestamp,symbol,type,quantity,price,cash",
+                                        "1500,AAPL,BUY,100,150.25,84975",
+                                        "1600,GOOG,SELL,5,2500.5,97477.5"}));
+}
+
+TEST_F(ResultSinkTest, FilesAndHeadersExistBeforeAnyRecord) {
+    ResultSink sink(equity_path_, "");
+    sink.flush();
+    EXPECT_EQ(read_lines(equity_path_), std::vector<std::string>{"timestamp,equity"});
+    EXPECT_FALSE(std::filesystem::exists(trades_path_));
+}
+
+TEST_F(ResultSinkTest, FlushWritesEverythingAcrossBlocks) {
+    ResultSink::Options options;
+    options.block_records = 7; // many full blocks plus a partial one
+    options.max_pending_blocks = 2;
+    ResultSink sink(equity_path_, "", options);
+    for (int i = 0; i < 1000; ++i) {
+        sink.add_equity(i, 100.0 + i);
+    }
+    sink.flush();
+
+    auto lines = read_lines(equity_path_);
+    ASSERT_EQ(lines.size(), 1001u);
+    EXPECT_EQ(lines[1], "0,100");
+    EXPECT_EQ(lines[1000], "999,1099");
+}
+
+TEST_F(ResultSinkTest, BinaryRoundTrip) {
+    ResultSink::Options options;
+    options.format = ResultFormat::Binary;
+    options.block_records = 3;
+    std::vector<TradeRecord> trades = {trade(10, "AAPL", true, 100, 150.125, 84987.5),
+                                       trade(11, "", false, 7, 0.1, 1.0 / 3.0),
+                                       trade(12, "BRK.B", false, 1, 412.5, 85400.0),
+                                       trade(13, "MSFT", true, 2, 330.0, 84740.0)};
+    {
+        ResultSink sink(equity_path_, trades_path_, options);
+        for (int i = 0; i < 10; ++i) {
+            sink.add_equity(1000 + i, 100000.0 + 0.1 * i);
+        }
+        for (const auto& t : trades) {
+            sink.add_trade(t);
+        }
+    }
+
+    auto points = read_equity_binary(equity_path_);
+    ASSERT_EQ(points.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(points[i].timestamp, 1000 + i);
+        EXPECT_EQ(points[i].equity, 100000.0 + 0.1 * i); // bit-exact
+    }
+
+    auto read = read_trades_binary(trades_path_);
+    ASSERT_EQ(read.size(), trades.size());
+    for (std::size_t i = 0; i < trades.size(); ++i) {
+        EXPECT_EQ(read[i].timestamp, trades[i].timestamp);
+        EXPECT_EQ(read[i].symbol, trades[i].symbol);
+        EXPECT_EQ(read[i].buy, trades[i].buy);
+        EXPECT_EQ(read[i].quantity, trades[i].quantity);
+        EXPECT_EQ(read[i].price, trades[i].price);
+        EXPECT_EQ(read[i].cash, trades[i].cash);
+    }
+}
+
+TEST_F(ResultSinkTest, ParquetRoundTrip) {
+    ResultSink::Options options;
+    options.format = ResultFormat::Parquet;
+    options.block_records = 3; // one row group per block: several per file
+    std::vector<TradeRecord> trades = {trade(10, "AAPL", true, 100, 150.125, 84987.5),
+                                       trade(11, "", false, 7, 0.1, 1.0 / 3.0),
+                                       trade(12, "BRK.B", false, 1, 412.5, 85400.0),
+                                       trade(13, "MSFT", true, 2, 330.0, 84740.0)};
+    {
+        ResultSink sink(equity_path_, trades_path_, options);
+        for (int i = 0; i < 10; ++i) {
+            sink.add_equity(1000 + i, 100000.0 + 0.1 * i);
+        }
+        for (const auto& t : trades) {
+            sink.add_trade(t);
+        }
+    }
+
+    auto equity = read_parquet(equity_path_);
+    EXPECT_EQ(equity->schema()->field_names(), (std::vector<std::string>{"timestamp", "equity"}));
+    const auto timestamps = column_values<arrow::Int64Array, int64_t>(*equity, "timestamp");
+    const auto values = column_values<arrow::DoubleArray, double>(*equity, "equity");
+    ASSERT_EQ(timestamps.size(), 10u);
+    ASSERT_EQ(values.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(timestamps[i], 1000 + i);
+        EXPECT_EQ(values[i], 100000.0 + 0.1 * i); // bit-exact
+    }
+
+    auto log = read_parquet(trades_path_);
+    EXPECT_EQ(log->schema()->field_names(),
+              (std::vector<std::string>{"timestamp", "symbol", "type", "quantity", "price",
+                                        "cash"}));
+    const auto trade_times = column_values<arrow::Int64Array, int64_t>(*log, "timestamp");
+    const auto symbols = column_values<arrow::StringArray, std::string>(*log, "symbol");
+    const auto types = column_values<arrow::StringArray, std::string>(*log, "type");
+    const auto quantities = column_values<arrow::Int32Array, int>(*log, "quantity");
+    const auto prices = column_values<arrow::DoubleArray, double>(*log, "price");
+    const auto cash = column_values<arrow::DoubleArray, double>(*log, "cash");
+    ASSERT_EQ(log->num_rows(), static_cast<int64_t>(trades.size()));
+    for (std::size_t i = 0; i < trades.size(); ++i) {
+        EXPECT_EQ(trade_times[i], trades[i].timestamp);
+        EXPECT_EQ(symbols[i], trades[i].symbol);
+        EXPECT_EQ(types[i], trades[i].buy ? "BUY" : "SELL");
+        EXPECT_EQ(quantities[i], trades[i].quantity);
+        EXPECT_EQ(prices[i], trades[i].price);
+        EXPECT_EQ(cash[i], trades[i].cash);
+    }
+}
+
+TEST_F(ResultSinkTest, BinaryReaderRejectsOtherFiles) {
+    { ResultSink sink(equity_path_, ""); } // CSV
+    EXPECT_THROW(read_equity_binary(equity_path_), std::runtime_error);
+    EXPECT_THROW(read_equity_binary("no_such_result_file.bin"), std::runtime_error);
+
+    ResultSink::Options options;
+    options.format = ResultFormat::Binary;
+    { ResultSink sink(equity_path_, "", options); }
+    // An equity file is not a trade log
+    EXPECT_THROW(read_trades_binary(equity_path_), std::runtime_error);
+    EXPECT_TRUE(read_equity_binary(equity_path_).empty());
+}
+
+TEST_F(ResultSinkTest, SynchronousModeWritesOnTheCallersThread) {
+    ResultSink::Options options;
+    options.async = false;
+    options.block_records = 2;
+    ResultSink sink(equity_path_, "", options);
+    sink.add_equity(1, 1.5);
+    sink.add_equity(2, 2.5); // fills the block: written here
+    sink.flush();
+    EXPECT_EQ(read_lines(equity_path_),
+              (std::vector<std::string>{"timestamp,equity", "1,1.5", "2,2.5"}));
+}
+
+TEST_F(ResultSinkTest, RejectsBadOptionsAndPaths) {
+    ResultSink::Options options;
+    options.block_records = 0;
+    EXPECT_THROW(ResultSink(equity_path_, "", options), std::invalid_argument);
+    EXPECT_THROW(ResultSink("no_such_dir/equity.csv", ""), std::runtime_error);
+    EXPECT_THROW(parse_result_format("json"), std::invalid_argument);
+    EXPECT_EQ(parse_result_format("binary"), ResultFormat::Binary);
+}
+
+TEST_F(ResultSinkTest, OrderManagerSamplesEquityButSummarizesEveryPoint) {
+    {
+        OrderManager om(1000.0, equity_path_, "");
+        om.set_equity_sample_every(4);
+        std::map<std::string, double> prices;
+        for (int i = 0; i < 10; ++i) {
+            om.record_equity(i, prices);
+        }
+        EXPECT_EQ(om.run_summary().equity_points, 10u);
+        EXPECT_THROW(om.set_equity_sample_every(0), std::invalid_argument);
+    }
+    // Points 0, 4 and 8 by sampling, and the final point 9
+    EXPECT_EQ(read_lines(equity_path_), (std::vector<std::string>{"timestamp,equity", "0,1000",
+                                                                  "4,1000", "8,1000", "9,1000"}));
+}
+
+TEST_F(ResultSinkTest, BacktesterCanRecordEquityPerBar) {
+    {
+        auto om = std::make_shared<OrderManager>(1000.0, equity_path_, "");
+        Backtester backtester("AAPL", nullptr, std::make_unique<DoNothingStrategy>(), om,
+                              std::chrono::seconds(60));
+        backtester.set_equity_per_bar(true);
+
+        // Ticks every 20 s from 0 to 200 s: minute bars complete on the
+        // ticks at 60, 120 and 180 s, and finish() records the last tick
+        for (int i = 0; i <= 10; ++i) {
+            Tick tick{};
+            tick.symbol = "AAPL";
+            tick.timestamp = from_unix_ms(20000LL * i);
+            tick.price = 100.0;
+            tick.volume = 1;
+            ASSERT_TRUE(backtester.step(tick));
+        }
+        backtester.finish();
+        EXPECT_EQ(om->run_summary().equity_points, 4u);
+    }
+    EXPECT_EQ(read_lines(equity_path_),
+              (std::vector<std::string>{"timestamp,equity", "60000,1000", "120000,1000",
+                                        "180000,1000", "200000,1000"}));
+}
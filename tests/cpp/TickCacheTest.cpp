@@ -0,0 +1,177 @@
+// Binary tick cache: LoadMode::Cached writes <csv>.qtc on the first load,
+// reuses it while the CSV is unchanged and rebuilds it when it is not.
+
+#include <gtest/gtest.h>
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/SymbolTable.h"
+#include "qse/data/TickCache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+using Mode = qse::CSVDataReader::LoadMode;
+
+class TickCacheTest : public ::testing::Test {
+protected:
+    const std::string path_ = "tick_cache_test.csv";
+
+    void write_csv(const std::string& content) {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+        std::remove(qse::tick_cache_path(path_).c_str());
+    }
+};
+
+const char* kFullRows = "timestamp,symbol,price,volume,bid,ask,bid_size,ask_size\n"
+                        "1700000003,CACHE_B,20.5,7,20.4,20.6,100,110\n"
+                        "1700000001,CACHE_A,10.25,5,10.2,10.3,50,60\n"
+                        "1700000002,CACHE_A,bad,9,10.4,10.6,70,80\n"
+                        "1700000006,CACHE_A,10.5,9,10.4,10.6,70,80\n";
+
+} // namespace
+
+TEST_F(TickCacheTest, FirstLoadWritesCacheAndSecondLoadReadsIt) {
+    write_csv(kFullRows);
+    qse::CSVDataReader parsed(path_, "", Mode::Cached);
+    ASSERT_TRUE(std::filesystem::exists(qse::tick_cache_path(path_)));
+
+    qse::TickCacheHeader header{};
+    ASSERT_TRUE(qse::read_tick_cache_header(qse::tick_cache_path(path_), header));
+    EXPECT_EQ(header.row_count, 3u);
+    EXPECT_EQ(header.symbol_count, 2u);
+    EXPECT_EQ(header.min_timestamp, qse::Timestamp(std::chrono::seconds(1700000001))
+                                        .time_since_epoch()
+                                        .count());
+    EXPECT_EQ(header.max_timestamp, qse::Timestamp(std::chrono::seconds(1700000006))
+                                        .time_since_epoch()
+                                        .count());
+
+    // Replace the CSV's text behind the cache's back, keeping size and
+    // mtime: a reader that still parsed would see the new price
+    const auto mtime = std::filesystem::last_write_time(path_);
+    std::string changed = kFullRows;
+    changed.replace(changed.find("20.5"), 4, "99.5");
+    write_csv(changed);
+    std::filesystem::last_write_time(path_, mtime);
+
+    qse::CSVDataReader cached(path_, "", Mode::Cached);
+    const auto& a = parsed.read_all_ticks();
+    const auto& b = cached.read_all_ticks();
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a[i].timestamp, b[i].timestamp);
+        EXPECT_EQ(a[i].symbol, b[i].symbol);
+        EXPECT_EQ(a[i].symbol_id, b[i].symbol_id);
+        EXPECT_DOUBLE_EQ(a[i].price, b[i].price);
+        EXPECT_DOUBLE_EQ(a[i].ask, b[i].ask);
+        EXPECT_EQ(a[i].ask_size, b[i].ask_size);
+    }
+    EXPECT_DOUBLE_EQ(b[1].price, 20.5); // CACHE_B row, served from the cache
+    EXPECT_EQ(cached.skipped_row_count(), 1u);
+    EXPECT_EQ(cached.gap_count(), parsed.gap_count());
+}
+
+TEST_F(TickCacheTest, ChangedSourceInvalidatesCache) {
+    write_csv(kFullRows);
+    qse::CSVDataReader first(path_, "", Mode::Cached);
+    ASSERT_EQ(first.read_tick_columns().size(), 3u);
+
+    write_csv(std::string(kFullRows) + "1700000007,CACHE_B,21.0,1,20.9,21.1,10,10\n");
+    qse::CSVDataReader second(path_, "", Mode::Cached);
+    EXPECT_EQ(second.read_tick_columns().size(), 4u);
+
+    qse::TickCacheHeader header{};
+    ASSERT_TRUE(qse::read_tick_cache_header(qse::tick_cache_path(path_), header));
+    EXPECT_EQ(header.row_count, 4u); // rebuilt
+}
+
+TEST_F(TickCacheTest, CacheIsKeyedBySymbolOverride) {
+    write_csv("timestamp,price,volume\n1700000000,1.5,10\n1700000001,1.6,11\n");
+    qse::CSVDataReader first(path_, "OVR_ONE", Mode::Cached);
+    qse::CSVDataReader second(path_, "OVR_TWO", Mode::Cached);
+    EXPECT_EQ(second.read_all_ticks().front().symbol, "OVR_TWO");
+
+    qse::TickColumns columns;
+    qse::TickCacheStats stats;
+    EXPECT_TRUE(qse::load_tick_cache(path_, "OVR_TWO", columns, stats));
+    EXPECT_FALSE(qse::load_tick_cache(path_, "OVR_ONE", columns, stats));
+}
+
+TEST_F(TickCacheTest, CorruptCacheFallsBackToParsing) {
+    write_csv(kFullRows);
+    { qse::CSVDataReader first(path_, "", Mode::Cached); }
+    std::filesystem::resize_file(qse::tick_cache_path(path_),
+                                 std::filesystem::file_size(qse::tick_cache_path(path_)) - 8);
+
+    qse::TickColumns columns;
+    qse::TickCacheStats stats;
+    EXPECT_FALSE(qse::load_tick_cache(path_, "", columns, stats));
+    EXPECT_TRUE(columns.empty());
+
+    qse::CSVDataReader reader(path_, "", Mode::Cached);
+    EXPECT_EQ(reader.read_tick_columns().size(), 3u);
+    EXPECT_TRUE(qse::load_tick_cache(path_, "", columns, stats)); // rewritten
+}
+
+TEST_F(TickCacheTest, SymbolIdsAreRemappedToThisProcess) {
+    // Another ticker interned first, so CACHE_A (file-local ID 0, the first
+    // row by time) has a different process ID and the load must remap
+    qse::intern_symbol("CACHE_PAD");
+    write_csv(kFullRows);
+    qse::TickColumns original = qse::CSVDataReader(path_, "", Mode::Mapped).read_tick_columns();
+    ASSERT_NE(original.symbol_ids().front(), 0u);
+    ASSERT_TRUE(qse::write_tick_cache(path_, "", original, {}));
+
+    qse::TickColumns loaded;
+    qse::TickCacheStats stats;
+    ASSERT_TRUE(qse::load_tick_cache(path_, "", loaded, stats));
+    EXPECT_EQ(loaded.symbol_ids(), original.symbol_ids());
+    EXPECT_EQ(loaded.timestamps(), original.timestamps());
+    EXPECT_EQ(loaded.prices(), original.prices());
+}
+
+TEST_F(TickCacheTest, UnreadableCacheIsTreatedAsMissing) {
+    write_csv(kFullRows);
+    // Exists, but cannot be mapped
+    std::filesystem::create_directory(qse::tick_cache_path(path_));
+
+    EXPECT_EQ(qse::map_tick_cache(path_, ""), nullptr);
+    qse::TickColumns columns;
+    qse::TickCacheStats stats;
+    EXPECT_FALSE(qse::load_tick_cache(path_, "", columns, stats));
+}
+
+TEST_F(TickCacheTest, OutOfRangeSymbolIdIsRejected) {
+    write_csv(kFullRows);
+    { qse::CSVDataReader first(path_, "", Mode::Cached); }
+    const std::string cache_path = qse::tick_cache_path(path_);
+    qse::TickCacheHeader header{};
+    ASSERT_TRUE(qse::read_tick_cache_header(cache_path, header));
+    ASSERT_NE(qse::map_tick_cache(path_, ""), nullptr);
+
+    // The symbol ID column follows the timestamps; point its last row past
+    // the file's two symbols. The CSV is untouched, so the cache is not stale.
+    const auto align8 = [](std::uint64_t n) { return (n + 7) / 8 * 8; };
+    const std::uint64_t ids_at =
+        sizeof(header) + align8(header.strings_bytes) + align8(header.row_count * 8);
+    {
+        std::fstream file(cache_path, std::ios::binary | std::ios::in | std::ios::out);
+        const qse::SymbolId bad = header.symbol_count;
+        file.seekp(static_cast<std::streamoff>(ids_at + (header.row_count - 1) * sizeof(bad)));
+        file.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+    }
+
+    EXPECT_EQ(qse::map_tick_cache(path_, ""), nullptr);
+    qse::TickColumns columns;
+    qse::TickCacheStats stats;
+    EXPECT_FALSE(qse::load_tick_cache(path_, "", columns, stats));
+}
@@ -0,0 +1,195 @@
+// Columnar tick store and symbol interning: readers load ticks into
+// struct-of-arrays columns keyed by dense SymbolIds, and the hot path (order
+// book, backtester per-symbol state) indexes by ID instead of ticker string.
+
+#include <gtest/gtest.h>
+#include "qse/core/Backtester.h"
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/OrderBook.h"
+#include "qse/data/SymbolTable.h"
+#include "qse/data/TickColumns.h"
+#include "qse/strategy/IStrategy.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+qse::Tick make_tick(const std::string& symbol, long long ms, double price) {
+    qse::Tick t{};
+    t.symbol = symbol;
+    t.timestamp = qse::from_unix_ms(ms);
+    t.price = price;
+    t.bid = price - 0.01;
+    t.ask = price + 0.01;
+    t.bid_size = 100;
+    t.ask_size = 200;
+    t.volume = 10;
+    return t;
+}
+
+class BarCollector : public qse::IStrategy {
+public:
+    explicit BarCollector(std::vector<qse::Bar>* bars) : bars_(bars) {}
+    void on_tick(const qse::Tick&) override {}
+    void on_bar(const qse::Bar& bar) override { bars_->push_back(bar); }
+
+private:
+    std::vector<qse::Bar>* bars_;
+};
+
+} // namespace
+
+TEST(SymbolTableTest, InternIsIdempotentAndNamesRoundTrip) {
+    auto& table = qse::SymbolTable::instance();
+    const qse::SymbolId a = table.intern("SYMTAB_A");
+    const qse::SymbolId b = table.intern("SYMTAB_B");
+
+    EXPECT_NE(a, b);
+    EXPECT_EQ(table.intern("SYMTAB_A"), a);
+    EXPECT_EQ(table.find("SYMTAB_B"), b);
+    EXPECT_EQ(table.name(a), "SYMTAB_A");
+    EXPECT_EQ(table.find("SYMTAB_NEVER_SEEN"), qse::kInvalidSymbolId);
+    EXPECT_THROW(table.name(qse::kInvalidSymbolId), std::out_of_range);
+}
+
+TEST(SymbolTableTest, ResolveFallsBackToInterningTheTicker) {
+    qse::Tick tick = make_tick("SYMTAB_RESOLVE", 0, 1.0);
+    ASSERT_EQ(tick.symbol_id, qse::kInvalidSymbolId);
+    const qse::SymbolId id = qse::resolve_symbol_id(tick);
+    EXPECT_EQ(id, qse::SymbolTable::instance().find("SYMTAB_RESOLVE"));
+}
+
+TEST(TickColumnsTest, RoundTripsTicksThroughColumns) {
+    std::vector<qse::Tick> ticks = {make_tick("COL_A", 1000, 10.0),
+                                    make_tick("COL_B", 2000, 20.0)};
+    qse::TickColumns columns = qse::TickColumns::from_ticks(ticks);
+
+    ASSERT_EQ(columns.size(), 2u);
+    EXPECT_EQ(columns.symbol_ids()[0], qse::SymbolTable::instance().find("COL_A"));
+
+    std::vector<qse::Tick> back = columns.to_ticks();
+    ASSERT_EQ(back.size(), 2u);
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        EXPECT_EQ(back[i].symbol, ticks[i].symbol);
+        EXPECT_EQ(back[i].timestamp, ticks[i].timestamp);
+        EXPECT_DOUBLE_EQ(back[i].price, ticks[i].price);
+        EXPECT_DOUBLE_EQ(back[i].bid, ticks[i].bid);
+        EXPECT_DOUBLE_EQ(back[i].ask, ticks[i].ask);
+        EXPECT_EQ(back[i].bid_size, ticks[i].bid_size);
+        EXPECT_EQ(back[i].ask_size, ticks[i].ask_size);
+        EXPECT_EQ(back[i].volume, ticks[i].volume);
+    }
+}
+
+TEST(TickColumnsTest, SortByTimeKeepsRowsTogether) {
+    qse::TickColumns columns;
+    columns.push_back(make_tick("COL_A", 3000, 3.0));
+    columns.push_back(make_tick("COL_B", 1000, 1.0));
+    columns.push_back(make_tick("COL_A", 2000, 2.0));
+    ASSERT_FALSE(columns.is_time_sorted());
+
+    columns.sort_by_time();
+
+    ASSERT_TRUE(columns.is_time_sorted());
+    EXPECT_EQ(columns.tick_at(0).symbol, "COL_B");
+    EXPECT_DOUBLE_EQ(columns.tick_at(0).price, 1.0);
+    EXPECT_DOUBLE_EQ(columns.tick_at(1).price, 2.0);
+    EXPECT_DOUBLE_EQ(columns.tick_at(2).price, 3.0);
+}
+
+TEST(TickColumnsTest, ColumnarCursorReplaysInBatches) {
+    qse::TickColumns columns;
+    const std::size_t rows = qse::kTickBatchSize + 3;
+    for (std::size_t i = 0; i < rows; ++i) {
+        columns.push_back(make_tick(i % 2 ? "COL_A" : "COL_B", static_cast<long long>(i),
+                                    static_cast<double>(i)));
+    }
+
+    qse::ColumnarTickCursor cursor(columns.view());
+    qse::TickBatch first = cursor.next_batch();
+    ASSERT_EQ(first.size, qse::kTickBatchSize);
+    EXPECT_EQ(first.data[1].symbol, "COL_A");
+    qse::TickBatch second = cursor.next_batch();
+    ASSERT_EQ(second.size, 3u);
+    // Reused slots are refreshed when the symbol differs from the last batch
+    EXPECT_EQ(second.data[0].symbol, rows % 2 ? "COL_B" : "COL_A");
+    EXPECT_DOUBLE_EQ(second.data[2].price, static_cast<double>(rows - 1));
+    EXPECT_TRUE(cursor.next_batch().empty());
+}
+
+TEST(TickColumnsTest, CSVReaderLoadsColumnsWithInternedIds) {
+    const std::string path = "columns_reader.csv";
+    {
+        std::ofstream out(path);
+        out << "timestamp,symbol,price,volume,bid,ask,bid_size,ask_size\n";
+        out << "1700000002,CSVCOL_B,2.0,5,1.9,2.1,10,11\n";
+        out << "1700000001,CSVCOL_A,1.0,5,0.9,1.1,10,11\n";
+    }
+    qse::CSVDataReader reader(path);
+
+    const qse::TickColumns& columns = reader.read_tick_columns();
+    ASSERT_EQ(columns.size(), 2u);
+    EXPECT_TRUE(columns.is_time_sorted());
+    EXPECT_EQ(columns.symbol_ids()[0], qse::SymbolTable::instance().find("CSVCOL_A"));
+
+    // Materialized ticks carry the same IDs as the columns they came from
+    const auto& ticks = reader.read_all_ticks();
+    ASSERT_EQ(ticks.size(), 2u);
+    EXPECT_EQ(ticks[0].symbol, "CSVCOL_A");
+    EXPECT_EQ(ticks[0].symbol_id, columns.symbol_ids()[0]);
+    EXPECT_EQ(ticks[1].symbol_id, columns.symbol_ids()[1]);
+    std::remove(path.c_str());
+}
+
+TEST(TickColumnsTest, OrderBookIdAndNameLookupsAgree) {
+    qse::OrderBook book;
+    qse::Tick tick = make_tick("BOOK_ID", 0, 50.0);
+    book.on_tick(tick);
+
+    const qse::SymbolId id = qse::SymbolTable::instance().find("BOOK_ID");
+    ASSERT_NE(id, qse::kInvalidSymbolId);
+    EXPECT_EQ(&book.top_of_book(id), &book.top_of_book("BOOK_ID"));
+    EXPECT_EQ(book.top_of_book(id).best_ask_size, 200u);
+
+    EXPECT_EQ(book.consume_liquidity(id, qse::Order::Side::BUY, 150), 150u);
+    EXPECT_EQ(book.consume_liquidity("BOOK_ID", qse::Order::Side::BUY, 150), 50u);
+    EXPECT_EQ(book.consume_liquidity("BOOK_UNKNOWN", qse::Order::Side::BUY, 1), 0u);
+    EXPECT_FALSE(book.top_of_book("BOOK_UNKNOWN").has_ask());
+}
+
+TEST(TickColumnsTest, BacktesterKeepsPerSymbolBarsSeparate) {
+    // Two symbols interleaved in one source: each gets its own bar builder
+    class InterleavedReader : public qse::IDataReader {
+    public:
+        InterleavedReader() {
+            for (int i = 0; i < 4; ++i) {
+                ticks_.push_back(make_tick("BT_X", 1000LL * i, 100.0 + i));
+                ticks_.push_back(make_tick("BT_Y", 1000LL * i + 1, 200.0 + i));
+            }
+        }
+        const std::vector<qse::Tick>& read_all_ticks() const override { return ticks_; }
+        const std::vector<qse::Bar>& read_all_bars() const override { return bars_; }
+
+    private:
+        std::vector<qse::Tick> ticks_;
+        std::vector<qse::Bar> bars_;
+    };
+
+    std::vector<qse::Bar> bars;
+    qse::Backtester backtester("BT_X", std::make_unique<InterleavedReader>(),
+                               std::make_unique<BarCollector>(&bars), nullptr,
+                               std::chrono::seconds(60));
+    backtester.run();
+
+    ASSERT_EQ(bars.size(), 2u);
+    for (const qse::Bar& bar : bars) {
+        const double base = bar.symbol == "BT_X" ? 100.0 : 200.0;
+        EXPECT_EQ(bar.symbol_id, qse::SymbolTable::instance().find(bar.symbol));
+        EXPECT_DOUBLE_EQ(bar.open, base);
+        EXPECT_DOUBLE_EQ(bar.close, base + 3.0);
+    }
+}
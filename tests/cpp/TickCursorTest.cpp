@@ -0,0 +1,138 @@
+// Streaming tick cursors: readers hand ticks out batch by batch so the
+// backtester can run without materializing read_all_ticks().
+
+#include <gtest/gtest.h>
+#include "qse/core/Backtester.h"
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/TickCursor.h"
+#include "qse/strategy/IStrategy.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+class CountingStrategy : public qse::IStrategy {
+public:
+    explicit CountingStrategy(std::vector<double>* prices) : prices_(prices) {}
+    void on_tick(const qse::Tick& tick) override { prices_->push_back(tick.price); }
+
+private:
+    std::vector<double>* prices_;
+};
+
+class TickCursorTest : public ::testing::Test {
+protected:
+    std::string path_;
+
+    void write_ticks(const std::string& name, std::size_t rows, bool with_bad_row = false) {
+        path_ = name;
+        std::ofstream out(path_);
+        out << "timestamp,price,volume\n";
+        for (std::size_t i = 0; i < rows; ++i) {
+            out << (1700000000 + i) << "," << (100.0 + 0.01 * static_cast<double>(i)) << ",10\n";
+            if (with_bad_row && i == rows / 2) {
+                out << "1700000000,not_a_price,10\n";
+            }
+        }
+    }
+
+    void TearDown() override {
+        if (!path_.empty()) {
+            std::remove(path_.c_str());
+        }
+    }
+};
+
+std::vector<qse::Tick> drain(qse::ITickCursor& cursor, std::size_t* batches = nullptr) {
+    std::vector<qse::Tick> out;
+    for (qse::TickBatch batch = cursor.next_batch(); !batch.empty(); batch = cursor.next_batch()) {
+        out.insert(out.end(), batch.begin(), batch.end());
+        if (batches != nullptr) {
+            ++*batches;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_F(TickCursorTest, VectorCursorHandsOutOneZeroCopyBatch) {
+    std::vector<qse::Tick> ticks(3);
+    qse::VectorTickCursor cursor(ticks);
+
+    qse::TickBatch batch = cursor.next_batch();
+    EXPECT_EQ(batch.data, ticks.data());
+    EXPECT_EQ(batch.size, 3u);
+    EXPECT_TRUE(cursor.next_batch().empty());
+}
+
+TEST_F(TickCursorTest, StreamingCursorMatchesEagerLoadAcrossBatches) {
+    const std::size_t rows = qse::kTickBatchSize * 2 + 17; // forces three batches
+    write_ticks("cursor_stream.csv", rows);
+
+    qse::CSVDataReader eager(path_, "TEST");
+    qse::CSVDataReader streaming(path_, "TEST", qse::CSVDataReader::LoadMode::Streaming);
+
+    std::size_t batches = 0;
+    auto cursor = streaming.open_tick_cursor();
+    auto streamed = drain(*cursor, &batches);
+
+    EXPECT_EQ(batches, 3u);
+    const auto& loaded = eager.read_all_ticks();
+    ASSERT_EQ(streamed.size(), loaded.size());
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        EXPECT_EQ(streamed[i].timestamp, loaded[i].timestamp);
+        EXPECT_DOUBLE_EQ(streamed[i].price, loaded[i].price);
+        EXPECT_EQ(streamed[i].symbol, "TEST");
+    }
+}
+
+TEST_F(TickCursorTest, StreamingCursorPublishesSkippedRowsAtEndOfFile) {
+    write_ticks("cursor_bad_row.csv", 10, /*with_bad_row=*/true);
+
+    qse::CSVDataReader streaming(path_, "TEST", qse::CSVDataReader::LoadMode::Streaming);
+    auto cursor = streaming.open_tick_cursor();
+    auto streamed = drain(*cursor);
+
+    EXPECT_EQ(streamed.size(), 10u);
+    EXPECT_EQ(streaming.skipped_row_count(), 1u);
+}
+
+TEST_F(TickCursorTest, StreamingReaderStillMaterializesOnDemand) {
+    write_ticks("cursor_materialize.csv", 5);
+
+    qse::CSVDataReader streaming(path_, "TEST", qse::CSVDataReader::LoadMode::Streaming);
+    EXPECT_EQ(streaming.read_all_ticks().size(), 5u);
+
+    // Once loaded, the cursor serves the resident ticks instead of re-parsing
+    auto cursor = streaming.open_tick_cursor();
+    qse::TickBatch batch = cursor->next_batch();
+    EXPECT_EQ(batch.data, streaming.read_all_ticks().data());
+}
+
+TEST_F(TickCursorTest, StreamingReaderRejectsMissingFile) {
+    EXPECT_THROW(qse::CSVDataReader("no/such/ticks.csv", "TEST",
+                                    qse::CSVDataReader::LoadMode::Streaming),
+                 std::runtime_error);
+}
+
+TEST_F(TickCursorTest, BacktesterRunsOffStreamingCursor) {
+    const std::size_t rows = qse::kTickBatchSize + 5;
+    write_ticks("cursor_backtest.csv", rows);
+
+    std::vector<double> seen;
+    qse::Backtester backtester(
+        "TEST",
+        std::make_unique<qse::CSVDataReader>(path_, "TEST",
+                                             qse::CSVDataReader::LoadMode::Streaming),
+        std::make_unique<CountingStrategy>(&seen), nullptr, std::chrono::seconds(60));
+    backtester.run();
+
+    ASSERT_EQ(seen.size(), rows);
+    EXPECT_DOUBLE_EQ(seen.front(), 100.0);
+    EXPECT_DOUBLE_EQ(seen.back(), 100.0 + 0.01 * static_cast<double>(rows - 1));
+}
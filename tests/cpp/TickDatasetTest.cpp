@@ -0,0 +1,157 @@
+// TickDataset: one immutable copy of a tick series (or none, when it is the
+// mapped tick cache) replayed by any number of readers and threads.
+
+#include <gtest/gtest.h>
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/SharedTickDataReader.h"
+#include "qse/data/TickCache.h"
+#include "qse/data/TickDataset.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class TickDatasetTest : public ::testing::Test {
+protected:
+    const std::string path_ = "tick_dataset_test.csv";
+
+    void SetUp() override {
+        std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+        file << "timestamp,symbol,price,volume,bid,ask,bid_size,ask_size\n";
+        for (int i = 0; i < 500; ++i) {
+            file << 1700000000 + i << ",DS_" << (i % 3) << ',' << 50.0 + 0.25 * i << ",10,"
+                 << 49.9 + 0.25 * i << ',' << 50.1 + 0.25 * i << ",100,100\n";
+        }
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+        std::remove(qse::tick_cache_path(path_).c_str());
+    }
+};
+
+double replay_price_sum(const qse::TickBatch& first, qse::ITickCursor& cursor) {
+    double sum = 0.0;
+    for (auto batch = first; !batch.empty(); batch = cursor.next_batch()) {
+        for (const qse::Tick& tick : batch) {
+            sum += tick.price;
+        }
+    }
+    return sum;
+}
+
+double replay_price_sum(qse::ITickCursor& cursor) {
+    return replay_price_sum(cursor.next_batch(), cursor);
+}
+
+} // namespace
+
+TEST_F(TickDatasetTest, LoadServesTheMappedCache) {
+    const auto parsed = qse::CSVDataReader(path_, "", qse::CSVDataReader::LoadMode::Eager)
+                            .read_all_ticks();
+
+    // First load parses and writes the cache, second finds it; both map it
+    for (int pass = 0; pass < 2; ++pass) {
+        const auto dataset = qse::TickDataset::load(path_);
+        ASSERT_TRUE(dataset->is_mapped());
+        ASSERT_EQ(dataset->size(), parsed.size());
+        // At most the remapped symbol-ID column lives on the heap
+        EXPECT_LE(dataset->heap_bytes(), dataset->size() * sizeof(qse::SymbolId));
+
+        qse::SharedTickDataReader reader(dataset);
+        const auto& ticks = reader.read_all_ticks();
+        ASSERT_EQ(ticks.size(), parsed.size());
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            EXPECT_EQ(ticks[i].timestamp, parsed[i].timestamp);
+            EXPECT_EQ(ticks[i].symbol, parsed[i].symbol);
+            EXPECT_DOUBLE_EQ(ticks[i].price, parsed[i].price);
+            EXPECT_DOUBLE_EQ(ticks[i].bid, parsed[i].bid);
+        }
+    }
+}
+
+TEST_F(TickDatasetTest, ReadersAndThreadsShareOneCopy) {
+    const auto dataset = qse::TickDataset::load(path_, "DS_OVERRIDE");
+    double expected = 0.0;
+    for (int i = 0; i < 500; ++i) {
+        expected += 50.0 + 0.25 * i;
+    }
+
+    // Every reader replays the same memory
+    std::vector<std::unique_ptr<qse::SharedTickDataReader>> readers;
+    for (int i = 0; i < 8; ++i) {
+        readers.push_back(std::make_unique<qse::SharedTickDataReader>(dataset));
+        EXPECT_EQ(readers.back()->dataset().view().prices, dataset->view().prices);
+    }
+    EXPECT_EQ(dataset.use_count(), 9);
+
+    std::vector<double> sums(readers.size());
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < readers.size(); ++i) {
+        threads.emplace_back([&, i] {
+            auto cursor = readers[i]->open_tick_cursor();
+            sums[i] = replay_price_sum(*cursor);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (double sum : sums) {
+        EXPECT_DOUBLE_EQ(sum, expected);
+    }
+}
+
+TEST_F(TickDatasetTest, MappingOutlivesTheCacheFile) {
+    const auto dataset = qse::TickDataset::load(path_);
+    ASSERT_TRUE(dataset->is_mapped());
+    std::remove(qse::tick_cache_path(path_).c_str());
+
+    auto cursor = dataset->open_cursor();
+    auto batch = cursor->next_batch();
+    ASSERT_FALSE(batch.empty());
+    EXPECT_DOUBLE_EQ(batch.begin()->price, 50.0);
+    EXPECT_GT(replay_price_sum(batch, *cursor), 0.0);
+}
+
+TEST_F(TickDatasetTest, CursorsOutliveTheirReader) {
+    const double expected = replay_price_sum(*qse::TickDataset::load(path_)->open_cursor());
+
+    // One cursor over the mapped columns, one over the materialized ticks;
+    // the reader (the dataset's last other owner) is gone before either runs
+    std::unique_ptr<qse::ITickCursor> mapped;
+    std::unique_ptr<qse::ITickCursor> materialized;
+    {
+        qse::SharedTickDataReader reader(qse::TickDataset::load(path_));
+        mapped = reader.open_tick_cursor();
+        reader.read_all_ticks();
+        materialized = reader.open_tick_cursor();
+    }
+    EXPECT_DOUBLE_EQ(replay_price_sum(*mapped), expected);
+    EXPECT_DOUBLE_EQ(replay_price_sum(*materialized), expected);
+}
+
+TEST(TickDatasetColumnsTest, WrapsLoadedColumnsWithoutCopying) {
+    auto columns = std::make_shared<qse::TickColumns>();
+    for (int i = 0; i < 4; ++i) {
+        qse::Tick t{};
+        t.symbol = "DS_COLUMNS";
+        t.timestamp = qse::from_unix_ms(1000 * (i + 1));
+        t.price = 1.0 + i;
+        columns->push_back(t);
+    }
+    const auto dataset = qse::TickDataset::from_columns(columns);
+    EXPECT_FALSE(dataset->is_mapped());
+    EXPECT_EQ(dataset->size(), 4u);
+    EXPECT_EQ(dataset->view().prices, columns->prices().data());
+    EXPECT_EQ(dataset->heap_bytes(), 4 * (7 * 8 + sizeof(qse::SymbolId)));
+
+    EXPECT_THROW(qse::TickDataset::from_columns(std::shared_ptr<const qse::TickColumns>()),
+                 std::invalid_argument);
+    EXPECT_THROW(qse::TickDataset::load("no_such_tick_file.csv"), std::runtime_error);
+}
@@ -0,0 +1,135 @@
+// K-way merge of per-source tick cursors: time-ordered sources interleave
+// without a global sort; an out-of-order source is sorted on its own.
+
+#include <gtest/gtest.h>
+#include "qse/data/CSVDataReader.h"
+#include "qse/data/TickMerger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+qse::Tick make_tick(const std::string& symbol, long long ms, double price) {
+    qse::Tick t{};
+    t.symbol = symbol;
+    t.timestamp = qse::from_unix_ms(ms);
+    t.price = price;
+    return t;
+}
+
+std::vector<qse::Tick> drain(qse::TickMerger& merger) {
+    std::vector<qse::Tick> out;
+    while (const qse::Tick* t = merger.next()) {
+        out.push_back(*t);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST(TickMergerTest, InterleavesSortedSourcesByTimestamp) {
+    std::vector<qse::Tick> a = {make_tick("A", 1, 1.0), make_tick("A", 4, 4.0),
+                                make_tick("A", 5, 5.0)};
+    std::vector<qse::Tick> b = {make_tick("B", 2, 2.0), make_tick("B", 3, 3.0),
+                                make_tick("B", 6, 6.0)};
+
+    qse::TickMerger merger;
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(a));
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(b));
+
+    auto merged = drain(merger);
+    ASSERT_EQ(merged.size(), 6u);
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+        EXPECT_DOUBLE_EQ(merged[i].price, static_cast<double>(i + 1));
+    }
+    EXPECT_EQ(merger.sorted_fallback_count(), 0u);
+}
+
+TEST(TickMergerTest, TiesAreBrokenBySourceOrder) {
+    std::vector<qse::Tick> a = {make_tick("A", 10, 1.0), make_tick("A", 20, 3.0)};
+    std::vector<qse::Tick> b = {make_tick("B", 10, 2.0), make_tick("B", 20, 4.0)};
+
+    qse::TickMerger merger;
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(a));
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(b));
+
+    auto merged = drain(merger);
+    ASSERT_EQ(merged.size(), 4u);
+    EXPECT_EQ(merged[0].symbol, "A");
+    EXPECT_EQ(merged[1].symbol, "B");
+    EXPECT_EQ(merged[2].symbol, "A");
+    EXPECT_EQ(merged[3].symbol, "B");
+}
+
+TEST(TickMergerTest, UnsortedSourceFallsBackToSortingOnlyThatSource) {
+    std::vector<qse::Tick> sorted = {make_tick("A", 1, 1.0), make_tick("A", 3, 3.0)};
+    std::vector<qse::Tick> shuffled = {make_tick("B", 4, 4.0), make_tick("B", 2, 2.0)};
+
+    qse::TickMerger merger;
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(sorted));
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(shuffled));
+
+    auto merged = drain(merger);
+    ASSERT_EQ(merged.size(), 4u);
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+        EXPECT_DOUBLE_EQ(merged[i].price, static_cast<double>(i + 1));
+    }
+    EXPECT_EQ(merger.sorted_fallback_count(), 1u);
+    // The source vector itself is never reordered
+    EXPECT_DOUBLE_EQ(shuffled.front().price, 4.0);
+}
+
+TEST(TickMergerTest, EmptyAndMissingSourcesAreSkipped) {
+    std::vector<qse::Tick> empty;
+    std::vector<qse::Tick> one = {make_tick("A", 1, 1.0)};
+
+    qse::TickMerger merger;
+    merger.add_source(nullptr);
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(empty));
+    merger.add_source(std::make_unique<qse::VectorTickCursor>(one));
+
+    auto merged = drain(merger);
+    ASSERT_EQ(merged.size(), 1u);
+    EXPECT_EQ(merger.next(), nullptr);
+}
+
+TEST(TickMergerTest, MergesStreamingSourcesAcrossBatchBoundaries) {
+    // Two streaming CSV readers, each longer than one batch, on interleaved
+    // odd/even second grids
+    const std::size_t rows = qse::kTickBatchSize + 100;
+    const std::string paths[2] = {"merge_even.csv", "merge_odd.csv"};
+    for (int f = 0; f < 2; ++f) {
+        std::ofstream out(paths[f]);
+        out << "timestamp,price,volume\n";
+        for (std::size_t i = 0; i < rows; ++i) {
+            out << (1700000000 + 2 * i + f) << ",100.0,10\n";
+        }
+    }
+
+    qse::CSVDataReader even(paths[0], "EVEN", qse::CSVDataReader::LoadMode::Streaming);
+    qse::CSVDataReader odd(paths[1], "ODD", qse::CSVDataReader::LoadMode::Streaming);
+    qse::TickMerger merger;
+    merger.add_source(even.open_tick_cursor());
+    merger.add_source(odd.open_tick_cursor());
+
+    std::size_t count = 0;
+    qse::Timestamp prev{};
+    bool monotone = true;
+    while (const qse::Tick* t = merger.next()) {
+        if (count > 0 && t->timestamp <= prev) {
+            monotone = false;
+        }
+        prev = t->timestamp;
+        ++count;
+    }
+
+    EXPECT_EQ(count, 2 * rows);
+    EXPECT_TRUE(monotone);
+    EXPECT_EQ(merger.sorted_fallback_count(), 0u);
+    std::remove(paths[0].c_str());
+    std::remove(paths[1].c_str());
+}
@@ -0,0 +1,188 @@
+// Work-stealing pool: the Chase-Lev deque hands every task out exactly once
+// under concurrent stealing, small callables are stored inline, and the
+// pool's fork/join helpers (TaskGroup, parallel_for) nest without blocking.
+
+#include <gtest/gtest.h>
+#include "qse/core/WorkStealingPool.h"
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using qse::detail::Task;
+using qse::detail::WorkStealingDeque;
+
+// A task that records its id in `out`
+Task id_task(std::vector<int>* out, int id) {
+    return Task::make([out, id] { out->push_back(id); });
+}
+
+long fib(qse::WorkStealingPool& pool, int n) {
+    if (n < 12) {
+        return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+    long a = 0, b = 0;
+    qse::TaskGroup group(pool);
+    group.run([&] { a = fib(pool, n - 1); });
+    b = fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+} // namespace
+
+TEST(WorkStealingDequeTest, OwnerPopsLifoThievesStealFifoAndRingGrows) {
+    WorkStealingDeque deque(4);
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i) {
+        deque.push(id_task(&order, i)); // grows 4 -> 8 -> 16
+    }
+    Task task;
+    ASSERT_TRUE(deque.steal(task));
+    task();
+    ASSERT_TRUE(deque.pop(task));
+    task();
+    while (deque.pop(task)) {
+        task();
+    }
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.steal(task));
+    ASSERT_EQ(order.size(), 10u);
+    EXPECT_EQ(order[0], 0); // oldest, stolen
+    EXPECT_EQ(order[1], 9); // newest, popped
+    EXPECT_EQ(order.back(), 1);
+}
+
+TEST(WorkStealingDequeTest, ConcurrentStealsTakeEachTaskExactlyOnce) {
+    constexpr int kTasks = 200000;
+    WorkStealingDeque deque(16);
+    std::vector<std::atomic<int>> runs(kTasks);
+    std::atomic<bool> done{false};
+    std::atomic<int> executed{0};
+
+    auto make = [&](int i) {
+        return Task::make([&runs, &executed, i] {
+            runs[i].fetch_add(1, std::memory_order_relaxed);
+            executed.fetch_add(1, std::memory_order_relaxed);
+        });
+    };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            Task task;
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (deque.steal(task)) {
+                    task();
+                }
+            }
+        });
+    }
+    Task task;
+    for (int i = 0; i < kTasks; ++i) {
+        deque.push(make(i));
+        if (i % 3 == 0 && deque.pop(task)) {
+            task();
+        }
+    }
+    while (deque.pop(task)) {
+        task();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    EXPECT_EQ(executed.load(), kTasks);
+    for (int i = 0; i < kTasks; ++i) {
+        ASSERT_EQ(runs[i].load(), 1) << "task " << i;
+    }
+}
+
+TEST(WorkStealingPoolTest, SmallCallablesAreStoredInline) {
+    int x = 0;
+    double* p = nullptr;
+    std::size_t a = 1, b = 2, c = 3;
+    auto small = [&x, p, a, b, c] { x += static_cast<int>(a + b + c) + (p != nullptr); };
+    EXPECT_TRUE(Task::fits_inline<decltype(small)>());
+
+    std::string name = "boxed";
+    auto owning = [name] { (void)name.size(); };
+    EXPECT_FALSE(Task::fits_inline<decltype(owning)>());
+
+    Task inline_task = Task::make(small);
+    inline_task();
+    EXPECT_EQ(x, 6);
+    Task boxed_task = Task::make(owning); // freed when run
+    boxed_task();
+}
+
+TEST(WorkStealingPoolTest, PostAndEnqueueRunEverything) {
+    std::atomic<int> counter{0};
+    std::vector<std::future<int>> results;
+    {
+        qse::WorkStealingPool pool(4);
+        EXPECT_EQ(pool.size(), 4u);
+        for (int i = 0; i < 1000; ++i) {
+            pool.post([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        for (int i = 0; i < 10; ++i) {
+            results.push_back(pool.enqueue([](int v) { return v * 2; }, i));
+        }
+        auto failing = pool.enqueue([]() -> int { throw std::runtime_error("boom"); });
+        EXPECT_THROW(failing.get(), std::runtime_error);
+    } // destructor drains the queues
+    EXPECT_EQ(counter.load(), 1000);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(results[i].get(), i * 2);
+    }
+}
+
+TEST(WorkStealingPoolTest, ParallelForVisitsEveryIndexOnceAndNests) {
+    qse::WorkStealingPool pool(4);
+    constexpr std::size_t kOuter = 64, kInner = 500;
+    std::vector<std::atomic<int>> hits(kOuter * kInner);
+    pool.parallel_for(0, kOuter, [&](std::size_t i) {
+        EXPECT_TRUE(pool.on_worker_thread());
+        pool.parallel_for(0, kInner, [&](std::size_t j) {
+            hits[i * kInner + j].fetch_add(1, std::memory_order_relaxed);
+        }, 32);
+    });
+    for (const auto& h : hits) {
+        ASSERT_EQ(h.load(), 1);
+    }
+    EXPECT_FALSE(pool.on_worker_thread());
+
+    pool.parallel_for(5, 5, [](std::size_t) { FAIL() << "empty range"; });
+}
+
+TEST(WorkStealingPoolTest, RecursiveForkJoin) {
+    qse::WorkStealingPool pool(3);
+    EXPECT_EQ(fib(pool, 25), 75025);
+}
+
+TEST(WorkStealingPoolTest, TaskGroupRethrowsFirstErrorAfterAllTasksRan) {
+    qse::WorkStealingPool pool(2);
+    std::atomic<int> ran{0};
+    qse::TaskGroup group(pool);
+    for (int i = 0; i < 50; ++i) {
+        group.run([&ran, i] {
+            ran.fetch_add(1);
+            if (i == 7) {
+                throw std::invalid_argument("task 7");
+            }
+        });
+    }
+    EXPECT_THROW(group.wait(), std::invalid_argument);
+    EXPECT_EQ(ran.load(), 50);
+
+    // The group is reusable once waited on
+    group.run([&ran] { ran.fetch_add(1); });
+    group.wait();
+    EXPECT_EQ(ran.load(), 51);
+}
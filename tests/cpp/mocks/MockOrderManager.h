@@ -22,6 +22,7 @@ public:
     MOCK_METHOD(double, get_cash, (), (const, override));
     MOCK_METHOD(void, record_equity, (long long timestamp, const MarketPrices& market_prices),
                 (override));
+    MOCK_METHOD(void, record_equity, (long long timestamp), (override));
 
     // --- Tick-level order management mock methods ---
     MOCK_METHOD(qse::OrderId, submit_market_order,
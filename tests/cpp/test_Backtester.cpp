@@ -212,7 +212,7 @@ TEST_F(BacktesterTickIntegrationTest, TickStreamIntegration) {
     EXPECT_CALL(*mock_order_manager, attempt_fills()).Times(test_ticks_.size());
 
     // Expect the equity curve to be marked to market after each tick
-    EXPECT_CALL(*mock_order_manager, record_equity(_, _)).Times(test_ticks_.size());
+    EXPECT_CALL(*mock_order_manager, record_equity(_)).Times(test_ticks_.size());
 
     // Expect strategy to receive bars when they're completed
     // The BarBuilder will create bars and call on_bar
@@ -308,7 +308,7 @@ TEST_F(BacktesterTickIntegrationTest, TickProcessingOrder) {
     EXPECT_CALL(*mock_strategy, on_tick(_)).Times(test_ticks_.size());
     EXPECT_CALL(*mock_order_manager, process_tick(_)).Times(test_ticks_.size());
     EXPECT_CALL(*mock_order_manager, attempt_fills()).Times(test_ticks_.size());
-    EXPECT_CALL(*mock_order_manager, record_equity(_, _)).Times(test_ticks_.size());
+    EXPECT_CALL(*mock_order_manager, record_equity(_)).Times(test_ticks_.size());
 
     // Expect strategy to receive bars when they're completed
     EXPECT_CALL(*mock_strategy, on_bar(_)).Times(::testing::AtLeast(1));
@@ -349,7 +349,7 @@ TEST_F(BacktesterTickIntegrationTest, LargeTickStream) {
     EXPECT_CALL(*mock_strategy, on_tick(_)).Times(1000);
     EXPECT_CALL(*mock_order_manager, process_tick(_)).Times(1000);
     EXPECT_CALL(*mock_order_manager, attempt_fills()).Times(1000);
-    EXPECT_CALL(*mock_order_manager, record_equity(_, _)).Times(1000);
+    EXPECT_CALL(*mock_order_manager, record_equity(_)).Times(1000);
 
     // Expect strategy to receive bars when they're completed
     EXPECT_CALL(*mock_strategy, on_bar(_)).Times(::testing::AtLeast(1));
@@ -55,4 +55,108 @@ TEST(BarBuilderTest, AggregatesTicksIntoBars) {
     EXPECT_DOUBLE_EQ(bar2.low, 11.0);
     EXPECT_DOUBLE_EQ(bar2.close, 11.0);
     EXPECT_EQ(bar2.volume, 100); // 100 (bid_size + ask_size)
-}
\ No newline at end of file
+}
+namespace {
+
+Tick make_tick(long long ms, double price, long long volume = 100) {
+    Tick t{};
+    t.symbol = "TEST";
+    t.timestamp = from_unix_ms(ms);
+    t.price = price;
+    t.volume = volume;
+    return t;
+}
+
+} // namespace
+
+TEST(BarBuilderTest, InOrderTicksCompleteOneBarPerInterval) {
+    BarBuilder builder(std::chrono::seconds(1));
+    std::vector<Bar> completed;
+    for (int i = 0; i < 30; ++i) {
+        // ten ticks per second, prices rising within each second
+        if (auto b = builder.add_tick(make_tick(1000 + 100 * i, 1.0 + i, 10))) {
+            completed.push_back(*b);
+        }
+    }
+    ASSERT_EQ(completed.size(), 2u);
+    auto last = builder.flush();
+    ASSERT_TRUE(last.has_value());
+    EXPECT_FALSE(builder.flush().has_value());
+    completed.push_back(*last);
+
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_EQ(to_unix_ms(completed[k].timestamp), 1000LL * (k + 1));
+        EXPECT_DOUBLE_EQ(completed[k].open, 1.0 + 10 * k);
+        EXPECT_DOUBLE_EQ(completed[k].low, 1.0 + 10 * k);
+        EXPECT_DOUBLE_EQ(completed[k].high, 10.0 + 10 * k);
+        EXPECT_DOUBLE_EQ(completed[k].close, 10.0 + 10 * k);
+        EXPECT_EQ(completed[k].volume, 100);
+    }
+    EXPECT_EQ(builder.late_ticks_dropped(), 0u);
+}
+
+TEST(BarBuilderTest, ReorderWindowPlacesLateTicksInTheirInterval) {
+    BarBuilder builder(std::chrono::seconds(1), std::chrono::milliseconds(500));
+    std::vector<Bar> completed;
+    auto feed = [&](const Tick& t) {
+        if (auto b = builder.add_tick(t)) {
+            completed.push_back(*b);
+        }
+    };
+
+    feed(make_tick(1200, 12.0));
+    feed(make_tick(2100, 21.0)); // opens [2000,3000); [1000,2000) stays open
+    feed(make_tick(1000, 10.0)); // 1.1 s behind, but its interval is open: new open
+    feed(make_tick(1900, 19.0)); // new close
+    feed(make_tick(1500, 30.0)); // inside: high only
+    EXPECT_TRUE(completed.empty());
+
+    feed(make_tick(2500, 25.0)); // watermark 2000 closes [1000,2000)
+    ASSERT_EQ(completed.size(), 1u);
+    const Bar& bar = completed[0];
+    EXPECT_EQ(to_unix_ms(bar.timestamp), 1000LL);
+    EXPECT_DOUBLE_EQ(bar.open, 10.0);
+    EXPECT_DOUBLE_EQ(bar.high, 30.0);
+    EXPECT_DOUBLE_EQ(bar.low, 10.0);
+    EXPECT_DOUBLE_EQ(bar.close, 19.0);
+    EXPECT_EQ(bar.volume, 400);
+
+    // Past the window: dropped and counted, the closed bar is not reopened
+    feed(make_tick(1999, 99.0));
+    EXPECT_EQ(builder.late_ticks_dropped(), 1u);
+    EXPECT_EQ(completed.size(), 1u);
+
+    auto rest = builder.flush();
+    ASSERT_TRUE(rest.has_value());
+    EXPECT_EQ(to_unix_ms(rest->timestamp), 2000LL);
+    EXPECT_DOUBLE_EQ(rest->open, 21.0);
+    EXPECT_DOUBLE_EQ(rest->close, 25.0);
+    EXPECT_EQ(rest->volume, 200);
+    EXPECT_FALSE(builder.flush().has_value());
+}
+
+TEST(BarBuilderTest, OneTickCanCompleteSeveralBars) {
+    BarBuilder builder(std::chrono::seconds(1), std::chrono::milliseconds(2000));
+    EXPECT_FALSE(builder.add_tick(make_tick(1500, 1.0)).has_value());
+    EXPECT_FALSE(builder.add_tick(make_tick(3100, 3.0)).has_value());
+    EXPECT_FALSE(builder.add_tick(make_tick(2400, 2.0)).has_value()); // late, inserted
+
+    // watermark 6000 closes all three open intervals
+    auto first = builder.add_tick(make_tick(8000, 8.0));
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(to_unix_ms(first->timestamp), 1000LL);
+    auto second = builder.pop_completed();
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(to_unix_ms(second->timestamp), 2000LL);
+    EXPECT_DOUBLE_EQ(second->close, 2.0);
+
+    // flush drains what is ready before what is still open
+    auto third = builder.flush();
+    ASSERT_TRUE(third.has_value());
+    EXPECT_EQ(to_unix_ms(third->timestamp), 3000LL);
+    auto fourth = builder.flush();
+    ASSERT_TRUE(fourth.has_value());
+    EXPECT_EQ(to_unix_ms(fourth->timestamp), 8000LL);
+    EXPECT_FALSE(builder.flush().has_value());
+    EXPECT_FALSE(builder.pop_completed().has_value());
+}
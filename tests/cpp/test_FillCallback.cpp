@@ -4,6 +4,7 @@
 #include "qse/core/Config.h"
 #include <memory>
 #include <filesystem>
+#include <fstream>
 
 namespace qse {
 
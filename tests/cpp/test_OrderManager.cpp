@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <fstream>
 #include <gmock/gmock.h>
 #include <memory>
 #include <vector>
 #include <string>
 #include <sstream>
 
+#include "qse/core/Config.h"
 #include "qse/order/OrderManager.h"
 #include "qse/data/OrderBook.h"
 
@@ -268,7 +270,7 @@ TEST_F(OrderManagerTickSimulationTest, MarketOrderFillsImmediately) {
 
     // Submit a market buy order
     auto order_id = order_manager->submit_market_order("AAPL", qse::Order::Side::BUY, 100);
-    EXPECT_FALSE(order_id.empty());
+    EXPECT_NE(order_id, qse::kInvalidOrderId);
 
     // Verify order is active
     auto order = order_manager->get_order(order_id);
@@ -531,20 +533,47 @@ TEST_F(OrderManagerTickSimulationTest, MultipleOrdersOnSameTick) {
     EXPECT_EQ(sell->status, qse::Order::Status::FILLED);
 }
 
-namespace qse {
-
-void OrderBook::on_tick(const Tick& tick) {
-    auto& tob = books_[tick.symbol];
-    tob.best_bid_price = tick.bid;
-    tob.best_bid_size = tick.bid_size;
-    tob.best_ask_price = tick.ask;
-    tob.best_ask_size = tick.ask_size;
-}
-
-const TopOfBook& OrderBook::top_of_book(const std::string& symbol) const {
-    static TopOfBook empty;
-    auto it = books_.find(symbol);
-    return (it != books_.end()) ? it->second : empty;
+// Off-grid limits round inward: a buy down and a sell up to the next tick
+TEST_F(OrderManagerTickSimulationTest, OffGridLimitsRoundAwayFromTheTouch) {
+    const std::string config_path = "om_off_grid_config.yaml";
+    {
+        std::ofstream out(config_path);
+        out << "symbols:\n"
+               "  AAPL:\n"
+               "    tick_size: 0.01\n";
+    }
+    qse::Config config;
+    ASSERT_TRUE(config.load_config(config_path));
+    std::filesystem::remove(config_path);
+    qse::OrderManager order_manager(config, "test_equity.csv", "test_tradelog.csv");
+
+    auto buy = order_manager.submit_limit_order("AAPL", qse::Order::Side::BUY, 100, 10.005,
+                                                qse::Order::TimeInForce::GTC);
+    auto sell = order_manager.submit_limit_order("AAPL", qse::Order::Side::SELL, 100, 10.015,
+                                                 qse::Order::TimeInForce::GTC);
+    EXPECT_EQ(order_manager.get_order(buy)->limit_price, 10.0);
+    EXPECT_EQ(order_manager.get_order(sell)->limit_price, 10.02);
+
+    // Limits already on the grid keep their tick despite floating-point noise
+    auto on_grid_buy = order_manager.submit_limit_order("AAPL", qse::Order::Side::BUY, 100, 10.03,
+                                                        qse::Order::TimeInForce::GTC);
+    auto on_grid_sell = order_manager.submit_limit_order(
+        "AAPL", qse::Order::Side::SELL, 100, 10.03, qse::Order::TimeInForce::GTC);
+    EXPECT_EQ(order_manager.get_order(on_grid_buy)->limit_price, 10.03);
+    EXPECT_EQ(order_manager.get_order(on_grid_sell)->limit_price, 10.03);
+    order_manager.cancel_order(on_grid_buy);
+    order_manager.cancel_order(on_grid_sell);
+
+    // An ask of 10.01 is above the buy's 10.005 and a bid of 10.01 below the
+    // sell's 10.015: nearest-tick rounding would have filled both
+    qse::Tick inside{"AAPL", qse::from_unix_ms(1000), 10.01, 10.01, 10.01, 100, 100, 100};
+    order_manager.process_tick(inside);
+    EXPECT_EQ(order_manager.get_order(buy)->filled_quantity, 0);
+    EXPECT_EQ(order_manager.get_order(sell)->filled_quantity, 0);
+
+    qse::Tick through{"AAPL", qse::from_unix_ms(1001), 10.0, 10.0, 10.0, 100, 100, 100};
+    order_manager.process_tick(through);
+    EXPECT_TRUE(order_manager.get_order(buy)->is_filled());
+    EXPECT_DOUBLE_EQ(order_manager.get_order(buy)->avg_fill_price, 10.0);
+    EXPECT_EQ(order_manager.get_order(sell)->filled_quantity, 0);
 }
-
-} // namespace qse
\ No newline at end of file
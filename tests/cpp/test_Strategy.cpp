@@ -23,6 +23,7 @@ public:
     MOCK_METHOD(void, record_equity,
                 (long long timestamp, (const std::map<std::string, double>&)market_prices),
                 (override));
+    MOCK_METHOD(void, record_equity, (long long timestamp), (override));
     // --- Tick-level order management mock methods ---
     MOCK_METHOD(qse::OrderId, submit_market_order,
                 (const std::string& symbol, qse::Order::Side side, qse::Volume quantity),
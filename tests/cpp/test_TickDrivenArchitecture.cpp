@@ -6,6 +6,7 @@
 #include "qse/core/Config.h"
 #include <memory>
 #include <filesystem>
+#include <fstream>
 
 namespace qse {
 